@@ -99,7 +99,6 @@ int main(int argc, char **argv){
         std::cout << "Reading from input file is not implemented yet." << std::endl;
         return 1;
     }
-    bool* bitMapTemp = new bool[inVectorSize];
     vector<uint64_t> inVector(inVectorSize);
 
     std::cout << "DB element size: " << inVectorSize << std::endl;
@@ -109,7 +108,8 @@ int main(int argc, char **argv){
         inVector[i] = rand() % MY_RANGE;
     }
 
-    std::vector<uint8_t> bitMap(inVectorSize, 0);
+    std::vector<uint64_t> outVector(inVectorSize);
+    uint64_t outSize = 0;
 
     if (!createDevice(p.configFile)){
         return 1;
@@ -140,89 +140,56 @@ int main(int argc, char **argv){
         return 1;
     }
 
-    status = pimCopyDeviceToHost(srcObj2, (void *)bitMap.data());
-    if (status != PIM_OK){
-      std::cout << "Abort" << std::endl;
+    // Pack selected elements densely on device, so that only they are copied back to host
+    PimObjId destObj = pimAllocAssociated(srcObj1, PIM_UINT64);
+    if (destObj == -1){
+        std::cout << "Abort" << std::endl;
+        return 1;
+    }
+    status = pimCompact(srcObj1, srcObj2, destObj, &outSize);
+    if (status != PIM_OK) {
+        std::cout << "Abort" << std::endl;
+        return 1;
+    }
+    if (outSize > 0) {
+        status = pimCopyDeviceToHost(destObj, (void *)outVector.data(), 0, outSize);
+        if (status != PIM_OK){
+          std::cout << "Abort" << std::endl;
+        }
     }
     pimShowStats();
 
     pimFree(srcObj1);
     pimFree(srcObj2);
+    pimFree(destObj);
     
     uint64_t dummyVectorSize = 1073741824;
     vector<int> dummyVector1(dummyVectorSize, 0);
 
-    auto start_cpu = std::chrono::high_resolution_clock::now();
-
     for (uint64_t j = 0; j < dummyVectorSize; j++){
       dummyVector1[j] += rand() % MY_RANGE;
     }
     cout << "Cache flushed!" << endl;
 
-    for (uint64_t i = 0; i < inVectorSize; i++){
-      if(bitMap[i] == 1){
-        bitMapTemp[i] = true;
-      }
-    }
-    
-    uint64_t buffer_in_CPU1 = 0;
-    uint64_t buffer_in_CPU2 = 0;
-    uint64_t buffer_in_CPU3 = 0;
-    uint64_t buffer_in_CPU4 = 0;
-    uint64_t buffer_in_CPU5 = 0;
-    uint64_t buffer_in_CPU6 = 0;
-    uint64_t buffer_in_CPU7 = 0;
-    uint64_t buffer_in_CPU8 = 0;
-    uint64_t selectedNum1 = 0;
-    uint64_t selectedNum2 = 0;
-    uint64_t selectedNum3 = 0;
-    uint64_t selectedNum4 = 0;
-    uint64_t selectedNum5 = 0;
-    uint64_t selectedNum6 = 0;
-    uint64_t selectedNum7 = 0;
-    uint64_t selectedNum8 = 0;
-
-    start_cpu = std::chrono::high_resolution_clock::now();
-    for (uint64_t i = 0; i < inVectorSize; i+=8){
-      if(bitMapTemp[i + 0] == true){
-        buffer_in_CPU1 += inVector[i + 0];
-        selectedNum1++;
-      }
-      if(bitMapTemp[i + 1] == true){
-        buffer_in_CPU2 += inVector[i + 1];
-        selectedNum2++;
-      }
-      if(bitMapTemp[i + 2] == true){
-        buffer_in_CPU3 += inVector[i + 2];
-        selectedNum3++;
-      }
-      if(bitMapTemp[i + 3] == true){
-        buffer_in_CPU4 += inVector[i + 3];
-        selectedNum4++;
-      }
-      if(bitMapTemp[i + 4] == true){
-        buffer_in_CPU5 += inVector[i + 4];
-        selectedNum5++;
-      }
-      if(bitMapTemp[i + 5] == true){
-        buffer_in_CPU6 += inVector[i + 5];
-        selectedNum6++;
-      }
-      if(bitMapTemp[i + 6] == true){
-        buffer_in_CPU7 += inVector[i + 6];
-        selectedNum7++;
-      }
-      if(bitMapTemp[i + 7] == true){
-        buffer_in_CPU8 += inVector[i + 7];
-        selectedNum8++;
-      }
+    // Host consumes the selected elements
+    uint64_t buffer_in_CPU = 0;
+    auto start_cpu = std::chrono::high_resolution_clock::now();
+    for (uint64_t i = 0; i < outSize; i++){
+      buffer_in_CPU += outVector[i];
     }
-    uint64_t outSize = selectedNum1 + selectedNum2 + selectedNum3 + selectedNum4 + selectedNum5 + selectedNum6 + selectedNum7 + selectedNum8;
-
     auto stop_cpu = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> hostElapsedTime = (stop_cpu - start_cpu);
+
     if (p.shouldVerify){
+        vector<uint64_t> expected;
+        for (uint64_t i = 0; i < inVectorSize; i++){
+          if (inVector[i] < static_cast<uint64_t>(key)){
+            expected.push_back(inVector[i]);
+          }
+        }
+        outVector.resize(outSize);
         cout << outSize <<" out of " << inVectorSize << " selected" << endl;
+        cout << (outVector == expected ? "Correct!" : "Wrong answer!") << endl;
     }
     cout << "Host elapsed time: " << std::fixed << std::setprecision(3) << hostElapsedTime.count() << " ms." << endl;
     return 0;
@@ -8,6 +8,7 @@
 #include <getopt.h>
 #include <stdint.h>
 #include <iomanip>
+#include <algorithm>
 #if defined(_OPENMP)
 #include <omp.h>
 #endif
@@ -84,93 +85,76 @@ struct Params getInputParams(int argc, char **argv)
   return p;
 }
 
-void gemv(uint64_t row, uint64_t col, std::vector<int> &srcVector, std::vector<std::vector<int>> &srcMatrix, std::vector<int> &dst)
+void transposeMatrix(uint64_t row, uint64_t col, std::vector<std::vector<int>> &srcMatrix, std::vector<std::vector<int>> &dstMatrix)
 {
-  PimObjId srcObj1 = pimAlloc(PIM_ALLOC_AUTO, row, PIM_INT32);
-  if (srcObj1 == -1)
+#pragma omp parallel for
+  for (uint64_t i = 0; i < col; ++i)
   {
-    std::cout << "Abort" << std::endl;
-    return;
+    for (uint64_t j = 0; j < row; ++j)
+    {
+      dstMatrix[i][j] = srcMatrix[j][i];
+    }
+  }
+}
+
+void gemm(uint64_t row, uint64_t colA, uint64_t colB, std::vector<std::vector<int>> &srcMatrixA, std::vector<std::vector<int>> &srcMatrixB, std::vector<std::vector<int>> &dstMatrix, bool shouldVerify)
+{
+  dstMatrix.resize(row, std::vector<int>(colB, 0));
+  std::vector<std::vector<int>> transposedDstMat(colB, std::vector<int>(row, 0));
+  vector<std::vector<int>> srcMatrixAT(colA, std::vector<int>(row, 0)), srcMatrixBT(colB, std::vector<int>(colA, 0));
+  // TODO: Do we actually need to transpose matrices
+  transposeMatrix(row, colA, srcMatrixA, srcMatrixAT);
+  transposeMatrix(colA, colB, srcMatrixB, srcMatrixBT);
+  // Matrix A is stored column by column, so that each column of it is placed next to the rows of the result
+  std::vector<int> flatMatA(row * colA), flatMatB(colA * colB), flatDst(row * colB);
+  for (uint64_t i = 0; i < colA; ++i)
+  {
+    std::copy(srcMatrixAT[i].begin(), srcMatrixAT[i].end(), flatMatA.begin() + i * row);
   }
-  PimObjId srcObj2 = pimAllocAssociated(srcObj1, PIM_INT32);
-  if (srcObj2 == -1)
+  for (uint64_t i = 0; i < colB; ++i)
+  {
+    std::copy(srcMatrixBT[i].begin(), srcMatrixBT[i].end(), flatMatB.begin() + i * colA);
+  }
+
+  PimObjId matObj = pimAlloc(PIM_ALLOC_AUTO, row * colA, PIM_INT32);
+  if (matObj == -1)
   {
     std::cout << "Abort" << std::endl;
     return;
   }
-
-  PimObjId dstObj = pimAllocAssociated(srcObj1, PIM_INT32);
+  PimObjId dstObj = pimAlloc(PIM_ALLOC_AUTO, row * colB, PIM_INT32);
   if (dstObj == -1)
   {
     std::cout << "Abort" << std::endl;
     return;
   }
 
-  PimStatus status = pimBroadcastInt(dstObj, 0);
+  PimStatus status = pimCopyHostToDevice((void *)flatMatA.data(), matObj);
   if (status != PIM_OK)
   {
     std::cout << "Abort" << std::endl;
     return;
   }
 
-  for (uint64_t i = 0; i < col; ++i)
+  status = pimGemm(matObj, (void *)flatMatB.data(), dstObj, colB);
+  if (status != PIM_OK)
   {
-    status = pimCopyHostToDevice((void *)srcMatrix[i].data(), srcObj1);
-    if (status != PIM_OK)
-    {
-      std::cout << "Abort" << std::endl;
-      return;
-    }
-
-    status = pimMulScalar(srcObj1, srcObj2, srcVector[i]);
-    if (status != PIM_OK)
-    {
-      std::cout << "Abort" << std::endl;
-      return;
-    }
-
-    status = pimAdd(srcObj2, dstObj, dstObj);
-    if (status != PIM_OK)
-    {
-      std::cout << "Abort" << std::endl;
-      return;
-    }
+    std::cout << "Abort" << std::endl;
+    return;
   }
 
-  dst.reserve(row);
-  status = pimCopyDeviceToHost(dstObj, (void *)dst.data());
+  status = pimCopyDeviceToHost(dstObj, (void *)flatDst.data());
   if (status != PIM_OK)
   {
     std::cout << "Abort" << std::endl;
+    return;
   }
-  pimFree(srcObj1);
-  pimFree(srcObj2);
+  pimFree(matObj);
   pimFree(dstObj);
-}
-
-void transposeMatrix(uint64_t row, uint64_t col, std::vector<std::vector<int>> &srcMatrix, std::vector<std::vector<int>> &dstMatrix)
-{
-#pragma omp parallel for
-  for (uint64_t i = 0; i < col; ++i)
-  {
-    for (uint64_t j = 0; j < row; ++j)
-    {
-      dstMatrix[i][j] = srcMatrix[j][i];
-    }
-  }
-}
 
-void gemm(uint64_t row, uint64_t colA, uint64_t colB, std::vector<std::vector<int>> &srcMatrixA, std::vector<std::vector<int>> &srcMatrixB, std::vector<std::vector<int>> &dstMatrix, bool shouldVerify)
-{
-  dstMatrix.resize(row, std::vector<int>(colB, 0));
-  std::vector<std::vector<int>> transposedDstMat(colB, std::vector<int>(row, 0));
-  vector<std::vector<int>> srcMatrixAT(colA, std::vector<int>(row, 0)), srcMatrixBT(colB, std::vector<int>(colA, 0));
-  // TODO: Do we actually need to transpose matrices
-  transposeMatrix(row, colA, srcMatrixA, srcMatrixAT);
-  transposeMatrix(colA, colB, srcMatrixB, srcMatrixBT);
   for (uint64_t i = 0; i < colB; ++i)
   {
-    gemv(row, colA, srcMatrixBT[i], srcMatrixAT, transposedDstMat[i]);
+    std::copy(flatDst.begin() + i * row, flatDst.begin() + (i + 1) * row, transposedDstMat[i].begin());
   }
   transposeMatrix(colB, row, transposedDstMat, dstMatrix);
   if (shouldVerify)
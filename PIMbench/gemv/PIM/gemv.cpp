@@ -82,42 +82,37 @@ struct Params getInputParams(int argc, char **argv)
 
 void gemv(uint64_t row, uint64_t col, std::vector<int> &srcVector, std::vector<std::vector<int>> &srcMatrix, std::vector<int> &dst)
 {
-  PimObjId srcObj1 = pimAlloc(PIM_ALLOC_AUTO, row, PIM_INT32);
+  // column-major matrix object: column i occupies elements [i * row, (i + 1) * row)
+  PimObjId srcObj1 = pimAlloc(PIM_ALLOC_AUTO, row * col, PIM_INT32);
   if (srcObj1 == -1)
   {
     std::cout << "Abort" << std::endl;
     return;
   }
 
-  PimObjId dstObj = pimAllocAssociated(srcObj1, PIM_INT32);
+  PimObjId dstObj = pimAlloc(PIM_ALLOC_AUTO, row, PIM_INT32);
   if (dstObj == -1)
   {
     std::cout << "Abort" << std::endl;
     return;
   }
 
-  PimStatus status = pimBroadcastInt(dstObj, 0);
-  if (status != PIM_OK)
-  {
-    std::cout << "Abort" << std::endl;
-    return;
-  }
-
+  PimStatus status = PIM_OK;
   for (uint64_t i = 0; i < col; ++i)
   {
-    status = pimCopyHostToDevice((void *)srcMatrix[i].data(), srcObj1);
+    status = pimCopyHostToDevice((void *)srcMatrix[i].data(), srcObj1, i * row, (i + 1) * row);
     if (status != PIM_OK)
     {
       std::cout << "Abort" << std::endl;
       return;
     }
+  }
 
-    status = pimScaledAdd(srcObj1, dstObj, dstObj, srcVector[i]);
-    if (status != PIM_OK)
-    {
-      std::cout << "Abort" << std::endl;
-      return;
-    }
+  status = pimGemv(srcObj1, srcVector.data(), dstObj);
+  if (status != PIM_OK)
+  {
+    std::cout << "Abort" << std::endl;
+    return;
   }
 
   dst.resize(row);
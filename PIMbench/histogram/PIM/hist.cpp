@@ -28,6 +28,7 @@ typedef struct Params
   char *configFile;
   std::string inputFile;
   bool shouldVerify;
+  bool useScatterAdd;
 } Params;
 
 void usage()
@@ -38,6 +39,7 @@ void usage()
           "\n    -c    dramsim config file"
           "\n    -i    24-bit .bmp input file (default=uses 'sample1.bmp' from 'histogram_datafiles' directory)"
           "\n    -v    t = verifies PIM output with host output. (default=false)"
+          "\n    -s    t = counts pixels into bins with scatter-add instead of per-bin compares. (default=false)"
           "\n");
 }
 
@@ -47,9 +49,10 @@ struct Params getInputParams(int argc, char **argv)
   p.configFile = nullptr;
   p.inputFile = "../histogram_datafiles/sample1.bmp";
   p.shouldVerify = false;
+  p.useScatterAdd = false;
 
   int opt;
-  while ((opt = getopt(argc, argv, "h:c:i:v:")) >= 0)
+  while ((opt = getopt(argc, argv, "h:c:i:v:s:")) >= 0)
   {
     switch (opt)
     {
@@ -66,6 +69,9 @@ struct Params getInputParams(int argc, char **argv)
     case 'v':
       p.shouldVerify = (*optarg == 't') ? true : false;
       break;
+    case 's':
+      p.useScatterAdd = (*optarg == 't') ? true : false;
+      break;
     default:
       fprintf(stderr, "\nUnrecognized option!\n");
       usage();
@@ -84,8 +90,12 @@ void histogram(uint64_t imgDataBytes, const std::vector<uint8_t> &redData, const
   assert(greenObj != -1);
   PimObjId blueObj = pimAllocAssociated(redObj, PIM_UINT8);
   assert(blueObj != -1);
-  PimObjId tempObj = pimAllocAssociated(redObj, PIM_BOOL);
-  assert(tempObj != -1);
+  PimObjId redTempObj = pimAllocAssociated(redObj, PIM_BOOL);
+  assert(redTempObj != -1);
+  PimObjId greenTempObj = pimAllocAssociated(redObj, PIM_BOOL);
+  assert(greenTempObj != -1);
+  PimObjId blueTempObj = pimAllocAssociated(redObj, PIM_BOOL);
+  assert(blueTempObj != -1);
 
   PimStatus status = pimCopyHostToDevice((void *) redData.data(), redObj);
   assert(status == PIM_OK);
@@ -94,40 +104,69 @@ void histogram(uint64_t imgDataBytes, const std::vector<uint8_t> &redData, const
   status = pimCopyHostToDevice((void *) greenData.data(), greenObj);
   assert(status == PIM_OK);
 
-  uint64_t prevCount; // Needed when image data can't fit in one PIM object, multiple passes are needed
-
+  // Count all three channels of a bin with one batched reduction
+  PimObjId tempObjs[] = { blueTempObj, greenTempObj, redTempObj };
+  PimReductionEnum ops[] = { PIM_RED_SUM, PIM_RED_SUM, PIM_RED_SUM };
   for (int i = 0; i < NUMBINS; ++i) 
   {
-    status = pimEQScalar(blueObj, tempObj, static_cast<uint64_t> (i));
-    assert(status == PIM_OK);
-
-    prevCount = blueCount[i];
-    status = pimRedSum(tempObj, static_cast<void*>(&blueCount[i]));
+    status = pimEQScalar(blueObj, blueTempObj, static_cast<uint64_t> (i));
     assert(status == PIM_OK);
-    blueCount[i] += prevCount;
-
-    status = pimEQScalar(greenObj, tempObj, static_cast<uint64_t> (i));
-    assert(status == PIM_OK);
-
-    prevCount = greenCount[i];
-    status = pimRedSum(tempObj, static_cast<void*>(&greenCount[i]));
+    status = pimEQScalar(greenObj, greenTempObj, static_cast<uint64_t> (i));
     assert(status == PIM_OK);
-    greenCount[i] += prevCount;
-
-    status = pimEQScalar(redObj, tempObj, static_cast<uint64_t> (i));
+    status = pimEQScalar(redObj, redTempObj, static_cast<uint64_t> (i));
     assert(status == PIM_OK);
 
-    prevCount = redCount[i];
-    status = pimRedSum(tempObj, static_cast<void*>(&redCount[i]));
+    // Counts are accumulated, as needed when image data can't fit in one PIM object and multiple passes are needed
+    void* counts[] = { &blueCount[i], &greenCount[i], &redCount[i] };
+    status = pimRedBatched(tempObjs, ops, counts, 3);
     assert(status == PIM_OK);
-    redCount[i] += prevCount;
   }
   pimFree(redObj);
   pimFree(greenObj);
   pimFree(blueObj);
-  pimFree(tempObj);
+  pimFree(redTempObj);
+  pimFree(greenTempObj);
+  pimFree(blueTempObj);
 }
 
+// Count pixels into bins with one scatter-add per channel, using pixel values as bin indices
+void histogramScatterAdd(uint64_t imgDataBytes, const std::vector<uint8_t> &redData, const std::vector<uint8_t> &greenData, const std::vector<uint8_t> &blueData,
+                         std::vector<uint64_t> &redCount, std::vector<uint64_t> &greenCount, std::vector<uint64_t> &blueCount)
+{
+  // Allocate the wider object first, so that pixels can be associated with it in horizontal layout
+  PimObjId onesObj = pimAlloc(PIM_ALLOC_AUTO, imgDataBytes, PIM_UINT32);
+  assert(onesObj != -1);
+  PimObjId pixelObj = pimAllocAssociated(onesObj, PIM_UINT8);
+  assert(pixelObj != -1);
+  PimObjId binsObj = pimAlloc(PIM_ALLOC_AUTO, NUMBINS, PIM_UINT32);
+  assert(binsObj != -1);
+
+  PimStatus status = pimBroadcastUInt(onesObj, 1);
+  assert(status == PIM_OK);
+
+  const std::vector<uint8_t>* channelData[] = { &blueData, &greenData, &redData };
+  std::vector<uint64_t>* channelCount[] = { &blueCount, &greenCount, &redCount };
+  std::vector<uint32_t> bins(NUMBINS);
+  for (int c = 0; c < NUMCHANNELS; ++c)
+  {
+    status = pimCopyHostToDevice((void *) channelData[c]->data(), pixelObj);
+    assert(status == PIM_OK);
+    status = pimBroadcastUInt(binsObj, 0);
+    assert(status == PIM_OK);
+    status = pimScatterAdd(onesObj, pixelObj, binsObj);
+    assert(status == PIM_OK);
+    status = pimCopyDeviceToHost(binsObj, (void *) bins.data());
+    assert(status == PIM_OK);
+    // Counts are accumulated across multiple passes
+    for (int i = 0; i < NUMBINS; ++i)
+    {
+      (*channelCount[c])[i] += bins[i];
+    }
+  }
+  pimFree(pixelObj);
+  pimFree(onesObj);
+  pimFree(binsObj);
+}
 
 int main(int argc, char *argv[])
 {
@@ -203,18 +242,27 @@ int main(int argc, char *argv[])
   uint64_t numCol = deviceProp.numColPerSubarray, numRow = deviceProp.numRowPerSubarray, 
            numCore = deviceProp.numRanks * deviceProp.numBankPerRank * deviceProp.numSubarrayPerBank;
   uint64_t totalAvailableBits = numCol * numRow * numCore;
-  uint64_t requiredBitsforImage = ((imgDataBytes / NUMCHANNELS * 8) + 8); // Using uint8_t instead of int, only require 8 bits
+  // Using uint8_t instead of int, only require 8 bits. Scatter-add also needs a uint32_t addend per pixel
+  uint64_t bitsPerPixel = params.useScatterAdd ? 40 : 8;
+  uint64_t requiredBitsforImage = ((imgDataBytes / NUMCHANNELS * bitsPerPixel) + 8);
   int numItr = std::ceil(static_cast<double> (requiredBitsforImage) / totalAvailableBits);
   //std::cout << "Required iterations for image: " << numItr << std::endl;
 
   if (numItr == 1)
   {
-    histogram(imgDataBytes / NUMCHANNELS, redData, greenData, blueData, redCount, greenCount, blueCount);
+    if (params.useScatterAdd)
+    {
+      histogramScatterAdd(imgDataBytes / NUMCHANNELS, redData, greenData, blueData, redCount, greenCount, blueCount);
+    }
+    else
+    {
+      histogram(imgDataBytes / NUMCHANNELS, redData, greenData, blueData, redCount, greenCount, blueCount);
+    }
   }
   else
   {
     //TODO: ensure large inputs can be run in multiple histogram() calls if they can't fit in one PIM object
-    uint64_t bytesPerChunk = totalAvailableBits / 8;
+    uint64_t bytesPerChunk = totalAvailableBits / bitsPerPixel;
 
     for (int itr = 0; itr < numItr; ++itr)
     {
@@ -226,7 +274,14 @@ int main(int argc, char *argv[])
       std::vector<uint8_t> greenDataChunk(greenData.begin() + startByte, greenData.begin() + endByte);
       std::vector<uint8_t> blueDataChunk(blueData.begin() + startByte, blueData.begin() + endByte);
 
-      histogram(chunkSize, redDataChunk, greenDataChunk, blueDataChunk, redCount, greenCount, blueCount);
+      if (params.useScatterAdd)
+      {
+        histogramScatterAdd(chunkSize, redDataChunk, greenDataChunk, blueDataChunk, redCount, greenCount, blueCount);
+      }
+      else
+      {
+        histogram(chunkSize, redDataChunk, greenDataChunk, blueDataChunk, redCount, greenCount, blueCount);
+      }
     }
   }
 
@@ -148,21 +148,17 @@ vector<pair<int, int>> findKSmallestWithIndices(const vector<int>& data, int k)
     return result;   
 }
 
-void countLabelsAndClassify(uint64_t numPoints, uint64_t numTests, vector<vector<int>> &dataPoints, 
-          vector<vector<int>> &distMat, 
-          int adjusted_dim, 
-          int k,
+void classifyByNeighbors(uint64_t numTests, vector<vector<int>> &dataPoints,
+          vector<vector<uint64_t>> &kNearest,
+          int adjusted_dim,
           vector<int> &testPredictions
           ) {
 
   #pragma omp parallel for schedule(static)
   for(int i = 0; i < (int) numTests; i++) {
-    vector<pair<int, int>> kSmallest = findKSmallestWithIndices(distMat[i], k);
-
     // Tally the labels of the k nearest neighbors
     unordered_map<int, int> labelCount;
-    for (const auto& elem : kSmallest) {
-      int index = elem.second;
+    for (uint64_t index : kNearest[i]) {
       int label = dataPoints[adjusted_dim][index];
       #pragma omp atomic
       labelCount[label]++;
@@ -171,8 +167,7 @@ void countLabelsAndClassify(uint64_t numPoints, uint64_t numTests, vector<vector
     // Find the label with the highest count
     int maxCount = 0;
     int bestLabel = -1;
-    for (const auto& entry : kSmallest) {
-      int index = entry.second;
+    for (uint64_t index : kNearest[i]) {
       int label = dataPoints[adjusted_dim][index];
       if (labelCount[label] > maxCount) {
         maxCount = labelCount[label];
@@ -185,6 +180,25 @@ void countLabelsAndClassify(uint64_t numPoints, uint64_t numTests, vector<vector
   }
 }
 
+void countLabelsAndClassify(uint64_t numPoints, uint64_t numTests, vector<vector<int>> &dataPoints, 
+          vector<vector<int>> &distMat, 
+          int adjusted_dim, 
+          int k,
+          vector<int> &testPredictions
+          ) {
+
+  vector<vector<uint64_t>> kNearest(numTests);
+  #pragma omp parallel for schedule(static)
+  for(int i = 0; i < (int) numTests; i++) {
+    vector<pair<int, int>> kSmallest = findKSmallestWithIndices(distMat[i], k);
+    for (const auto& elem : kSmallest) {
+      kNearest[i].push_back(elem.second);
+    }
+  }
+
+  classifyByNeighbors(numTests, dataPoints, kNearest, adjusted_dim, testPredictions);
+}
+
 bool knn_test(vector<vector<int>> ref,
           const vector<vector<int>> query,
           int           dim,
@@ -277,7 +291,8 @@ void runKNN(uint64_t numOfPoints, uint64_t numOfTests, int dimension, int k, vec
   allocatePimObject(numOfPoints, dimension, resultObjectList, dataPointObjectList[0]);
 
 
-  vector<vector<int>> distMat(numOfTests, vector<int>(numOfPoints));
+  // Only the indices of the k nearest points are copied back instead of all distances
+  vector<vector<uint64_t>> kNearest(numOfTests, vector<uint64_t>(k));
   
   for(int j = 0; j < (int) numOfTests; ++j){
     for (int i = 0; i < dimension; ++i){
@@ -307,7 +322,7 @@ void runKNN(uint64_t numOfPoints, uint64_t numOfTests, int dimension, int k, vec
 
     }
 
-    PimStatus status = pimCopyDeviceToHost(resultObjectList[0], (void *)distMat[j].data());
+    PimStatus status = pimTopK(resultObjectList[0], k, nullptr, kNearest[j].data(), true);
     if (status != PIM_OK)
     {
       cout << "Abort" << endl;
@@ -318,7 +333,7 @@ void runKNN(uint64_t numOfPoints, uint64_t numOfTests, int dimension, int k, vec
 
   auto start = std::chrono::high_resolution_clock::now();
   
-  countLabelsAndClassify(numOfPoints, numOfTests, dataPoints, distMat, adjusted_dim, k, testPredictions);
+  classifyByNeighbors(numOfTests, dataPoints, kNearest, adjusted_dim, testPredictions);
 
   auto end = std::chrono::high_resolution_clock::now();
   hostElapsedTime += (end - start);
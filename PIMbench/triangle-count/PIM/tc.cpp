@@ -29,6 +29,8 @@
 #define INPUT_MODE ADJ_LIST
 
 #define USE_OPT 0
+#define USE_BATCHED 1
+#define MAX_PAIRS_PER_BATCH (1 << 20)
 
 typedef uint32_t UINT32;
 
@@ -449,6 +451,69 @@ int run_adjlist(const unordered_map<int, unordered_set<int>>& adjList, uint64_t
     return count / 6;
 }
 
+// Keep one neighbor bitmap row per node in PIM, and count common neighbors of all edges with batched AND-popcount
+int run_adjlist_batched(const unordered_map<int, unordered_set<int>>& adjList) {
+    int maxNode = 0;
+    for (const auto& it : adjList) {
+        maxNode = max(maxNode, it.first);
+    }
+    uint64_t numBitmapRows = maxNode + 1;
+    uint64_t wordsPerMatrixRow = (numBitmapRows + BITS_PER_INT - 1) / BITS_PER_INT; // Number of 32-bit integers needed per row
+    vector<uint32_t> bitmaps(numBitmapRows * wordsPerMatrixRow, 0);
+    for (const auto& it : adjList) {
+        convertToBitMap(it.second, it.first * wordsPerMatrixRow, bitmaps);
+    }
+
+    PimObjId bitmapObj = pimAlloc(PIM_ALLOC_AUTO, bitmaps.size(), PIM_UINT32);
+    if (bitmapObj == -1) {
+        std::cout << "bitmaps: pimAlloc" << std::endl;
+        return -1;
+    }
+    PimStatus status = pimCopyHostToDevice((void *)bitmaps.data(), bitmapObj);
+    if (status != PIM_OK) {
+        std::cout << "bitmaps: pimCopyHostToDevice Abort" << std::endl;
+        return -1;
+    }
+
+    uint64_t count = 0;
+    uint16_t iterations = 0;
+    vector<uint64_t> rowsA, rowsB, counts;
+    auto flush = [&]() {
+        if (rowsA.empty()) {
+            return true;
+        }
+        cout << "-------------itr[" << iterations << "]-------------" << endl;
+        cout << "Number of edges that are processed in this iteration: " << rowsA.size() << endl;
+        counts.resize(rowsA.size());
+        if (pimAndPopCountBatched(bitmapObj, wordsPerMatrixRow, rowsA.data(), rowsB.data(), rowsA.size(), counts.data()) != PIM_OK) {
+            std::cout << "pimAndPopCountBatched Abort" << std::endl;
+            return false;
+        }
+        for (uint64_t c : counts) {
+            count += c;
+        }
+        iterations++;
+        rowsA.clear();
+        rowsB.clear();
+        return true;
+    };
+    for (const auto& it : adjList) {
+        for (int v : it.second) {
+            rowsA.push_back(it.first);
+            rowsB.push_back(v);
+            if (rowsA.size() == MAX_PAIRS_PER_BATCH && !flush()) {
+                return -1;
+            }
+        }
+    }
+    if (!flush()) {
+        return -1;
+    }
+    pimFree(bitmapObj);
+    // Each triangle is counted 6 times (once per direction of each of its edges), so divide the count by 6
+    return count / 6;
+}
+
 int cpuTrianglesAdjMatrix(const vector<vector<bool>>& adjMatrix) {
     int count = 0;
     int V = adjMatrix.size();
@@ -548,7 +613,7 @@ int main(int argc, char** argv) {
             cout << "-----------convertToAdjList-----------" << endl;
             unordered_map<int, unordered_set<int>> adjList = convertToAdjList(edgeList);
             cout << "-----------Start running on PIM-----------" << endl;
-            pimTriCount = run_adjlist(adjList, words_per_device);
+            pimTriCount = USE_BATCHED ? run_adjlist_batched(adjList) : run_adjlist(adjList, words_per_device);
             if (params.shouldVerify){
                 //run on cpu
                 cout << "-----------Triangle Count Verification-----------" << endl;
@@ -48,6 +48,14 @@ bitSerialBase::runTests(const std::vector<std::string>& testList)
       ok &= testInt<uint32_t>(testName, PIM_UINT32);
     } else if (testName == "uint64") {
       ok &= testInt<uint64_t>(testName, PIM_UINT64);
+    } else if (testName == "int4") {
+      ok &= testInt<int8_t>(testName, PIM_INT4);
+    } else if (testName == "uint4") {
+      ok &= testInt<uint8_t>(testName, PIM_UINT4);
+    } else if (testName == "int2") {
+      ok &= testInt<int8_t>(testName, PIM_INT2);
+    } else if (testName == "uint2") {
+      ok &= testInt<uint8_t>(testName, PIM_UINT2);
     } else if (testName == "fp32") {
       ok &= testFp<float>(testName, PIM_FP32);
     } else {
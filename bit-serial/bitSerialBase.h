@@ -198,6 +198,27 @@ bitSerialBase::testInt(const std::string& category, PimDataType dataType)
         isSigned = false;
         maxVal = static_cast<T>(40000000000LL);
         break;
+    // sub-byte types use one host byte per element
+    case PIM_INT4:
+        numBits = 4;
+        minVal = static_cast<T>(-7);
+        maxVal = static_cast<T>(7);
+        break;
+    case PIM_UINT4:
+        numBits = 4;
+        isSigned = false;
+        maxVal = static_cast<T>(15);
+        break;
+    case PIM_INT2:
+        numBits = 2;
+        minVal = static_cast<T>(-1);
+        maxVal = static_cast<T>(1);
+        break;
+    case PIM_UINT2:
+        numBits = 2;
+        isSigned = false;
+        maxVal = static_cast<T>(3);
+        break;
     default:
       std::cout << "Error: Unsupported data type." << std::endl;
       return false;
@@ -222,7 +243,7 @@ bitSerialBase::testInt(const std::string& category, PimDataType dataType)
   vecSrc2[100] = vecSrc1[100];
   vecSrc2[3000] = vecSrc1[3000];
   // scalar value uses this type to represent bits for now
-  uint64_t scalarVal = 123;
+  uint64_t scalarVal = (numBits == 2 ? 1 : (numBits == 4 ? 5 : 123));
   vecSrc1[500] = static_cast<T>(scalarVal); // cover scalar EQ
   vecSrc1[501] = static_cast<T>(scalarVal - 1); // cover scalar LT
 
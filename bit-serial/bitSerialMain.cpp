@@ -26,6 +26,10 @@ bitSerialMain::bitSerialMain()
     "uint16",
     "uint32",
     "uint64",
+    "int4",
+    "uint4",
+    "int2",
+    "uint2",
     "fp32",
   };
 }
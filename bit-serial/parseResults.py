@@ -8,55 +8,131 @@
 import sys
 import re
 
-if len(sys.argv) != 2:
+
+def usage():
     print("Usage:")
     print("./bitSerial.out > result.txt")
-    print("./parseResult.py result.txt")
-    exit()
+    print("./parseResults.py result.txt                          # print C++ tables")
+    print("./parseResults.py result.txt --check <table-cpp>      # fail if the table drifts from results")
+    print("./parseResults.py result.txt --update <table-cpp>     # regenerate the table from results")
+    exit(1)
+
+
+def parse_results(filename):
+    """ Return a list of (device, data_type, op, numR, numW, numL, succeeded) in output order """
+    results = []
+    with open(filename, 'r') as f:
+        numR = 0
+        numW = 0
+        numL = 0
+        for line in f:
+            line = line.strip()
+
+            match1 = re.match(r'\[(.*):(.*):(.*):(.*)\] Start', line)
+            if match1:
+                numR = 0
+                numW = 0
+                numL = 0
 
-filename = sys.argv[1]
-print("INFO: Bit-serial Micro-program Performance Results")
+            match2 = re.match(r'Num Read, Write, Logic : (\S+), (\S+), (\S+)', line)
+            if match2:
+                numR = int(match2.group(1))
+                numW = int(match2.group(2))
+                numL = int(match2.group(3))
 
-with open(filename, 'r') as f:
+            match3 = re.match(r'\[(.*):(.*):(.*):(.*)\] End', line)
+            if match3:
+                succeeded = 'Succeeded' in line
+                results.append((match3.group(1), match3.group(2), match3.group(3), numR, numW, numL, succeeded))
+    return results
+
+
+def print_tables(results):
+    print("INFO: Bit-serial Micro-program Performance Results")
     device = ''
     data_type = ''
-    op = ''
-    numR = 0
-    numW = 0
-    numL = 0
-    for line in f:
-        line = line.strip()
-
-        match1 = re.match(r'\[(.*):(.*):(.*):(.*)\] Start', line)
-        if match1:
-            prev_device = device
-            device = match1.group(1)
-            if device != prev_device:
-                if prev_device:
-                    print("  }},")
-                print("  { PIM_DEVICE_%s, {" % (device.upper()))
-            prev_data_type = data_type
-            data_type = match1.group(2)
-            if data_type != prev_data_type:
-                if prev_data_type:
-                    print("    }},")
-                print("    { PIM_%s, {" % (data_type.upper()))
-            op = match1.group(3)
-            numR = 0
-            numW = 0
-            numL = 0
-
-        match2 = re.match(r'Num Read, Write, Logic : (\S+), (\S+), (\S+)', line)
-        if match2:
-            numR = int(match2.group(1))
-            numW = int(match2.group(2))
-            numL = int(match2.group(3))
-
-        match3 = re.match(r'\[(.*):(.*):(.*):(.*)\] End', line)
-        if match3:
-            print("      { PimCmdEnum::%-13s { %4d, %4d, %4d } }," % (op.upper() + ',', numR, numW, numL))
-
+    for (cur_device, cur_data_type, op, numR, numW, numL, _) in results:
+        if cur_device != device:
+            if device:
+                print("    }},")
+                print("  }},")
+            print("  { PIM_DEVICE_%s, {" % (cur_device.upper()))
+            data_type = ''
+        if cur_data_type != data_type:
+            if data_type:
+                print("    }},")
+            print("    { PIM_%s, {" % (cur_data_type.upper()))
+        device = cur_device
+        data_type = cur_data_type
+        print("      { PimCmdEnum::%-13s { %4d, %4d, %4d } }," % (op.upper() + ',', numR, numW, numL))
     print("    }")
     print("  }")
 
 
+def sync_table(results, table_file, update):
+    """ Compare or update active table entries with results of succeeded micro-programs.
+        Hand-maintained entries without a succeeded micro-program are kept as is. """
+    measured = {}
+    for (device, data_type, op, numR, numW, numL, succeeded) in results:
+        if succeeded:
+            measured[('PIM_DEVICE_' + device.upper(), 'PIM_' + data_type.upper(), op.upper())] = (numR, numW, numL)
+
+    re_device = re.compile(r'^\s*\{ (PIM_DEVICE_\w+), \{')
+    re_data_type = re.compile(r'^\s*\{ (PIM_\w+), \{')
+    re_entry = re.compile(r'^(\s*\{ PimCmdEnum::(\w+),\s*\{)\s*(\d+),\s*(\d+),\s*(\d+) (\} \},.*)$')
+
+    with open(table_file, 'r') as f:
+        lines = f.read().split('\n')
+
+    device = ''
+    data_type = ''
+    table_devices = set()
+    num_checked = 0
+    num_drifts = 0
+    matched = set()
+    for i, line in enumerate(lines):
+        match = re_device.match(line)
+        if match:
+            device = match.group(1)
+            table_devices.add(device)
+            continue
+        match = re_data_type.match(line)
+        if match:
+            data_type = match.group(1)
+            continue
+        match = re_entry.match(line)
+        if not match:
+            continue
+        key = (device, data_type, match.group(2))
+        if key not in measured:
+            continue
+        matched.add(key)
+        num_checked += 1
+        table_val = (int(match.group(3)), int(match.group(4)), int(match.group(5)))
+        if table_val != measured[key]:
+            num_drifts += 1
+            print("%s: %s %s %s: table %s vs micro-program %s" % ("UPDATE" if update else "DRIFT",
+                  device, data_type, key[2], table_val, measured[key]))
+            lines[i] = "%s %4d, %4d, %4d %s" % (match.group(1), measured[key][0], measured[key][1], measured[key][2], match.group(6))
+
+    for key in sorted(set(measured.keys()) - matched):
+        if key[0] in table_devices:
+            print("INFO: %s %s %s is measured but not in the table" % key)
+
+    print("INFO: Checked %d table entries against succeeded micro-programs, %d drifted" % (num_checked, num_drifts))
+    if update:
+        if num_drifts > 0:
+            with open(table_file, 'w') as f:
+                f.write('\n'.join(lines))
+            print("INFO: Regenerated %s" % table_file)
+        return 0
+    return 1 if num_drifts > 0 else 0
+
+
+if __name__ == '__main__':
+    if len(sys.argv) == 2:
+        print_tables(parse_results(sys.argv[1]))
+    elif len(sys.argv) == 4 and sys.argv[2] in ('--check', '--update'):
+        exit(sync_table(parse_results(sys.argv[1]), sys.argv[3], sys.argv[2] == '--update'))
+    else:
+        usage()
@@ -6,6 +6,7 @@
 
 #include "libpimeval.h"
 #include "pimSim.h"
+#include "pimTrace.h"
 #include "pimUtils.h"
 
 //! @brief  Create a PIM device
@@ -40,6 +41,36 @@ pimDeleteDevice()
   return ok ? PIM_OK : PIM_ERROR;
 }
 
+//! @brief  Select the PIM device used by following PIM APIs
+PimStatus
+pimSetDevice(PimDeviceId device)
+{
+  bool ok = pimSim::get()->setDevice(device);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Get the PIM device used by following PIM APIs
+PimDeviceId
+pimGetDevice()
+{
+  return pimSim::get()->getCurDeviceId();
+}
+
+//! @brief  Get number of created PIM devices
+unsigned
+pimGetNumDevices()
+{
+  return pimSim::get()->getNumDevices();
+}
+
+//! @brief  Copy data between PIM objects of two PIM devices
+PimStatus
+pimCopyInterDevice(PimDeviceId srcDevice, PimObjId src, PimDeviceId destDevice, PimObjId dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  bool ok = pimSim::get()->pimCopyInterDevice(srcDevice, src, destDevice, dest, idxBegin, idxEnd);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 PimStatus
 pimPrefixSum(PimObjId src, PimObjId dest)
 {
@@ -82,6 +113,18 @@ pimIsAnalysisMode()
   return pimSim::get()->isAnalysisMode();
 }
 
+//! @brief  Replay a binary PIM API trace
+PimStatus
+pimReplayTrace(const char* traceFilePath, PimDeviceEnum deviceType, const char* configFilePath)
+{
+  if (!traceFilePath) {
+    return PIM_ERROR;
+  }
+  pimTraceReader reader(traceFilePath, deviceType, configFilePath ? configFilePath : "");
+  bool ok = reader.replay();
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 //! @brief  Allocate a PIM resource
 PimObjId
 pimAlloc(PimAllocEnum allocType, uint64_t numElements, PimDataType dataType)
@@ -178,6 +221,82 @@ PimStatus pimConvertType(PimObjId src, PimObjId dest)
   return ok ? PIM_OK : PIM_ERROR;
 }
 
+//! @brief  Copy data from main memory to PIM device asynchronously
+PimCopyHandle
+pimCopyHostToDeviceAsync(void* src, PimObjId dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  return pimSim::get()->pimCopyMainToDeviceAsync(src, dest, idxBegin, idxEnd);
+}
+
+//! @brief  Copy data from PIM device to main memory asynchronously
+PimCopyHandle
+pimCopyDeviceToHostAsync(PimObjId src, void* dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  return pimSim::get()->pimCopyDeviceToMainAsync(src, dest, idxBegin, idxEnd);
+}
+
+//! @brief  Wait for an async data copy to finish
+PimStatus
+pimWait(PimCopyHandle handle)
+{
+  bool ok = pimSim::get()->pimWait(handle);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Create a PIM stream
+PimStreamId
+pimStreamCreate()
+{
+  return pimSim::get()->pimStreamCreate();
+}
+
+//! @brief  Destroy a PIM stream after its commands finish
+PimStatus
+pimStreamDestroy(PimStreamId stream)
+{
+  bool ok = pimSim::get()->pimStreamDestroy(stream);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Set the PIM stream for subsequent PIM APIs
+PimStatus
+pimSetStream(PimStreamId stream)
+{
+  bool ok = pimSim::get()->pimSetStream(stream);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Wait for all commands of a PIM stream to finish
+PimStatus
+pimStreamSynchronize(PimStreamId stream)
+{
+  bool ok = pimSim::get()->pimStreamSynchronize(stream);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Record an event on a PIM stream
+PimEventId
+pimEventRecord(PimStreamId stream)
+{
+  return pimSim::get()->pimEventRecord(stream);
+}
+
+//! @brief  Make subsequent commands of a PIM stream wait for an event
+PimStatus
+pimStreamWaitEvent(PimStreamId stream, PimEventId event)
+{
+  bool ok = pimSim::get()->pimStreamWaitEvent(stream, event);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  Wait for an event on the host
+PimStatus
+pimEventSynchronize(PimEventId event)
+{
+  bool ok = pimSim::get()->pimEventSynchronize(event);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 //! @brief  Load vector with a signed int value
 PimStatus
 pimBroadcastInt(PimObjId dest, int64_t value)
@@ -428,6 +547,54 @@ pimPopCount(PimObjId src, PimObjId dest)
   return ok ? PIM_OK : PIM_ERROR;
 }
 
+//! @brief  PIM elementwise exponential approximation
+PimStatus
+pimExp(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  bool ok = pimSim::get()->pimExp(src, dest, precision, numFracBits);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM elementwise natural logarithm approximation
+PimStatus
+pimLog(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  bool ok = pimSim::get()->pimLog(src, dest, precision, numFracBits);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM elementwise square root approximation
+PimStatus
+pimSqrt(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  bool ok = pimSim::get()->pimSqrt(src, dest, precision, numFracBits);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM elementwise reciprocal approximation
+PimStatus
+pimRecip(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  bool ok = pimSim::get()->pimRecip(src, dest, precision, numFracBits);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM elementwise sigmoid approximation
+PimStatus
+pimSigmoid(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  bool ok = pimSim::get()->pimSigmoid(src, dest, precision, numFracBits);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM elementwise hyperbolic tangent approximation
+PimStatus
+pimTanh(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  bool ok = pimSim::get()->pimTanh(src, dest, precision, numFracBits);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 //! @brief  Extract a bit slice from a data vector. Dest must be BOOL type
 PimStatus
 pimBitSliceExtract(PimObjId src, PimObjId destBool, unsigned bitIdx)
@@ -511,6 +678,70 @@ PimStatus pimMAC(PimObjId src1, PimObjId src2, void *dest)
   return ok ? PIM_OK : PIM_ERROR;
 }
 
+//! @brief  PIM matrix-vector multiplication: dest = mat x vec, with a column-major PIM matrix and a host vector
+PimStatus
+pimGemv(PimObjId mat, const void* vec, PimObjId dest)
+{
+  bool ok = pimSim::get()->pimGemv(mat, vec, dest);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM matrix-matrix multiplication: dest = mat x matB, with a column-major PIM matrix and a column-major host matrix
+PimStatus
+pimGemm(PimObjId mat, const void* matB, PimObjId dest, uint64_t numColsB)
+{
+  bool ok = pimSim::get()->pimGemm(mat, matB, dest, numColsB);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM batched AND-popcount of pairs of bitmap rows. Counts returned to a host array
+PimStatus
+pimAndPopCountBatched(PimObjId bitmaps, uint64_t numWordsPerRow, const uint64_t* rowsA, const uint64_t* rowsB, uint64_t numPairs, uint64_t* counts)
+{
+  bool ok = pimSim::get()->pimAndPopCountBatched(bitmaps, numWordsPerRow, rowsA, rowsB, numPairs, counts);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM gather: dest[i] = src[index[i]]
+PimStatus
+pimGather(PimObjId src, PimObjId index, PimObjId dest)
+{
+  bool ok = pimSim::get()->pimGather(src, index, dest);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM scatter: dest[index[i]] = src[i]
+PimStatus
+pimScatter(PimObjId src, PimObjId index, PimObjId dest)
+{
+  bool ok = pimSim::get()->pimScatter(src, index, dest);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM scatter-add: dest[index[i]] += src[i]
+PimStatus
+pimScatterAdd(PimObjId src, PimObjId index, PimObjId dest)
+{
+  bool ok = pimSim::get()->pimScatterAdd(src, index, dest);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM stream compaction of elements selected by a bool condition. Count returned to a host variable
+PimStatus
+pimCompact(PimObjId src, PimObjId cond, PimObjId dest, uint64_t* count)
+{
+  bool ok = pimSim::get()->pimCompact(src, cond, dest, count);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM top-k selection of largest or smallest elements. Values and indices returned to host arrays
+PimStatus
+pimTopK(PimObjId src, uint64_t k, void* outValues, uint64_t* outIndices, bool isSmallest)
+{
+  bool ok = pimSim::get()->pimTopK(src, k, outValues, outIndices, isSmallest);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 //! @brief  PIM reduction sum for signed int. Result returned to a host variable
 PimStatus
 pimRedSum(PimObjId src, void* sum, uint64_t idxBegin, uint64_t idxEnd)
@@ -519,6 +750,62 @@ pimRedSum(PimObjId src, void* sum, uint64_t idxBegin, uint64_t idxEnd)
   return ok ? PIM_OK : PIM_ERROR;
 }
 
+//! @brief  PIM segmented reduction sum with a fixed segment length. One result per segment returned to a host array
+PimStatus
+pimRedSumSegmented(PimObjId src, void* results, uint64_t segmentLen)
+{
+  bool ok = pimSim::get()->pimRedSumSegmented(src, results, segmentLen);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM segmented min reduction with a fixed segment length. One result per segment returned to a host array
+PimStatus
+pimRedMinSegmented(PimObjId src, void* results, uint64_t segmentLen)
+{
+  bool ok = pimSim::get()->pimRedMinSegmented(src, results, segmentLen);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM segmented max reduction with a fixed segment length. One result per segment returned to a host array
+PimStatus
+pimRedMaxSegmented(PimObjId src, void* results, uint64_t segmentLen)
+{
+  bool ok = pimSim::get()->pimRedMaxSegmented(src, results, segmentLen);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM segmented reduction sum with segment offsets. One result per segment returned to a host array
+PimStatus
+pimRedSumSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments)
+{
+  bool ok = pimSim::get()->pimRedSumSegmentedByOffsets(src, results, offsets, numSegments);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM segmented min reduction with segment offsets. One result per segment returned to a host array
+PimStatus
+pimRedMinSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments)
+{
+  bool ok = pimSim::get()->pimRedMinSegmentedByOffsets(src, results, offsets, numSegments);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM segmented max reduction with segment offsets. One result per segment returned to a host array
+PimStatus
+pimRedMaxSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments)
+{
+  bool ok = pimSim::get()->pimRedMaxSegmentedByOffsets(src, results, offsets, numSegments);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
+//! @brief  PIM batched reductions of associated objects. Results returned to host variables
+PimStatus
+pimRedBatched(const PimObjId* srcs, const PimReductionEnum* ops, void** results, unsigned numObjs, uint64_t idxBegin, uint64_t idxEnd)
+{
+  bool ok = pimSim::get()->pimRedBatched(srcs, ops, results, numObjs, idxBegin, idxEnd);
+  return ok ? PIM_OK : PIM_ERROR;
+}
+
 //! @brief  Rotate all elements of an obj by one step to the right
 PimStatus
 pimRotateElementsRight(PimObjId src)
@@ -74,6 +74,19 @@ enum PimCopyEnum {
   PIM_COPY_H,
 };
 
+//! @brief  PIM reduction types of batched reductions
+enum PimReductionEnum {
+  PIM_RED_SUM = 0,
+  PIM_RED_MIN,
+  PIM_RED_MAX,
+};
+
+//! @brief  PIM precision of elementwise math approximations
+enum PimMathPrecision {
+  PIM_MATH_PRECISE = 0,  // accurate to a few FP32 ulps
+  PIM_MATH_FAST,         // fewer polynomial terms and iterations, with relative error within 3e-3
+};
+
 //! @brief  PIM datatypes
 enum PimDataType {
   PIM_BOOL = 0,
@@ -89,6 +102,11 @@ enum PimDataType {
   PIM_FP16,
   PIM_BF16,
   PIM_FP8,
+  // sub-byte integers: host data uses one int8_t/uint8_t per element
+  PIM_INT4,
+  PIM_UINT4,
+  PIM_INT2,
+  PIM_UINT2,
 };
 
 //! @brief  PIM device properties
@@ -106,6 +124,10 @@ struct PimDeviceProperties {
 
 typedef int PimCoreId;
 typedef int PimObjId;
+typedef int PimCopyHandle;
+typedef int PimStreamId;
+typedef int PimEventId;
+typedef int PimDeviceId;
 
 // PIMeval simulation
 // CPU runtime between start/end timer will be measured for modeling DRAM refresh
@@ -114,6 +136,9 @@ void pimEndTimer();
 void pimShowStats();
 void pimResetStats();
 bool pimIsAnalysisMode();
+// Replay a binary PIM API trace recorded with PIMEVAL_TRACE_FILE
+// Optionally redirect device creation to another device type or simulator config file
+PimStatus pimReplayTrace(const char* traceFilePath, PimDeviceEnum deviceType = PIM_DEVICE_NONE, const char* configFilePath = nullptr);
 
 // Device creation and deletion
 /**
@@ -132,6 +157,15 @@ PimStatus pimCreateDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned
 PimStatus pimCreateDeviceFromConfig(PimDeviceEnum deviceType, const char* configFileName);
 PimStatus pimGetDeviceProperties(PimDeviceProperties* deviceProperties);
 PimStatus pimDeleteDevice();
+// Multiple devices
+// Each device ID is a slot holding one PIM device with its own PIM objects and stats, and device 0 is used by default.
+// pimSetDevice selects the slot used by all following PIM APIs, including device creation and deletion.
+// pimCopyInterDevice is modeled as a transfer through an inter-device link, and recorded in stats of the current device.
+// A ranged copy writes elements [idxBegin, idxEnd) of src to the same range of dest, which may differ in size.
+PimStatus pimSetDevice(PimDeviceId device);
+PimDeviceId pimGetDevice();
+unsigned pimGetNumDevices();
+PimStatus pimCopyInterDevice(PimDeviceId srcDevice, PimObjId src, PimDeviceId destDevice, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
 
 // Resource allocation and deletion
 PimObjId pimAlloc(PimAllocEnum allocType, uint64_t numElements, PimDataType dataType);
@@ -153,6 +187,30 @@ PimStatus pimCopyDeviceToHost(PimObjId src, void* dest, uint64_t idxBegin = 0, u
 PimStatus pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
 PimStatus pimCopyObjectToObject(PimObjId src, PimObjId dest);
 PimStatus pimConvertType(PimObjId src, PimObjId dest);
+// Asynchronous data transfer
+// Returns a handle for pimWait, or -1 on failure. The copy runs in the background and its modeled transfer time
+// overlaps with PIM commands issued before pimWait. The host buffer must not be accessed until pimWait returns.
+// PIM commands using the PIM object wait for the copy, while others overlap with it. Only results of the 1024 most
+// recent copies that finished without pimWait are kept for it.
+PimCopyHandle pimCopyHostToDeviceAsync(void* src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+PimCopyHandle pimCopyDeviceToHostAsync(PimObjId src, void* dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+PimStatus pimWait(PimCopyHandle handle);
+
+// Streams and events
+// PIM APIs are submitted to the current stream, which is the default stream 0 unless changed with pimSetStream.
+// Commands of a non-default stream run in order on a host thread of that stream and return before they finish.
+// Commands of different streams overlap in modeled time if their PIM objects occupy disjoint PIM cores.
+// The default stream synchronizes with all streams, as do data copy, allocation and deallocation.
+// Results of reductions and MAC on a non-default stream are ready after pimStreamSynchronize. This includes the host
+// outputs of top-k, AND-popcount and segmented reductions, which must stay valid until then. Host inputs of GEMV
+// and GEMM are read when the command is submitted.
+PimStreamId pimStreamCreate();
+PimStatus pimStreamDestroy(PimStreamId stream);
+PimStatus pimSetStream(PimStreamId stream);
+PimStatus pimStreamSynchronize(PimStreamId stream);
+PimEventId pimEventRecord(PimStreamId stream);
+PimStatus pimStreamWaitEvent(PimStreamId stream, PimEventId event);
+PimStatus pimEventSynchronize(PimEventId event);
 
 // Logic and Arithmetic Operation
 // Mixed data type extensions:
@@ -194,6 +252,19 @@ PimStatus pimNEScalar(PimObjId src, PimObjId destBool, uint64_t scalarValue);
 PimStatus pimScaledAdd(PimObjId src1, PimObjId src2, PimObjId dest, uint64_t scalarValue);
 PimStatus pimPopCount(PimObjId src, PimObjId dest);
 
+// Elementwise math approximations with polynomials and Newton iterations, built from PIM multiplies and adds
+// - FP types are computed as FP32. Out-of-domain inputs follow std::exp/log/sqrt, e.g., log of negative is NaN
+// - Integer types are fixed-point numbers with numFracBits fractional bits. Results are rounded to nearest and
+//   saturated to the range of the data type, and NaN results become 0
+// - Fixed-point values are evaluated through FP32, so results keep about 24 significant bits. INT32/UINT32 and
+//   64-bit results with more significant bits lose their low bits
+PimStatus pimExp(PimObjId src, PimObjId dest, PimMathPrecision precision = PIM_MATH_PRECISE, unsigned numFracBits = 0);
+PimStatus pimLog(PimObjId src, PimObjId dest, PimMathPrecision precision = PIM_MATH_PRECISE, unsigned numFracBits = 0);
+PimStatus pimSqrt(PimObjId src, PimObjId dest, PimMathPrecision precision = PIM_MATH_PRECISE, unsigned numFracBits = 0);
+PimStatus pimRecip(PimObjId src, PimObjId dest, PimMathPrecision precision = PIM_MATH_PRECISE, unsigned numFracBits = 0);
+PimStatus pimSigmoid(PimObjId src, PimObjId dest, PimMathPrecision precision = PIM_MATH_PRECISE, unsigned numFracBits = 0);
+PimStatus pimTanh(PimObjId src, PimObjId dest, PimMathPrecision precision = PIM_MATH_PRECISE, unsigned numFracBits = 0);
+
 // Only supported by bit-parallel PIM
 PimStatus pimPrefixSum(PimObjId src, PimObjId dest);
 
@@ -204,11 +275,60 @@ PimStatus pimPrefixSum(PimObjId src, PimObjId dest);
 // Note: User needs to ensure that dest vector is of size equal to the total number of PIM cores in the device, and contains `0` or any value that the user wants it to have as initial values.
 PimStatus pimMAC(PimObjId src1, PimObjId src2, void* dest);
 
+// Matrix multiplication with a host operand in one command. Matrices are stored column-major, i.e., element (i, j)
+// of an M x K matrix is at index j * M + i, and a PIM matrix object holds M x K elements of a single data type.
+// pimGemv: dest[i] = sum_j mat[j * M + i] * vec[j], where dest holds M elements and vec holds K host elements
+// pimGemm: dest = mat x matB, where matB is a K x numColsB host matrix and dest holds M x numColsB elements
+// Note: dest must have the same data type as mat; host operands use the host representation of that data type
+PimStatus pimGemv(PimObjId mat, const void* vec, PimObjId dest);
+PimStatus pimGemm(PimObjId mat, const void* matB, PimObjId dest, uint64_t numColsB);
+
+// Batched intersection counts of bitmap rows, e.g., for graph neighbor set intersection
+// counts[i] = popcount(row rowsA[i] AND row rowsB[i]) for numPairs pairs, where row r of an integer PIM object
+// covers elements [r * numWordsPerRow, (r + 1) * numWordsPerRow)
+// Note: counts are overwritten rather than accumulated into
+PimStatus pimAndPopCountBatched(PimObjId bitmaps, uint64_t numWordsPerRow, const uint64_t* rowsA, const uint64_t* rowsB, uint64_t numPairs, uint64_t* counts);
+
+// Indexed element access through an integer index object. src and dest have the same data type.
+// Gather: dest[i] = src[index[i]], where index is associated with dest
+// Scatter: dest[index[i]] = src[i], where index is associated with src. With repeated indices, the largest i wins
+// Scatter-add: dest[index[i]] += src[i], where index is associated with src
+// Note: Out-of-range or negative indices are errors. dest elements not indexed by scatter are unchanged
+PimStatus pimGather(PimObjId src, PimObjId index, PimObjId dest);
+PimStatus pimScatter(PimObjId src, PimObjId index, PimObjId dest);
+PimStatus pimScatterAdd(PimObjId src, PimObjId index, PimObjId dest);
+
+// Stream compaction: pack src elements whose bool condition is true densely into dest in element order,
+// and return the number of selected elements. cond is associated with src, and dest has the same data type
+// Note: dest elements beyond the count are unchanged. Copy back [0, count) of dest to read selected elements
+// Note: In analysis mode, count is the modeled number of selected elements, i.e., all src elements that fit in dest
+PimStatus pimCompact(PimObjId src, PimObjId cond, PimObjId dest, uint64_t* count);
+
+// Top-k selection: return the k largest (or smallest) src elements and their indices, ordered from the best.
+// Ties are broken by lower element index. Either output can be nullptr if not needed
+// Note: outValues holds k elements of the host type of src, e.g., one byte per INT4 element, and FP32 for FP16
+PimStatus pimTopK(PimObjId src, uint64_t k, void* outValues, uint64_t* outIndices, bool isSmallest = false);
+
 // Note: Reduction sum range is [idxBegin, idxEnd)
 PimStatus pimRedSum(PimObjId src, void* sum, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
 // Min/Max Reduction APIs
 PimStatus pimRedMin(PimObjId src, void* min, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
 PimStatus pimRedMax(PimObjId src, void* max, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+// Segmented reductions: reduce many segments of one object in a single pass, with one result per segment
+// pimRed*Segmented:          segment i covers [i * segmentLen, min((i + 1) * segmentLen, numElements))
+// pimRed*SegmentedByOffsets: segment i covers [offsets[i], offsets[i + 1]), with numSegments + 1 non-decreasing offsets
+// Note: results must hold one value per segment, of the same type as the result of pimRedSum/pimRedMin/pimRedMax
+// Note: unlike pimRedSum, results are overwritten rather than accumulated into
+PimStatus pimRedSumSegmented(PimObjId src, void* results, uint64_t segmentLen);
+PimStatus pimRedMinSegmented(PimObjId src, void* results, uint64_t segmentLen);
+PimStatus pimRedMaxSegmented(PimObjId src, void* results, uint64_t segmentLen);
+PimStatus pimRedSumSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments);
+PimStatus pimRedMinSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments);
+PimStatus pimRedMaxSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments);
+// Batched reductions: reduce a number of associated objects in one walk over their shared regions
+// Note: ops[i] is applied to srcs[i], and results[i] has the same type and semantics as the result of pimRedSum/pimRedMin/pimRedMax
+// Note: Reduction range [idxBegin, idxEnd) applies to all objects
+PimStatus pimRedBatched(const PimObjId* srcs, const PimReductionEnum* ops, void** results, unsigned numObjs, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
 
 // Bit slice operations
 PimStatus pimBitSliceExtract(PimObjId src, PimObjId destBool, unsigned bitIdx);
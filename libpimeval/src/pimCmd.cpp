@@ -13,9 +13,12 @@
 #include "libpimeval.h"      // for PimObjId
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <climits>
+#include <cfloat>            // for FLT_MIN
+#include <cstring>           // for memcpy
 #include <cinttypes>         // for PRIu64, PRIx64
 
 //! @brief  Get PIM command name from command type enum
@@ -79,7 +82,25 @@ pimCmd::getName(PimCmdEnum cmdType, const std::string& suffix)
     { PimCmdEnum::REDMIN_RANGE, "redmin_range" },
     { PimCmdEnum::REDMAX, "redmax" },
     { PimCmdEnum::REDMAX_RANGE, "redmax_range" },
+    { PimCmdEnum::REDSUM_SEGMENTED, "redsum_segmented" },
+    { PimCmdEnum::REDMIN_SEGMENTED, "redmin_segmented" },
+    { PimCmdEnum::REDMAX_SEGMENTED, "redmax_segmented" },
+    { PimCmdEnum::RED_BATCHED, "red_batched" },
     { PimCmdEnum::MAC, "mac" },
+    { PimCmdEnum::GEMV, "gemv" },
+    { PimCmdEnum::GEMM, "gemm" },
+    { PimCmdEnum::AND_POPCOUNT_BATCHED, "and_popcount_batched" },
+    { PimCmdEnum::GATHER, "gather" },
+    { PimCmdEnum::SCATTER, "scatter" },
+    { PimCmdEnum::SCATTER_ADD, "scatter_add" },
+    { PimCmdEnum::COMPACT, "compact" },
+    { PimCmdEnum::TOPK, "topk" },
+    { PimCmdEnum::EXP, "exp" },
+    { PimCmdEnum::LOG, "log" },
+    { PimCmdEnum::SQRT, "sqrt" },
+    { PimCmdEnum::RECIP, "recip" },
+    { PimCmdEnum::SIGMOID, "sigmoid" },
+    { PimCmdEnum::TANH, "tanh" },
     { PimCmdEnum::ROTATE_ELEM_R, "rotate_elem_r" },
     { PimCmdEnum::ROTATE_ELEM_L, "rotate_elem_l" },
     { PimCmdEnum::SHIFT_ELEM_R, "shift_elem_r" },
@@ -166,6 +187,82 @@ pimCmd::isConvertibleType(const pimObjInfo& src, const pimObjInfo& dest) const
   return true;
 }
 
+//! @brief  Update stats of this command after execution, unless it has been modeled at submission
+bool
+pimCmd::recordStats() const
+{
+  return m_skipStats || updateStats(m_device, pimSim::get()->getStatsMgr());
+}
+
+//! @brief  Record a micro-op that skips simulated memory access in analysis mode
+bool
+pimCmd::recordAnalysisModeStats(const std::string& cmdName) const
+{
+  pimeval::perfEnergy prfEnrgy;
+  pimSim::get()->getStatsMgr()->recordCmd(cmdName, prfEnrgy);
+  return true;
+}
+
+//! @brief  Ratio of bit-serial steps needed by actual data values, for data-aware perf modeling
+//! - MUL_SCALAR: skip partial products of zero scalar bits
+//! - MUL: skip partial products of multiplier bits that are zero in all elements
+//! - POPCOUNT: skip bit positions that are zero in all elements
+//! - Comparisons: process bits from MSB and exit early once all elements differ
+//! Returns a negative value if the command is not data-dependent
+double
+pimCmd::getDataAwareRatio(const pimObjInfo& objSrc1, const pimObjInfo* objSrc2, uint64_t scalarValue) const
+{
+  PimDataType dataType = objSrc1.getDataType();
+  if (!pimUtils::isSigned(dataType) && !pimUtils::isUnsigned(dataType)) {
+    return -1.0;
+  }
+  unsigned bitsPerElement = objSrc1.getBitsPerElement(PimBitWidth::ACTUAL);
+  if (bitsPerElement == 0 || bitsPerElement > 64) {
+    return -1.0;
+  }
+  uint64_t mask = (bitsPerElement == 64) ? ~0ULL : ((1ULL << bitsPerElement) - 1);
+  uint64_t numElements = objSrc1.getNumElements();
+  unsigned numSteps = 0;
+
+  switch (m_cmdType) {
+  case PimCmdEnum::MUL_SCALAR:
+    numSteps = __builtin_popcountll(scalarValue & mask);
+    break;
+  case PimCmdEnum::MUL:
+  case PimCmdEnum::POPCOUNT:
+  {
+    const pimObjInfo& obj = (m_cmdType == PimCmdEnum::MUL && objSrc2) ? *objSrc2 : objSrc1;
+    uint64_t bitsInUse = 0;
+    for (uint64_t i = 0; i < numElements && (bitsInUse & mask) != mask; ++i) {
+      bitsInUse |= obj.getElementBits(i);
+    }
+    numSteps = __builtin_popcountll(bitsInUse & mask);
+    break;
+  }
+  case PimCmdEnum::GT:
+  case PimCmdEnum::LT:
+  case PimCmdEnum::EQ:
+  case PimCmdEnum::NE:
+  case PimCmdEnum::GT_SCALAR:
+  case PimCmdEnum::LT_SCALAR:
+  case PimCmdEnum::EQ_SCALAR:
+  case PimCmdEnum::NE_SCALAR:
+  {
+    bool isScalar = (objSrc2 == nullptr);
+    for (uint64_t i = 0; i < numElements && numSteps < bitsPerElement; ++i) {
+      uint64_t diff = (objSrc1.getElementBits(i) ^ (isScalar ? scalarValue : objSrc2->getElementBits(i))) & mask;
+      // bits from MSB down to the first differing bit, or all bits for equal values
+      unsigned steps = diff ? bitsPerElement - (63 - __builtin_clzll(diff)) : bitsPerElement;
+      numSteps = std::max(numSteps, steps);
+    }
+    break;
+  }
+  default:
+    return -1.0;
+  }
+  return static_cast<double>(std::max(numSteps, 1u)) / bitsPerElement;
+}
+
 //! @brief  Process all regions in MT used by derived classes
 bool
 pimCmd::computeAllRegions(unsigned numRegions)
@@ -200,25 +297,45 @@ pimCmdCopy::execute()
     return false;
   }
 
+  pimObjInfo* objSrc = nullptr;
+  pimObjInfo* objDest = nullptr;
+  getObjInfo(objSrc, objDest);
+  if (!copyData(objSrc, objDest)) {
+    return false;
+  }
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM Data Copy - get source and destination PIM objects, or nullptr for host side
+void
+pimCmdCopy::getObjInfo(pimObjInfo*& objSrc, pimObjInfo*& objDest) const
+{
+  pimResMgr* resMgr = m_device->getResMgr();
+  objSrc = (m_cmdType == PimCmdEnum::COPY_D2H || m_cmdType == PimCmdEnum::COPY_D2D) ? &resMgr->getObjInfo(m_src) : nullptr;
+  objDest = (m_cmdType == PimCmdEnum::COPY_H2D || m_cmdType == PimCmdEnum::COPY_D2D) ? &resMgr->getObjInfo(m_dest) : nullptr;
+}
+
+//! @brief  PIM Data Copy - functional data movement
+//! This does not look up any PIM objects, so that async copies can run it on a background thread
+bool
+pimCmdCopy::copyData(pimObjInfo* objSrc, pimObjInfo* objDest) const
+{
   // for non-functional simulation, sync src data from simulated memory
   if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
     if (m_cmdType == PimCmdEnum::COPY_D2H || m_cmdType == PimCmdEnum::COPY_D2D) {
-      pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
-      objSrc.syncFromSimulatedMem();
+      objSrc->syncFromSimulatedMem();
     }
   }
 
   if (!pimSim::get()->isAnalysisMode()) {
     if (m_cmdType == PimCmdEnum::COPY_H2D) {
-      pimObjInfo &objDest = m_device->getResMgr()->getObjInfo(m_dest);
-      objDest.copyFromHost(m_ptr, m_idxBegin, m_idxEnd);
+      objDest->copyFromHost(m_ptr, m_idxBegin, m_idxEnd);
     } else if (m_cmdType == PimCmdEnum::COPY_D2H) {
-      const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
-      objSrc.copyToHost(m_ptr, m_idxBegin, m_idxEnd);
+      objSrc->copyToHost(m_ptr, m_idxBegin, m_idxEnd);
     } else if (m_cmdType == PimCmdEnum::COPY_D2D) {
-      const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
-      pimObjInfo &objDest = m_device->getResMgr()->getObjInfo(m_dest);
-      objSrc.copyToObj(objDest, m_idxBegin, m_idxEnd);
+      objSrc->copyToObj(*objDest, m_idxBegin, m_idxEnd);
     } else {
       assert(0);
     }
@@ -227,12 +344,9 @@ pimCmdCopy::execute()
   // for non-functional simulation, sync dest data to simulated memory
   if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
     if (m_cmdType == PimCmdEnum::COPY_H2D || m_cmdType == PimCmdEnum::COPY_D2D) {
-      const pimObjInfo &objDest = m_device->getResMgr()->getObjInfo(m_dest);
-      objDest.syncToSimulatedMem();
+      objDest->syncToSimulatedMem();
     }
   }
-
-  updateStats();
   return true;
 }
 
@@ -313,45 +427,48 @@ pimCmdCopy::sanityCheck() const
 
 //! @brief  PIM Data Copy - update stats
 bool
-pimCmdCopy::updateStats() const
+pimCmdCopy::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
    if (m_cmdType == PimCmdEnum::COPY_H2D) {
-    const pimObjInfo &objDest = m_device->getResMgr()->getObjInfo(m_dest);
+    const pimObjInfo &objDest = device->getResMgr()->getObjInfo(m_dest);
     uint64_t numElements = objDest.getNumElements();
     if (!m_copyFullRange) {
       numElements = m_idxEnd - m_idxBegin;
     }
     unsigned bitsPerElement = objDest.getBitsPerElement(PimBitWidth::ACTUAL);
-    pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
-    pimSim::get()->getStatsMgr()->recordCopyMainToDevice(numElements * bitsPerElement, mPerfEnergy);
+    pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
+    statsMgr->recordCopyMainToDevice(numElements * bitsPerElement, mPerfEnergy, m_asyncHandle, &objDest);
 
     if (m_debugCmds) {
-      std::printf("PIM-Cmd: Copied %" PRIu64 " elements of %u bits from host to PIM obj %d\n",
-                  numElements, bitsPerElement, m_dest);
+      std::printf("PIM-Cmd: Copied %" PRIu64 " elements of %u bits from host to PIM obj %d%s\n",
+                  numElements, bitsPerElement, m_dest, m_asyncHandle != -1 ? " (async)" : "");
     }
   } else if (m_cmdType == PimCmdEnum::COPY_D2H) {
-    const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
+    const pimObjInfo &objSrc = device->getResMgr()->getObjInfo(m_src);
     uint64_t numElements = objSrc.getNumElements();
     if (!m_copyFullRange) {
       numElements = m_idxEnd - m_idxBegin;
     }
     unsigned bitsPerElement = objSrc.getBitsPerElement(PimBitWidth::ACTUAL);
-    pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
-    pimSim::get()->getStatsMgr()->recordCopyDeviceToMain(numElements * bitsPerElement, mPerfEnergy);
+    pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
+    statsMgr->recordCopyDeviceToMain(numElements * bitsPerElement, mPerfEnergy, m_asyncHandle, &objSrc);
 
     if (m_debugCmds) {
-      std::printf("PIM-Cmd: Copied %" PRIu64 " elements of %u bits from PIM obj %d to host\n",
-                  numElements, bitsPerElement, m_src);
+      std::printf("PIM-Cmd: Copied %" PRIu64 " elements of %u bits from PIM obj %d to host%s\n",
+                  numElements, bitsPerElement, m_src, m_asyncHandle != -1 ? " (async)" : "");
     }
   } else if (m_cmdType == PimCmdEnum::COPY_D2D) {
-    const pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
+    const pimObjInfo &objSrc = device->getResMgr()->getObjInfo(m_src);
     uint64_t numElements = objSrc.getNumElements();
     if (!m_copyFullRange) {
       numElements = m_idxEnd - m_idxBegin;
     }
     unsigned bitsPerElement = objSrc.getBitsPerElement(PimBitWidth::ACTUAL);
-    pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(m_cmdType, numElements * bitsPerElement / 8);
-    pimSim::get()->getStatsMgr()->recordCopyDeviceToDevice(numElements * bitsPerElement, mPerfEnergy);
+    const pimObjInfo &objDest = device->getResMgr()->getObjInfo(m_dest);
+    uint64_t idxBegin = m_copyFullRange ? 0 : m_idxBegin;
+    uint64_t idxEnd = m_copyFullRange ? objSrc.getNumElements() : m_idxEnd;
+    pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getPerfEnergyForCopyD2D(objSrc, objDest, idxBegin, idxEnd);
+    statsMgr->recordCopyDeviceToDevice(numElements * bitsPerElement, mPerfEnergy, m_asyncHandle, &objSrc, &objDest);
 
     if (m_debugCmds) {
       std::printf("PIM-Cmd: Copied %" PRIu64 " elements of %u bits from PIM obj %d to PIM obj %d\n",
@@ -386,6 +503,9 @@ pimCmdFunc1::execute()
   }
 
   const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  if (pimSim::get()->isDataAwarePerf() && !pimSim::get()->isAnalysisMode()) {
+    m_dataAwareRatio = getDataAwareRatio(objSrc, nullptr, m_scalarValue);
+  }
   unsigned numRegions = objSrc.getRegions().size();
   computeAllRegions(numRegions);
 
@@ -394,7 +514,7 @@ pimCmdFunc1::execute()
     objDest.syncToSimulatedMem();
   }
 
-  updateStats();
+  recordStats();
   return true;
 }
 
@@ -519,8 +639,10 @@ pimCmdFunc1::computeRegion(unsigned index)
     } else if (pimUtils::isFP(dataType)) {
       uint64_t bits = objSrc.getElementBits(elemIdx);
       float floatOperand = pimUtils::castBitsToType<float>(bits);
+      // round scalar to data type, so that low-precision FP results are correctly rounded when stored
+      float floatScalar = pimUtils::castBitsToType<float>(pimUtils::unpackFpBits(pimUtils::packFpBits(m_scalarValue, dataType), dataType));
       float result = 0.0;
-      if(!computeResultFP(floatOperand, m_cmdType, pimUtils::castBitsToType<float>(m_scalarValue), result)) return false;
+      if(!computeResultFP(floatOperand, m_cmdType, floatScalar, result)) return false;
       if (objDest.getDataType() == PIM_BOOL) {
         bool resultBool = result > 0;
         objDest.setElement(elemIdx, resultBool);
@@ -589,19 +711,30 @@ pimCmdFunc1::bitSliceInsert(const pimObjInfo& objSrcBool, pimObjInfo& objDest, u
   return true;
 }
 
+//! @brief  PIM CMD: Functional 1-operand - data-aware modeling needs the ratio computed during execution
+bool
+pimCmdFunc1::isDataDependentStats() const
+{
+  return pimSim::get()->isDataAwarePerf() && !pimSim::get()->isAnalysisMode();
+}
+
 //! @brief  PIM CMD: Functional 1-operand - update stats
 bool
-pimCmdFunc1::updateStats() const
+pimCmdFunc1::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
   // Special handling: Use dest for performance energy calculation of bit-slice insert
   bool useDestAsSrc = (m_cmdType == PimCmdEnum::BIT_SLICE_INSERT);
-  const pimObjInfo& objSrc = (useDestAsSrc? m_device->getResMgr()->getObjInfo(m_dest) : m_device->getResMgr()->getObjInfo(m_src));
-  const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  const pimObjInfo& objSrc = (useDestAsSrc? device->getResMgr()->getObjInfo(m_dest) : device->getResMgr()->getObjInfo(m_src));
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
   PimDataType dataType = objSrc.getDataType();
   bool isVLayout = objSrc.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForFunc1(m_cmdType, objSrc, objDest);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForFunc1(m_cmdType, objSrc, objDest);
+  if (m_dataAwareRatio >= 0.0) {
+    mPerfEnergy.m_msDataAware = device->getPerfEnergyModel()->getMsRuntimeDataAware(m_cmdType, mPerfEnergy, m_dataAwareRatio);
+  }
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
   return true;
 }
 
@@ -625,6 +758,9 @@ pimCmdFunc2::execute()
   }
 
   const pimObjInfo& objSrc1 = m_device->getResMgr()->getObjInfo(m_src1);
+  if (pimSim::get()->isDataAwarePerf() && !pimSim::get()->isAnalysisMode()) {
+    m_dataAwareRatio = getDataAwareRatio(objSrc1, &m_device->getResMgr()->getObjInfo(m_src2), m_scalarValue);
+  }
   unsigned numRegions = objSrc1.getRegions().size();
   computeAllRegions(numRegions);
 
@@ -633,7 +769,7 @@ pimCmdFunc2::execute()
     objDest.syncToSimulatedMem();
   }
 
-  updateStats();
+  recordStats();
   return true;
 }
 
@@ -753,8 +889,9 @@ pimCmdFunc2::computeRegion(unsigned index)
       uint64_t operandBits2 = objSrc2.getElementBits(elemIdx);
       float floatOperand1 = pimUtils::castBitsToType<float>(operandBits1);
       float floatOperand2 = pimUtils::castBitsToType<float>(operandBits2);
+      float floatScalar = pimUtils::castBitsToType<float>(pimUtils::unpackFpBits(pimUtils::packFpBits(m_scalarValue, dataType), dataType));
       float result = 0.0;
-      if(!computeResultFP(floatOperand1, floatOperand2, m_cmdType, pimUtils::castBitsToType<float>(m_scalarValue), result)) return false;
+      if(!computeResultFP(floatOperand1, floatOperand2, m_cmdType, floatScalar, result)) return false;
       if (objDest.getDataType() == PIM_BOOL) {
         bool resultBool = result > 0;
         objDest.setElement(elemIdx, resultBool);
@@ -768,18 +905,29 @@ pimCmdFunc2::computeRegion(unsigned index)
   return true;
 }
 
+//! @brief  PIM CMD: Functional 2-operand - data-aware modeling needs the ratio computed during execution
+bool
+pimCmdFunc2::isDataDependentStats() const
+{
+  return pimSim::get()->isDataAwarePerf() && !pimSim::get()->isAnalysisMode();
+}
+
 //! @brief  PIM CMD: Functional 2-operand - update stats
 bool
-pimCmdFunc2::updateStats() const
+pimCmdFunc2::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
-  const pimObjInfo& objSrc1 = m_device->getResMgr()->getObjInfo(m_src1);
-  const pimObjInfo& objSrc2 = m_device->getResMgr()->getObjInfo(m_src2);
-  const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  const pimObjInfo& objSrc1 = device->getResMgr()->getObjInfo(m_src1);
+  const pimObjInfo& objSrc2 = device->getResMgr()->getObjInfo(m_src2);
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
   PimDataType dataType = objSrc1.getDataType();
   bool isVLayout = objSrc1.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForFunc2(m_cmdType, objSrc1, objSrc2, objDest);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForFunc2(m_cmdType, objSrc1, objSrc2, objDest);
+  if (m_dataAwareRatio >= 0.0) {
+    mPerfEnergy.m_msDataAware = device->getPerfEnergyModel()->getMsRuntimeDataAware(m_cmdType, mPerfEnergy, m_dataAwareRatio);
+  }
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc1);
+  statsMgr->recordCoreBusyTime(objSrc1, mPerfEnergy.m_msRuntime);
   return true;
 }
 
@@ -822,7 +970,7 @@ pimCmdCond::execute()
     objDest.syncToSimulatedMem();
   }
 
-  updateStats();
+  recordStats();
   return true;
 }
 
@@ -942,24 +1090,25 @@ pimCmdCond::computeRegion(unsigned index)
 
 //! @brief  PIM CMD: Conditional Operations - update stats
 bool
-pimCmdCond::updateStats() const
+pimCmdCond::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
-  const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
   PimDataType dataType = objDest.getDataType();
   bool isVLayout = objDest.isVLayout();
 
   // Reuse func2 to calculate performance and energy
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForFunc2(m_cmdType, objDest, objDest, objDest);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForFunc2(m_cmdType, objDest, objDest, objDest);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objDest);
+  statsMgr->recordCoreBusyTime(objDest, mPerfEnergy.m_msRuntime);
   return true;
 }
  
 //! @brief  PIM CMD: redsum non-ranged/ranged - sanity check
-template <typename T> bool
-pimCmdReduction<T>::sanityCheck() const
+bool
+pimCmdReductionBase::sanityCheck() const
 {
   pimResMgr* resMgr = m_device->getResMgr();
-  if (!isValidObjId(resMgr, m_src) || !m_result) {
+  if (!isValidObjId(resMgr, m_src)) {
     return false;
   }
 
@@ -975,8 +1124,8 @@ pimCmdReduction<T>::sanityCheck() const
   return true;
 }
 
-template <typename T> bool
-pimCmdReduction<T>::execute()
+bool
+pimCmdReductionBase::execute()
 {
   if (m_debugCmds) {
     std::printf("PIM-Cmd: %s (obj id %d)\n", getName().c_str(), m_src);
@@ -992,23 +1141,75 @@ pimCmdReduction<T>::execute()
   }
 
   unsigned numRegions = objSrc.getRegions().size();
+  initRegionResults(numRegions);
+  computeAllRegions(numRegions);
+  mergeRegionResults();
 
-  // prepare per-region storage
-  //reduction
-  for (unsigned i = 0; i < numRegions; ++i) {
-    if (m_cmdType == PimCmdEnum::REDSUM || m_cmdType == PimCmdEnum::REDSUM_RANGE) {
-      m_regionResult.resize(numRegions, 0);
-    } else if (m_cmdType == PimCmdEnum::REDMIN || m_cmdType == PimCmdEnum::REDMIN_RANGE) {
-      m_regionResult.resize(numRegions, std::numeric_limits<T>::max());
-    } else if (m_cmdType == PimCmdEnum::REDMAX || m_cmdType == PimCmdEnum::REDMAX_RANGE) {
-      m_regionResult.resize(numRegions, std::numeric_limits<T>::lowest());
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: redsum non-ranged/ranged - number of passes over regions of a core
+unsigned
+pimCmdReductionBase::getNumPass(const pimObjInfo& objSrc) const
+{
+  unsigned numPass = 0;
+  if (m_cmdType == PimCmdEnum::REDSUM_RANGE || m_cmdType == PimCmdEnum::REDMIN_RANGE || m_cmdType == PimCmdEnum::REDMAX_RANGE) {
+    // determine numPass for ranged reduction
+    std::unordered_map<PimCoreId, unsigned> activeRegionPerCore;
+    uint64_t index = 0;
+    for (const auto& region : objSrc.getRegions()) {
+      PimCoreId coreId = region.getCoreId();
+      unsigned numElementsInRegion = region.getNumElemInRegion();
+      bool isActive = index < m_idxEnd && index + numElementsInRegion - 1 >= m_idxBegin;
+      if (isActive) {
+        activeRegionPerCore[coreId]++;
+      }
+      index += numElementsInRegion;
+    }
+    for (const auto& [coreId, count] : activeRegionPerCore) {
+      if (numPass < count) {
+        numPass = count;
+      }
     }
+  } else {
+    numPass = objSrc.getMaxNumRegionsPerCore();
   }
+  return numPass;
+}
 
-  computeAllRegions(numRegions);
-  
-  //reduction
-  for (unsigned i = 0; i < numRegions; ++i) {
+bool
+pimCmdReductionBase::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
+  PimDataType dataType = objSrc.getDataType();
+  bool isVLayout = objSrc.isVLayout();
+
+  unsigned numPass = getNumPass(objSrc);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForReduction(m_cmdType, objSrc, numPass);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  PIM CMD: redsum non-ranged/ranged - prepare per-region storage
+template <typename T> void
+pimCmdReduction<T>::initRegionResults(unsigned numRegions)
+{
+  if (m_cmdType == PimCmdEnum::REDSUM || m_cmdType == PimCmdEnum::REDSUM_RANGE) {
+    m_regionResult.assign(numRegions, 0);
+  } else if (m_cmdType == PimCmdEnum::REDMIN || m_cmdType == PimCmdEnum::REDMIN_RANGE) {
+    m_regionResult.assign(numRegions, std::numeric_limits<T>::max());
+  } else if (m_cmdType == PimCmdEnum::REDMAX || m_cmdType == PimCmdEnum::REDMAX_RANGE) {
+    m_regionResult.assign(numRegions, std::numeric_limits<T>::lowest());
+  }
+}
+
+//! @brief  PIM CMD: redsum non-ranged/ranged - merge per-region results into the host result
+template <typename T> void
+pimCmdReduction<T>::mergeRegionResults()
+{
+  for (unsigned i = 0; i < m_regionResult.size(); ++i) {
     if (m_cmdType == PimCmdEnum::REDSUM || m_cmdType == PimCmdEnum::REDSUM_RANGE) {
       if (std::is_integral_v<T> && std::is_signed_v<T>)
       {
@@ -1032,9 +1233,6 @@ pimCmdReduction<T>::execute()
       *static_cast<T *>(m_result) = *static_cast<T *>(m_result) < static_cast<T>(m_regionResult[i]) ? static_cast<T>(m_regionResult[i]) : *static_cast<T *>(m_result);
     }
   }
-
-  updateStats();
-  return true;
 }
 
 template <typename T> bool
@@ -1102,38 +1300,262 @@ pimCmdReduction<T>::computeRegion(unsigned index)
   return true;
 }
 
+//! @brief  PIM CMD: batched reduction - sanity check
+bool
+pimCmdReductionBatched::sanityCheck() const
+{
+  if (m_reductions.empty()) {
+    std::printf("PIM-Error: Batched reduction requires at least one PIM object\n");
+    return false;
+  }
+  pimResMgr* resMgr = m_device->getResMgr();
+  for (const auto& reduction : m_reductions) {
+    if (!reduction->sanityCheck()) {
+      return false;
+    }
+    if (!isAssociated(resMgr->getObjInfo(m_reductions[0]->getSrc()), resMgr->getObjInfo(reduction->getSrc()))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: batched reduction - execute
+bool
+pimCmdReductionBatched::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (%lu objects)\n", getName().c_str(), m_reductions.size());
+  }
+
+  for (auto& reduction : m_reductions) {
+    reduction->setDevice(m_device);
+  }
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  for (auto& reduction : m_reductions) {
+    pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(reduction->getSrc());
+    if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+      objSrc.syncFromSimulatedMem();
+    }
+  }
+
+  // associated objects share the same region layout
+  unsigned numRegions = m_device->getResMgr()->getObjInfo(m_reductions[0]->getSrc()).getRegions().size();
+  for (auto& reduction : m_reductions) {
+    reduction->initRegionResults(numRegions);
+  }
+  computeAllRegions(numRegions);
+  for (auto& reduction : m_reductions) {
+    reduction->mergeRegionResults();
+  }
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: batched reduction - reduce a region of all objects
+bool
+pimCmdReductionBatched::computeRegion(unsigned index)
+{
+  for (auto& reduction : m_reductions) {
+    reduction->computeRegion(index);
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: batched reduction - update stats
+bool
+pimCmdReductionBatched::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objFirst = device->getResMgr()->getObjInfo(m_reductions[0]->getSrc());
+  PimDataType dataType = objFirst.getDataType();
+  bool isVLayout = objFirst.isVLayout();
+
+  std::vector<pimeval::perfEnergy> perfs;
+  for (const auto& reduction : m_reductions) {
+    const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(reduction->getSrc());
+    perfs.push_back(device->getPerfEnergyModel()->getCachedPerfEnergyForReduction(reduction->getCmdType(), objSrc, reduction->getNumPass(objSrc)));
+  }
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getPerfEnergyForBatchedReduction(perfs);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objFirst);
+  statsMgr->recordCoreBusyTime(objFirst, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  PIM CMD: segmented reduction - sanity check
+template <typename T> bool
+pimCmdReductionSegmented<T>::sanityCheck() const
+{
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (!isValidObjId(resMgr, m_src) || !m_results) {
+    return false;
+  }
+  if (m_offsets.size() < 2) {
+    std::printf("PIM-Error: Segmented reduction of PIM object ID %d requires at least one segment\n", m_src);
+    return false;
+  }
+  if (!std::is_sorted(m_offsets.begin(), m_offsets.end())) {
+    std::printf("PIM-Error: Segment offsets of PIM object ID %d must be non-decreasing\n", m_src);
+    return false;
+  }
+  uint64_t numElements = resMgr->getObjInfo(m_src).getNumElements();
+  if (m_offsets.back() > numElements) {
+    std::printf("PIM-Error: The end of the last segment for PIM object ID %d is greater than the number of elements\n", m_src);
+    return false;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: segmented reduction - initial value of a segment result
+template <typename T> T
+pimCmdReductionSegmented<T>::getIdentity() const
+{
+  if (m_cmdType == PimCmdEnum::REDMIN_SEGMENTED) {
+    return std::numeric_limits<T>::max();
+  } else if (m_cmdType == PimCmdEnum::REDMAX_SEGMENTED) {
+    return std::numeric_limits<T>::lowest();
+  }
+  return 0;
+}
+
+//! @brief  PIM CMD: segmented reduction - combine two values
+template <typename T> T
+pimCmdReductionSegmented<T>::reduce(T lhs, T rhs) const
+{
+  if (m_cmdType == PimCmdEnum::REDMIN_SEGMENTED) {
+    return lhs > rhs ? rhs : lhs;
+  } else if (m_cmdType == PimCmdEnum::REDMAX_SEGMENTED) {
+    return lhs < rhs ? rhs : lhs;
+  }
+  return lhs + rhs;
+}
+
+//! @brief  PIM CMD: segmented reduction - execute
+template <typename T> bool
+pimCmdReductionSegmented<T>::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (obj id %d, %lu segments)\n", getName().c_str(), m_src, m_offsets.size() - 1);
+  }
+
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objSrc.syncFromSimulatedMem();
+  }
+
+  unsigned numRegions = objSrc.getRegions().size();
+  m_regionResults.clear();
+  m_regionResults.resize(numRegions);
+
+  computeAllRegions(numRegions);
+
+  // merge per-region partial results into the host output array
+  T* results = static_cast<T*>(m_results);
+  uint64_t numSegments = m_offsets.size() - 1;
+  std::fill(results, results + numSegments, getIdentity());
+  for (const auto& partials : m_regionResults) {
+    for (const auto& [segIdx, partial] : partials) {
+      results[segIdx] = reduce(results[segIdx], partial);
+    }
+  }
+  m_regionResults.clear();
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: segmented reduction - compute partial results of all segments overlapping a region
 template <typename T> bool
-pimCmdReduction<T>::updateStats() const
+pimCmdReductionSegmented<T>::computeRegion(unsigned index)
 {
   const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  const pimRegion& srcRegion = objSrc.getRegions()[index];
   PimDataType dataType = objSrc.getDataType();
-  bool isVLayout = objSrc.isVLayout();
+  bool isFP = pimUtils::isFP(dataType);
+  bool isSigned = pimUtils::isSigned(dataType);
 
-  unsigned numPass = 0;
-  if (m_cmdType == PimCmdEnum::REDSUM_RANGE || m_cmdType == PimCmdEnum::REDMIN_RANGE || m_cmdType == PimCmdEnum::REDMAX_RANGE) {
-    // determine numPass for ranged reduction
-    std::unordered_map<PimCoreId, unsigned> activeRegionPerCore;
-    uint64_t index = 0;
-    for (const auto& region : objSrc.getRegions()) {
-      PimCoreId coreId = region.getCoreId();
-      unsigned numElementsInRegion = region.getNumElemInRegion();
-      bool isActive = index < m_idxEnd && index + numElementsInRegion - 1 >= m_idxBegin;
-      if (isActive) {
-        activeRegionPerCore[coreId]++;
-      }
-      index += numElementsInRegion;
-    }
-    for (const auto& [coreId, count] : activeRegionPerCore) {
-      if (numPass < count) {
-        numPass = count;
+  uint64_t idxBegin = std::max<uint64_t>(srcRegion.getElemIdxBegin(), m_offsets.front());
+  uint64_t idxEnd = std::min<uint64_t>(srcRegion.getElemIdxBegin() + srcRegion.getNumElemInRegion(), m_offsets.back());
+  if (idxBegin >= idxEnd) {
+    return true;
+  }
+
+  // segment containing the first element of this region
+  uint64_t segIdx = std::upper_bound(m_offsets.begin(), m_offsets.end(), idxBegin) - m_offsets.begin() - 1;
+  std::vector<std::pair<uint64_t, T>>& partials = m_regionResults[index];
+  partials.emplace_back(segIdx, getIdentity());
+  for (uint64_t idx = idxBegin; idx < idxEnd; ++idx) {
+    if (idx >= m_offsets[segIdx + 1]) {
+      // skip empty segments
+      while (idx >= m_offsets[segIdx + 1]) {
+        ++segIdx;
       }
+      partials.emplace_back(segIdx, getIdentity());
+    }
+    uint64_t operandBits = objSrc.getElementBits(idx);
+    T operand;
+    if (isFP) {
+      operand = pimUtils::castBitsToType<float>(operandBits);
+    } else if (isSigned) {
+      operand = pimUtils::signExt(operandBits, dataType);
+    } else {
+      operand = static_cast<T>(operandBits);
     }
-  } else {
-    numPass = objSrc.getMaxNumRegionsPerCore();
+    partials.back().second = reduce(partials.back().second, operand);
   }
+  return true;
+}
+
+//! @brief  PIM CMD: segmented reduction - update stats
+template <typename T> bool
+pimCmdReductionSegmented<T>::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
+  PimDataType dataType = objSrc.getDataType();
+  bool isVLayout = objSrc.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForReduction(m_cmdType, objSrc, numPass);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  // All segments share one pass over the active regions of each core, and each active region
+  // returns one partial result per segment that it overlaps
+  std::unordered_map<PimCoreId, unsigned> activeRegionPerCore;
+  uint64_t numPartials = 0;
+  for (const auto& region : objSrc.getRegions()) {
+    uint64_t idxBegin = std::max<uint64_t>(region.getElemIdxBegin(), m_offsets.front());
+    uint64_t idxEnd = std::min<uint64_t>(region.getElemIdxBegin() + region.getNumElemInRegion(), m_offsets.back());
+    if (idxBegin >= idxEnd) {
+      continue;
+    }
+    activeRegionPerCore[region.getCoreId()]++;
+    numPartials += 1 + (std::lower_bound(m_offsets.begin(), m_offsets.end(), idxEnd) -
+                        std::upper_bound(m_offsets.begin(), m_offsets.end(), idxBegin));
+  }
+  unsigned numPass = 0;
+  for (const auto& [coreId, count] : activeRegionPerCore) {
+    if (numPass < count) {
+      numPass = count;
+    }
+  }
+
+  PimCmdEnum redCmdType = PimCmdEnum::REDSUM;
+  if (m_cmdType == PimCmdEnum::REDMIN_SEGMENTED) {
+    redCmdType = PimCmdEnum::REDMIN;
+  } else if (m_cmdType == PimCmdEnum::REDMAX_SEGMENTED) {
+    redCmdType = PimCmdEnum::REDMAX;
+  }
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForReduction(redCmdType, objSrc, numPass);
+  // Partial results depend on segment boundaries rather than object shape, so they are not memoized
+  pimeval::perfEnergy perfPartials = device->getPerfEnergyModel()->getPerfEnergyForSegmentedPartials(objSrc, numPartials);
+  mPerfEnergy.m_msRuntime += perfPartials.m_msRuntime;
+  mPerfEnergy.m_mjEnergy += perfPartials.m_mjEnergy;
+  mPerfEnergy.m_mjBreakdown += perfPartials.m_mjBreakdown;
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
   return true;
 }
 
@@ -1158,7 +1580,7 @@ pimCmdBroadcast::execute()
     objDest.syncToSimulatedMem();
   }
 
-  updateStats();
+  recordStats();
   return true;
 }
 
@@ -1191,14 +1613,15 @@ pimCmdBroadcast::computeRegion(unsigned index)
 
 //! @brief  PIM CMD: broadcast a value to all elements - update stats
 bool
-pimCmdBroadcast::updateStats() const
+pimCmdBroadcast::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
-  const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
   PimDataType dataType = objDest.getDataType();
   bool isVLayout = objDest.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForBroadcast(m_cmdType, objDest);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForBroadcast(m_cmdType, objDest);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objDest);
+  statsMgr->recordCoreBusyTime(objDest, mPerfEnergy.m_msRuntime);
   return true;
 }
 
@@ -1261,7 +1684,7 @@ pimCmdRotate::execute()
     objSrc.syncToSimulatedMem();
   }
 
-  updateStats();
+  recordStats();
   return true;
 }
 
@@ -1322,14 +1745,20 @@ pimCmdRotate::computeRegion(unsigned index)
 
 //! @brief  PIM CMD: rotate right/left - update stats
 bool
-pimCmdRotate::updateStats() const
+pimCmdRotate::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
-  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
   PimDataType dataType = objSrc.getDataType();
   bool isVLayout = objSrc.isVLayout();
 
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForRotate(m_cmdType, objSrc);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForRotate(m_cmdType, objSrc);
+  // Boundary element movement depends on region placement rather than object shape, so it is not memoized
+  pimeval::perfEnergy perfBoundary = device->getPerfEnergyModel()->getPerfEnergyForRotateBoundary(m_cmdType, objSrc);
+  mPerfEnergy.m_msRuntime += perfBoundary.m_msRuntime;
+  mPerfEnergy.m_mjEnergy += perfBoundary.m_mjEnergy;
+  mPerfEnergy.m_mjBreakdown += perfBoundary.m_mjBreakdown;
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
   return true;
 }
 
@@ -1366,7 +1795,7 @@ pimCmdPrefixSum::execute()
 
   unsigned numRegions = objSrc.getRegions().size();
   computeAllRegions(numRegions);
-  updateStats();
+  recordStats();
   return true;
 }
 
@@ -1419,13 +1848,14 @@ pimCmdPrefixSum::computeRegion(unsigned index)
 }
 
 bool
-pimCmdPrefixSum::updateStats() const
+pimCmdPrefixSum::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
-  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
   PimDataType dataType = objSrc.getDataType();
   bool isVLayout = objSrc.isVLayout();
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForPrefixSum(m_cmdType, objSrc);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForPrefixSum(m_cmdType, objSrc);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
   return true;
 }
 
@@ -1487,6 +1917,8 @@ pimCmdMAC<T>::execute()
       switch (objSrc1.getDataType())
       {
       case PIM_INT8:
+      case PIM_INT4:
+      case PIM_INT2:
         static_cast<int8_t *>(m_dest)[objSrc1.getRegions()[i].getCoreId()] += static_cast<int8_t>(m_regionResult[i]);
         break;
       case PIM_INT16:
@@ -1507,6 +1939,8 @@ pimCmdMAC<T>::execute()
       switch (objSrc1.getDataType())
       {
       case PIM_UINT8:
+      case PIM_UINT4:
+      case PIM_UINT2:
         static_cast<int8_t *>(m_dest)[objSrc1.getRegions()[i].getCoreId()] += static_cast<int8_t>(m_regionResult[i]);
         break;
       case PIM_UINT16:
@@ -1527,7 +1961,7 @@ pimCmdMAC<T>::execute()
       static_cast<float *>(m_dest)[objSrc1.getRegions()[i].getCoreId()] += static_cast<float>(m_regionResult[i]);
     }
   }
-  updateStats();
+  recordStats();
   return true;
 }
 
@@ -1569,24 +2003,1175 @@ pimCmdMAC<T>::computeRegion(unsigned index)
 }
 
 template <typename T> bool
-pimCmdMAC<T>::updateStats() const
+pimCmdMAC<T>::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
-  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src1);
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src1);
   PimDataType dataType = objSrc.getDataType();
   bool isVLayout = objSrc.isVLayout();
-  pimeval::perfEnergy mPerfEnergy = pimSim::get()->getPerfEnergyModel()->getPerfEnergyForMac(m_cmdType, objSrc);
-  pimSim::get()->getStatsMgr()->recordCmd(getName(dataType, isVLayout), mPerfEnergy);
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForMac(m_cmdType, objSrc);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
   return true;
 }
 
-//! @brief  Pim CMD: BitSIMD-V: Read a row to SA
+//! @brief  PIM CMD: Batched AND-popcount - sanity check
 bool
-pimCmdReadRowToSa::execute()
+pimCmdAndPopCountBatched::sanityCheck() const
 {
-  if (m_debugCmds) {
-    std::printf("PIM-MicroOp: BitSIMD-V ReadRowToSa (obj id %d ofst %u)\n", m_objId, m_ofst);
-  }
-
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (!isValidObjId(resMgr, m_bitmaps)) {
+    return false;
+  }
+  const pimObjInfo& objBitmaps = resMgr->getObjInfo(m_bitmaps);
+  PimDataType dataType = objBitmaps.getDataType();
+  if (objBitmaps.isBuffer() || !(pimUtils::isSigned(dataType) || pimUtils::isUnsigned(dataType))) {
+    std::printf("PIM-Error: PIM CMD %s requires an integer PIM object of bitmap words\n", getName().c_str());
+    return false;
+  }
+  if (m_numWordsPerRow == 0 || objBitmaps.getNumElements() % m_numWordsPerRow != 0) {
+    std::printf("PIM-Error: Number of elements of object %d is not a multiple of %" PRIu64 " words per row for PIM CMD %s\n",
+                m_bitmaps, m_numWordsPerRow, getName().c_str());
+    return false;
+  }
+  if (m_rowsA.size() != m_rowsB.size() || (!m_rowsA.empty() && m_counts == nullptr)) {
+    std::printf("PIM-Error: Invalid row pairs or null result pointer for PIM CMD %s\n", getName().c_str());
+    return false;
+  }
+  uint64_t numRows = objBitmaps.getNumElements() / m_numWordsPerRow;
+  for (uint64_t i = 0; i < m_rowsA.size(); ++i) {
+    if (m_rowsA[i] >= numRows || m_rowsB[i] >= numRows) {
+      std::printf("PIM-Error: Row pair %" PRIu64 " (%" PRIu64 ", %" PRIu64 ") is out of range of %" PRIu64 " bitmap rows for PIM CMD %s\n",
+                  i, m_rowsA[i], m_rowsB[i], numRows, getName().c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Batched AND-popcount
+bool
+pimCmdAndPopCountBatched::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (obj id %d, %lu pairs of %" PRIu64 "-word rows)\n",
+                getName().c_str(), m_bitmaps, m_rowsA.size(), m_numWordsPerRow);
+  }
+
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    pimObjInfo& objBitmaps = m_device->getResMgr()->getObjInfo(m_bitmaps);
+    objBitmaps.syncFromSimulatedMem();
+  }
+
+  // counts are overwritten; pairs are split into chunks of work items for the thread pool
+  std::fill(m_counts, m_counts + m_rowsA.size(), 0);
+  unsigned numChunks = (m_rowsA.size() + NUM_PAIRS_PER_CHUNK - 1) / NUM_PAIRS_PER_CHUNK;
+  computeAllRegions(numChunks);
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: Batched AND-popcount - count common set bits of a chunk of row pairs
+bool
+pimCmdAndPopCountBatched::computeRegion(unsigned index)
+{
+  const pimObjInfo& objBitmaps = m_device->getResMgr()->getObjInfo(m_bitmaps);
+  unsigned bitsPerElement = objBitmaps.getBitsPerElement(PimBitWidth::ACTUAL);
+  uint64_t mask = (bitsPerElement >= 64 ? ~0ULL : (1ULL << bitsPerElement) - 1);
+
+  uint64_t pairBegin = static_cast<uint64_t>(index) * NUM_PAIRS_PER_CHUNK;
+  uint64_t pairEnd = std::min<uint64_t>(pairBegin + NUM_PAIRS_PER_CHUNK, m_rowsA.size());
+  for (uint64_t i = pairBegin; i < pairEnd; ++i) {
+    uint64_t idxA = m_rowsA[i] * m_numWordsPerRow;
+    uint64_t idxB = m_rowsB[i] * m_numWordsPerRow;
+    uint64_t count = 0;
+    for (uint64_t j = 0; j < m_numWordsPerRow; ++j) {
+      uint64_t bits = objBitmaps.getElementBits(idxA + j) & objBitmaps.getElementBits(idxB + j);
+      count += __builtin_popcountll(bits & mask);
+    }
+    m_counts[i] = count;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Batched AND-popcount - update stats
+bool
+pimCmdAndPopCountBatched::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objBitmaps = device->getResMgr()->getObjInfo(m_bitmaps);
+  PimDataType dataType = objBitmaps.getDataType();
+  bool isVLayout = objBitmaps.isVLayout();
+  uint64_t numWords = m_rowsA.size() * m_numWordsPerRow;
+
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForAndPopCount(m_cmdType, objBitmaps, numWords);
+  // one count per pair is returned to host
+  pimeval::perfEnergy perfCounts = device->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, m_rowsA.size() * sizeof(uint64_t));
+  mPerfEnergy.m_msRuntime += perfCounts.m_msRuntime;
+  mPerfEnergy.m_mjEnergy += perfCounts.m_mjEnergy;
+  mPerfEnergy.m_mjBreakdown += perfCounts.m_mjBreakdown;
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objBitmaps);
+  statsMgr->recordCoreBusyTime(objBitmaps, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  PIM CMD: Gather/scatter - sanity check
+bool
+pimCmdGatherScatter::sanityCheck() const
+{
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (!isValidObjId(resMgr, m_src) || !isValidObjId(resMgr, m_index) || !isValidObjId(resMgr, m_dest)) {
+    return false;
+  }
+  const pimObjInfo& objSrc = resMgr->getObjInfo(m_src);
+  const pimObjInfo& objIndex = resMgr->getObjInfo(m_index);
+  const pimObjInfo& objDest = resMgr->getObjInfo(m_dest);
+  if (objSrc.isBuffer() || objIndex.isBuffer() || objDest.isBuffer()) {
+    std::printf("PIM-Error: PIM CMD %s does not support PIM buffers\n", getName().c_str());
+    return false;
+  }
+  if (m_src == m_dest || m_index == m_dest) {
+    std::printf("PIM-Error: PIM CMD %s requires a destination object different from its operands\n", getName().c_str());
+    return false;
+  }
+  if (!isCompatibleType(objSrc, objDest)) {
+    return false;
+  }
+  PimDataType indexType = objIndex.getDataType();
+  if (!(pimUtils::isSigned(indexType) || pimUtils::isUnsigned(indexType))) {
+    std::printf("PIM-Error: PIM CMD %s requires an integer index object\n", getName().c_str());
+    return false;
+  }
+  if (m_cmdType == PimCmdEnum::GATHER) {
+    if (!isAssociated(objIndex, objDest)) {
+      return false;
+    }
+  } else {
+    if (!isAssociated(objSrc, objIndex)) {
+      return false;
+    }
+  }
+  if (m_cmdType == PimCmdEnum::SCATTER_ADD && objDest.getDataType() == PIM_BOOL) {
+    std::printf("PIM-Error: PIM CMD %s does not support bool data type\n", getName().c_str());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Gather/scatter - read and validate indices, and group scatter sources by dest element
+bool
+pimCmdGatherScatter::readIndices()
+{
+  const pimObjInfo& objIndex = m_device->getResMgr()->getObjInfo(m_index);
+  const pimObjInfo& objTarget = m_device->getResMgr()->getObjInfo(m_cmdType == PimCmdEnum::GATHER ? m_src : m_dest);
+  PimDataType indexType = objIndex.getDataType();
+  uint64_t numIndices = objIndex.getNumElements();
+  uint64_t numTargets = objTarget.getNumElements();
+
+  // negative indices become out of range after sign extension
+  m_indices.resize(numIndices);
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    m_indices[i] = pimUtils::signExt(objIndex.getElementBits(i), indexType);
+    if (m_indices[i] >= numTargets) {
+      std::printf("PIM-Error: Index %" PRId64 " at element %" PRIu64 " of object %d is out of range of %" PRIu64 " elements for PIM CMD %s\n",
+                  static_cast<int64_t>(m_indices[i]), i, m_index, numTargets, getName().c_str());
+      m_indices.clear();
+      return false;
+    }
+  }
+  if (m_cmdType == PimCmdEnum::GATHER) {
+    return true;
+  }
+
+  // counting sort of src elements by dest element keeps increasing src order within each dest element
+  m_srcOffsets.assign(numTargets + 1, 0);
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    m_srcOffsets[m_indices[i] + 1]++;
+  }
+  for (uint64_t j = 0; j < numTargets; ++j) {
+    m_srcOffsets[j + 1] += m_srcOffsets[j];
+  }
+  std::vector<uint64_t> cursors(m_srcOffsets.begin(), m_srcOffsets.end() - 1);
+  m_srcOrder.resize(numIndices);
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    m_srcOrder[cursors[m_indices[i]]++] = i;
+  }
+  m_indices.clear();
+  return true;
+}
+
+//! @brief  PIM CMD: Gather/scatter
+bool
+pimCmdGatherScatter::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (obj id %d indexed by %d -> %d)\n", getName().c_str(), m_src, m_index, m_dest);
+  }
+
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  pimObjInfo& objIndex = m_device->getResMgr()->getObjInfo(m_index);
+  pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objSrc.syncFromSimulatedMem();
+    objIndex.syncFromSimulatedMem();
+    if (m_cmdType != PimCmdEnum::GATHER) {
+      objDest.syncFromSimulatedMem();
+    }
+  }
+
+  if (!pimSim::get()->isAnalysisMode() && !readIndices()) {
+    return false;
+  }
+
+  // all commands are computed per dest region, so that no two threads write the same element
+  unsigned numRegions = objDest.getRegions().size();
+  computeAllRegions(numRegions);
+  m_indices.clear();
+  m_srcOffsets.clear();
+  m_srcOrder.clear();
+
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objDest.syncToSimulatedMem();
+  }
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: Gather/scatter - compute a dest region
+bool
+pimCmdGatherScatter::computeRegion(unsigned index)
+{
+  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  PimDataType dataType = objDest.getDataType();
+
+  const pimRegion& destRegion = objDest.getRegions()[index];
+  uint64_t elemIdxBegin = destRegion.getElemIdxBegin();
+  uint64_t elemIdxEnd = elemIdxBegin + destRegion.getNumElemInRegion();
+  for (uint64_t j = elemIdxBegin; j < elemIdxEnd; ++j) {
+    if (m_cmdType == PimCmdEnum::GATHER) {
+      objDest.setElementBits(j, objSrc.getElementBits(m_indices[j]));
+      continue;
+    }
+    uint64_t srcBegin = m_srcOffsets[j];
+    uint64_t srcEnd = m_srcOffsets[j + 1];
+    if (srcBegin == srcEnd) {
+      continue;
+    }
+    if (m_cmdType == PimCmdEnum::SCATTER) {
+      objDest.setElementBits(j, objSrc.getElementBits(m_srcOrder[srcEnd - 1]));
+    } else if (pimUtils::isFP(dataType)) {
+      // accumulate in FP32 and round once when stored
+      float acc = pimUtils::castBitsToType<float>(objDest.getElementBits(j));
+      for (uint64_t k = srcBegin; k < srcEnd; ++k) {
+        acc += pimUtils::castBitsToType<float>(objSrc.getElementBits(m_srcOrder[k]));
+      }
+      objDest.setElement(j, acc);
+    } else {
+      // integer addition wraps around at the data type width
+      uint64_t acc = objDest.getElementBits(j);
+      for (uint64_t k = srcBegin; k < srcEnd; ++k) {
+        acc += objSrc.getElementBits(m_srcOrder[k]);
+      }
+      objDest.setElementBits(j, acc);
+    }
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Gather/scatter - update stats
+bool
+pimCmdGatherScatter::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
+  const pimObjInfo& objIndex = device->getResMgr()->getObjInfo(m_index);
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
+  PimDataType dataType = objDest.getDataType();
+  bool isVLayout = objDest.isVLayout();
+
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForGatherScatter(m_cmdType, objSrc, objIndex, objDest);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objDest);
+  statsMgr->recordCoreBusyTime(objDest, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  PIM CMD: Compact - sanity check
+bool
+pimCmdCompact::sanityCheck() const
+{
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (!isValidObjId(resMgr, m_src) || !isValidObjId(resMgr, m_cond) || !isValidObjId(resMgr, m_dest)) {
+    return false;
+  }
+  const pimObjInfo& objSrc = resMgr->getObjInfo(m_src);
+  const pimObjInfo& objCond = resMgr->getObjInfo(m_cond);
+  const pimObjInfo& objDest = resMgr->getObjInfo(m_dest);
+  if (objSrc.isBuffer() || objCond.isBuffer() || objDest.isBuffer()) {
+    std::printf("PIM-Error: PIM CMD %s does not support PIM buffers\n", getName().c_str());
+    return false;
+  }
+  if (m_src == m_dest || m_cond == m_dest) {
+    std::printf("PIM-Error: PIM CMD %s requires a destination object different from its operands\n", getName().c_str());
+    return false;
+  }
+  if (!isAssociated(objSrc, objCond) || !isCompatibleType(objSrc, objDest)) {
+    return false;
+  }
+  if (objCond.getDataType() != PIM_BOOL) {
+    std::printf("PIM-Error: PIM CMD %s requires a bool condition object\n", getName().c_str());
+    return false;
+  }
+  if (m_count == nullptr) {
+    std::printf("PIM-Error: Invalid null count pointer for PIM CMD %s\n", getName().c_str());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Compact
+//! Parallel prefix-sum based compaction: count selected elements per chunk, compute chunk offsets,
+//! then pack selected elements of all chunks in parallel.
+bool
+pimCmdCompact::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (obj id %d selected by %d -> %d)\n", getName().c_str(), m_src, m_cond, m_dest);
+  }
+
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  pimObjInfo& objCond = m_device->getResMgr()->getObjInfo(m_cond);
+  pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objSrc.syncFromSimulatedMem();
+    objCond.syncFromSimulatedMem();
+    objDest.syncFromSimulatedMem();
+  }
+
+  unsigned numChunks = (objSrc.getNumElements() + NUM_ELEMENTS_PER_CHUNK - 1) / NUM_ELEMENTS_PER_CHUNK;
+  m_chunkOffsets.assign(numChunks, 0);
+  m_isCountPhase = true;
+  computeAllRegions(numChunks);
+
+  // analysis mode does not compute, and all elements that fit in dest are assumed to be selected
+  m_numSelected = 0;
+  for (uint64_t& offset : m_chunkOffsets) {
+    uint64_t numSelected = offset;
+    offset = m_numSelected;
+    m_numSelected += numSelected;
+  }
+  if (pimSim::get()->isAnalysisMode()) {
+    m_numSelected = std::min(objSrc.getNumElements(), objDest.getNumElements());
+  } else if (m_numSelected > objDest.getNumElements()) {
+    std::printf("PIM-Error: %" PRIu64 " selected elements exceed %" PRIu64 " elements of object %d for PIM CMD %s\n",
+                m_numSelected, objDest.getNumElements(), m_dest, getName().c_str());
+    return false;
+  }
+
+  m_isCountPhase = false;
+  computeAllRegions(numChunks);
+  m_chunkOffsets.clear();
+  *m_count = m_numSelected;
+
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objDest.syncToSimulatedMem();
+  }
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: Compact - count or pack selected elements of a chunk
+bool
+pimCmdCompact::computeRegion(unsigned index)
+{
+  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  const pimObjInfo& objCond = m_device->getResMgr()->getObjInfo(m_cond);
+  pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+
+  uint64_t elemIdxBegin = static_cast<uint64_t>(index) * NUM_ELEMENTS_PER_CHUNK;
+  uint64_t elemIdxEnd = std::min<uint64_t>(elemIdxBegin + NUM_ELEMENTS_PER_CHUNK, objSrc.getNumElements());
+  uint64_t destIdx = m_chunkOffsets[index];
+  uint64_t numSelected = 0;
+  for (uint64_t i = elemIdxBegin; i < elemIdxEnd; ++i) {
+    if (objCond.getElementBits(i) & 1) {
+      if (!m_isCountPhase) {
+        objDest.setElementBits(destIdx++, objSrc.getElementBits(i));
+      }
+      numSelected++;
+    }
+  }
+  if (m_isCountPhase) {
+    m_chunkOffsets[index] = numSelected;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Compact - update stats
+bool
+pimCmdCompact::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
+  const pimObjInfo& objCond = device->getResMgr()->getObjInfo(m_cond);
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
+  PimDataType dataType = objSrc.getDataType();
+  bool isVLayout = objSrc.isVLayout();
+
+  // not memoized, as the model depends on the number of selected elements of each call
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getPerfEnergyForCompact(m_cmdType, objSrc, objCond, objDest, m_numSelected);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  PIM CMD: Top-k - sanity check
+bool
+pimCmdTopK::sanityCheck() const
+{
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (!isValidObjId(resMgr, m_src)) {
+    return false;
+  }
+  const pimObjInfo& objSrc = resMgr->getObjInfo(m_src);
+  if (objSrc.isBuffer()) {
+    std::printf("PIM-Error: PIM CMD %s does not support PIM buffers\n", getName().c_str());
+    return false;
+  }
+  if (m_k == 0 || m_k > objSrc.getNumElements()) {
+    std::printf("PIM-Error: Invalid k = %" PRIu64 " for %" PRIu64 " elements of object %d for PIM CMD %s\n",
+                m_k, objSrc.getNumElements(), m_src, getName().c_str());
+    return false;
+  }
+  if (m_outValues == nullptr && m_outIndices == nullptr) {
+    std::printf("PIM-Error: Invalid null result pointers for PIM CMD %s\n", getName().c_str());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Top-k - select the k best of candidate element indices, ordered from the best
+//! Values are compared as type T. Ties and NaNs are ordered by element index, with NaNs after all numbers.
+template <typename T> void
+pimCmdTopK::selectTopK(std::vector<uint64_t>& indices) const
+{
+  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  PimDataType dataType = objSrc.getDataType();
+  std::vector<std::pair<T, uint64_t>> candidates;
+  candidates.reserve(indices.size());
+  for (uint64_t idx : indices) {
+    uint64_t bits = objSrc.getElementBits(idx);
+    if constexpr (std::is_floating_point_v<T>) {
+      candidates.emplace_back(pimUtils::castBitsToType<float>(bits), idx);
+    } else {
+      candidates.emplace_back(static_cast<T>(pimUtils::signExt(bits, dataType)), idx);
+    }
+  }
+  auto isBetter = [this](const std::pair<T, uint64_t>& a, const std::pair<T, uint64_t>& b) {
+    if constexpr (std::is_floating_point_v<T>) {
+      bool isNanA = std::isnan(a.first);
+      bool isNanB = std::isnan(b.first);
+      if (isNanA || isNanB) {
+        return isNanA == isNanB ? a.second < b.second : isNanB;
+      }
+    }
+    if (a.first != b.first) {
+      return m_isSmallest ? a.first < b.first : a.first > b.first;
+    }
+    return a.second < b.second;
+  };
+  uint64_t numSelected = std::min<uint64_t>(m_k, candidates.size());
+  if (numSelected < candidates.size()) {
+    std::nth_element(candidates.begin(), candidates.begin() + numSelected, candidates.end(), isBetter);
+    candidates.resize(numSelected);
+  }
+  std::sort(candidates.begin(), candidates.end(), isBetter);
+  indices.resize(numSelected);
+  for (uint64_t i = 0; i < numSelected; ++i) {
+    indices[i] = candidates[i].second;
+  }
+}
+
+//! @brief  PIM CMD: Top-k
+bool
+pimCmdTopK::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (obj id %d, k = %" PRIu64 ", %s)\n", getName().c_str(), m_src, m_k,
+                m_isSmallest ? "smallest" : "largest");
+  }
+
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objSrc.syncFromSimulatedMem();
+  }
+
+  // per-region partial selection
+  unsigned numRegions = objSrc.getRegions().size();
+  m_regionResults.assign(numRegions, {});
+  computeAllRegions(numRegions);
+
+  // merge candidates of all regions
+  if (!pimSim::get()->isAnalysisMode()) {
+    std::vector<uint64_t> indices;
+    for (const std::vector<uint64_t>& regionResult : m_regionResults) {
+      indices.insert(indices.end(), regionResult.begin(), regionResult.end());
+    }
+    PimDataType dataType = objSrc.getDataType();
+    if (pimUtils::isSigned(dataType)) {
+      selectTopK<int64_t>(indices);
+    } else if (pimUtils::isUnsigned(dataType)) {
+      selectTopK<uint64_t>(indices);
+    } else if (pimUtils::isFP(dataType)) {
+      selectTopK<float>(indices);
+    } else {
+      assert(0); // todo: data type
+    }
+
+    // values are returned in host data type
+    unsigned numBytesPerValue = pimUtils::getNumBitsOfDataType(dataType, PimBitWidth::HOST) / 8;
+    for (uint64_t i = 0; i < indices.size(); ++i) {
+      if (m_outIndices) {
+        m_outIndices[i] = indices[i];
+      }
+      if (m_outValues) {
+        uint64_t bits = pimUtils::signExt(objSrc.getElementBits(indices[i]), dataType);
+        std::memcpy(static_cast<uint8_t*>(m_outValues) + i * numBytesPerValue, &bits, numBytesPerValue);
+      }
+    }
+  }
+  m_regionResults.clear();
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: Top-k - select k candidates of a region
+bool
+pimCmdTopK::computeRegion(unsigned index)
+{
+  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  PimDataType dataType = objSrc.getDataType();
+  const pimRegion& srcRegion = objSrc.getRegions()[index];
+  uint64_t elemIdxBegin = srcRegion.getElemIdxBegin();
+  uint64_t numElemInRegion = srcRegion.getNumElemInRegion();
+
+  std::vector<uint64_t>& indices = m_regionResults[index];
+  indices.resize(numElemInRegion);
+  for (uint64_t i = 0; i < numElemInRegion; ++i) {
+    indices[i] = elemIdxBegin + i;
+  }
+  if (pimUtils::isSigned(dataType)) {
+    selectTopK<int64_t>(indices);
+  } else if (pimUtils::isUnsigned(dataType)) {
+    selectTopK<uint64_t>(indices);
+  } else if (pimUtils::isFP(dataType)) {
+    selectTopK<float>(indices);
+  } else {
+    assert(0); // todo: data type
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Top-k - update stats
+bool
+pimCmdTopK::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
+  PimDataType dataType = objSrc.getDataType();
+  bool isVLayout = objSrc.isVLayout();
+
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForTopK(m_cmdType, objSrc, m_k);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  PIM CMD: Math - accumulate micro-ops
+pimCmdMath::microOps&
+pimCmdMath::microOps::operator+=(const microOps& rhs)
+{
+  m_numMul += rhs.m_numMul;
+  m_numAdd += rhs.m_numAdd;
+  m_numDiv += rhs.m_numDiv;
+  m_numMulScalar += rhs.m_numMulScalar;
+  return *this;
+}
+
+//! @brief  PIM CMD: Math - number of polynomial terms or Newton iterations of an approximation
+//! - exp: degree of Taylor polynomial after range reduction to |r| <= ln2/2
+//! - log: number of odd terms after s, in log(m) = 2 * atanh(s), s = (m - 1) / (m + 1)
+//! - sqrt: Newton iterations of reciprocal square root from the magic number initial guess
+//! - recip: Newton iterations from the linear initial guess of mantissa in [0.5, 1)
+//! - tanh: number of odd Taylor terms after x for |x| < 0.25
+unsigned
+pimCmdMath::getNumTerms(PimCmdEnum cmdType, PimMathPrecision precision)
+{
+  bool isFast = (precision == PIM_MATH_FAST);
+  switch (cmdType) {
+    case PimCmdEnum::EXP: return isFast ? 3 : 6;
+    case PimCmdEnum::LOG: return isFast ? 1 : 4;
+    case PimCmdEnum::SQRT: return isFast ? 1 : 3;
+    case PimCmdEnum::RECIP: return isFast ? 2 : 3;
+    case PimCmdEnum::TANH: return isFast ? 1 : 3;
+    default: break;
+  }
+  return 0;
+}
+
+//! @brief  PIM CMD: Math - micro-ops of an approximation, including range reduction and exponent field updates
+pimCmdMath::microOps
+pimCmdMath::getMicroOps(PimCmdEnum cmdType, PimMathPrecision precision)
+{
+  microOps ops;
+  unsigned numTerms = getNumTerms(cmdType, precision);
+  switch (cmdType) {
+    case PimCmdEnum::EXP:
+      // n = round(x * log2e) with magic number adds, r = x - n * ln2, Horner, scale by 2^n
+      ops.m_numMulScalar = 2;
+      ops.m_numMul = numTerms;
+      ops.m_numAdd = numTerms + 4;
+      break;
+    case PimCmdEnum::LOG:
+      // exponent and mantissa extraction, s = (m - 1) / (m + 1), Horner in s^2, times s, plus e * ln2
+      ops.m_numDiv = 1;
+      ops.m_numMul = numTerms + 2;
+      ops.m_numAdd = numTerms + 5;
+      ops.m_numMulScalar = 1;
+      break;
+    case PimCmdEnum::SQRT:
+      // magic number guess, y = y * (1.5 - 0.5 * x * y * y) per iteration, x * y
+      ops.m_numMulScalar = 1;
+      ops.m_numMul = 3 * numTerms + 1;
+      ops.m_numAdd = numTerms + 1;
+      break;
+    case PimCmdEnum::RECIP:
+      // exponent extraction and update, linear guess, y = y * (2 - x * y) per iteration
+      ops.m_numMulScalar = 1;
+      ops.m_numMul = 2 * numTerms;
+      ops.m_numAdd = numTerms + 3;
+      break;
+    case PimCmdEnum::SIGMOID:
+      // 1 / (1 + exp(-x))
+      ops = getMicroOps(PimCmdEnum::EXP, precision);
+      ops += getMicroOps(PimCmdEnum::RECIP, precision);
+      ops.m_numAdd += 1;
+      break;
+    case PimCmdEnum::TANH:
+      // (1 - e) / (1 + e) with e = exp(-2|x|), Taylor polynomial for small |x|, and select
+      ops = getMicroOps(PimCmdEnum::EXP, precision);
+      ops += getMicroOps(PimCmdEnum::RECIP, precision);
+      ops.m_numMul += numTerms + 3;
+      ops.m_numAdd += numTerms + 3;
+      break;
+    default:
+      assert(0);
+  }
+  return ops;
+}
+
+//! @brief  PIM CMD: Math - exp approximation
+float
+pimCmdMath::approxExp(float val, PimMathPrecision precision)
+{
+  if (std::isnan(val)) {
+    return val;
+  }
+  if (val > 88.7228394f) {
+    return INFINITY;
+  }
+  if (val < -103.972084f) {
+    return 0.0f;
+  }
+  const float log2e = 1.44269504f;
+  const float ln2Hi = 0.693359375f;
+  const float ln2Lo = -2.12194440e-4f;
+  float n = std::nearbyint(val * log2e);
+  float r = (val - n * ln2Hi) - n * ln2Lo;
+  unsigned degree = getNumTerms(PimCmdEnum::EXP, precision);
+  float coef = 1.0f;
+  for (unsigned i = 2; i <= degree; ++i) {
+    coef /= static_cast<float>(i);
+  }
+  float poly = coef;
+  for (unsigned i = degree; i > 0; --i) {
+    coef *= static_cast<float>(i);
+    poly = poly * r + coef;
+  }
+  return std::ldexp(poly, static_cast<int>(n));
+}
+
+//! @brief  PIM CMD: Math - natural log approximation
+float
+pimCmdMath::approxLog(float val, PimMathPrecision precision)
+{
+  if (std::isnan(val) || val < 0.0f) {
+    return NAN;
+  }
+  if (val == 0.0f) {
+    return -INFINITY;
+  }
+  if (std::isinf(val)) {
+    return val;
+  }
+  int exp = 0;
+  float m = std::frexp(val, &exp);
+  if (m < 0.70710678f) {
+    m *= 2.0f;
+    --exp;
+  }
+  float s = (m - 1.0f) / (m + 1.0f);
+  float s2 = s * s;
+  unsigned numTerms = getNumTerms(PimCmdEnum::LOG, precision);
+  float poly = 2.0f / static_cast<float>(2 * numTerms + 1);
+  for (unsigned i = numTerms; i > 0; --i) {
+    poly = poly * s2 + 2.0f / static_cast<float>(2 * i - 1);
+  }
+  return static_cast<float>(exp) * 0.693147181f + poly * s;
+}
+
+//! @brief  PIM CMD: Math - sqrt approximation
+float
+pimCmdMath::approxSqrt(float val, PimMathPrecision precision)
+{
+  if (std::isnan(val) || val < 0.0f) {
+    return NAN;
+  }
+  if (val == 0.0f || std::isinf(val)) {
+    return val;
+  }
+  // scale denormals into the normal range for the magic number guess
+  float scale = 1.0f;
+  if (val < FLT_MIN) {
+    val *= 16777216.0f;
+    scale = 1.0f / 4096.0f;
+  }
+  uint32_t bits = 0;
+  std::memcpy(&bits, &val, sizeof(bits));
+  bits = 0x5f3759df - (bits >> 1);
+  float y = 0.0f;
+  std::memcpy(&y, &bits, sizeof(y));
+  float halfVal = 0.5f * val;
+  unsigned numIters = getNumTerms(PimCmdEnum::SQRT, precision);
+  for (unsigned i = 0; i < numIters; ++i) {
+    y = y * (1.5f - halfVal * y * y);
+  }
+  return val * y * scale;
+}
+
+//! @brief  PIM CMD: Math - reciprocal approximation
+float
+pimCmdMath::approxRecip(float val, PimMathPrecision precision)
+{
+  if (std::isnan(val)) {
+    return val;
+  }
+  if (val == 0.0f) {
+    return std::copysign(INFINITY, val);
+  }
+  if (std::isinf(val)) {
+    return std::copysign(0.0f, val);
+  }
+  int exp = 0;
+  float m = std::frexp(std::fabs(val), &exp);
+  float y = 48.0f / 17.0f - 32.0f / 17.0f * m;
+  unsigned numIters = getNumTerms(PimCmdEnum::RECIP, precision);
+  for (unsigned i = 0; i < numIters; ++i) {
+    y = y * (2.0f - m * y);
+  }
+  return std::copysign(std::ldexp(y, -exp), val);
+}
+
+//! @brief  PIM CMD: Math - sigmoid approximation
+float
+pimCmdMath::approxSigmoid(float val, PimMathPrecision precision)
+{
+  return approxRecip(1.0f + approxExp(-val, precision), precision);
+}
+
+//! @brief  PIM CMD: Math - tanh approximation
+float
+pimCmdMath::approxTanh(float val, PimMathPrecision precision)
+{
+  float absVal = std::fabs(val);
+  if (absVal < 0.25f) {
+    // Taylor terms of x, x^3, x^5, x^7, avoiding cancellation of 1 - e
+    static const float coefs[] = { 1.0f, -1.0f / 3.0f, 2.0f / 15.0f, -17.0f / 315.0f };
+    unsigned numTerms = getNumTerms(PimCmdEnum::TANH, precision);
+    float val2 = val * val;
+    float poly = coefs[numTerms];
+    for (unsigned i = numTerms; i > 0; --i) {
+      poly = poly * val2 + coefs[i - 1];
+    }
+    return poly * val;
+  }
+  float e = approxExp(-2.0f * absVal, precision);
+  return std::copysign((1.0f - e) * approxRecip(1.0f + e, precision), val);
+}
+
+//! @brief  PIM CMD: Math - compute one element
+float
+pimCmdMath::compute(PimCmdEnum cmdType, float val, PimMathPrecision precision)
+{
+  switch (cmdType) {
+    case PimCmdEnum::EXP: return approxExp(val, precision);
+    case PimCmdEnum::LOG: return approxLog(val, precision);
+    case PimCmdEnum::SQRT: return approxSqrt(val, precision);
+    case PimCmdEnum::RECIP: return approxRecip(val, precision);
+    case PimCmdEnum::SIGMOID: return approxSigmoid(val, precision);
+    case PimCmdEnum::TANH: return approxTanh(val, precision);
+    default: assert(0);
+  }
+  return 0.0f;
+}
+
+//! @brief  PIM CMD: Math - sanity check
+bool
+pimCmdMath::sanityCheck() const
+{
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (!isValidObjId(resMgr, m_src) || !isValidObjId(resMgr, m_dest)) {
+    return false;
+  }
+  const pimObjInfo& objSrc = resMgr->getObjInfo(m_src);
+  const pimObjInfo& objDest = resMgr->getObjInfo(m_dest);
+  if (!isAssociated(objSrc, objDest)) {
+    return false;
+  }
+  PimDataType dataType = objSrc.getDataType();
+  if (dataType == PIM_BOOL) {
+    std::printf("PIM-Error: PIM command %s does not support PIM_BOOL type\n", getName().c_str());
+    return false;
+  }
+  if (objDest.getDataType() != dataType) {
+    std::printf("PIM-Error: PIM command %s does not support mixed data type\n", getName().c_str());
+    return false;
+  }
+  if (m_precision != PIM_MATH_PRECISE && m_precision != PIM_MATH_FAST) {
+    std::printf("PIM-Error: Invalid math precision %d for PIM command %s\n", static_cast<int>(m_precision), getName().c_str());
+    return false;
+  }
+  if (pimUtils::isFP(dataType) ? m_numFracBits != 0 : m_numFracBits >= objSrc.getBitsPerElement(PimBitWidth::ACTUAL)) {
+    std::printf("PIM-Error: Invalid number of fractional bits %u of %s type for PIM command %s\n", m_numFracBits,
+                pimUtils::pimDataTypeEnumToStr(dataType).c_str(), getName().c_str());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Math
+bool
+pimCmdMath::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (obj id %d -> %d)\n", getName().c_str(), m_src, m_dest);
+  }
+
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    pimObjInfo &objSrc = m_device->getResMgr()->getObjInfo(m_src);
+    objSrc.syncFromSimulatedMem();
+  }
+
+  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  unsigned numRegions = objSrc.getRegions().size();
+  computeAllRegions(numRegions);
+
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    const pimObjInfo &objDest = m_device->getResMgr()->getObjInfo(m_dest);
+    objDest.syncToSimulatedMem();
+  }
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: Math - compute region
+//! Elements of a region are converted to FP32, computed in a batch, and converted back
+bool
+pimCmdMath::computeRegion(unsigned index)
+{
+  const pimObjInfo& objSrc = m_device->getResMgr()->getObjInfo(m_src);
+  pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  PimDataType dataType = objSrc.getDataType();
+  const pimRegion& srcRegion = objSrc.getRegions()[index];
+  uint64_t elemIdxBegin = srcRegion.getElemIdxBegin();
+  unsigned numElementsInRegion = srcRegion.getNumElemInRegion();
+  bool isFP = pimUtils::isFP(dataType);
+  bool isSigned = pimUtils::isSigned(dataType);
+  double scale = std::ldexp(1.0, static_cast<int>(m_numFracBits));
+
+  std::vector<float> vals(numElementsInRegion);
+  for (unsigned j = 0; j < numElementsInRegion; ++j) {
+    uint64_t bits = objSrc.getElementBits(elemIdxBegin + j);
+    if (isFP) {
+      vals[j] = pimUtils::castBitsToType<float>(bits);
+    } else if (isSigned) {
+      vals[j] = static_cast<float>(static_cast<double>(static_cast<int64_t>(pimUtils::signExt(bits, dataType))) / scale);
+    } else {
+      vals[j] = static_cast<float>(static_cast<double>(bits) / scale);
+    }
+  }
+
+  for (unsigned j = 0; j < numElementsInRegion; ++j) {
+    vals[j] = compute(m_cmdType, vals[j], m_precision);
+  }
+
+  // fixed-point results are rounded to nearest and saturated
+  unsigned numBits = objSrc.getBitsPerElement(PimBitWidth::ACTUAL);
+  double minVal = isSigned ? -std::ldexp(1.0, numBits - 1) : 0.0;
+  double maxVal = isSigned ? std::ldexp(1.0, numBits - 1) - 1.0 : std::ldexp(1.0, numBits) - 1.0;
+  for (unsigned j = 0; j < numElementsInRegion; ++j) {
+    uint64_t elemIdx = elemIdxBegin + j;
+    if (isFP) {
+      objDest.setElement(elemIdx, vals[j]);
+      continue;
+    }
+    double result = std::nearbyint(static_cast<double>(vals[j]) * scale);
+    if (std::isnan(result)) {
+      result = 0.0;
+    }
+    if (isSigned) {
+      int64_t intVal = 0;
+      if (result <= minVal) {
+        intVal = numBits == 64 ? INT64_MIN : static_cast<int64_t>(minVal);
+      } else if (result >= maxVal) {
+        intVal = numBits == 64 ? INT64_MAX : static_cast<int64_t>(maxVal);
+      } else {
+        intVal = static_cast<int64_t>(result);
+      }
+      objDest.setElement(elemIdx, intVal);
+    } else {
+      uint64_t uintVal = 0;
+      if (result >= maxVal) {
+        uintVal = numBits == 64 ? UINT64_MAX : static_cast<uint64_t>(maxVal);
+      } else if (result > 0.0) {
+        uintVal = static_cast<uint64_t>(result);
+      }
+      objDest.setElement(elemIdx, uintVal);
+    }
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: Math - update stats
+bool
+pimCmdMath::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objSrc = device->getResMgr()->getObjInfo(m_src);
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
+  PimDataType dataType = objSrc.getDataType();
+  bool isVLayout = objSrc.isVLayout();
+
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForMath(m_cmdType, objSrc, objDest, m_precision, m_numFracBits);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objSrc);
+  statsMgr->recordCoreBusyTime(objSrc, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  PIM CMD: GEMV/GEMM - sanity check
+bool
+pimCmdGemv::sanityCheck() const
+{
+  pimResMgr* resMgr = m_device->getResMgr();
+  if (!isValidObjId(resMgr, m_mat) || !isValidObjId(resMgr, m_dest)) {
+    return false;
+  }
+  const pimObjInfo& objMat = resMgr->getObjInfo(m_mat);
+  const pimObjInfo& objDest = resMgr->getObjInfo(m_dest);
+  if (objMat.isBuffer() || objDest.isBuffer()) {
+    std::printf("PIM-Error: PIM CMD %s does not support PIM buffers\n", getName().c_str());
+    return false;
+  }
+  if (!isCompatibleType(objMat, objDest)) {
+    return false;
+  }
+  if (objMat.getDataType() == PIM_BOOL) {
+    std::printf("PIM-Error: PIM CMD %s does not support bool data type\n", getName().c_str());
+    return false;
+  }
+  if (m_vec == nullptr) {
+    std::printf("PIM-Error: Invalid null host operand for PIM CMD %s\n", getName().c_str());
+    return false;
+  }
+  uint64_t numDestElements = objDest.getNumElements();
+  if (m_numVectors == 0 || numDestElements % m_numVectors != 0) {
+    std::printf("PIM-Error: Number of elements of object %d is not a multiple of %" PRIu64 " vectors for PIM CMD %s\n",
+                m_dest, m_numVectors, getName().c_str());
+    return false;
+  }
+  uint64_t numRows = numDestElements / m_numVectors;
+  if (objMat.getNumElements() % numRows != 0) {
+    std::printf("PIM-Error: Number of elements of matrix object %d is not a multiple of %" PRIu64 " rows for PIM CMD %s\n",
+                m_mat, numRows, getName().c_str());
+    return false;
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: GEMV/GEMM - decode the host operand once, so that all regions share the element bits
+//! Stream commands decode it at submission, as the caller may release the host operand before execution.
+void
+pimCmdGemv::readHostInputs()
+{
+  if (m_isHostInputRead || pimSim::get()->isAnalysisMode()) {
+    return;
+  }
+  const pimObjInfo& objMat = m_device->getResMgr()->getObjInfo(m_mat);
+  const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  uint64_t numCols = objMat.getNumElements() / (objDest.getNumElements() / m_numVectors);
+  pimDataHolder vecData(objMat.getDataType(), numCols * m_numVectors);
+  vecData.copyFromHost(const_cast<void*>(m_vec));
+  m_vecBits.resize(numCols * m_numVectors);
+  for (uint64_t i = 0; i < m_vecBits.size(); ++i) {
+    vecData.getElementBits(i, m_vecBits[i]);
+  }
+  m_isHostInputRead = true;
+}
+
+//! @brief  PIM CMD: GEMV/GEMM
+bool
+pimCmdGemv::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-Cmd: %s (obj id %d x host operand -> %d, %" PRIu64 " vectors)\n",
+                getName().c_str(), m_mat, m_dest, m_numVectors);
+  }
+
+  if (!sanityCheck()) {
+    return false;
+  }
+
+  pimObjInfo& objMat = m_device->getResMgr()->getObjInfo(m_mat);
+  const pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  m_numRows = objDest.getNumElements() / m_numVectors;
+  m_numCols = objMat.getNumElements() / m_numRows;
+  readHostInputs();
+
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objMat.syncFromSimulatedMem();
+  }
+
+  unsigned numRegions = objDest.getRegions().size();
+  computeAllRegions(numRegions);
+  m_vecBits.clear();
+
+  if (pimSim::get()->getDeviceType() != PIM_FUNCTIONAL) {
+    objDest.syncToSimulatedMem();
+  }
+
+  recordStats();
+  return true;
+}
+
+//! @brief  PIM CMD: GEMV/GEMM - compute a dest region with accumulation type T
+//! The region is processed in blocks of rows of one output vector, iterating matrix columns in the outer loop
+//! so that each matrix column and host operand element is read once per block.
+template <typename T> void
+pimCmdGemv::computeRegionTyped(unsigned index)
+{
+  const pimObjInfo& objMat = m_device->getResMgr()->getObjInfo(m_mat);
+  pimObjInfo& objDest = m_device->getResMgr()->getObjInfo(m_dest);
+  PimDataType dataType = objMat.getDataType();
+
+  auto toValue = [dataType](uint64_t bits) -> T {
+    if constexpr (std::is_floating_point_v<T>) {
+      return pimUtils::castBitsToType<float>(bits);
+    } else if constexpr (std::is_signed_v<T>) {
+      return pimUtils::signExt(bits, dataType);
+    } else {
+      return bits;
+    }
+  };
+
+  const pimRegion& destRegion = objDest.getRegions()[index];
+  uint64_t elemIdx = destRegion.getElemIdxBegin();
+  uint64_t elemIdxEnd = elemIdx + destRegion.getNumElemInRegion();
+  std::vector<T> acc;
+  while (elemIdx < elemIdxEnd) {
+    uint64_t vecIdx = elemIdx / m_numRows;
+    uint64_t rowBegin = elemIdx % m_numRows;
+    uint64_t numRowsInBlock = std::min(elemIdxEnd - elemIdx, m_numRows - rowBegin);
+    acc.assign(numRowsInBlock, 0);
+    for (uint64_t col = 0; col < m_numCols; ++col) {
+      T scalar = toValue(m_vecBits[vecIdx * m_numCols + col]);
+      uint64_t matIdx = col * m_numRows + rowBegin;
+      for (uint64_t i = 0; i < numRowsInBlock; ++i) {
+        acc[i] += toValue(objMat.getElementBits(matIdx + i)) * scalar;
+      }
+    }
+    for (uint64_t i = 0; i < numRowsInBlock; ++i) {
+      objDest.setElement(elemIdx + i, acc[i]);
+    }
+    elemIdx += numRowsInBlock;
+  }
+}
+
+//! @brief  PIM CMD: GEMV/GEMM - compute a dest region
+bool
+pimCmdGemv::computeRegion(unsigned index)
+{
+  PimDataType dataType = m_device->getResMgr()->getObjInfo(m_mat).getDataType();
+  if (pimUtils::isSigned(dataType)) {
+    computeRegionTyped<int64_t>(index);
+  } else if (pimUtils::isUnsigned(dataType)) {
+    computeRegionTyped<uint64_t>(index);
+  } else if (pimUtils::isFP(dataType)) {
+    computeRegionTyped<float>(index);
+  } else {
+    assert(0); // todo: data type
+  }
+  return true;
+}
+
+//! @brief  PIM CMD: GEMV/GEMM - update stats
+bool
+pimCmdGemv::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  const pimObjInfo& objMat = device->getResMgr()->getObjInfo(m_mat);
+  const pimObjInfo& objDest = device->getResMgr()->getObjInfo(m_dest);
+  PimDataType dataType = objMat.getDataType();
+  bool isVLayout = objMat.isVLayout();
+  uint64_t numCols = objMat.getNumElements() / (objDest.getNumElements() / m_numVectors);
+
+  pimeval::perfEnergy mPerfEnergy = device->getPerfEnergyModel()->getCachedPerfEnergyForGemv(m_cmdType, objMat, objDest, numCols);
+  // Matrix columns not co-located with dest are moved next to it first
+  mPerfEnergy += device->getPerfEnergyModel()->getPerfEnergyForGemvMoves(objMat, objDest, numCols);
+  statsMgr->recordCmd(getName(dataType, isVLayout), mPerfEnergy, &objDest);
+  statsMgr->recordCoreBusyTime(objDest, mPerfEnergy.m_msRuntime);
+  return true;
+}
+
+//! @brief  Pim CMD: BitSIMD-V: Read a row to SA
+bool
+pimCmdReadRowToSa::execute()
+{
+  if (m_debugCmds) {
+    std::printf("PIM-MicroOp: BitSIMD-V ReadRowToSa (obj id %d ofst %u)\n", m_objId, m_ofst);
+  }
+
+  // skip simulated memory access in analysis mode
+  if (pimSim::get()->isAnalysisMode()) {
+    return recordAnalysisModeStats(getName());
+  }
+
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& objSrc = resMgr->getObjInfo(m_objId);
   for (unsigned i = 0; i < objSrc.getRegions().size(); ++i) {
@@ -1613,6 +3198,11 @@ pimCmdWriteSaToRow::execute()
     std::printf("PIM-MicroOp: BitSIMD-V WriteSaToRow (obj id %d ofst %u)\n", m_objId, m_ofst);
   }
 
+  // skip simulated memory access in analysis mode
+  if (pimSim::get()->isAnalysisMode()) {
+    return recordAnalysisModeStats(getName());
+  }
+
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& objSrc = resMgr->getObjInfo(m_objId);
   for (unsigned i = 0; i < objSrc.getRegions().size(); ++i) {
@@ -1640,6 +3230,11 @@ pimCmdRRegOp::execute()
                 getName().c_str(), m_objId, m_dest, m_src1, m_src2, m_src3, m_val);
   }
 
+  // skip simulated memory access in analysis mode
+  if (pimSim::get()->isAnalysisMode()) {
+    return recordAnalysisModeStats(getName());
+  }
+
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& refObj = resMgr->getObjInfo(m_objId);
   for (unsigned i = 0; i < refObj.getRegions().size(); ++i) {
@@ -1744,6 +3339,11 @@ pimCmdRRegRotate::execute()
     std::printf("PIM-MicroOp: BitSIMD-V %s (obj-id %d src-reg %d)\n", getName().c_str(), m_objId, m_dest);
   }
 
+  // skip simulated memory access in analysis mode
+  if (pimSim::get()->isAnalysisMode()) {
+    return recordAnalysisModeStats(getName());
+  }
+
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& objSrc = resMgr->getObjInfo(m_objId);
   if (m_cmdType == PimCmdEnum::RREG_ROTATE_R) {  // Right Rotate
@@ -1800,6 +3400,11 @@ pimCmdAnalogAAP::execute()
     return false;
   }
 
+  // skip simulated memory access in analysis mode
+  if (pimSim::get()->isAnalysisMode()) {
+    return recordAnalysisModeStats(getName() + "@" + std::to_string(m_srcRows.size()) + "," + std::to_string(m_destRows.size()));
+  }
+
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& objSrc = resMgr->getObjInfo(m_srcRows[0].first);
 
@@ -1903,6 +3508,11 @@ pimCmdAnalogAPP::execute()
     std::printf("PIM-MicroOp: BitSIMD APP (obj id %d ofst %u)\n", rowIdx.first, rowIdx.second);
   }
 
+  // skip simulated memory access in analysis mode
+  if (pimSim::get()->isAnalysisMode()) {
+    return recordAnalysisModeStats(getName());
+  }
+
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& objSrc = resMgr->getObjInfo(rowIdx.first);
   bool isDCCN = objSrc.isDualContactRef();
@@ -1942,6 +3552,11 @@ pimCmdColGrpOP::execute()
     }
   }
 
+  // skip simulated memory access in analysis mode
+  if (pimSim::get()->isAnalysisMode()) {
+    return recordAnalysisModeStats(getName() + "@" + std::to_string(m_shift_num));
+  }
+
   pimResMgr* resMgr = m_device->getResMgr();
   const pimObjInfo& objSrc = resMgr->getObjInfo(m_objId);
   // PimDataType dataType = objSrc.getDataType();
@@ -2007,6 +3622,15 @@ template class pimCmdReduction<uint16_t>;
 template class pimCmdReduction<uint32_t>;
 template class pimCmdReduction<uint64_t>;
 template class pimCmdReduction<float>;
+template class pimCmdReductionSegmented<int8_t>;
+template class pimCmdReductionSegmented<int16_t>;
+template class pimCmdReductionSegmented<int32_t>;
+template class pimCmdReductionSegmented<int64_t>;
+template class pimCmdReductionSegmented<uint8_t>;
+template class pimCmdReductionSegmented<uint16_t>;
+template class pimCmdReductionSegmented<uint32_t>;
+template class pimCmdReductionSegmented<uint64_t>;
+template class pimCmdReductionSegmented<float>;
 
 template class pimCmdMAC<int8_t>;
 template class pimCmdMAC<int16_t>;
@@ -17,8 +17,11 @@
 #include <cassert>           // for assert
 #include <bitset>            // for bitset
 #include <variant>
+#include <memory>            // for unique_ptr
+#include <utility>           // for pair, move
 
 class pimDevice;
+class pimStatsMgr;
 
 
 enum class PimCmdEnum {
@@ -78,6 +81,10 @@ enum class PimCmdEnum {
   REDMIN_RANGE,
   REDMAX,
   REDMAX_RANGE,
+  REDSUM_SEGMENTED,
+  REDMIN_SEGMENTED,
+  REDMAX_SEGMENTED,
+  RED_BATCHED,
   BROADCAST,
   ROTATE_ELEM_R,
   ROTATE_ELEM_L,
@@ -87,6 +94,20 @@ enum class PimCmdEnum {
   AES_INVERSE_SBOX,
   PREFIX_SUM,
   MAC,
+  GEMV,
+  GEMM,
+  AND_POPCOUNT_BATCHED,
+  GATHER,
+  SCATTER,
+  SCATTER_ADD,
+  COMPACT,
+  TOPK,
+  EXP,
+  LOG,
+  SQRT,
+  RECIP,
+  SIGMOID,
+  TANH,
 
   // BitSIMD v-layout commands
   ROW_R,
@@ -126,6 +147,16 @@ public:
 
   void setDevice(pimDevice* device) { m_device = device; }
   virtual bool execute() = 0;
+  virtual bool sanityCheck() const { return false; }
+  PimCmdEnum getCmdType() const { return m_cmdType; }
+  // Stream commands are modeled at submission, so their execution skips updating stats
+  void setSkipStats(bool val) { m_skipStats = val; }
+  //! @brief  Whether perf modeling depends on values computed during execution, e.g., data-aware ratio
+  virtual bool isDataDependentStats() const { return false; }
+  //! @brief  PIM objects read or written by this command, which wait for pending async copies of them
+  virtual std::vector<PimObjId> getObjIds() const { return {}; }
+  //! @brief  Read host inputs in the calling thread, before the command is submitted to a non-default stream
+  virtual void readHostInputs() {}
 
   std::string getName() const {
     return getName(m_cmdType, "");
@@ -137,6 +168,9 @@ public:
   }
   static std::string getName(PimCmdEnum cmdType, const std::string& suffix);
 
+  //! @brief  Model performance and energy of this command on a device and record them into a stats manager
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const { return false; }
+
 protected:
   bool isValidObjId(pimResMgr* resMgr, PimObjId objId) const;
   bool isAssociated(const pimObjInfo& obj1, const pimObjInfo& obj2) const;
@@ -144,10 +178,11 @@ protected:
   bool isConvertibleType(const pimObjInfo& src, const pimObjInfo& dest) const;
 
   unsigned getNumElementsInRegion(const pimRegion& region, unsigned bitsPerElement) const;
+  bool recordStats() const;
+  bool recordAnalysisModeStats(const std::string& cmdName) const;
+  double getDataAwareRatio(const pimObjInfo& objSrc1, const pimObjInfo* objSrc2, uint64_t scalarValue) const;
 
-  virtual bool sanityCheck() const { return false; }
   virtual bool computeRegion(unsigned index) { return false; }
-  virtual bool updateStats() const { return false; }
   bool computeAllRegions(unsigned numRegions);
 
   //! @brief  Utility: Get bits of an element from a region. The bits are stored as uint64_t without sign extension
@@ -169,6 +204,8 @@ protected:
   PimCmdEnum m_cmdType;
   pimDevice* m_device = nullptr;
   bool m_debugCmds;
+  bool m_skipStats = false;
+  double m_dataAwareRatio = -1.0;  // ratio of bit-serial steps needed by actual data, negative if not modeled
 
   //! @class  pimCmd::regionWorker
   //! @brief  Thread worker to process regions in parallel
@@ -198,9 +235,15 @@ public:
     : pimCmd(PimCmdEnum::COPY_D2D), m_copyType(copyType), m_src(src), m_dest(dest), m_idxBegin(idxBegin), m_idxEnd(idxEnd), m_copyFullRange(idxEnd == 0ULL) {}
 
   virtual ~pimCmdCopy() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src, m_dest}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+
+  // Async copies run copyData on a background thread with object info resolved in the calling thread
+  void setAsyncHandle(PimCopyHandle handle) { m_asyncHandle = handle; }
+  void getObjInfo(pimObjInfo*& objSrc, pimObjInfo*& objDest) const;
+  bool copyData(pimObjInfo* objSrc, pimObjInfo* objDest) const;
 protected:
   PimCopyEnum m_copyType;
   void* m_ptr = nullptr;
@@ -209,6 +252,7 @@ protected:
   uint64_t m_idxBegin = 0;
   uint64_t m_idxEnd = 0; 
   bool m_copyFullRange = false;
+  PimCopyHandle m_asyncHandle = -1;
 };
 
 //! @class  pimCmdFunc1
@@ -221,10 +265,12 @@ public:
   pimCmdFunc1(PimCmdEnum cmdType, PimObjId src, PimObjId dest, const std::vector<uint8_t>& lut)
     : pimCmd(cmdType), m_src(src), m_dest(dest), m_lut(lut) {}
   virtual ~pimCmdFunc1() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src, m_dest}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+  virtual bool isDataDependentStats() const override;
 protected:
   PimObjId m_src;
   PimObjId m_dest;
@@ -259,6 +305,8 @@ private:
     case PimCmdEnum::MAX_SCALAR: result = std::max(operand, scalarValue); break;
     case PimCmdEnum::POPCOUNT:
         switch (bitsPerElementSrc) {
+        case 2: result = std::bitset<2>(operand).count(); break;
+        case 4: result = std::bitset<4>(operand).count(); break;
         case 8: result = std::bitset<8>(operand).count(); break;
         case 16: result = std::bitset<16>(operand).count(); break;
         case 32: result = std::bitset<32>(operand).count(); break;
@@ -351,10 +399,12 @@ public:
   pimCmdFunc2(PimCmdEnum cmdType, PimObjId src1, PimObjId src2, PimObjId dest, uint64_t scalarValue)
     : pimCmd(cmdType), m_src1(src1), m_src2(src2), m_dest(dest), m_scalarValue(scalarValue) {}
   virtual ~pimCmdFunc2() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src1, m_src2, m_dest}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+  virtual bool isDataDependentStats() const override;
 protected:
   PimObjId m_src1;
   PimObjId m_src2;
@@ -456,10 +506,11 @@ public:
     assert(cmdType == PimCmdEnum::COND_SELECT_SCALAR);
   }
   virtual ~pimCmdCond() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_condBool, m_src1, m_src2, m_dest}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
 protected:
   PimObjId m_condBool;
   PimObjId m_src1 = -1;
@@ -468,34 +519,274 @@ protected:
   PimObjId m_dest;
 };
 
+//! @class  pimCmdReductionBase
+//! @brief  Pim CMD: Reduction non-ranged/ranged, independent of the result type
+//! A reduction walks all regions of the source object in three steps: initialize per-region results,
+//! compute each region, then merge per-region results into the host result.
+class pimCmdReductionBase : public pimCmd
+{
+public:
+  pimCmdReductionBase(PimCmdEnum cmdType, PimObjId src, uint64_t idxBegin, uint64_t idxEnd)
+    : pimCmd(cmdType), m_src(src), m_idxBegin(idxBegin)
+  {
+    assert(cmdType == PimCmdEnum::REDSUM || cmdType == PimCmdEnum::REDMIN || cmdType == PimCmdEnum::REDMAX || cmdType == PimCmdEnum::REDSUM_RANGE || cmdType == PimCmdEnum::REDMIN_RANGE || cmdType == PimCmdEnum::REDMAX_RANGE);
+    if (idxEnd) m_idxEnd = idxEnd;
+  }
+  virtual ~pimCmdReductionBase() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src}; }
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+
+  PimObjId getSrc() const { return m_src; }
+  unsigned getNumPass(const pimObjInfo& objSrc) const;
+  virtual void initRegionResults(unsigned numRegions) = 0;
+  virtual bool computeRegion(unsigned index) override = 0;
+  virtual void mergeRegionResults() = 0;
+protected:
+  PimObjId m_src;
+  uint64_t m_idxBegin = 0;
+  uint64_t m_idxEnd = std::numeric_limits<uint64_t>::max();
+};
+
 //! @class  pimCmdReduction
 //! @brief  Pim CMD: Reduction non-ranged/ranged
 template <typename T>
-class pimCmdReduction : public pimCmd
+class pimCmdReduction : public pimCmdReductionBase
 {
 public:
   pimCmdReduction(PimCmdEnum cmdType, PimObjId src, void* result)
-    : pimCmd(cmdType), m_src(src), m_result(result)
+    : pimCmdReductionBase(cmdType, src, 0, 0), m_result(result)
   {
     assert(cmdType == PimCmdEnum::REDSUM || cmdType == PimCmdEnum::REDMIN || cmdType == PimCmdEnum::REDMAX);
   }
   pimCmdReduction(PimCmdEnum cmdType, PimObjId src, void* result, uint64_t idxBegin, uint64_t idxEnd)
-    : pimCmd(cmdType), m_src(src), m_result(result), m_idxBegin(idxBegin)
+    : pimCmdReductionBase(cmdType, src, idxBegin, idxEnd), m_result(result)
   {
-    assert(cmdType == PimCmdEnum::REDSUM || cmdType == PimCmdEnum::REDMIN || cmdType == PimCmdEnum::REDMAX || cmdType == PimCmdEnum::REDSUM_RANGE || cmdType == PimCmdEnum::REDMIN_RANGE || cmdType == PimCmdEnum::REDMAX_RANGE);
-    if (idxEnd) m_idxEnd = idxEnd;
   }
   virtual ~pimCmdReduction() {}
+  virtual void initRegionResults(unsigned numRegions) override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual void mergeRegionResults() override;
+protected:
+  void* m_result;
+  std::vector<T> m_regionResult;
+};
+
+//! @class  pimCmdReductionBatched
+//! @brief  Pim CMD: Reductions of a number of associated objects in one walk over their shared regions
+class pimCmdReductionBatched : public pimCmd
+{
+public:
+  pimCmdReductionBatched(std::vector<std::unique_ptr<pimCmdReductionBase>> reductions)
+    : pimCmd(PimCmdEnum::RED_BATCHED), m_reductions(std::move(reductions)) {}
+  virtual ~pimCmdReductionBatched() {}
+  virtual std::vector<PimObjId> getObjIds() const override {
+    std::vector<PimObjId> objIds;
+    for (const auto& reduction : m_reductions) {
+      objIds.push_back(reduction->getObjIds().front());
+    }
+    return objIds;
+  }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
 protected:
+  std::vector<std::unique_ptr<pimCmdReductionBase>> m_reductions;
+};
+
+//! @class  pimCmdReductionSegmented
+//! @brief  Pim CMD: Segmented reduction with one result per segment, in one pass over all regions
+template <typename T>
+class pimCmdReductionSegmented : public pimCmd
+{
+public:
+  pimCmdReductionSegmented(PimCmdEnum cmdType, PimObjId src, void* results, std::vector<uint64_t> offsets)
+    : pimCmd(cmdType), m_src(src), m_results(results), m_offsets(std::move(offsets))
+  {
+    assert(cmdType == PimCmdEnum::REDSUM_SEGMENTED || cmdType == PimCmdEnum::REDMIN_SEGMENTED || cmdType == PimCmdEnum::REDMAX_SEGMENTED);
+  }
+  virtual ~pimCmdReductionSegmented() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src}; }
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+protected:
+  T getIdentity() const;
+  T reduce(T lhs, T rhs) const;
+
   PimObjId m_src;
-  void* m_result;
-  std::vector<T> m_regionResult;
-  uint64_t m_idxBegin = 0;
-  uint64_t m_idxEnd = std::numeric_limits<uint64_t>::max();
+  void* m_results;
+  std::vector<uint64_t> m_offsets; // segment i covers [m_offsets[i], m_offsets[i + 1])
+  std::vector<std::vector<std::pair<uint64_t, T>>> m_regionResults; // per region: segment index and partial result
+};
+
+//! @class  pimCmdAndPopCountBatched
+//! @brief  Pim CMD: Count common set bits of many pairs of bitmap rows of one PIM object
+//! Row r of the bitmap object covers elements [r * numWordsPerRow, (r + 1) * numWordsPerRow).
+class pimCmdAndPopCountBatched : public pimCmd
+{
+public:
+  pimCmdAndPopCountBatched(PimCmdEnum cmdType, PimObjId bitmaps, uint64_t numWordsPerRow,
+                           std::vector<uint64_t> rowsA, std::vector<uint64_t> rowsB, uint64_t* counts)
+    : pimCmd(cmdType), m_bitmaps(bitmaps), m_numWordsPerRow(numWordsPerRow),
+      m_rowsA(std::move(rowsA)), m_rowsB(std::move(rowsB)), m_counts(counts)
+  {
+    assert(cmdType == PimCmdEnum::AND_POPCOUNT_BATCHED);
+  }
+  virtual ~pimCmdAndPopCountBatched() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_bitmaps}; }
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+protected:
+  static constexpr uint64_t NUM_PAIRS_PER_CHUNK = 1024; // pairs per thread pool work item
+
+  PimObjId m_bitmaps;
+  uint64_t m_numWordsPerRow;
+  std::vector<uint64_t> m_rowsA;
+  std::vector<uint64_t> m_rowsB;
+  uint64_t* m_counts;
+};
+
+//! @class  pimCmdGatherScatter
+//! @brief  Pim CMD: Indexed element access through an integer index object
+//! Gather: dest[i] = src[index[i]], where index is associated with dest.
+//! Scatter: dest[index[i]] = src[i], where index is associated with src. With repeated indices, the
+//! largest i wins. Scatter-add: dest[index[i]] += src[i], accumulated in increasing order of i.
+class pimCmdGatherScatter : public pimCmd
+{
+public:
+  pimCmdGatherScatter(PimCmdEnum cmdType, PimObjId src, PimObjId index, PimObjId dest)
+    : pimCmd(cmdType), m_src(src), m_index(index), m_dest(dest)
+  {
+    assert(cmdType == PimCmdEnum::GATHER || cmdType == PimCmdEnum::SCATTER || cmdType == PimCmdEnum::SCATTER_ADD);
+  }
+  virtual ~pimCmdGatherScatter() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src, m_index, m_dest}; }
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+protected:
+  bool readIndices();
+
+  PimObjId m_src;
+  PimObjId m_index;
+  PimObjId m_dest;
+  std::vector<uint64_t> m_indices;     // gather: src element of each dest element
+  std::vector<uint64_t> m_srcOffsets;  // scatter: sources of dest element j are m_srcOrder[m_srcOffsets[j], m_srcOffsets[j + 1])
+  std::vector<uint64_t> m_srcOrder;    // scatter: src elements sorted by dest element, in increasing order within each
+};
+
+//! @class  pimCmdCompact
+//! @brief  Pim CMD: Stream compaction of elements selected by a bool condition object
+//! Selected src elements are densely packed into dest in element order, and the number of selected
+//! elements is returned to host. dest elements beyond the count are unchanged.
+class pimCmdCompact : public pimCmd
+{
+public:
+  pimCmdCompact(PimCmdEnum cmdType, PimObjId src, PimObjId cond, PimObjId dest, uint64_t* count)
+    : pimCmd(cmdType), m_src(src), m_cond(cond), m_dest(dest), m_count(count)
+  {
+    assert(cmdType == PimCmdEnum::COMPACT);
+  }
+  virtual ~pimCmdCompact() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src, m_cond, m_dest}; }
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+  virtual bool isDataDependentStats() const override { return true; }
+protected:
+  static constexpr uint64_t NUM_ELEMENTS_PER_CHUNK = 65536; // elements per thread pool work item
+
+  PimObjId m_src;
+  PimObjId m_cond;
+  PimObjId m_dest;
+  uint64_t* m_count;
+  bool m_isCountPhase = true;
+  std::vector<uint64_t> m_chunkOffsets; // number of selected elements per chunk, then exclusive prefix sum
+  uint64_t m_numSelected = 0;
+};
+
+//! @class  pimCmdTopK
+//! @brief  Pim CMD: Select k largest or smallest elements with their indices
+//! Each region selects its own k candidates, which are then merged. Results are ordered from the best,
+//! and ties are broken by lower element index.
+class pimCmdTopK : public pimCmd
+{
+public:
+  pimCmdTopK(PimCmdEnum cmdType, PimObjId src, uint64_t k, void* outValues, uint64_t* outIndices, bool isSmallest)
+    : pimCmd(cmdType), m_src(src), m_k(k), m_outValues(outValues), m_outIndices(outIndices), m_isSmallest(isSmallest)
+  {
+    assert(cmdType == PimCmdEnum::TOPK);
+  }
+  virtual ~pimCmdTopK() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src}; }
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+protected:
+  template <typename T> void selectTopK(std::vector<uint64_t>& indices) const;
+
+  PimObjId m_src;
+  uint64_t m_k;
+  void* m_outValues;
+  uint64_t* m_outIndices;
+  bool m_isSmallest;
+  std::vector<std::vector<uint64_t>> m_regionResults; // per region: indices of its k candidates
+};
+
+//! @class  pimCmdMath
+//! @brief  Pim CMD: Elementwise math approximations, i.e., exp, log, sqrt, reciprocal, sigmoid and tanh
+//! Functional results follow the same polynomial and Newton iteration steps as the micro-ops in perf models.
+//! Integer types are fixed-point numbers with m_numFracBits fractional bits.
+class pimCmdMath : public pimCmd
+{
+public:
+  //! @brief  Number of PIM micro-ops of an approximation, with scalar adds counted as adds
+  struct microOps {
+    unsigned m_numMul = 0;
+    unsigned m_numAdd = 0;
+    unsigned m_numDiv = 0;
+    unsigned m_numMulScalar = 0;
+    microOps& operator+=(const microOps& rhs);
+  };
+
+  pimCmdMath(PimCmdEnum cmdType, PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+    : pimCmd(cmdType), m_src(src), m_dest(dest), m_precision(precision), m_numFracBits(numFracBits)
+  {
+    assert(cmdType == PimCmdEnum::EXP || cmdType == PimCmdEnum::LOG || cmdType == PimCmdEnum::SQRT ||
+           cmdType == PimCmdEnum::RECIP || cmdType == PimCmdEnum::SIGMOID || cmdType == PimCmdEnum::TANH);
+  }
+  virtual ~pimCmdMath() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src, m_dest}; }
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+
+  static microOps getMicroOps(PimCmdEnum cmdType, PimMathPrecision precision);
+  static float compute(PimCmdEnum cmdType, float val, PimMathPrecision precision);
+
+protected:
+  static unsigned getNumTerms(PimCmdEnum cmdType, PimMathPrecision precision);
+  static float approxExp(float val, PimMathPrecision precision);
+  static float approxLog(float val, PimMathPrecision precision);
+  static float approxSqrt(float val, PimMathPrecision precision);
+  static float approxRecip(float val, PimMathPrecision precision);
+  static float approxSigmoid(float val, PimMathPrecision precision);
+  static float approxTanh(float val, PimMathPrecision precision);
+
+  PimObjId m_src;
+  PimObjId m_dest;
+  PimMathPrecision m_precision;
+  unsigned m_numFracBits;
 };
 
 //! @class  pimCmdPrefixSum
@@ -509,10 +800,11 @@ public:
     assert(cmdType == PimCmdEnum::PREFIX_SUM);
   }
   virtual ~pimCmdPrefixSum() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src, m_dst}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
 protected:
   PimObjId m_src, m_dst;
 };
@@ -529,16 +821,49 @@ public:
     assert(cmdType == PimCmdEnum::MAC);
   }
   virtual ~pimCmdMAC() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src1, m_src2}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
 protected:
   std::vector<T> m_regionResult;
   PimObjId m_src1, m_src2;
   void* m_dest; // Pointer to the destination buffer where MAC results will be stored
 };
 
+//! @class  pimCmdGemv
+//! @brief  Pim CMD: Matrix-vector and matrix-matrix multiplication with a host operand
+//! The PIM matrix A of M x K elements is stored column-major, i.e., element (i, j) is at index j * M + i.
+//! The host operand holds numVectors column-major vectors of K elements, and dest holds M x numVectors results.
+class pimCmdGemv : public pimCmd
+{
+public:
+  pimCmdGemv(PimCmdEnum cmdType, PimObjId mat, const void* vec, PimObjId dest, uint64_t numVectors)
+    : pimCmd(cmdType), m_mat(mat), m_vec(vec), m_dest(dest), m_numVectors(numVectors)
+  {
+    assert(cmdType == PimCmdEnum::GEMV || cmdType == PimCmdEnum::GEMM);
+  }
+  virtual ~pimCmdGemv() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_mat, m_dest}; }
+  virtual void readHostInputs() override;
+  virtual bool execute() override;
+  virtual bool sanityCheck() const override;
+  virtual bool computeRegion(unsigned index) override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
+protected:
+  template <typename T> void computeRegionTyped(unsigned index);
+
+  PimObjId m_mat;
+  const void* m_vec; // host operand, only accessed by readHostInputs
+  PimObjId m_dest;
+  uint64_t m_numVectors;
+  uint64_t m_numRows = 0;
+  uint64_t m_numCols = 0;
+  std::vector<uint64_t> m_vecBits; // host operand as element bits of the matrix data type
+  bool m_isHostInputRead = false;
+};
+
 
 //! @class  pimCmdBroadcast
 //! @brief  Pim CMD: Broadcast a value to all elements
@@ -551,10 +876,11 @@ public:
     assert(cmdType == PimCmdEnum::BROADCAST);
   }
   virtual ~pimCmdBroadcast() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_dest}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
 protected:
   PimObjId m_dest;
   uint64_t m_signExtBits;
@@ -572,10 +898,11 @@ public:
            cmdType == PimCmdEnum::SHIFT_ELEM_R || cmdType == PimCmdEnum::SHIFT_ELEM_L);
   }
   virtual ~pimCmdRotate() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_src}; }
   virtual bool execute() override;
   virtual bool sanityCheck() const override;
   virtual bool computeRegion(unsigned index) override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
 protected:
   PimObjId m_src;
   std::vector<uint64_t> m_regionBoundary;
@@ -589,6 +916,7 @@ public:
   pimCmdReadRowToSa(PimCmdEnum cmdType, PimObjId objId, unsigned ofst)
     : pimCmd(cmdType), m_objId(objId), m_ofst(ofst) {}
   virtual ~pimCmdReadRowToSa() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_objId}; }
   virtual bool execute() override;
 protected:
   PimObjId m_objId;
@@ -603,6 +931,7 @@ public:
   pimCmdWriteSaToRow(PimCmdEnum cmdType, PimObjId objId, unsigned ofst)
     : pimCmd(cmdType), m_objId(objId), m_ofst(ofst) {}
   virtual ~pimCmdWriteSaToRow() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_objId}; }
   virtual bool execute() override;
 protected:
   PimObjId m_objId;
@@ -634,6 +963,7 @@ public:
     assert(cmdType == PimCmdEnum::RREG_MAJ || cmdType == PimCmdEnum::RREG_SEL);
   }
   virtual ~pimCmdRRegOp() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_objId}; }
   virtual bool execute() override;
 protected:
   PimObjId m_objId;
@@ -652,6 +982,7 @@ public:
   pimCmdRRegRotate(PimCmdEnum cmdType, PimObjId objId, PimRowReg dest)
     : pimCmd(cmdType), m_objId(objId), m_dest(dest) {}
   virtual ~pimCmdRRegRotate() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_objId}; }
   virtual bool execute() override;
 protected:
   PimObjId m_objId;
@@ -699,6 +1030,7 @@ public:
   pimCmdColGrpOP(PimCmdEnum cmdType, PimObjId objId, unsigned shift_num)
     : pimCmd(cmdType), m_objId(objId), m_shift_num(shift_num) {}
   virtual ~pimCmdColGrpOP() {}
+  virtual std::vector<PimObjId> getObjIds() const override { return {m_objId}; }
   virtual bool execute() override;
 protected:
   PimObjId m_objId;
@@ -5,6 +5,7 @@
 // See the LICENSE file in the root of this repository for more details.
 
 #include "pimCmdFuse.h"
+#include "pimSim.h"
 #include <cstdio>
 
 
@@ -28,13 +29,13 @@ pimCmdFuse::execute()
   }
 
   // Analyze API fusion opportunities
-  success = success && updateStats();
+  success = success && recordStats();
   return success;
 }
 
 //! @brief  Pim CMD: PIM API Fusion - update stats
 bool
-pimCmdFuse::updateStats() const
+pimCmdFuse::updateStats(pimDevice* device, pimStatsMgr* statsMgr) const
 {
   // TODO: Parse m_prog and update stats
   return true;
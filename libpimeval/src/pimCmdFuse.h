@@ -19,7 +19,7 @@ public:
   pimCmdFuse(PimProg prog) : pimCmd(PimCmdEnum::NOOP), m_prog(prog) {}
   virtual ~pimCmdFuse() {}
   virtual bool execute() override;
-  virtual bool updateStats() const override;
+  virtual bool updateStats(pimDevice* device, pimStatsMgr* statsMgr) const override;
 private:
   PimProg m_prog;
 };
@@ -7,17 +7,20 @@
 #include "pimDevice.h"
 #include "pimResMgr.h"
 #include "pimSim.h"
+#include "pimSweep.h"
 #include "libpimeval.h"
 #include "pimUtils.h"
 #include <cstdio>
 #include <memory>
 #include <cassert>
 #include <string>
+#include <algorithm>
 
 
 //! @brief  pimDevice ctor
-pimDevice::pimDevice(const pimSimConfig& config)
-  : m_config(config)
+pimDevice::pimDevice(const pimSimConfig& config, const pimParamsDram& paramsDram)
+  : m_config(config),
+    m_paramsDram(paramsDram)
 {
   init();
 }
@@ -25,6 +28,8 @@ pimDevice::pimDevice(const pimSimConfig& config)
 //! @brief  pimDevice dtor
 pimDevice::~pimDevice()
 {
+  m_streams.clear();
+  finishAsyncCopies();
 }
 
 //! @brief  Adjust config for modeling different simulation target with same inputs
@@ -107,6 +112,9 @@ pimDevice::init()
   unsigned bufferSize = getOnChipBufferSize();
   if (adjustConfigForSimTarget(numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols)) {
     m_numCores = numRanks * numBankPerRank * numSubarrayPerBank;
+    m_numCoreRanks = numRanks;
+    m_numCoreBankPerRank = numBankPerRank;
+    m_numCoreSubarrayPerBank = numSubarrayPerBank;
     m_numRows = numRows;
     m_numCols = numCols;
     m_bufferSize = bufferSize;
@@ -115,16 +123,12 @@ pimDevice::init()
   }
 
 #ifdef DRAMSIM3_INTEG
-  std::string configFile = m_config.getSimConfigFile();
-  //TODO: DRAMSim3 requires an output directory but for our purpose we do not need it so sending empty string
-  m_deviceMemory = new dramsim3::PIMCPU(configFile, "");
-  m_deviceMemoryConfig = m_deviceMemory->getMemorySystem()->getConfig();
-  u_int64_t rowsPerBank = m_deviceMemoryConfig->rows, columnPerRow = m_deviceMemoryConfig->columns * m_deviceMemoryConfig->device_width;
-
-  // todo: adjust for sim target
-  m_numCores = 16;
-  m_numRows = rowsPerBank/m_numCores;
-  m_numCols = columnPerRow;
+  // Cross-validate analytical perf models with cycle-level DRAMsim3 on the same memory config
+  if (!m_config.getMemConfigFile().empty()) {
+    m_dramSim3 = std::make_unique<pimDramSim3>(m_config.getMemConfigFile(), m_paramsDram, m_numCoreSubarrayPerBank, m_numRows);
+  } else {
+    std::printf("PIM-Warning: DRAMsim3 bridge requires a memory config file\n");
+  }
 #endif
 
   m_isValid = (m_numCores > 0 && m_numRows > 0 && m_numCols > 0);
@@ -138,12 +142,11 @@ pimDevice::init()
   }
 
   m_resMgr = std::make_unique<pimResMgr>(this);
-  const pimParamsDram& paramsDram = pimSim::get()->getParamsDram(); // created before pimDevice ctor
-  pimPerfEnergyModelParams params(getSimTarget(), getNumRanks(), paramsDram);
+  pimPerfEnergyModelParams params(getSimTarget(), getNumRanks(), getNumBankPerRank(), m_paramsDram);
   m_perfEnergyModel = pimPerfEnergyFactory::createPerfEnergyModel(params);
 
-  // Disable simulated memory creation for functional simulation
-  if (getDeviceType() != PIM_FUNCTIONAL) {
+  // Disable simulated memory creation for functional simulation and analysis mode
+  if (getDeviceType() != PIM_FUNCTIONAL && !m_config.isAnalysisMode()) {
     m_cores.resize(m_numCores, pimCore(m_numRows, m_numCols));
   }
 
@@ -164,6 +167,8 @@ pimDevice::init()
 PimObjId
 pimDevice::pimAlloc(PimAllocEnum allocType, uint64_t numElements, PimDataType dataType)
 {
+  synchronizeStreams();
+  PimAllocEnum requestedAllocType = allocType;
   if (allocType == PIM_ALLOC_AUTO) {
     if (isVLayoutDevice()) {
       allocType = PIM_ALLOC_V;
@@ -173,46 +178,77 @@ pimDevice::pimAlloc(PimAllocEnum allocType, uint64_t numElements, PimDataType da
       assert(0);
     }
   }
-  return m_resMgr->pimAlloc(allocType, numElements, dataType);
+  PimObjId objId = m_resMgr->pimAlloc(allocType, numElements, dataType);
+  if (m_cmdStream && objId != -1) {
+    // keep auto allocation type, as the layout is decided by the replaying device
+    m_cmdStream->recordAlloc(objId, requestedAllocType, numElements, dataType);
+  }
+  return objId;
 }
 
  //! @brief  Allocate a PIM buffer
 PimObjId
 pimDevice::pimAllocBuffer(uint32_t numElements, PimDataType dataType)
 {
+  synchronizeStreams();
   if (getSimTarget() != PIM_DEVICE_AIM) {
     std::printf("PIM-Error: Device does not support On-Chip Buffer\n");
     return -1;
   }
-  return m_resMgr->pimAllocBuffer(numElements, dataType);
+  PimObjId objId = m_resMgr->pimAllocBuffer(numElements, dataType);
+  if (m_cmdStream && objId != -1) {
+    m_cmdStream->recordAllocBuffer(objId, numElements, dataType);
+  }
+  return objId;
 }
 
 //! @brief  Allocate a PIM object associated with another PIM object
 PimObjId
 pimDevice::pimAllocAssociated(PimObjId assocId, PimDataType dataType)
 {
-  return m_resMgr->pimAllocAssociated(assocId, dataType);
+  synchronizeStreams();
+  PimObjId objId = m_resMgr->pimAllocAssociated(assocId, dataType);
+  if (m_cmdStream && objId != -1) {
+    m_cmdStream->recordAllocAssociated(objId, assocId, dataType);
+  }
+  return objId;
 }
 
 //! @brief  Free a PIM object
 bool
 pimDevice::pimFree(PimObjId obj)
 {
-  return m_resMgr->pimFree(obj);
+  synchronizeStreams();
+  finishAsyncCopies();
+  bool ok = m_resMgr->pimFree(obj);
+  if (m_cmdStream && ok) {
+    m_cmdStream->recordFree(obj);
+  }
+  return ok;
 }
 
 //! @brief  Create an obj referencing to a range of an existing obj
 PimObjId
 pimDevice::pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd)
 {
-  return m_resMgr->pimCreateRangedRef(refId, idxBegin, idxEnd);
+  synchronizeStreams();
+  PimObjId objId = m_resMgr->pimCreateRangedRef(refId, idxBegin, idxEnd);
+  if (m_cmdStream && objId != -1) {
+    m_cmdStream->recordCreateRangedRef(objId, refId, idxBegin, idxEnd);
+  }
+  return objId;
 }
 
 //! @brief  Create an obj referencing to negation of an existing obj based on dual-contact memory cells
 PimObjId
 pimDevice::pimCreateDualContactRef(PimObjId refId)
 {
-  return m_resMgr->pimCreateDualContactRef(refId);
+  synchronizeStreams();
+  PimObjId objId = m_resMgr->pimCreateDualContactRef(refId);
+  if (m_cmdStream && objId != -1) {
+    m_cmdStream->recordCreateDualContactRef(objId, refId);
+  }
+  return objId;
 }
 
 //! @brief  Copy data from host to PIM within a range
@@ -260,13 +296,304 @@ pimDevice::pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin,
   return executeCmd(std::move(cmd));
 }
 
+//! @brief  Copy data from host to PIM within a range asynchronously
+PimCopyHandle
+pimDevice::pimCopyMainToDeviceAsync(void* src, PimObjId dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  PimCopyEnum copyType = m_resMgr->isHLayoutObj(dest) ? PIM_COPY_H : PIM_COPY_V;
+  return executeCopyAsync(std::make_unique<pimCmdCopy>(PimCmdEnum::COPY_H2D, copyType, src, dest, idxBegin, idxEnd));
+}
+
+//! @brief  Copy data from PIM to host within a range asynchronously
+PimCopyHandle
+pimDevice::pimCopyDeviceToMainAsync(PimObjId src, void* dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  PimCopyEnum copyType = m_resMgr->isHLayoutObj(src) ? PIM_COPY_H : PIM_COPY_V;
+  return executeCopyAsync(std::make_unique<pimCmdCopy>(PimCmdEnum::COPY_D2H, copyType, src, dest, idxBegin, idxEnd));
+}
+
+//! @brief  Wait for an async copy to finish
+bool
+pimDevice::pimWait(PimCopyHandle handle)
+{
+  bool ok = false;
+  auto it = m_asyncCopies.find(handle);
+  auto itFinished = m_finishedAsyncCopies.find(handle);
+  if (it != m_asyncCopies.end()) {
+    ok = it->second.m_result.get();
+    m_asyncCopies.erase(it);
+  } else if (itFinished != m_finishedAsyncCopies.end()) {
+    ok = itFinished->second;
+    m_finishedAsyncCopies.erase(itFinished);
+  } else {
+    std::printf("PIM-Error: Invalid async copy handle %d\n", handle);
+    return false;
+  }
+  pimSim::get()->getStatsMgr()->recordAsyncCopyWait(handle);
+  return ok;
+}
+
+//! @brief  Execute a data copy command on a background thread
+//! Sanity check, object lookup and perf modeling happen in the calling thread
+PimCopyHandle
+pimDevice::executeCopyAsync(std::unique_ptr<pimCmdCopy> cmd)
+{
+  synchronizeStreams();
+  cmd->setDevice(this);
+  if (!cmd->sanityCheck()) {
+    return -1;
+  }
+  PimCopyHandle handle = m_nextAsyncHandle++;
+  cmd->setAsyncHandle(handle);
+  pimObjInfo* objSrc = nullptr;
+  pimObjInfo* objDest = nullptr;
+  cmd->getObjInfo(objSrc, objDest);
+  std::vector<PimObjId> objIds = getBaseObjIds(*cmd);
+  cmd->updateStats(this, pimSim::get()->getStatsMgr());
+  if (m_cmdStream) {
+    m_cmdStream->recordCmd(std::make_unique<pimCmdCopy>(*cmd));
+  }
+
+  std::shared_ptr<pimCmdCopy> copyCmd(std::move(cmd));
+  std::shared_future<bool> prevCopy = m_lastAsyncCopy;
+  m_lastAsyncCopy = std::async(std::launch::async, [copyCmd, objSrc, objDest, prevCopy]() {
+    if (prevCopy.valid()) {
+      prevCopy.wait();
+    }
+    return copyCmd->copyData(objSrc, objDest);
+  }).share();
+  m_asyncCopies[handle] = { m_lastAsyncCopy, objIds };
+  return handle;
+}
+
+//! @brief  Finish all async copies functionally before touching PIM data in the calling thread
+//! This keeps functional simulation safe without pimWait, while modeled overlap is tracked by stats
+void
+pimDevice::finishAsyncCopies()
+{
+  if (!m_asyncCopies.empty()) {
+    finishAsyncCopiesUntil(m_asyncCopies.rbegin()->first);
+  }
+}
+
+//! @brief  Finish async copies of any of the given objects, while other copies keep running in the background
+//! No objects, e.g., for commands working on raw rows, finish all async copies
+void
+pimDevice::finishAsyncCopies(const std::vector<PimObjId>& objIds)
+{
+  if (objIds.empty()) {
+    finishAsyncCopies();
+    return;
+  }
+  // Async copies run in order, so finishing the last one using these objects also finishes all copies before it
+  for (auto it = m_asyncCopies.rbegin(); it != m_asyncCopies.rend(); ++it) {
+    for (PimObjId objId : it->second.m_objIds) {
+      if (std::find(objIds.begin(), objIds.end(), objId) != objIds.end()) {
+        finishAsyncCopiesUntil(it->first);
+        return;
+      }
+    }
+  }
+}
+
+//! @brief  Wait for async copies up to a handle, and keep their results for pimWait
+void
+pimDevice::finishAsyncCopiesUntil(PimCopyHandle handle)
+{
+  auto itEnd = m_asyncCopies.upper_bound(handle);
+  for (auto it = m_asyncCopies.begin(); it != itEnd; ++it) {
+    m_finishedAsyncCopies[it->first] = it->second.m_result.get();
+  }
+  m_asyncCopies.erase(m_asyncCopies.begin(), itEnd);
+  // Drop the oldest results that are never waited for
+  while (m_finishedAsyncCopies.size() > MAX_FINISHED_ASYNC_COPIES) {
+    m_finishedAsyncCopies.erase(m_finishedAsyncCopies.begin());
+  }
+}
+
+//! @brief  Get valid PIM objects used by a command, with ranged references resolved to the referenced objects
+std::vector<PimObjId>
+pimDevice::getBaseObjIds(const pimCmd& cmd) const
+{
+  std::vector<PimObjId> objIds;
+  for (PimObjId objId : cmd.getObjIds()) {
+    if (m_resMgr->isValidObjId(objId)) {
+      PimObjId refObjId = m_resMgr->getObjInfo(objId).getRefObjId();
+      objIds.push_back(refObjId != -1 ? refObjId : objId);
+    }
+  }
+  return objIds;
+}
+
+//! @brief  Create a PIM stream
+PimStreamId
+pimDevice::pimStreamCreate()
+{
+  PimStreamId streamId = m_nextStreamId++;
+  m_streams[streamId] = std::make_unique<pimStream>(streamId);
+  return streamId;
+}
+
+//! @brief  Destroy a PIM stream after finishing its commands
+bool
+pimDevice::pimStreamDestroy(PimStreamId streamId)
+{
+  if (streamId == 0 || !isValidStream(streamId)) {
+    std::printf("PIM-Error: Cannot destroy PIM stream %d\n", streamId);
+    return false;
+  }
+  m_streams.erase(streamId);
+  if (m_curStream == streamId) {
+    m_curStream = 0;
+  }
+  return true;
+}
+
+//! @brief  Set the stream for submitting subsequent PIM commands
+bool
+pimDevice::pimSetStream(PimStreamId streamId)
+{
+  if (!isValidStream(streamId)) {
+    std::printf("PIM-Error: Invalid PIM stream %d\n", streamId);
+    return false;
+  }
+  m_curStream = streamId;
+  return true;
+}
+
+//! @brief  Wait for all commands of a stream to finish
+bool
+pimDevice::pimStreamSynchronize(PimStreamId streamId)
+{
+  if (!isValidStream(streamId)) {
+    std::printf("PIM-Error: Invalid PIM stream %d\n", streamId);
+    return false;
+  }
+  if (streamId == 0) {
+    synchronizeStreams();
+  } else {
+    m_streams.at(streamId)->synchronize();
+  }
+  return true;
+}
+
+//! @brief  Record an event after all commands submitted to a stream so far
+PimEventId
+pimDevice::pimEventRecord(PimStreamId streamId)
+{
+  if (!isValidStream(streamId)) {
+    std::printf("PIM-Error: Invalid PIM stream %d\n", streamId);
+    return -1;
+  }
+  PimEventId eventId = m_nextEventId++;
+  if (streamId == 0) {
+    // Default stream commands are done when they return
+    std::promise<void> done;
+    done.set_value();
+    m_events[eventId] = done.get_future().share();
+  } else {
+    m_events[eventId] = m_streams.at(streamId)->recordEvent();
+  }
+  return eventId;
+}
+
+//! @brief  Make subsequent commands of a stream wait for an event
+bool
+pimDevice::pimStreamWaitEvent(PimStreamId streamId, PimEventId eventId)
+{
+  if (!isValidStream(streamId) || m_events.find(eventId) == m_events.end()) {
+    std::printf("PIM-Error: Invalid PIM stream %d or event %d\n", streamId, eventId);
+    return false;
+  }
+  std::shared_future<void> event = m_events.at(eventId);
+  if (streamId == 0) {
+    event.wait();
+  } else {
+    m_streams.at(streamId)->submit([event]() { event.wait(); });
+  }
+  return true;
+}
+
+//! @brief  Wait for an event on the host
+bool
+pimDevice::pimEventSynchronize(PimEventId eventId)
+{
+  auto it = m_events.find(eventId);
+  if (it == m_events.end()) {
+    std::printf("PIM-Error: Invalid PIM event %d\n", eventId);
+    return false;
+  }
+  it->second.wait();
+  return true;
+}
+
+//! @brief  Check if a stream ID is the default stream or a created stream
+bool
+pimDevice::isValidStream(PimStreamId streamId) const
+{
+  return streamId == 0 || m_streams.find(streamId) != m_streams.end();
+}
+
+//! @brief  Wait for all streams and async copies to finish, e.g., before switching to another device
+void
+pimDevice::synchronize()
+{
+  synchronizeStreams();
+  finishAsyncCopies();
+}
+
+//! @brief  Wait for all non-default streams to finish, before changing resources or running default stream commands
+void
+pimDevice::synchronizeStreams() const
+{
+  for (const auto& it : m_streams) {
+    it.second->synchronize();
+  }
+}
+
 //! @brief  Execute a PIM command
 bool
 pimDevice::executeCmd(std::unique_ptr<pimCmd> cmd)
 {
   cmd->setDevice(this);
+
+  // Wait for pending async copies of objects used by this command, both functionally and in the model
+  std::vector<PimObjId> objIds = getBaseObjIds(*cmd);
+  finishAsyncCopies(objIds);
+  pimSim::get()->getStatsMgr()->recordAsyncCopyHazard(objIds);
+
+  // Submit to a non-default stream. Data copy and API fusion always run on the calling thread.
+  PimCmdEnum cmdType = cmd->getCmdType();
+  bool isStreamCmd = m_curStream != 0 && !m_cmdStream && cmdType != PimCmdEnum::NOOP &&
+                     cmdType != PimCmdEnum::COPY_H2D && cmdType != PimCmdEnum::COPY_D2H && cmdType != PimCmdEnum::COPY_D2D;
+  if (isStreamCmd && cmd->isDataDependentStats()) {
+    // Models that need values computed during execution run in order on the calling thread,
+    // and are still scheduled on the modeled timeline of the current stream
+    m_streams.at(m_curStream)->synchronize();
+    return cmd->execute();
+  }
+  if (isStreamCmd) {
+    if (!cmd->sanityCheck()) {
+      return false;
+    }
+    cmd->readHostInputs();
+    cmd->updateStats(this, pimSim::get()->getStatsMgr());
+    cmd->setSkipStats(true);
+    std::shared_ptr<pimCmd> streamCmd(std::move(cmd));
+    m_streams.at(m_curStream)->submit([streamCmd]() {
+      if (!streamCmd->execute()) {
+        std::printf("PIM-Error: Failed to execute %s on a PIM stream\n", streamCmd->getName().c_str());
+      }
+    });
+    return true;
+  }
+  synchronizeStreams();
   bool ok = cmd->execute();
 
+  // Keep executed commands for replaying their perf-energy models later
+  if (m_cmdStream && ok) {
+    m_cmdStream->recordCmd(std::move(cmd));
+  }
   return ok;
 }
 
@@ -12,12 +12,18 @@
 #include "pimCore.h"
 #include "pimCmd.h"
 #include "pimPerfEnergyBase.h"
+#include "pimStream.h"
 #ifdef DRAMSIM3_INTEG
-#include "cpu.h"
+#include "pimDramSim3.h"
 #endif
+#include <future>
+#include <map>
 #include <memory>
+#include <unordered_map>
 
 class pimResMgr;
+class pimParamsDram;
+class pimCmdStream;
 
 
 //! @class  pimDevice
@@ -25,7 +31,7 @@ class pimResMgr;
 class pimDevice
 {
 public:
-  pimDevice(const pimSimConfig& config);
+  pimDevice(const pimSimConfig& config, const pimParamsDram& paramsDram);
   ~pimDevice();
 
   const pimSimConfig& getConfig() const { return m_config; }
@@ -40,6 +46,10 @@ public:
   unsigned getOnChipBufferSize() const { return m_config.getBufferSize(); }
 
   unsigned getNumCores() const { return m_numCores; }
+  // Core grid after adjusting for the simulation target, e.g., with subarray aggregation
+  unsigned getNumCoreRanks() const { return m_numCoreRanks; }
+  unsigned getNumCoreBankPerRank() const { return m_numCoreBankPerRank; }
+  unsigned getNumCoreSubarrayPerBank() const { return m_numCoreSubarrayPerBank; }
   unsigned getNumRows() const { return m_numRows; }
   unsigned getNumCols() const { return m_numCols; }
   unsigned getBufferSize() const { return m_bufferSize; }
@@ -61,18 +71,49 @@ public:
   bool pimCopyMainToDeviceWithType(PimCopyEnum copyType, void* src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimCopyDeviceToMainWithType(PimCopyEnum copyType, PimObjId src, void* dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+  PimCopyHandle pimCopyMainToDeviceAsync(void* src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+  PimCopyHandle pimCopyDeviceToMainAsync(PimObjId src, void* dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+  bool pimWait(PimCopyHandle handle);
+
+  PimStreamId pimStreamCreate();
+  bool pimStreamDestroy(PimStreamId streamId);
+  bool pimSetStream(PimStreamId streamId);
+  bool pimStreamSynchronize(PimStreamId streamId);
+  PimEventId pimEventRecord(PimStreamId streamId);
+  bool pimStreamWaitEvent(PimStreamId streamId, PimEventId eventId);
+  bool pimEventSynchronize(PimEventId eventId);
+  PimStreamId getCurStream() const { return m_curStream; }
+  void synchronize();
 
   pimResMgr* getResMgr() { return m_resMgr.get(); }
   pimPerfEnergyBase* getPerfEnergyModel() { return m_perfEnergyModel.get(); }
   pimCore& getCore(PimCoreId coreId) { return m_cores[coreId]; }
   bool executeCmd(std::unique_ptr<pimCmd> cmd);
 
+  // Record resource operations and executed commands, e.g., for design-space sweeps
+  void setCmdStream(pimCmdStream* cmdStream) { m_cmdStream = cmdStream; }
+
+#ifdef DRAMSIM3_INTEG
+  pimDramSim3* getDramSim3() { return m_dramSim3.get(); }
+#endif
+
 private:
   bool init();
   bool adjustConfigForSimTarget(unsigned& numRanks, unsigned& numBankPerRank, unsigned& numSubarrayPerBank, unsigned& numRows, unsigned& numCols);
+  PimCopyHandle executeCopyAsync(std::unique_ptr<pimCmdCopy> cmd);
+  void finishAsyncCopies();
+  void finishAsyncCopies(const std::vector<PimObjId>& objIds);
+  void finishAsyncCopiesUntil(PimCopyHandle handle);
+  std::vector<PimObjId> getBaseObjIds(const pimCmd& cmd) const;
+  bool isValidStream(PimStreamId streamId) const;
+  void synchronizeStreams() const;
 
   const pimSimConfig& m_config;
+  const pimParamsDram& m_paramsDram;
   unsigned m_numCores = 0;
+  unsigned m_numCoreRanks = 0;
+  unsigned m_numCoreBankPerRank = 0;
+  unsigned m_numCoreSubarrayPerBank = 0;
   unsigned m_numRows = 0;
   unsigned m_numCols = 0;
   unsigned m_bufferSize = 0;
@@ -81,11 +122,28 @@ private:
   std::unique_ptr<pimResMgr> m_resMgr;
   std::unique_ptr<pimPerfEnergyBase> m_perfEnergyModel;
   std::vector<pimCore> m_cores;
+  pimCmdStream* m_cmdStream = nullptr;
+
+  // Async copies run on background threads one after another, each waiting for the previous one
+  struct asyncCopy {
+    std::shared_future<bool> m_result;
+    std::vector<PimObjId> m_objIds; // objects of the copy, with references resolved
+  };
+  static constexpr size_t MAX_FINISHED_ASYNC_COPIES = 1024;
+  std::map<PimCopyHandle, asyncCopy> m_asyncCopies;
+  std::map<PimCopyHandle, bool> m_finishedAsyncCopies; // results of recent copies finished before pimWait
+  std::shared_future<bool> m_lastAsyncCopy;
+  PimCopyHandle m_nextAsyncHandle = 0;
+
+  // Non-default streams, each with its own host thread. Stream 0 is the default stream on the calling thread.
+  std::map<PimStreamId, std::unique_ptr<pimStream>> m_streams;
+  std::unordered_map<PimEventId, std::shared_future<void>> m_events;
+  PimStreamId m_curStream = 0;
+  PimStreamId m_nextStreamId = 1;
+  PimEventId m_nextEventId = 0;
 
 #ifdef DRAMSIM3_INTEG
-  dramsim3::PIMCPU* m_hostMemory = nullptr;
-  dramsim3::PIMCPU* m_deviceMemory = nullptr;
-  dramsim3::Config* m_deviceMemoryConfig = nullptr;
+  std::unique_ptr<pimDramSim3> m_dramSim3;
 #endif
 };
 
@@ -0,0 +1,239 @@
+// File: pimDramSim3.cpp
+// PIMeval Simulator - DRAMsim3 Bridge
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifdef DRAMSIM3_INTEG
+
+#include "pimDramSim3.h"
+#include "pimResMgr.h"
+#include "channel_state.h"   // DRAMsim3
+#include "configuration.h"   // DRAMsim3
+#include "memory_system.h"   // DRAMsim3
+#include "timing.h"          // DRAMsim3
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <set>
+
+
+//! @brief  pimDramSim3 ctor
+pimDramSim3::pimDramSim3(const std::string& memConfigFile, const pimParamsDram& paramsDram,
+                         unsigned numCoresPerBank, unsigned numRowsPerCore)
+  : m_paramsDram(paramsDram),
+    m_numCoresPerBank(std::max(numCoresPerBank, 1u)),
+    m_numRowsPerCore(numRowsPerCore)
+{
+  // DRAMsim3 only writes stats files when asked, so current directory is good enough as output directory
+  m_config = std::make_unique<dramsim3::Config>(memConfigFile, ".");
+  m_timing = std::make_unique<dramsim3::Timing>(*m_config);
+  for (int ch = 0; ch < m_config->channels; ++ch) {
+    m_channelStates.push_back(std::make_unique<dramsim3::ChannelState>(*m_config, *m_timing));
+  }
+  auto cb = std::bind(&pimDramSim3::callback, this, std::placeholders::_1);
+  m_memory = std::make_unique<dramsim3::MemorySystem>(memConfigFile, ".", cb, cb);
+  std::printf("PIM-Info: Created DRAMsim3 memory system from %s: %d channels, %d ranks, %d banks, tCK = %f ns\n",
+              memConfigFile.c_str(), m_config->channels, m_config->ranks, m_config->banks, m_config->tCK);
+}
+
+//! @brief  pimDramSim3 dtor
+pimDramSim3::~pimDramSim3()
+{
+}
+
+//! @brief  Compose a physical address following DRAMsim3 address mapping
+uint64_t
+pimDramSim3::getAddr(int channel, int rank, int bankgroup, int bank, int row, int col) const
+{
+  uint64_t addr = (static_cast<uint64_t>(channel) << m_config->ch_pos)
+                | (static_cast<uint64_t>(rank) << m_config->ra_pos)
+                | (static_cast<uint64_t>(bankgroup) << m_config->bg_pos)
+                | (static_cast<uint64_t>(bank) << m_config->ba_pos)
+                | (static_cast<uint64_t>(row) << m_config->ro_pos)
+                | (static_cast<uint64_t>(col) << m_config->co_pos);
+  return addr << m_config->shift_bits;
+}
+
+//! @brief  Map a global bank ID in rank/bank order to a DRAMsim3 bank, with banks varying fastest
+pimDramSim3::bankRows
+pimDramSim3::getBank(unsigned globalBankId) const
+{
+  unsigned numBanks = static_cast<unsigned>(m_config->channels * m_config->ranks * m_config->banks);
+  unsigned id = globalBankId % numBanks;
+  bankRows bank;
+  bank.m_bank = static_cast<int>(id % m_config->banks_per_group);
+  id /= m_config->banks_per_group;
+  bank.m_bankgroup = static_cast<int>(id % m_config->bankgroups);
+  id /= m_config->bankgroups;
+  bank.m_rank = static_cast<int>(id % m_config->ranks);
+  bank.m_channel = static_cast<int>(id / m_config->ranks);
+  return bank;
+}
+
+//! @brief  Get DRAMsim3 banks and rows occupied by a PIM object
+//! Subarrays of a bank run in lockstep, so only rows of the first region in each bank are activated
+std::vector<pimDramSim3::bankRows>
+pimDramSim3::getObjBanks(const pimObjInfo& obj) const
+{
+  std::vector<bankRows> banks;
+  std::set<unsigned> bankIds;
+  for (const auto& region : obj.getRegions()) {
+    unsigned bankId = static_cast<unsigned>(region.getCoreId()) / m_numCoresPerBank;
+    if (!bankIds.insert(bankId).second) {
+      continue;
+    }
+    bankRows bank = getBank(bankId);
+    unsigned subarrayId = static_cast<unsigned>(region.getCoreId()) % m_numCoresPerBank;
+    for (unsigned i = 0; i < std::max(region.getNumAllocRows(), 1u); ++i) {
+      uint64_t row = static_cast<uint64_t>(subarrayId) * m_numRowsPerCore + region.getRowIdx() + i;
+      bank.m_rows.push_back(static_cast<int>(row % m_config->rows));
+    }
+    banks.push_back(bank);
+  }
+  return banks;
+}
+
+//! @brief  Get column burst addresses over the rows of a PIM object, up to a number of bits
+void
+pimDramSim3::getObjBursts(const pimObjInfo& obj, uint64_t numBits, std::vector<uint64_t>& addrs) const
+{
+  uint64_t bitsPerBurst = static_cast<uint64_t>(m_config->request_size_bytes) * 8;
+  uint64_t numBursts = (numBits + bitsPerBurst - 1) / bitsPerBurst;
+  uint64_t numBurstsPerRow = static_cast<uint64_t>(m_config->co_mask) + 1;
+  for (const auto& bank : getObjBanks(obj)) {
+    for (int row : bank.m_rows) {
+      for (uint64_t col = 0; col < numBurstsPerRow; ++col) {
+        if (addrs.size() == numBursts) {
+          return;
+        }
+        addrs.push_back(getAddr(bank.m_channel, bank.m_rank, bank.m_bankgroup, bank.m_bank, row, static_cast<int>(col)));
+      }
+    }
+  }
+  // Wrap around if the object is smaller than the copied bits
+  for (size_t i = 0; !addrs.empty() && addrs.size() < numBursts; ++i) {
+    addrs.push_back(addrs[i]);
+  }
+}
+
+//! @brief  Issue ACT/PRE pairs to DRAMsim3 channel states without using the data bus. Return runtime in ms
+//! Each bank performs the given number of row operations over its rows. Each channel issues at most one
+//! command per cycle, and DRAMsim3 timing decides when an ACT or PRE is ready.
+double
+pimDramSim3::runRowOps(const std::vector<bankRows>& banks, uint64_t numRowOps)
+{
+  if (numRowOps == 0 || banks.empty()) {
+    return 0.0;
+  }
+  uint64_t clkBegin = m_clk;
+  std::vector<uint64_t> numDone(banks.size(), 0);
+  size_t numPending = banks.size();
+  while (numPending > 0) {
+    std::vector<bool> isCmdIssued(m_config->channels, false);
+    for (size_t i = 0; i < banks.size(); ++i) {
+      const bankRows& bank = banks[i];
+      if (numDone[i] == numRowOps || isCmdIssued[bank.m_channel]) {
+        continue;
+      }
+      // Probe with a column read: DRAMsim3 returns the ACT or PRE needed before it, once timing allows.
+      // An open row is probed with another row so that the probe always asks for a PRE.
+      dramsim3::ChannelState& channelState = *m_channelStates[bank.m_channel];
+      int row = bank.m_rows[numDone[i] % bank.m_rows.size()];
+      if (channelState.IsRowOpen(bank.m_rank, bank.m_bankgroup, bank.m_bank)) {
+        row = (channelState.OpenRow(bank.m_rank, bank.m_bankgroup, bank.m_bank) + 1) % m_config->rows;
+      }
+      dramsim3::Address addr(bank.m_channel, bank.m_rank, bank.m_bankgroup, bank.m_bank, row, 0);
+      dramsim3::Command probe(dramsim3::CommandType::READ, addr,
+                              getAddr(bank.m_channel, bank.m_rank, bank.m_bankgroup, bank.m_bank, row, 0));
+      dramsim3::Command cmd = channelState.GetReadyCommand(probe, m_clk);
+      if (!cmd.IsValid() || (cmd.cmd_type != dramsim3::CommandType::ACTIVATE &&
+                             cmd.cmd_type != dramsim3::CommandType::PRECHARGE)) {
+        continue;
+      }
+      channelState.UpdateTimingAndStates(cmd, m_clk);
+      isCmdIssued[bank.m_channel] = true;
+      if (cmd.cmd_type == dramsim3::CommandType::PRECHARGE && ++numDone[i] == numRowOps) {
+        numPending--;
+      }
+    }
+    m_clk++;
+  }
+  // The last precharge completes after tRP
+  m_clk += m_config->tRP;
+  return (m_clk - clkBegin) * m_config->tCK / 1000000.0; // Convert ns to ms
+}
+
+//! @brief  Feed transactions in order and tick DRAMsim3 until all of them complete. Return runtime in ms
+double
+pimDramSim3::run(const std::vector<std::pair<uint64_t, bool>>& trans)
+{
+  m_numCompleted = 0;
+  uint64_t numCycles = 0;
+  size_t idx = 0;
+  while (m_numCompleted < trans.size()) {
+    while (idx < trans.size() && m_memory->WillAcceptTransaction(trans[idx].first, trans[idx].second)) {
+      m_memory->AddTransaction(trans[idx].first, trans[idx].second);
+      idx++;
+    }
+    m_memory->ClockTick();
+    numCycles++;
+  }
+  return numCycles * m_config->tCK / 1000000.0; // Convert ns to ms
+}
+
+//! @brief  Simulate row reads and writes of a PIM command given its analytical perf-energy and its object.
+//!         Return cycle-level runtime of the row operations in ms
+//! Other time, e.g., logic operations in sense amplifiers, does not involve DRAM commands and is not simulated.
+//! Commands without an object, e.g., micro-ops, are broadcast to all banks.
+double
+pimDramSim3::simulateCmd(const pimeval::perfEnergy& perfEnergy, const pimObjInfo* obj)
+{
+  double msRowRead = m_paramsDram.getNsRowRead() / 1000000.0;
+  double msRowWrite = m_paramsDram.getNsRowWrite() / 1000000.0;
+  uint64_t numRowOps = static_cast<uint64_t>(std::llround(perfEnergy.m_msRead / msRowRead))
+                     + static_cast<uint64_t>(std::llround(perfEnergy.m_msWrite / msRowWrite));
+  if (numRowOps == 0) {
+    return 0.0;
+  }
+
+  std::vector<bankRows> banks;
+  if (obj) {
+    banks = getObjBanks(*obj);
+  } else {
+    for (int i = 0; i < m_config->channels * m_config->ranks * m_config->banks; ++i) {
+      banks.push_back(getBank(i));
+      banks.back().m_rows.push_back(0);
+    }
+  }
+  return runRowOps(banks, numRowOps);
+}
+
+//! @brief  Simulate a data copy as column bursts over object rows. Return cycle-level runtime in ms
+//! Host-to-device copies only have a destination object, and device-to-host copies only have a source object
+double
+pimDramSim3::simulateCopy(uint64_t numBits, const pimObjInfo* objSrc, const pimObjInfo* objDest)
+{
+  std::vector<uint64_t> readAddrs;
+  std::vector<uint64_t> writeAddrs;
+  if (objSrc) {
+    getObjBursts(*objSrc, numBits, readAddrs);
+  }
+  if (objDest) {
+    getObjBursts(*objDest, numBits, writeAddrs);
+  }
+  std::vector<std::pair<uint64_t, bool>> trans;
+  for (size_t i = 0; i < std::max(readAddrs.size(), writeAddrs.size()); ++i) {
+    if (i < readAddrs.size()) {
+      trans.emplace_back(readAddrs[i], false);
+    }
+    if (i < writeAddrs.size()) {
+      trans.emplace_back(writeAddrs[i], true);
+    }
+  }
+  return run(trans);
+}
+
+#endif
+
@@ -0,0 +1,81 @@
+// File: pimDramSim3.h
+// PIMeval Simulator - DRAMsim3 Bridge
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_DRAMSIM3_H
+#define LAVA_PIM_DRAMSIM3_H
+
+#ifdef DRAMSIM3_INTEG
+
+#include "pimParamsDram.h"
+#include "pimPerfEnergyBase.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dramsim3 {
+  class Config;
+  class Timing;
+  class ChannelState;
+  class MemorySystem;
+}
+class pimObjInfo;
+
+
+//! @class  pimDramSim3
+//! @brief  Lower PIM commands into DRAMsim3 commands for cycle-level cross-validation
+//!
+//! PIM cores map to DRAMsim3 banks in rank/bank order, and subarrays of a bank share one DRAMsim3 bank:
+//! - In-bank PIM row operations never use the data bus. They are issued as ACT/PRE pairs directly to
+//!   DRAMsim3 channel states, to the rows of the command's object in the banks it occupies. DRAMsim3
+//!   enforces tRAS, tRP, tRRD and tFAW, while refresh is not modeled on this path. The number of row
+//!   operations per core comes from the command's micro-program in the analytical model.
+//! - Data copies are column bursts over the rows of the copied objects through the DRAMsim3 memory
+//!   controller, sharing the channel data bus.
+class pimDramSim3
+{
+public:
+  pimDramSim3(const std::string& memConfigFile, const pimParamsDram& paramsDram,
+              unsigned numCoresPerBank, unsigned numRowsPerCore);
+  ~pimDramSim3();
+
+  bool isValid() const { return m_memory != nullptr; }
+
+  double simulateCmd(const pimeval::perfEnergy& perfEnergy, const pimObjInfo* obj);
+  double simulateCopy(uint64_t numBits, const pimObjInfo* objSrc, const pimObjInfo* objDest);
+
+private:
+  //! @brief  Location of a DRAMsim3 bank and the rows to activate in it
+  struct bankRows {
+    int m_channel;
+    int m_rank;
+    int m_bankgroup;
+    int m_bank;
+    std::vector<int> m_rows;
+  };
+
+  uint64_t getAddr(int channel, int rank, int bankgroup, int bank, int row, int col) const;
+  bankRows getBank(unsigned globalBankId) const;
+  std::vector<bankRows> getObjBanks(const pimObjInfo& obj) const;
+  void getObjBursts(const pimObjInfo& obj, uint64_t numBits, std::vector<uint64_t>& addrs) const;
+  double runRowOps(const std::vector<bankRows>& banks, uint64_t numRowOps);
+  double run(const std::vector<std::pair<uint64_t, bool>>& trans);
+  void callback(uint64_t addr) { m_numCompleted++; }
+
+  const pimParamsDram& m_paramsDram;
+  unsigned m_numCoresPerBank;
+  unsigned m_numRowsPerCore;
+  std::unique_ptr<dramsim3::Config> m_config;
+  std::unique_ptr<dramsim3::Timing> m_timing;
+  std::vector<std::unique_ptr<dramsim3::ChannelState>> m_channelStates;
+  std::unique_ptr<dramsim3::MemorySystem> m_memory;
+  uint64_t m_numCompleted = 0;
+  uint64_t m_clk = 0;  // clock of ACT/PRE issued to channel states
+};
+
+#endif
+#endif
+
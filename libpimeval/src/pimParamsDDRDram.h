@@ -46,6 +46,16 @@ public:
   double gettCCD_S() const override { return m_tCCD_S; }
   double gettCK() const override { return m_tCK; }
   double gettRAS() const override { return m_tRAS; }
+  double getNsRRD() const override { return m_tCK * m_tRRD_S; }
+  double getNsFAW() const override { return m_tCK * m_tFAW; }
+  double getNsLisaHop() const override { return m_nsLisaHop; }
+  std::string getRefreshPolicy() const override { return m_refreshPolicy; }
+  double getNsRFC() const override { return m_tCK * m_tRFC; }
+  double getNsREFI() const override { return m_tCK * m_tREFI; }
+  double getNsRFCb() const override { return 0.0; }
+  double getNsREFIb() const override { return 0.0; }
+  double getPjRefresh() const override { return m_VDD * (m_IDD5AB - m_IDD3N) * m_tCK * m_tRFC; } // refresh energy per chip
+  double getPjRefreshBank() const override { return 0.0; }
   
 private:
   // [dram_structure]
@@ -76,6 +86,7 @@ private:
   int m_tWTR_S = 0;
   int m_tWTR_L = 0;
   int m_tFAW = 0;
+  double m_nsLisaHop = 8.0; // LISA reports a few ns per hop through linked row buffers; 8 ns is conservative
   int m_tWR = 0;
   int m_tWR2 = 0;
   int m_tRTP = 0;
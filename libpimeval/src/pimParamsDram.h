@@ -52,6 +52,22 @@ public:
   virtual double gettCCD_S() const = 0;
   virtual double gettRAS() const = 0; 
   virtual double gettCK() const = 0;
+
+  // Row activation rate limits
+  virtual double getNsRRD() const = 0;         // activate to activate delay across bank groups
+  virtual double getNsFAW() const = 0;         // four activate window
+
+  // LISA row buffer movement latency across one subarray boundary
+  virtual double getNsLisaHop() const = 0;
+
+  // DRAM refresh
+  virtual std::string getRefreshPolicy() const = 0;
+  virtual double getNsRFC() const = 0;         // all-bank refresh cycle time
+  virtual double getNsREFI() const = 0;        // all-bank refresh interval
+  virtual double getNsRFCb() const = 0;        // per-bank refresh cycle time, 0 if not supported
+  virtual double getNsREFIb() const = 0;       // per-bank refresh interval, 0 if not supported
+  virtual double getPjRefresh() const = 0;     // energy of one all-bank refresh per chip
+  virtual double getPjRefreshBank() const = 0; // energy of one per-bank refresh per chip
 };
 
 #endif
@@ -74,6 +74,7 @@ pimParamsGDDRDram::pimParamsGDDRDram()
     m_busWidth(128),
     m_addressMapping("rochrababgco"),
     m_queueStructure("PER_BANK"),
+    m_refreshPolicy("RANK_LEVEL_STAGGERED"),
     m_rowBufPolicy("OPEN_PAGE"),
     m_cmdQueueSize(8),
     m_transQueueSize(32),
@@ -111,6 +112,12 @@ pimParamsGDDRDram::pimParamsGDDRDram(std::unordered_map<std::string, std::string
     m_tWTR_S = std::stoi(pimUtils::getParam(params, "tWTR_S"));
     m_tWTR_L = std::stoi(pimUtils::getParam(params, "tWTR_L"));
     m_tFAW = std::stoi(pimUtils::getParam(params, "tFAW"));
+    // tLISA_HOP in ns is optional, as it is not a DRAMsim3 parameter
+    bool hasLisaHop = false;
+    std::string lisaHop = pimUtils::getOptionalParam(params, "tLISA_HOP", hasLisaHop);
+    if (hasLisaHop) {
+      m_nsLisaHop = std::stod(lisaHop);
+    }
     m_tWR = std::stoi(pimUtils::getParam(params, "tWR"));
     m_tCCD_S = std::stoi(pimUtils::getParam(params, "tCCD_S"));
     m_tCCD_L = std::stoi(pimUtils::getParam(params, "tCCD_L"));
@@ -134,6 +141,11 @@ pimParamsGDDRDram::pimParamsGDDRDram(std::unordered_map<std::string, std::string
     m_IDD4W = std::stoi(pimUtils::getParam(params, "IDD4W"));
     m_IDD4R = std::stoi(pimUtils::getParam(params, "IDD4R"));
     m_IDD5AB = std::stoi(pimUtils::getParam(params, "IDD5AB"));
+    bool hasIDD5PB = false;
+    std::string idd5pb = pimUtils::getOptionalParam(params, "IDD5PB", hasIDD5PB);
+    if (hasIDD5PB) {
+      m_IDD5PB = std::stoi(idd5pb);
+    }
     m_IDD6x = std::stoi(pimUtils::getParam(params, "IDD6x"));
 
     m_channelSize = std::stoi(pimUtils::getParam(params, "channel_size"));
@@ -142,6 +154,12 @@ pimParamsGDDRDram::pimParamsGDDRDram(std::unordered_map<std::string, std::string
     m_addressMapping = pimUtils::getParam(params, "address_mapping");
     m_queueStructure = pimUtils::getParam(params, "queue_structure");
     m_rowBufPolicy = pimUtils::getParam(params, "row_buf_policy");
+    // refresh_policy is optional in GDDR and HBM configs
+    bool hasRefreshPolicy = false;
+    std::string refreshPolicy = pimUtils::getOptionalParam(params, "refresh_policy", hasRefreshPolicy);
+    if (hasRefreshPolicy) {
+      m_refreshPolicy = refreshPolicy;
+    }
     m_cmdQueueSize = std::stoi(pimUtils::getParam(params, "cmd_queue_size"));
     m_transQueueSize = std::stoi(pimUtils::getParam(params, "trans_queue_size"));
 
@@ -46,6 +46,16 @@ public:
   double gettCCD_S() const override { return m_tCCD_S; }
   double gettCK() const override { return m_tCK; }
   double gettRAS() const override { return m_tRAS; }
+  double getNsRRD() const override { return m_tCK * m_tRRD_S; }
+  double getNsFAW() const override { return m_tCK * m_tFAW; }
+  double getNsLisaHop() const override { return m_nsLisaHop; }
+  std::string getRefreshPolicy() const override { return m_refreshPolicy; }
+  double getNsRFC() const override { return m_tCK * m_tRFC; }
+  double getNsREFI() const override { return m_tCK * m_tREFI; }
+  double getNsRFCb() const override { return m_tCK * m_RFCb; }
+  double getNsREFIb() const override { return m_tCK * m_tREFIb; }
+  double getPjRefresh() const override { return m_VDD * (m_IDD5AB - m_IDD3N) * m_tCK * m_tRFC; } // refresh energy per chip
+  double getPjRefreshBank() const override { return m_VDD * (m_IDD5PB - m_IDD3N) * m_tCK * m_RFCb; }
 
 private:
   // [dram_structure]
@@ -74,6 +84,7 @@ private:
   int m_tWTR_S = 0;
   int m_tWTR_L = 0;
   int m_tFAW = 0;
+  double m_nsLisaHop = 8.0; // LISA reports a few ns per hop through linked row buffers; 8 ns is conservative
   int m_tWR = 0;
   int m_tXS = 0;
   int m_tXP = 0;
@@ -107,6 +118,7 @@ private:
   int m_busWidth = 0;
   std::string m_addressMapping;
   std::string m_queueStructure;
+  std::string m_refreshPolicy = "RANK_LEVEL_STAGGERED";
   std::string m_rowBufPolicy;
   int m_cmdQueueSize = 0;
   int m_transQueueSize = 0;
@@ -71,6 +71,7 @@ pimParamsHBMDram::pimParamsHBMDram()
   m_busWidth(128),
   m_addressMapping("rorabgbachco"),
   m_queueStructure("PER_BANK"),
+  m_refreshPolicy("RANK_LEVEL_STAGGERED"),
   m_rowBufPolicy("OPEN_PAGE"),
   m_cmdQueueSize(8),
   m_transQueueSize(32),
@@ -112,6 +113,12 @@ pimParamsHBMDram::pimParamsHBMDram(std::unordered_map<std::string, std::string>
     m_tWTR_S = std::stoi(pimUtils::getParam(params, "tWTR_S"));
     m_tWTR_L = std::stoi(pimUtils::getParam(params, "tWTR_L"));
     m_tFAW = std::stoi(pimUtils::getParam(params, "tFAW"));
+    // tLISA_HOP in ns is optional, as it is not a DRAMsim3 parameter
+    bool hasLisaHop = false;
+    std::string lisaHop = pimUtils::getOptionalParam(params, "tLISA_HOP", hasLisaHop);
+    if (hasLisaHop) {
+      m_nsLisaHop = std::stod(lisaHop);
+    }
     m_tWR = std::stoi(pimUtils::getParam(params, "tWR"));
     m_tCCD_S = std::stoi(pimUtils::getParam(params, "tCCD_S"));
     m_tCCD_L = std::stoi(pimUtils::getParam(params, "tCCD_L"));
@@ -139,6 +146,12 @@ pimParamsHBMDram::pimParamsHBMDram(std::unordered_map<std::string, std::string>
     m_addressMapping = pimUtils::getParam(params, "address_mapping");
     m_queueStructure = pimUtils::getParam(params, "queue_structure");
     m_rowBufPolicy = pimUtils::getParam(params, "row_buf_policy");
+    // refresh_policy is optional in GDDR and HBM configs
+    bool hasRefreshPolicy = false;
+    std::string refreshPolicy = pimUtils::getOptionalParam(params, "refresh_policy", hasRefreshPolicy);
+    if (hasRefreshPolicy) {
+      m_refreshPolicy = refreshPolicy;
+    }
     m_cmdQueueSize = std::stoi(pimUtils::getParam(params, "cmd_queue_size"));
     m_transQueueSize = std::stoi(pimUtils::getParam(params, "trans_queue_size"));
     m_unifiedQueue = pimUtils::getParam(params, "address_mapping") == "False" ? false : true;
@@ -112,6 +112,12 @@ pimParamsLPDDRDram::pimParamsLPDDRDram(std::unordered_map<std::string, std::stri
     m_tWTR_S = std::stoi(pimUtils::getParam(params, "tWTR_S"));
     m_tWTR_L = std::stoi(pimUtils::getParam(params, "tWTR_L"));
     m_tFAW = std::stoi(pimUtils::getParam(params, "tFAW"));
+    // tLISA_HOP in ns is optional, as it is not a DRAMsim3 parameter
+    bool hasLisaHop = false;
+    std::string lisaHop = pimUtils::getOptionalParam(params, "tLISA_HOP", hasLisaHop);
+    if (hasLisaHop) {
+      m_nsLisaHop = std::stod(lisaHop);
+    }
     m_tWR = std::stoi(pimUtils::getParam(params, "tWR"));
     m_tWR2 = std::stoi(pimUtils::getParam(params, "tWR2"));
     m_tRTP = std::stoi(pimUtils::getParam(params, "tRTP"));
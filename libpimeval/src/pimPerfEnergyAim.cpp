@@ -6,6 +6,7 @@
 
 #include "pimPerfEnergyAim.h"
 #include "pimCmd.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 
@@ -19,7 +20,7 @@ pimeval::perfEnergy
 pimPerfEnergyAim::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& obj, const pimObjInfo& objDest) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -60,7 +61,7 @@ pimeval::perfEnergy
 pimPerfEnergyAim::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& obj, const pimObjInfo& objSrc2, const pimObjInfo& objDest) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -96,7 +97,7 @@ pimeval::perfEnergy
 pimPerfEnergyAim::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -121,7 +122,7 @@ pimeval::perfEnergy
 pimPerfEnergyAim::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -135,7 +136,7 @@ pimeval::perfEnergy
 pimPerfEnergyAim::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -156,7 +157,7 @@ pimeval::perfEnergy pimPerfEnergyAim::getPerfEnergyForMac(PimCmdEnum cmdType, co
   // AiM paper mentions accumulation reduction tree requires 4 cycles after the multiplier. Hence, the compute time for accumulation is `4 * tCK`.
   // TODO: Energy model
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -174,10 +175,46 @@ pimeval::perfEnergy pimPerfEnergyAim::getPerfEnergyForMac(PimCmdEnum cmdType, co
   msWrite = perfEnergyBT.m_msRuntime;
   msCompute = (gdlItr * m_tGDL + 4 * m_tCK * gdlItr);
   msRuntime = msRead + msWrite + msCompute;
-  mjEnergy = ((m_eACT + m_ePRE) + (maxElementsPerRegion * m_aquaboltArithmeticEnergy)) * numCore;
-  mjEnergy += m_eR * numBankPerChip * m_numRanks * gdlItr; // Energy for reading data from local row buffer to global row buffer
-  mjEnergy += perfEnergyBT.m_mjEnergy;
-  mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * numCore;
+  mjEnergy.m_mjLogic = maxElementsPerRegion * m_aquaboltArithmeticEnergy * numCore;
+  mjEnergy.m_mjGDL += m_eR * numBankPerChip * m_numRanks * gdlItr; // Energy for reading data from local row buffer to global row buffer
+  mjEnergy += perfEnergyBT.m_mjBreakdown;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
   totalOp = obj.getNumElements() * 2;
   return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
 }
+
+//! @brief  Perf energy model of aim PIM for GEMV/GEMM
+//! AiM runs GEMV as row-wise MAC: the host operand is broadcast into the global buffers once, each core
+//! streams its matrix rows through the multipliers and reduction tree, and writes one result per row
+//! back to the bank. Matrix rows are assumed to be evenly distributed across cores as AiM weight layout.
+pimeval::perfEnergy
+pimPerfEnergyAim::getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned bitsPerElement = objMat.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned numCore = objMat.getNumCoreAvailable();
+  unsigned numBankPerChip = numCore / m_numChipsPerRank;
+  uint64_t numOutputs = objDest.getNumElements();
+  uint64_t numVectors = numOutputs * numCols / objMat.getNumElements();
+  uint64_t outputsPerCore = std::ceil(numOutputs * 1.0 / numCore);
+  uint64_t elementsPerCore = outputsPerCore * numCols;
+  uint64_t elementsPerRow = std::max<uint64_t>(objMat.getMaxElementsPerRegion(), 1);
+  uint64_t numActs = std::ceil(elementsPerCore * 1.0 / elementsPerRow);
+  uint64_t gdlItr = std::ceil(elementsPerCore * bitsPerElement * 1.0 / m_GDLWidth);
+  uint64_t writeItr = std::ceil(outputsPerCore * bitsPerElement * 1.0 / m_GDLWidth);
+
+  pimeval::perfEnergy perfEnergyBT = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, (numCols * numVectors * bitsPerElement) / 8);
+
+  double msRead = perfEnergyBT.m_msRuntime + (m_tACT + m_tPRE) * numActs + (m_tCAS - m_tGDL) * gdlItr;
+  double msWrite = m_tACT + m_tPRE + m_tGDL * writeItr;
+  double msCompute = gdlItr * m_tGDL + 4 * m_tCK * gdlItr;
+  double msRuntime = msRead + msWrite + msCompute;
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * (numActs + 1) * numCore;
+  mjEnergy.m_mjLogic = elementsPerCore * m_aquaboltArithmeticEnergy * numCore;
+  mjEnergy.m_mjGDL = (m_eR * gdlItr + m_eW * writeItr) * numBankPerChip * m_numRanks;
+  mjEnergy += perfEnergyBT.m_mjBreakdown;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  uint64_t totalOp = numOutputs * numCols * 2;
+  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+}
@@ -28,6 +28,8 @@ public:
   virtual pimeval::perfEnergy getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
   virtual pimeval::perfEnergy getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
   virtual pimeval::perfEnergy getPerfEnergyForMac(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForGemvMoves(const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const override { return pimeval::perfEnergy(); }
   
 protected:
   unsigned m_aquaboltFPUBitWidth = 16;
@@ -22,7 +22,7 @@ pimeval::perfEnergy
 pimPerfEnergyAquabolt::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& obj, const pimObjInfo& objDest) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -52,11 +52,13 @@ pimPerfEnergyAquabolt::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInf
       msWrite = (m_tACT + m_tPRE) * numPass * numActPre;
       msCompute = (minGDLItr * aquaboltCoreCycle * numberOfOperationPerElement) + ((maxGDLItr * aquaboltCoreCycle * numberOfOperationPerElement) * (numPass - 1));
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = ((m_eACT + m_ePRE) * numActPre * 2 + (maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement)) * numCores * (numPass - 1);
-      mjEnergy += ((m_eACT + m_ePRE) * numActPre * 2 +  (minElementPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement)) * numCores;
-      mjEnergy += (m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * numActPre * 2 * numCores * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement * numCores * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * numActPre * 2 * numCores;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement * numCores;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -91,7 +93,7 @@ pimeval::perfEnergy
 pimPerfEnergyAquabolt::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& obj, const pimObjInfo& objSrc2, const pimObjInfo& objDest) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -119,11 +121,13 @@ pimPerfEnergyAquabolt::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInf
       msCompute = (maxGDLItr * numberOfOperationPerElement * aquaboltCoreCycle) * (numPass - 1);
       msCompute += (minGDLItr * numberOfOperationPerElement * aquaboltCoreCycle);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (((m_eACT + m_ePRE) * 3 * numActPre) + ((maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement))) * numCoresUsed * (numPass - 1);
-      mjEnergy += (((m_eACT + m_ePRE) * 3 * numActPre) + ((minElementPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement))) * numCoresUsed;
-      mjEnergy += (m_eR * maxGDLItr * 2 * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * 2 * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 3 * numActPre * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 3 * numActPre * numCoresUsed;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement * numCoresUsed;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * 2 * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * 2 * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -150,11 +154,13 @@ pimPerfEnergyAquabolt::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInf
       msCompute = (maxGDLItr * aquaboltCoreCycle * numberOfOperationPerElement) * (numPass - 1);
       msCompute += (minGDLItr * aquaboltCoreCycle * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (((m_eACT + m_ePRE) * 3 * numActPre) + ((maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement))) * numCoresUsed * (numPass - 1);
-      mjEnergy += (((m_eACT + m_ePRE) * 3 * numActPre) + ((minElementPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement))) * numCoresUsed;
-      mjEnergy += (m_eR * maxGDLItr * 2 * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * 2 * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 3 * numActPre * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 3 * numActPre * numCoresUsed;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement * numCoresUsed;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * 2 * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * 2 * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements() * 2;
       break;
     }
@@ -183,7 +189,7 @@ pimeval::perfEnergy
 pimPerfEnergyAquabolt::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -208,12 +214,14 @@ pimPerfEnergyAquabolt::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimOb
       msCompute += (m_tR + (minGDLItr * aquaboltCoreCycle * numberOfOperationPerElement));
       msRuntime = msRead + msWrite + msCompute;
       // Refer to fulcrum documentation
-      mjEnergy = (m_eAP + ((m_eR * maxGDLItr) + (maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement))) * numPass * numCore;
+      mjEnergy.m_mjActPre = m_eAP * numPass * numCore;
+      mjEnergy.m_mjGDL = m_eR * maxGDLItr * numPass * numCore;
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_aquaboltArithmeticEnergy * numberOfOperationPerElement * numPass * numCore;
       // reduction for all regions
       double aggregateMs = static_cast<double>(numCore) / (3200000 * 16);
       msRuntime += aggregateMs;
-      mjEnergy += aggregateMs * cpuTDP;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjHost += aggregateMs * cpuTDP;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -233,7 +241,7 @@ pimeval::perfEnergy
 pimPerfEnergyAquabolt::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -250,9 +258,11 @@ pimPerfEnergyAquabolt::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimOb
   msWrite = (m_tW + maxGDLItr * m_tGDL) * (numPass - 1);
   msWrite += (m_tW + minGDLItr * m_tGDL);
   msRuntime = msRead + msWrite + msCompute;
-  mjEnergy = (m_eAP + m_eR * maxGDLItr) * (numPass - 1) * numCore;
-  mjEnergy += (m_eAP + m_eR * minGDLItr) * numCore;
-  mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+  mjEnergy.m_mjActPre = m_eAP * (numPass - 1) * numCore;
+  mjEnergy.m_mjGDL = m_eR * maxGDLItr * (numPass - 1) * numCore;
+  mjEnergy.m_mjActPre += m_eAP * numCore;
+  mjEnergy.m_mjGDL += m_eR * minGDLItr * numCore;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
 
   return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
 }
@@ -262,7 +272,7 @@ pimeval::perfEnergy
 pimPerfEnergyAquabolt::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -15,7 +15,7 @@ pimeval::perfEnergy
 pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& obj, const pimObjInfo& objDest) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -45,10 +45,10 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE + maxGDLItr * m_tGDL) * (numPass - 1)) + (activateMS + m_tPRE + (minGDLItr * m_tGDL));
       msCompute = 0;
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = numPass * numCores * (m_eACT + m_ePRE) * 2;
-      mjEnergy += ((m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks) + (m_eR * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += ((m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks) + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = numPass * numCores * (m_eACT + m_ePRE) * 2;
+      mjEnergy.m_mjGDL += (m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks) + (m_eR * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjGDL += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks) + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       break;
     }
     case PimCmdEnum::POPCOUNT:
@@ -69,11 +69,13 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE + maxGDLItr * m_tGDL) * (numPass - 1)) + (activateMS + m_tPRE + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = ((m_eACT + m_ePRE) * 2 + (maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCores * (numPass - 1);
-      mjEnergy += ((m_eACT + m_ePRE) * 2 + (minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCores;
-      mjEnergy += (m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 2 * numCores * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCores * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 2 * numCores;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCores;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -86,11 +88,14 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE + maxGDLItr * m_tGDL) * (numPass - 1)) + (activateMS + m_tPRE + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = ((m_eACT + m_ePRE) * 2 + (maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCores * (numPass - 1);
-      mjEnergy += ((m_eACT + m_ePRE) * 2 + (minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCores;
-      mjEnergy += (m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks)) + (m_eAP * numCores + m_eR * numBankPerChip * m_numRanks);
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 2 * numCores * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCores * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 2 * numCores;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCores;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks) + m_eR * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjActPre += m_eAP * numCores;
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -109,11 +114,14 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE + maxGDLItr * m_tGDL) * (numPass - 1)) + (activateMS + m_tPRE + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (((m_eACT + m_ePRE) * 2) +  (maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCores * (numPass - 1);
-      mjEnergy += (((m_eACT + m_ePRE) * 2) + (minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCores;
-      mjEnergy += (m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks)) + (m_eAP * numCores + m_eR * numBankPerChip * m_numRanks);
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 2 * numCores * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCores * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 2 * numCores;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCores;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks) + m_eR * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjActPre += m_eAP * numCores;
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -124,11 +132,13 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE + maxGDLItr * m_tGDL) * (numPass - 1)) + (activateMS + m_tPRE + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (((m_eACT + m_ePRE) * 2) +  (maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCores * (numPass - 1);
-      mjEnergy += (((m_eACT + m_ePRE) * 2) + (minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCores;
-      mjEnergy += (m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 2 * numCores * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCores * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 2 * numCores;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCores;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -150,11 +160,13 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE + maxGDLItr * m_tGDL) * (numPass - 1)) + (activateMS + m_tPRE + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = ((m_eAP * 2) +  (maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCores * (numPass - 1);
-      mjEnergy += ((m_eAP * 2) + (minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCores;
-      mjEnergy += (m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += (m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = m_eAP * 2 * numCores * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCores * (numPass - 1);
+      mjEnergy.m_mjActPre += m_eAP * 2 * numCores;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCores;
+      mjEnergy.m_mjGDL += m_eR * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eR * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjGDL += m_eW * maxGDLItr * (numPass-1) * numBankPerChip * m_numRanks + (m_eW * minGDLItr * numBankPerChip * m_numRanks);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -163,7 +175,9 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
       break;
   }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, 2ULL * numPass);
+  return perf;
 }
 
 //! @brief  Perf energy model of bank-level PIM for func2
@@ -171,7 +185,7 @@ pimeval::perfEnergy
 pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& obj, const pimObjInfo& objSrc2, const pimObjInfo& objDest) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -200,11 +214,13 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE) + (maxGDLItr * m_tGDL)) * (numPass - 1) + ((activateMS + m_tPRE) + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (((m_eACT + m_ePRE) * 3) + (maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCoresUsed * (numPass - 1);
-      mjEnergy += (((m_eACT + m_ePRE) * 3) + (minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCoresUsed;
-      mjEnergy += ((m_eR * 2 * maxGDLItr * (numPass-1)) + (m_eR * 2 * minGDLItr)) * numBankPerChip * m_numRanks;
-      mjEnergy += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 3 * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 3 * numCoresUsed;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCoresUsed;
+      mjEnergy.m_mjGDL += ((m_eR * 2 * maxGDLItr * (numPass-1)) + (m_eR * 2 * minGDLItr)) * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjGDL += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -228,11 +244,14 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE) + (maxGDLItr * m_tGDL)) * (numPass - 1) + ((activateMS + m_tPRE) + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * 2 * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement * 2);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (((m_eACT + m_ePRE) * 3) + (maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * 2)) * numCoresUsed * (numPass - 1);
-      mjEnergy += (((m_eACT + m_ePRE) * 3) + (minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * 2)) * numCoresUsed;
-      mjEnergy += ((m_eR * 2 * maxGDLItr * (numPass-1)) + (m_eR * 2 * minGDLItr)) * numBankPerChip * m_numRanks + (m_eAP * numCoresUsed + m_eR * numBankPerChip * m_numRanks);
-      mjEnergy += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 3 * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * 2 * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 3 * numCoresUsed;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * 2 * numCoresUsed;
+      mjEnergy.m_mjGDL += ((m_eR * 2 * maxGDLItr * (numPass-1)) + (m_eR * 2 * minGDLItr)) * numBankPerChip * m_numRanks + m_eR * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjActPre += m_eAP * numCoresUsed;
+      mjEnergy.m_mjGDL += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements() * 2;
       break;
     }
@@ -254,11 +273,13 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       msWrite = ((m_tACT + m_tPRE) + (maxGDLItr * m_tGDL)) * (numPass - 1) + ((activateMS + m_tPRE) + (minGDLItr * m_tGDL));
       msCompute = (maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement);
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (((m_eACT + m_ePRE) * 3) + (maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCoresUsed * (numPass - 1);
-      mjEnergy += (((m_eACT + m_ePRE) * 3) + (minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement)) * numCoresUsed;
-      mjEnergy += ((m_eR * 2 * maxGDLItr * (numPass-1)) + (m_eR * 2 * minGDLItr)) * numBankPerChip * m_numRanks;
-      mjEnergy += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 3 * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCoresUsed * (numPass - 1);
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * 3 * numCoresUsed;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCoresUsed;
+      mjEnergy.m_mjGDL += ((m_eR * 2 * maxGDLItr * (numPass-1)) + (m_eR * 2 * minGDLItr)) * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjGDL += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -266,7 +287,9 @@ pimPerfEnergyBankLevel::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjIn
       printf("PIM-Warning: Perf energy model not available for PIM command %s\n", pimCmd::getName(cmdType, "").c_str());
       break;
   }
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, 3ULL * numPass);
+  return perf;
 }
 
 //! @brief  Perf energy model of bank-level PIM for reduction sum
@@ -274,7 +297,7 @@ pimeval::perfEnergy
 pimPerfEnergyBankLevel::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -307,11 +330,13 @@ pimPerfEnergyBankLevel::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimO
       msRuntime = msRead + msWrite + msCompute;
 
       // Refer to fulcrum documentation
-      mjEnergy = ((m_eACT + m_ePRE) + (maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * (numPass - 1) * numCore;
-      mjEnergy += ((m_eACT + m_ePRE) + (minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCore;
-      mjEnergy += aggregateMs * cpuTDP;
-      mjEnergy += ((m_eR * maxGDLItr * (numPass-1)) + (m_eR * minGDLItr)) * numBankPerChip;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * (numPass - 1) * numCore;
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * (numPass - 1) * numCore;
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * numCore;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCore;
+      mjEnergy.m_mjHost += aggregateMs * cpuTDP;
+      mjEnergy.m_mjGDL += ((m_eR * maxGDLItr * (numPass-1)) + (m_eR * minGDLItr)) * numBankPerChip;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -320,7 +345,9 @@ pimPerfEnergyBankLevel::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimO
       break;
     }
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, numPass);
+  return perf;
 }
 
 //! @brief  Perf energy model of bank-level PIM for broadcast
@@ -328,7 +355,7 @@ pimeval::perfEnergy
 pimPerfEnergyBankLevel::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -346,10 +373,12 @@ pimPerfEnergyBankLevel::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimO
   msWrite = ((m_tACT + m_tPRE) + (maxGDLItr * m_tGDL)) * (numPass - 1) + ((activateMS + m_tPRE) + (minGDLItr * m_tGDL));
 
   msRuntime = msRead + msWrite + msCompute;
-  mjEnergy = (m_eACT + m_ePRE) * numPass * numCore;
-  mjEnergy += (m_eW * maxGDLItr * (numPass-1) + m_eW * minGDLItr) * numBankPerChip;
-  mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * numPass * numCore;
+  mjEnergy.m_mjGDL += (m_eW * maxGDLItr * (numPass-1) + m_eW * minGDLItr) * numBankPerChip;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, numPass);
+  return perf;
 }
 
 // TODO: This needs to be revisited
@@ -358,16 +387,14 @@ pimeval::perfEnergy
 pimPerfEnergyBankLevel::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::ACTUAL);
-  unsigned numRegions = obj.getRegions().size();
   uint64_t totalOp = 0;
-  // boundary handling - assume two times copying between device and host for boundary elements
-  pimeval::perfEnergy perfEnergyBT = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numRegions * bitsPerElement / 8);
+  // boundary elements across regions are modeled separately by getPerfEnergyForRotateBoundary
 
   // rotate within subarray:
   // For every bit: Read row to SA; move SA to R1; Shift R1 by N steps; Move R1 to SA; Write SA to row
@@ -376,12 +403,13 @@ pimPerfEnergyBankLevel::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjI
   // TODO: perf per watt
   msRuntime = (m_tR + (bitsPerElement + 2) * m_tL + m_tW); // for one pass
   msRuntime *= numPass;
-  mjEnergy = (m_eAP + (bitsPerElement + 2) * m_eL) * numPass;
-  msRuntime += 2 * perfEnergyBT.m_msRuntime;
-  mjEnergy += 2 * perfEnergyBT.m_mjEnergy;
+  mjEnergy.m_mjActPre = m_eAP * numPass;
+  mjEnergy.m_mjLogic = (bitsPerElement + 2) * m_eL * numPass;
   printf("PIM-Warning: Perf energy model is not precise for PIM command %s\n", pimCmd::getName(cmdType, "").c_str());
 
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, 2ULL * numPass);
+  return perf;
 }
 
 //! @brief  Perf energy model of bank-level PIM for prefix-sum
@@ -389,7 +417,7 @@ pimeval::perfEnergy
 pimPerfEnergyBankLevel::getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -445,12 +473,16 @@ pimPerfEnergyBankLevel::getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimO
       msRuntime = msRead + msWrite + msCompute;
 
       // Refer to fulcrum documentation
-      mjEnergy = ((m_eACT + m_ePRE) + (maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * (numPass - 1) * numCore * 2;
-      mjEnergy += ((m_eACT + m_ePRE) + (minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement)) * numCore * 2;
-      mjEnergy += aggregateMs * cpuTDP + ((obj.getNumCoresUsed() * 1.0 / m_numChipsPerRank) * ((2 * m_eAP)  + m_eR + m_eW));
-      mjEnergy += ((m_eR * maxGDLItr * (numPass-1)) + (m_eR * minGDLItr)) * numBankPerChip * m_numRanks * 2;
-      mjEnergy += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks * 2;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * (numPass - 1) * numCore * 2;
+      mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * (numPass - 1) * numCore * 2;
+      mjEnergy.m_mjActPre += (m_eACT + m_ePRE) * numCore * 2;
+      mjEnergy.m_mjLogic += minElementPerRegion * m_blimpArithmeticEnergy * numberOfOperationPerElement * numCore * 2;
+      mjEnergy.m_mjHost += aggregateMs * cpuTDP;
+      mjEnergy.m_mjActPre += (obj.getNumCoresUsed() * 1.0 / m_numChipsPerRank) * 2 * m_eAP;
+      mjEnergy.m_mjGDL += (obj.getNumCoresUsed() * 1.0 / m_numChipsPerRank) * (m_eR + m_eW);
+      mjEnergy.m_mjGDL += ((m_eR * maxGDLItr * (numPass-1)) + (m_eR * minGDLItr)) * numBankPerChip * m_numRanks * 2;
+      mjEnergy.m_mjGDL += ((m_eW * maxGDLItr * (numPass-1)) + (m_eW * minGDLItr)) * numBankPerChip * m_numRanks * 2;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements() * 2;
       break;
     }
@@ -458,5 +490,204 @@ pimPerfEnergyBankLevel::getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimO
       printf("PIM-Warning: Unsupported reduction command for bank-level PIM: %s\n", pimCmd::getName(cmdType, "").c_str());
       break;
     }
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
-}
\ No newline at end of file
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, 2ULL * numPass);
+  return perf;
+}
+
+//! @brief  Perf energy model of bank-level PIM for batched AND-popcount
+//! Each bank streams the words of both operand rows through its ALU, which ANDs and popcounts them
+//! and accumulates one count per pair in registers. Nothing is written back to DRAM.
+pimeval::perfEnergy
+pimPerfEnergyBankLevel::getPerfEnergyForAndPopCount(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t numWords) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
+  unsigned numCore = obj.getNumCoresUsed();
+  unsigned numBankPerChip = numCore / m_numChipsPerRank;
+  uint64_t numPass = getNumPassForWords(obj, numWords);
+  double numberOfOperationPerElement = ((double)bitsPerElement / m_blimpCoreBitWidth);
+  unsigned gdlItr = std::ceil(maxElementsPerRegion * bitsPerElement * 1.0 / m_GDLWidth);
+
+  // AND, popcount and accumulate per word
+  double msRead = ((2 * (m_tACT + m_tPRE)) + (2 * gdlItr * m_tGDL)) * numPass;
+  double msWrite = 0.0;
+  double msCompute = maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * 3 * numPass;
+  double msRuntime = msRead + msWrite + msCompute;
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * 2 * numCore * numPass;
+  mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * 3 * numCore * numPass;
+  mjEnergy.m_mjGDL = m_eR * 2 * gdlItr * numPass * numBankPerChip * m_numRanks;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, numWords * 3);
+  applyActLimits(perf, 2ULL * numPass);
+  return perf;
+}
+
+//! @brief  Perf energy model of bank-level PIM for gather/scatter
+//! In-bank: each bank streams its rows of the sequentially accessed objects (index and dest for gather,
+//! index and src for scatter) and issues one random column access per element to the indexed object,
+//! which costs a row activation and precharge unless it hits the open row. Indices are assumed to be
+//! uniformly distributed, so small indexed objects mostly hit open rows, and the indexed elements held
+//! by other banks are relayed over the memory channel.
+pimeval::perfEnergy
+pimPerfEnergyBankLevel::getPerfEnergyForGatherScatter(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objIndex, const pimObjInfo& objDest) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  const pimObjInfo& objSeq = (cmdType == PimCmdEnum::GATHER ? objDest : objSrc);
+  const pimObjInfo& objIndexed = (cmdType == PimCmdEnum::GATHER ? objSrc : objDest);
+  unsigned bitsPerElement = objDest.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned bitsPerIndex = objIndex.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned numPass = std::max(objSeq.getMaxNumRegionsPerCore(), 1u);
+  unsigned maxElementsPerRegion = objSeq.getMaxElementsPerRegion();
+  unsigned numCore = objSeq.getNumCoresUsed();
+  unsigned numBankPerChip = numCore / m_numChipsPerRank;
+  uint64_t numElements = objIndex.getNumElements();
+  unsigned seqGdlItr = std::ceil(maxElementsPerRegion * (bitsPerElement + bitsPerIndex) * 1.0 / m_GDLWidth);
+  unsigned numRandomAccess = (cmdType == PimCmdEnum::SCATTER_ADD ? 2 : 1); // read-modify-write for scatter-add
+  double rowMissRate = 1.0 - 1.0 / std::max(objIndexed.getMaxNumRegionsPerCore(), 1u);
+
+  // stream index and sequential operand rows, plus one random row access per element
+  double msRead = (2 * (m_tACT + m_tPRE) + seqGdlItr * m_tGDL) * numPass;
+  double msWrite = 0.0;
+  double msRandom = ((m_tACT + m_tPRE) * rowMissRate + numRandomAccess * m_tGDL) * maxElementsPerRegion * numPass;
+  if (cmdType == PimCmdEnum::GATHER) {
+    msRead += msRandom;
+  } else {
+    msWrite += msRandom;
+  }
+  double msCompute = (cmdType == PimCmdEnum::SCATTER_ADD ? maxElementsPerRegion * m_blimpLatency * numPass : 0.0);
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * (2 + maxElementsPerRegion * rowMissRate) * numCore * numPass;
+  mjEnergy.m_mjGDL = (m_eR + m_eW) * (seqGdlItr + numRandomAccess * maxElementsPerRegion) * numPass * numBankPerChip * m_numRanks;
+  if (cmdType == PimCmdEnum::SCATTER_ADD) {
+    mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpArithmeticEnergy * numCore * numPass;
+  }
+
+  // elements held by other banks
+  uint64_t numRemoteBytes = (numCore > 1 ? (numElements * (numCore - 1) / numCore) * bitsPerElement / 8 : 0);
+  pimeval::perfEnergy perfRead = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numRemoteBytes);
+  pimeval::perfEnergy perfWrite = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, numRemoteBytes);
+  msRead += perfRead.m_msRuntime;
+  msWrite += perfWrite.m_msRuntime;
+  mjEnergy.m_mjGDL += perfRead.m_mjBreakdown.m_mjGDL + perfWrite.m_mjBreakdown.m_mjGDL;
+
+  double msRuntime = msRead + msWrite + msCompute;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, numElements);
+  applyActLimits(perf, static_cast<uint64_t>((2 + maxElementsPerRegion * rowMissRate) * numPass));
+  return perf;
+}
+
+//! @brief  Perf energy model of bank-level PIM for stream compaction
+//! In-bank: each bank streams its src and condition rows through the ALU, which appends selected elements
+//! to a row-sized output register and writes it back when full. Selected elements are assumed to be spread
+//! uniformly over all banks. Per-bank counts are combined by the host, and the selected elements whose
+//! dense position is in another bank are relayed over the memory channel.
+pimeval::perfEnergy
+pimPerfEnergyBankLevel::getPerfEnergyForCompact(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objCond, const pimObjInfo& objDest, uint64_t numSelected) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned bitsPerElement = objSrc.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned numPass = std::max(objSrc.getMaxNumRegionsPerCore(), 1u);
+  unsigned maxElementsPerRegion = objSrc.getMaxElementsPerRegion();
+  unsigned numCore = std::max(objSrc.getNumCoresUsed(), 1u);
+  unsigned numBankPerChip = numCore / m_numChipsPerRank;
+  double numberOfOperationPerElement = ((double)bitsPerElement / m_blimpCoreBitWidth);
+  unsigned readGdlItr = std::ceil(maxElementsPerRegion * (bitsPerElement + 1) * 1.0 / m_GDLWidth);
+  uint64_t numSelectedPerCore = (numSelected + numCore - 1) / numCore;
+  uint64_t numWriteRows = (numSelectedPerCore + maxElementsPerRegion - 1) / std::max(maxElementsPerRegion, 1u);
+  uint64_t writeGdlItr = (numSelectedPerCore * bitsPerElement + m_GDLWidth - 1) / m_GDLWidth;
+
+  double msRead = (2 * (m_tACT + m_tPRE) + readGdlItr * m_tGDL) * numPass;
+  double msWrite = numWriteRows * (m_tACT + m_tPRE) + writeGdlItr * m_tGDL;
+  double msCompute = maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * numPass;
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * (2 * numPass + numWriteRows) * numCore;
+  mjEnergy.m_mjLogic = maxElementsPerRegion * m_blimpLogicalEnergy * numberOfOperationPerElement * numCore * numPass;
+  mjEnergy.m_mjGDL = (m_eR * readGdlItr * numPass + m_eW * writeGdlItr) * numBankPerChip * m_numRanks;
+
+  // per-bank counts to host, and selected elements placed in other banks
+  uint64_t numRemoteBytes = (numSelected * (numCore - 1) / numCore) * bitsPerElement / 8;
+  pimeval::perfEnergy perfRead = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numRemoteBytes + numCore * sizeof(uint64_t));
+  pimeval::perfEnergy perfWrite = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, numRemoteBytes);
+  msRead += perfRead.m_msRuntime;
+  msWrite += perfWrite.m_msRuntime;
+  mjEnergy.m_mjGDL += perfRead.m_mjBreakdown.m_mjGDL + perfWrite.m_mjBreakdown.m_mjGDL;
+
+  double msRuntime = msRead + msWrite + msCompute;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, objSrc.getNumElements());
+  applyActLimits(perf, 2ULL * numPass + numWriteRows);
+  return perf;
+}
+
+//! @brief  Perf energy model of bank-level PIM for top-k selection
+//! Bank-local partial sort: each bank streams its rows through the ALU, which keeps a k-entry heap in
+//! registers with one compare per element and log2(k) compares per heap update. Heap updates are assumed
+//! to be rare after the heap fills up. The k candidates of every bank are merged on host.
+pimeval::perfEnergy
+pimPerfEnergyBankLevel::getPerfEnergyForTopK(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t k) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned numPass = std::max(obj.getMaxNumRegionsPerCore(), 1u);
+  unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
+  unsigned numCore = obj.getNumCoresUsed();
+  unsigned numBankPerChip = numCore / m_numChipsPerRank;
+  double numberOfOperationPerElement = ((double)bitsPerElement / m_blimpCoreBitWidth);
+  unsigned gdlItr = std::ceil(maxElementsPerRegion * bitsPerElement * 1.0 / m_GDLWidth);
+  uint64_t numElementsPerCore = static_cast<uint64_t>(maxElementsPerRegion) * numPass;
+  uint64_t numCandidatesPerCore = std::min<uint64_t>(k, numElementsPerCore);
+  double numHeapOps = numCandidatesPerCore * std::max(std::log2(static_cast<double>(numCandidatesPerCore)), 1.0);
+
+  double msRead = ((m_tACT + m_tPRE) + gdlItr * m_tGDL) * numPass;
+  double msWrite = 0.0;
+  double msCompute = (numElementsPerCore + numHeapOps) * m_blimpLatency * numberOfOperationPerElement;
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * numCore * numPass;
+  mjEnergy.m_mjLogic = (numElementsPerCore + numHeapOps) * m_blimpLogicalEnergy * numberOfOperationPerElement * numCore;
+  mjEnergy.m_mjGDL = m_eR * gdlItr * numPass * numBankPerChip * m_numRanks;
+
+  pimeval::perfEnergy perfResults = getPerfEnergyForTopKResults(obj, numCandidatesPerCore * numCore);
+  msRead += perfResults.m_msRuntime;
+  mjEnergy.m_mjGDL += perfResults.m_mjBreakdown.m_mjGDL;
+
+  double msRuntime = msRead + msWrite + msCompute;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, obj.getNumElements());
+  applyActLimits(perf, numPass);
+  return perf;
+}
+
+//! @brief  Perf energy model of bank-level PIM for GEMV/GEMM
+//! Fused column MAC: in each pass, BLIMP keeps the partial sums of a dest region in its buffer while the
+//! matching row of every matrix column is activated and read over the GDL. Dest is written once per pass.
+pimeval::perfEnergy
+pimPerfEnergyBankLevel::getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned numPass = objDest.getMaxNumRegionsPerCore();
+  unsigned bitsPerElement = objDest.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned numCoresUsed = objDest.isLoadBalanced() ? objDest.getNumCoreAvailable() : objDest.getNumCoresUsed();
+  unsigned maxElementsPerRegion = objDest.getMaxElementsPerRegion();
+  double numberOfOperationPerElement = ((double)bitsPerElement / m_blimpCoreBitWidth);
+  unsigned minElementPerRegion = objDest.isLoadBalanced() ? (std::ceil(objDest.getNumElements() * 1.0 / numCoresUsed) - (maxElementsPerRegion * (numPass - 1))) : maxElementsPerRegion;
+  unsigned maxGDLItr = std::ceil(maxElementsPerRegion * bitsPerElement * 1.0 / m_GDLWidth);
+  unsigned minGDLItr = std::ceil(minElementPerRegion * bitsPerElement * 1.0 / m_GDLWidth);
+  unsigned numBankPerChip = numCoresUsed / m_numChipsPerRank;
+  double activateMS = minGDLItr * m_tGDL < m_tRAS * m_tCK ? m_tRAS * m_tCK : m_tACT; // Use tRAS if GDL is less than tRAS
+
+  double msRowAccess = ((m_tACT + m_tPRE) + (maxGDLItr * m_tGDL)) * (numPass - 1) + ((activateMS + m_tPRE) + (minGDLItr * m_tGDL));
+  double msRead = msRowAccess * numCols;
+  double msWrite = msRowAccess;
+  double msCompute = numCols * ((maxElementsPerRegion * m_blimpLatency * numberOfOperationPerElement * 2 * (numPass - 1)) + (minElementPerRegion * m_blimpLatency * numberOfOperationPerElement * 2));
+  double msRuntime = msRead + msWrite + msCompute;
+  uint64_t numGDLItr = static_cast<uint64_t>(maxGDLItr) * (numPass - 1) + minGDLItr;
+  mjEnergy.m_mjActPre = (m_eACT + m_ePRE) * (numCols + 1) * numCoresUsed * numPass;
+  mjEnergy.m_mjLogic = numCols * m_blimpArithmeticEnergy * numberOfOperationPerElement * 2 * numCoresUsed * (maxElementsPerRegion * (numPass - 1) + minElementPerRegion);
+  mjEnergy.m_mjGDL = (m_eR * numCols + m_eW) * numGDLItr * numBankPerChip * m_numRanks;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  uint64_t totalOp = objDest.getNumElements() * numCols * 2;
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, (numCols + 1) * numPass);
+  return perf;
+}
@@ -28,6 +28,12 @@ public:
   virtual pimeval::perfEnergy getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
   virtual pimeval::perfEnergy getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
   virtual pimeval::perfEnergy getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForBatchedReduction(const std::vector<pimeval::perfEnergy>& perfs) const override { return getPerfEnergyForOverlappedReductions(perfs); }
+  virtual pimeval::perfEnergy getPerfEnergyForAndPopCount(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t numWords) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForGatherScatter(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objIndex, const pimObjInfo& objDest) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForCompact(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objCond, const pimObjInfo& objDest, uint64_t numSelected) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForTopK(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t k) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const override;
 
 protected:
   double m_blimpLatency = m_tCCD_L * m_tCK;
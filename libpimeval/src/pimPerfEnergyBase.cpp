@@ -13,6 +13,8 @@
 #include "pimPerfEnergyAim.h"
 #include <cstdint>
 #include <cstdio>
+#include <algorithm>
+#include <cmath>
 
 
 //! @brief  A factory function to create perf energy model for sim target
@@ -49,6 +51,7 @@ pimPerfEnergyFactory::createPerfEnergyModel(const pimPerfEnergyModelParams& para
 pimPerfEnergyBase::pimPerfEnergyBase(const pimPerfEnergyModelParams& params)
   : m_simTarget(params.getSimTarget()),
     m_numRanks(params.getNumRanks()),
+    m_numBankPerRank(params.getNumBankPerRank()),
     m_paramsDram(params.getParamsDram())
 {
   m_tR = m_paramsDram.getNsRowRead() / m_nano_to_milli;
@@ -74,7 +77,283 @@ pimPerfEnergyBase::pimPerfEnergyBase(const pimPerfEnergyModelParams& params)
   m_tRCD = m_paramsDram.gettRCD();
   m_tRP = m_paramsDram.gettRP();
   m_tCAS = m_paramsDram.getNsTCAS() / m_nano_to_milli; // Convert ns to ms
+  m_tLisaHop = m_paramsDram.getNsLisaHop() / m_nano_to_milli; // Convert ns to ms
   m_tRAS = m_paramsDram.gettRAS();
+
+  m_tRFC = m_paramsDram.getNsRFC() / m_nano_to_milli;
+  m_tREFI = m_paramsDram.getNsREFI() / m_nano_to_milli;
+  m_tRFCb = m_paramsDram.getNsRFCb() / m_nano_to_milli;
+  m_tREFIb = m_paramsDram.getNsREFIb() / m_nano_to_milli;
+  m_eRefresh = m_paramsDram.getPjRefresh() / m_pico_to_milli; // Convert pJ to mJ
+  m_eRefreshBank = m_paramsDram.getPjRefreshBank() / m_pico_to_milli; // Convert pJ to mJ
+
+  // A lockstep row operation activates all banks of a chip. Staggered by tRRD and at most four per tFAW,
+  // the last bank starts its activation late, which extends the row operation.
+  unsigned numBankPerChip = params.getNumBankPerRank() / std::max(m_numChipsPerRank, 1);
+  m_numActPerChip = std::max(numBankPerChip, 1u);
+  double tRRD = m_paramsDram.getNsRRD() / m_nano_to_milli;
+  double tFAW = m_paramsDram.getNsFAW() / m_nano_to_milli;
+  m_tActLimit = std::max((m_numActPerChip - 1) * tRRD, ((m_numActPerChip - 1) / 4) * tFAW);
+
+  std::string policy = m_paramsDram.getRefreshPolicy();
+  if (policy == "RANK_LEVEL_SIMULTANEOUS") {
+    m_refreshPolicy = refreshPolicy::RANK_LEVEL_SIMULTANEOUS;
+  } else if (policy == "RANK_LEVEL_STAGGERED") {
+    m_refreshPolicy = refreshPolicy::RANK_LEVEL_STAGGERED;
+  } else if (policy == "BANK_LEVEL_STAGGERED") {
+    m_refreshPolicy = refreshPolicy::BANK_LEVEL_STAGGERED;
+    if (m_tRFCb <= 0.0 || m_tREFIb <= 0.0) {
+      printf("PIM-Warning: Per-bank refresh timing is not available. Use RANK_LEVEL_STAGGERED refresh policy\n");
+      m_refreshPolicy = refreshPolicy::RANK_LEVEL_STAGGERED;
+    }
+  } else {
+    printf("PIM-Warning: Unknown DRAM refresh policy '%s'. Use RANK_LEVEL_STAGGERED refresh policy\n", policy.c_str());
+    m_refreshPolicy = refreshPolicy::RANK_LEVEL_STAGGERED;
+  }
+}
+
+//! @brief  pimPerfEnergyBase::cacheKey ctor
+pimPerfEnergyBase::cacheKey::cacheKey(PimCmdEnum cmdType, uint64_t extra, const pimObjInfo* obj1, const pimObjInfo* obj2, const pimObjInfo* obj3)
+{
+  m_vals[0] = static_cast<uint64_t>(cmdType);
+  m_vals[1] = extra;
+  const pimObjInfo* objs[3] = { obj1, obj2, obj3 };
+  size_t idx = 2;
+  for (const pimObjInfo* obj : objs) {
+    if (obj) {
+      m_vals[idx] = (static_cast<uint64_t>(obj->getDataType()) << 32) | obj->getBitsPerElement(PimBitWidth::PADDED);
+      m_vals[idx + 1] = obj->getNumElements();
+      m_vals[idx + 2] = (static_cast<uint64_t>(obj->getRegions().size()) << 32) | obj->getMaxNumRegionsPerCore();
+      m_vals[idx + 3] = (static_cast<uint64_t>(obj->getNumCoresUsed()) << 32) | obj->getNumCoreAvailable();
+      m_vals[idx + 4] = (static_cast<uint64_t>(obj->getMaxElementsPerRegion()) << 8) | (static_cast<uint64_t>(obj->getAllocType()) << 1) | (obj->isLoadBalanced() ? 1 : 0);
+    }
+    idx += NUM_VALS_PER_OBJ;
+  }
+}
+
+//! @brief  Hash function of pimPerfEnergyBase::cacheKey (FNV-1a over all values)
+size_t
+pimPerfEnergyBase::cacheKeyHash::operator()(const cacheKey& key) const
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (uint64_t val : key.m_vals) {
+    hash = (hash ^ val) * 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
+
+//! @brief  Look up a memoized perf energy result, or evaluate and insert it on a miss
+template <typename Eval>
+pimeval::perfEnergy
+pimPerfEnergyBase::lookupCache(const cacheKey& key, Eval eval) const
+{
+  auto it = m_cache.find(key);
+  if (it != m_cache.end()) {
+    m_numCacheHits++;
+    return it->second;
+  }
+  m_numCacheMisses++;
+  return m_cache.emplace(key, eval()).first->second;
+}
+
+//! @brief  Memoized perf energy model for func1
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objDest) const
+{
+  return lookupCache(cacheKey(cmdType, 0, &objSrc, &objDest),
+                     [&]() { return getPerfEnergyForFunc1(cmdType, objSrc, objDest); });
+}
+
+//! @brief  Memoized perf energy model for func2
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& objSrc1, const pimObjInfo& objSrc2, const pimObjInfo& objDest) const
+{
+  return lookupCache(cacheKey(cmdType, 0, &objSrc1, &objSrc2, &objDest),
+                     [&]() { return getPerfEnergyForFunc2(cmdType, objSrc1, objSrc2, objDest); });
+}
+
+//! @brief  Memoized perf energy model for reduction
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForReduction(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const
+{
+  return lookupCache(cacheKey(cmdType, numPass, &obj),
+                     [&]() { return getPerfEnergyForReduction(cmdType, obj, numPass); });
+}
+
+//! @brief  Memoized perf energy model for broadcast
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const
+{
+  return lookupCache(cacheKey(cmdType, 0, &obj),
+                     [&]() { return getPerfEnergyForBroadcast(cmdType, obj); });
+}
+
+//! @brief  Memoized perf energy model for rotate
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const
+{
+  return lookupCache(cacheKey(cmdType, 0, &obj),
+                     [&]() { return getPerfEnergyForRotate(cmdType, obj); });
+}
+
+//! @brief  Memoized perf energy model for prefix sum
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const
+{
+  return lookupCache(cacheKey(cmdType, 0, &obj),
+                     [&]() { return getPerfEnergyForPrefixSum(cmdType, obj); });
+}
+
+//! @brief  Memoized perf energy model for MAC
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForMac(PimCmdEnum cmdType, const pimObjInfo& obj) const
+{
+  return lookupCache(cacheKey(cmdType, 0, &obj),
+                     [&]() { return getPerfEnergyForMac(cmdType, obj); });
+}
+
+//! @brief  Memoized perf energy model for GEMV/GEMM
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const
+{
+  return lookupCache(cacheKey(cmdType, numCols, &objMat, &objDest),
+                     [&]() { return getPerfEnergyForGemv(cmdType, objMat, objDest, numCols); });
+}
+
+//! @brief  Memoized perf energy model for batched AND-popcount
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForAndPopCount(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t numWords) const
+{
+  return lookupCache(cacheKey(cmdType, numWords, &obj),
+                     [&]() { return getPerfEnergyForAndPopCount(cmdType, obj, numWords); });
+}
+
+//! @brief  Memoized perf energy model for gather/scatter
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForGatherScatter(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objIndex, const pimObjInfo& objDest) const
+{
+  return lookupCache(cacheKey(cmdType, 0, &objSrc, &objIndex, &objDest),
+                     [&]() { return getPerfEnergyForGatherScatter(cmdType, objSrc, objIndex, objDest); });
+}
+
+//! @brief  Memoized perf energy model for top-k selection
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForTopK(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t k) const
+{
+  return lookupCache(cacheKey(cmdType, k, &obj),
+                     [&]() { return getPerfEnergyForTopK(cmdType, obj, k); });
+}
+
+//! @brief  Memoized perf energy model for elementwise math approximations
+pimeval::perfEnergy
+pimPerfEnergyBase::getCachedPerfEnergyForMath(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objDest, PimMathPrecision precision, unsigned numFracBits) const
+{
+  return lookupCache(cacheKey(cmdType, (static_cast<uint64_t>(numFracBits) << 32) | precision, &objSrc, &objDest),
+                     [&]() { return getPerfEnergyForMath(cmdType, objSrc, objDest, precision, numFracBits); });
+}
+
+//! @brief  Perf energy model of reading top-k candidates, i.e., values and 32-bit indices, back to host
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForTopKResults(const pimObjInfo& obj, uint64_t numCandidates) const
+{
+  uint64_t numBytes = (numCandidates * (obj.getBitsPerElement(PimBitWidth::ACTUAL) + 32) + 7) / 8;
+  return getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numBytes);
+}
+
+//! @brief  Get number of passes for processing a number of words laid out like a PIM object across all its cores
+uint64_t
+pimPerfEnergyBase::getNumPassForWords(const pimObjInfo& obj, uint64_t numWords) const
+{
+  uint64_t numWordsPerPass = static_cast<uint64_t>(std::max(obj.getNumCoresUsed(), 1u)) * std::max(obj.getMaxElementsPerRegion(), 1u);
+  return std::max<uint64_t>((numWords + numWordsPerPass - 1) / numWordsPerPass, 1);
+}
+
+//! @brief  Get number of lockstep row activations of a command from its row read and write latency
+uint64_t
+pimPerfEnergyBase::getNumRowActRounds(const pimeval::perfEnergy& perf) const
+{
+  double numRounds = 0.0;
+  if (m_tR > 0.0) {
+    numRounds += perf.m_msRead / m_tR;
+  }
+  if (m_tW > 0.0) {
+    numRounds += perf.m_msWrite / m_tW;
+  }
+  return static_cast<uint64_t>(std::llround(numRounds));
+}
+
+//! @brief  Throttle lockstep row activations of a command by tRRD and tFAW
+void
+pimPerfEnergyBase::applyActLimits(pimeval::perfEnergy& perf, uint64_t numActRounds) const
+{
+  if (m_tActLimit <= 0.0 || numActRounds == 0) {
+    return;
+  }
+  double msActLimit = numActRounds * m_tActLimit;
+  double mjBackground = getMjBackground(msActLimit);
+  perf.m_msActLimit += msActLimit;
+  perf.m_msRuntime += msActLimit;
+  perf.m_mjBreakdown.m_mjBackground += mjBackground;
+  perf.m_mjEnergy += mjBackground;
+}
+
+//! @brief  Convert DRAM refresh policy to string
+std::string
+pimPerfEnergyBase::refreshPolicyToStr(refreshPolicy policy)
+{
+  switch (policy) {
+  case refreshPolicy::RANK_LEVEL_SIMULTANEOUS: return "RANK_LEVEL_SIMULTANEOUS";
+  case refreshPolicy::RANK_LEVEL_STAGGERED: return "RANK_LEVEL_STAGGERED";
+  case refreshPolicy::BANK_LEVEL_STAGGERED: return "BANK_LEVEL_STAGGERED";
+  }
+  return "Unknown";
+}
+
+//! @brief  Perf energy model of DRAM refresh over a PIM kernel
+//! PIM commands run in lockstep across all banks and ranks, and every PIM API waits for all cores to finish.
+//! - RANK_LEVEL_SIMULTANEOUS: all ranks refresh together, stalling the kernel for tRFC every tREFI
+//! - RANK_LEVEL_STAGGERED: rank refreshes are spread over tREFI. A short API sees refreshes of multiple ranks
+//!   back to back, while ranks drift independently within a long API and only pay the skew at the API boundary.
+//!   The effective number of stalling ranks per tREFI is min(numRanks, 1 + tREFI / average API runtime).
+//! - BANK_LEVEL_STAGGERED: one bank per chip refreshes for tRFCb every tREFIb, stalling the lockstep kernel
+//! Refresh energy is charged for all refresh commands over the stretched runtime, together with the
+//! background energy during stalls.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForRefresh(double msRuntime, uint64_t numApiCalls) const
+{
+  double msStall = 0.0;
+  double mjRefresh = 0.0;
+  if (msRuntime <= 0.0 || m_tREFI <= 0.0) {
+    return pimeval::perfEnergy();
+  }
+  switch (m_refreshPolicy) {
+  case refreshPolicy::RANK_LEVEL_SIMULTANEOUS:
+  {
+    msStall = msRuntime * m_tRFC / m_tREFI;
+    break;
+  }
+  case refreshPolicy::RANK_LEVEL_STAGGERED:
+  {
+    double msApiRuntime = msRuntime / (numApiCalls > 0 ? numApiCalls : 1);
+    double numStallingRanks = std::min<double>(m_numRanks, 1.0 + m_tREFI / msApiRuntime);
+    msStall = msRuntime * numStallingRanks * m_tRFC / m_tREFI;
+    break;
+  }
+  case refreshPolicy::BANK_LEVEL_STAGGERED:
+  {
+    msStall = msRuntime * m_tRFCb / m_tREFIb;
+    break;
+  }
+  }
+
+  double msTotal = msRuntime + msStall;
+  if (m_refreshPolicy == refreshPolicy::BANK_LEVEL_STAGGERED) {
+    mjRefresh = (msTotal / m_tREFIb) * m_eRefreshBank * m_numChipsPerRank * m_numRanks;
+  } else {
+    mjRefresh = (msTotal / m_tREFI) * m_eRefresh * m_numChipsPerRank * m_numRanks;
+  }
+  pimeval::energyBreakdown mjBreakdown(mjRefresh, 0.0, 0.0, getMjBackground(msStall), 0.0);
+  return pimeval::perfEnergy(msStall, mjBreakdown, 0.0, 0.0, 0.0, 0);
 }
 
 //! @brief  Perf energy model of data transfer between CPU memory and PIM memory
@@ -82,7 +361,7 @@ pimeval::perfEnergy
 pimPerfEnergyBase::getPerfEnergyForBytesTransfer(PimCmdEnum cmdType, uint64_t numBytes) const
 {
   //TODO: fine grain perf-energy modeling 
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -91,21 +370,21 @@ pimPerfEnergyBase::getPerfEnergyForBytesTransfer(PimCmdEnum cmdType, uint64_t nu
   switch (cmdType) {
     case PimCmdEnum::COPY_H2D:
     {
-      mjEnergy = m_eW * msRuntime * m_numChipsPerRank * m_numRanks;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjGDL = m_eW * msRuntime * m_numChipsPerRank * m_numRanks;
+      mjEnergy.m_mjBackground = getMjBackground(msRuntime);
       break;
     }
     case PimCmdEnum::COPY_D2H:
     {
-      mjEnergy = m_eR * msRuntime * m_numChipsPerRank * m_numRanks;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjGDL = m_eR * msRuntime * m_numChipsPerRank * m_numRanks;
+      mjEnergy.m_mjBackground = getMjBackground(msRuntime);
       break;
     }
     case PimCmdEnum::COPY_D2D:
     {
       // One row read, one row write within a subarray
-      mjEnergy = m_eAP * 2 * msRuntime * m_numChipsPerRank * m_numRanks;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = m_eAP * 2 * msRuntime * m_numChipsPerRank * m_numRanks;
+      mjEnergy.m_mjBackground = getMjBackground(msRuntime);
       break;
     }
     default:
@@ -117,6 +396,192 @@ pimPerfEnergyBase::getPerfEnergyForBytesTransfer(PimCmdEnum cmdType, uint64_t nu
   return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, mTotalOP);
 }
 
+//! @brief  Perf energy model of in-DRAM bulk row movement, with mechanism chosen by core placement
+//! - Same core: whole rows are copied with RowClone, and partial rows are merged with a masked select.
+//! - Same bank: whole rows hop across subarrays with LISA row buffer movement, and partial rows need
+//!   column accesses through the bank.
+//! - Same rank: column accesses over the rank-internal bus, which is shared by all banks of a rank.
+//! - Different ranks: reading and writing through the memory channel.
+//! Like PIM commands, cores work in parallel, while moves sharing a bank, a rank bus or the channel are serialized.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForRowMoves(const std::vector<rowMove>& moves, unsigned numCores) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned numRanks = std::max(m_numRanks, 1u);
+  numCores = std::max(numCores, 1u);
+  unsigned numCoresPerRank = std::max(numCores / numRanks, 1u);
+  unsigned numCoresPerBank = std::max(numCoresPerRank / std::max(m_numBankPerRank, 1u), 1u);
+  std::vector<double> msCoreBusy(numCores, 0.0);
+  std::vector<double> msBankBusy((numCores + numCoresPerBank - 1) / numCoresPerBank, 0.0);
+  std::vector<double> msRankBusBusy(numRanks, 0.0);
+  uint64_t numBytesChannel = 0;
+
+  for (const auto& move : moves) {
+    if (move.m_numRows == 0 || move.m_numBitsPerRow == 0) {
+      continue;
+    }
+    unsigned srcCore = std::min<unsigned>(move.m_srcCoreId, numCores - 1);
+    unsigned destCore = std::min<unsigned>(move.m_destCoreId, numCores - 1);
+    unsigned srcBank = srcCore / numCoresPerBank;
+    unsigned destBank = destCore / numCoresPerBank;
+    unsigned srcRank = std::min(srcCore / numCoresPerRank, numRanks - 1);
+    unsigned destRank = std::min(destCore / numCoresPerRank, numRanks - 1);
+    uint64_t numBursts = (move.m_numBitsPerRow + m_GDLWidth - 1) / m_GDLWidth;
+    double msColumnMove = m_tR + numBursts * m_tGDL + m_tW;
+
+    if (srcRank != destRank) {
+      numBytesChannel += move.m_numRows * ((move.m_numBitsPerRow + 7) / 8);
+    } else if (srcBank != destBank) {
+      msRankBusBusy[srcRank] += msColumnMove * move.m_numRows;
+      mjEnergy.m_mjActPre += m_eAP * 2 * move.m_numRows;
+      mjEnergy.m_mjGDL += (m_eR + m_eW) * numBursts * move.m_numRows;
+    } else if (srcCore == destCore) {
+      if (move.m_isWholeRow) {
+        msCoreBusy[srcCore] += (m_tR + m_tW) * move.m_numRows;
+        mjEnergy.m_mjActPre += m_eAP * 2 * move.m_numRows;
+      } else {
+        msCoreBusy[srcCore] += (m_tR + m_tL + m_tW) * move.m_numRows;
+        mjEnergy.m_mjActPre += m_eAP * 2 * move.m_numRows;
+        mjEnergy.m_mjLogic += m_eL * move.m_numRows;
+      }
+    } else if (move.m_isWholeRow) {
+      unsigned numHops = srcCore > destCore ? srcCore - destCore : destCore - srcCore;
+      msBankBusy[srcBank] += (m_tR + numHops * m_tLisaHop + m_tW) * move.m_numRows;
+      mjEnergy.m_mjActPre += m_eAP * (2 + numHops) * move.m_numRows;
+    } else {
+      msBankBusy[srcBank] += msColumnMove * move.m_numRows;
+      mjEnergy.m_mjActPre += m_eAP * 2 * move.m_numRows;
+      mjEnergy.m_mjGDL += (m_eR + m_eW) * numBursts * move.m_numRows;
+    }
+  }
+
+  double msRuntime = std::max({ *std::max_element(msCoreBusy.begin(), msCoreBusy.end()),
+                                *std::max_element(msBankBusy.begin(), msBankBusy.end()),
+                                *std::max_element(msRankBusBusy.begin(), msRankBusBusy.end()) });
+  if (numBytesChannel > 0) {
+    pimeval::perfEnergy perfRead = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numBytesChannel);
+    pimeval::perfEnergy perfWrite = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, numBytesChannel);
+    msRuntime += perfRead.m_msRuntime + perfWrite.m_msRuntime;
+    mjEnergy.m_mjGDL += perfRead.m_mjBreakdown.m_mjGDL + perfWrite.m_mjBreakdown.m_mjGDL;
+  }
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  return pimeval::perfEnergy(msRuntime, mjEnergy, 0.0, 0.0, 0.0, 0);
+}
+
+//! @brief  Perf energy model of copying an element range between two associated PIM objects
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForCopyD2D(const pimObjInfo& objSrc, const pimObjInfo& objDest, uint64_t idxBegin, uint64_t idxEnd) const
+{
+  const std::vector<pimRegion>& srcRegions = objSrc.getRegions();
+  const std::vector<pimRegion>& destRegions = objDest.getRegions();
+  unsigned bitsPerElement = objSrc.getBitsPerElement(PimBitWidth::PADDED);
+  std::vector<rowMove> moves;
+  for (size_t i = 0; i < srcRegions.size() && i < destRegions.size(); ++i) {
+    const pimRegion& srcRegion = srcRegions[i];
+    uint64_t elemBegin = std::max(idxBegin, srcRegion.getElemIdxBegin());
+    uint64_t elemEnd = std::min(idxEnd, srcRegion.getElemIdxEnd());
+    if (elemBegin >= elemEnd || srcRegion.getNumAllocRows() == 0) {
+      continue;
+    }
+    rowMove move;
+    move.m_srcCoreId = srcRegion.getCoreId();
+    move.m_destCoreId = destRegions[i].getCoreId();
+    move.m_numRows = srcRegion.getNumAllocRows();
+    move.m_numBitsPerRow = ((elemEnd - elemBegin) * bitsPerElement + move.m_numRows - 1) / move.m_numRows;
+    move.m_isWholeRow = (elemEnd - elemBegin == srcRegion.getNumElemInRegion());
+    moves.push_back(move);
+  }
+  return getPerfEnergyForRowMoves(moves, objSrc.getNumCoreAvailable());
+}
+
+//! @brief  Perf energy model of moving boundary elements across regions for rotate and shift
+//! The element shifted out of each region moves into the first slot of the neighboring region
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForRotateBoundary(PimCmdEnum cmdType, const pimObjInfo& obj) const
+{
+  const std::vector<pimRegion>& regions = obj.getRegions();
+  bool isRotate = (cmdType == PimCmdEnum::ROTATE_ELEM_R || cmdType == PimCmdEnum::ROTATE_ELEM_L);
+  bool isRight = (cmdType == PimCmdEnum::ROTATE_ELEM_R || cmdType == PimCmdEnum::SHIFT_ELEM_R);
+  unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::PADDED);
+  size_t numRegions = regions.size();
+  std::vector<rowMove> moves;
+  for (size_t i = 0; i < numRegions; ++i) {
+    // shifting drops the element moving out of the last region
+    bool isLast = isRight ? (i + 1 == numRegions) : (i == 0);
+    if (isLast && !isRotate) {
+      continue;
+    }
+    const pimRegion& srcRegion = regions[i];
+    const pimRegion& destRegion = regions[isRight ? (i + 1) % numRegions : (i + numRegions - 1) % numRegions];
+    if (srcRegion.getNumAllocRows() == 0) {
+      continue;
+    }
+    rowMove move;
+    move.m_srcCoreId = srcRegion.getCoreId();
+    move.m_destCoreId = destRegion.getCoreId();
+    move.m_numRows = srcRegion.getNumAllocRows();
+    move.m_numBitsPerRow = (bitsPerElement + move.m_numRows - 1) / move.m_numRows;
+    moves.push_back(move);
+  }
+  return getPerfEnergyForRowMoves(moves, obj.getNumCoreAvailable());
+}
+
+//! @brief  Perf energy model of reading out per-segment partial results of a segmented reduction
+//! Reduction models already return one result per PIM core. Each extra partial result at a segment
+//! boundary is read out as a 64-bit value over the channel and merged on host.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForSegmentedPartials(const pimObjInfo& obj, uint64_t numPartials) const
+{
+  uint64_t numCores = obj.getNumCoresUsed();
+  if (numPartials <= numCores) {
+    return pimeval::perfEnergy();
+  }
+  return getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, (numPartials - numCores) * sizeof(uint64_t));
+}
+
+//! @brief  Perf energy model of reductions of associated objects in one batched command
+//! Associated objects occupy different rows, so each reduction keeps its own row reads and energy. Reductions
+//! run one after another by default, e.g., bit-serial PIM reads rows and reduces with the same bit-serial logic.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForBatchedReduction(const std::vector<pimeval::perfEnergy>& perfs) const
+{
+  pimeval::perfEnergy perf;
+  for (const auto& perfObj : perfs) {
+    perf += perfObj;
+  }
+  return perf;
+}
+
+//! @brief  Perf energy model of batched reductions on PIM with separate row access and reduction units
+//! Partial results stay in PIM cores until the end of the batch, so row reads of the next object overlap with
+//! the in-core reduction of the previous object.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForOverlappedReductions(const std::vector<pimeval::perfEnergy>& perfs) const
+{
+  pimeval::perfEnergy perf = pimPerfEnergyBase::getPerfEnergyForBatchedReduction(perfs);
+  double msOverlap = 0.0;
+  for (size_t i = 1; i < perfs.size(); ++i) {
+    msOverlap += std::min(perfs[i].m_msRead, perfs[i - 1].m_msCompute);
+  }
+  double mjBackground = std::min(getMjBackground(msOverlap), perf.m_mjBreakdown.m_mjBackground);
+  perf.m_msRuntime -= msOverlap;
+  perf.m_mjBreakdown.m_mjBackground -= mjBackground;
+  perf.m_mjEnergy -= mjBackground;
+  return perf;
+}
+
+//! @brief  Perf energy model of data copy between two PIM devices through an inter-device link
+//! Reading the source device, the link transfer and writing the destination device are pipelined
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForInterDeviceCopy(const pimeval::perfEnergy& srcRead, const pimeval::perfEnergy& destWrite, uint64_t numBytes, unsigned linkMBps)
+{
+  double msLink = static_cast<double>(numBytes) / (static_cast<double>(linkMBps) * 1000);
+  double msRuntime = std::max({srcRead.m_msRuntime, msLink, destWrite.m_msRuntime});
+  pimeval::energyBreakdown mjEnergy = srcRead.m_mjBreakdown;
+  mjEnergy += destWrite.m_mjBreakdown;
+  return pimeval::perfEnergy(msRuntime, mjEnergy, 0.0, 0.0, 0.0, 0);
+}
+
 //! @brief  Perf energy model of base class for func1 (placeholder)
 pimeval::perfEnergy
 pimPerfEnergyBase::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objDest) const
@@ -207,3 +672,196 @@ pimPerfEnergyBase::getPerfEnergyForMac(PimCmdEnum cmdType, const pimObjInfo& obj
   uint64_t mTotalOP = 0;
   return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, mTotalOP);
 }
+
+//! @brief  Perf energy model of base class for batched AND-popcount
+//! Operand words of all pairs are processed in passes laid out like the bitmap object. Each pass
+//! costs a pass of AND, POPCOUNT and reduction sum over the bitmap object. Devices with dedicated
+//! popcount hardware override this.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForAndPopCount(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t numWords) const
+{
+  unsigned numObjPass = std::max(obj.getMaxNumRegionsPerCore(), 1u);
+  double scale = static_cast<double>(getNumPassForWords(obj, numWords)) / numObjPass;
+  pimeval::perfEnergy perfAnd = getPerfEnergyForFunc2(PimCmdEnum::AND, obj, obj, obj);
+  pimeval::perfEnergy perfPopCount = getPerfEnergyForFunc1(PimCmdEnum::POPCOUNT, obj, obj);
+  pimeval::perfEnergy perfRedSum = getPerfEnergyForReduction(PimCmdEnum::REDSUM, obj, numObjPass);
+  pimeval::energyBreakdown mjEnergy = perfAnd.m_mjBreakdown;
+  mjEnergy += perfPopCount.m_mjBreakdown;
+  mjEnergy += perfRedSum.m_mjBreakdown;
+  return pimeval::perfEnergy((perfAnd.m_msRuntime + perfPopCount.m_msRuntime + perfRedSum.m_msRuntime) * scale,
+                             mjEnergy * scale,
+                             (perfAnd.m_msRead + perfPopCount.m_msRead + perfRedSum.m_msRead) * scale,
+                             (perfAnd.m_msWrite + perfPopCount.m_msWrite + perfRedSum.m_msWrite) * scale,
+                             (perfAnd.m_msCompute + perfPopCount.m_msCompute + perfRedSum.m_msCompute) * scale,
+                             numWords * 3);
+}
+
+//! @brief  Perf energy model of base class for gather/scatter
+//! Host-assisted: PIM cores cannot address elements of other cores, so the host reads the index and
+//! source objects, permutes elements, and writes the dest object back. Scatter also reads the dest
+//! object to keep elements that are not indexed. Host compute time is not modeled.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForGatherScatter(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objIndex, const pimObjInfo& objDest) const
+{
+  auto numBytes = [](const pimObjInfo& obj) {
+    return (obj.getNumElements() * obj.getBitsPerElement(PimBitWidth::ACTUAL) + 7) / 8;
+  };
+  uint64_t numBytesRead = numBytes(objSrc) + numBytes(objIndex);
+  if (cmdType != PimCmdEnum::GATHER) {
+    numBytesRead += numBytes(objDest);
+  }
+  pimeval::perfEnergy perfRead = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numBytesRead);
+  pimeval::perfEnergy perfWrite = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, numBytes(objDest));
+  pimeval::energyBreakdown mjEnergy = perfRead.m_mjBreakdown;
+  mjEnergy += perfWrite.m_mjBreakdown;
+  return pimeval::perfEnergy(perfRead.m_msRuntime + perfWrite.m_msRuntime, mjEnergy,
+                             perfRead.m_msRuntime, perfWrite.m_msRuntime, 0.0, objIndex.getNumElements());
+}
+
+//! @brief  Perf energy model of base class for stream compaction
+//! The host reads the condition object as a bitmap and computes destination offsets. Only the selected
+//! elements are then moved from src to dest through the memory channel, so the cost scales with selectivity.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForCompact(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objCond, const pimObjInfo& objDest, uint64_t numSelected) const
+{
+  uint64_t numBytesCond = (objCond.getNumElements() + 7) / 8;
+  uint64_t numBytesSelected = (numSelected * objSrc.getBitsPerElement(PimBitWidth::ACTUAL) + 7) / 8;
+  pimeval::perfEnergy perfRead = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numBytesCond + numBytesSelected);
+  pimeval::perfEnergy perfWrite = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, numBytesSelected);
+  pimeval::energyBreakdown mjEnergy = perfRead.m_mjBreakdown;
+  mjEnergy += perfWrite.m_mjBreakdown;
+  return pimeval::perfEnergy(perfRead.m_msRuntime + perfWrite.m_msRuntime, mjEnergy,
+                             perfRead.m_msRuntime, perfWrite.m_msRuntime, 0.0, objSrc.getNumElements());
+}
+
+//! @brief  Perf energy model of base class for top-k selection
+//! In-memory tournament on a scratch copy: each of k rounds finds the winner with a min/max reduction,
+//! locates it with a scalar compare, and knocks it out with a conditional broadcast of a sentinel.
+//! Winners and their indices are read back to host.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForTopK(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t k) const
+{
+  unsigned numPass = std::max(obj.getMaxNumRegionsPerCore(), 1u);
+  pimeval::perfEnergy perfCopy = getPerfEnergyForFunc1(PimCmdEnum::COPY_O2O, obj, obj);
+  pimeval::perfEnergy perfRed = getPerfEnergyForReduction(PimCmdEnum::REDMAX, obj, numPass);
+  pimeval::perfEnergy perfEq = getPerfEnergyForFunc1(PimCmdEnum::EQ_SCALAR, obj, obj);
+  pimeval::perfEnergy perfKnockOut = getPerfEnergyForFunc2(PimCmdEnum::COND_BROADCAST, obj, obj, obj);
+  pimeval::perfEnergy perfResults = getPerfEnergyForTopKResults(obj, k);
+  pimeval::energyBreakdown mjRound = perfRed.m_mjBreakdown;
+  mjRound += perfEq.m_mjBreakdown;
+  mjRound += perfKnockOut.m_mjBreakdown;
+  pimeval::energyBreakdown mjEnergy = perfCopy.m_mjBreakdown;
+  mjEnergy += mjRound * k;
+  mjEnergy += perfResults.m_mjBreakdown;
+  double msRead = perfCopy.m_msRead + (perfRed.m_msRead + perfEq.m_msRead + perfKnockOut.m_msRead) * k + perfResults.m_msRuntime;
+  double msWrite = perfCopy.m_msWrite + (perfRed.m_msWrite + perfEq.m_msWrite + perfKnockOut.m_msWrite) * k;
+  double msCompute = perfCopy.m_msCompute + (perfRed.m_msCompute + perfEq.m_msCompute + perfKnockOut.m_msCompute) * k;
+  double msRuntime = perfCopy.m_msRuntime + (perfRed.m_msRuntime + perfEq.m_msRuntime + perfKnockOut.m_msRuntime) * k + perfResults.m_msRuntime;
+  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, obj.getNumElements() * k);
+}
+
+//! @brief  Perf energy model of base class for elementwise math approximations
+//! Sum of the micro-ops of the approximation on this device. Scalar adds are counted as adds, as FP scalar
+//! adds are not modeled by all devices. With fractional bits, each fixed-point multiply is followed by a right
+//! shift to realign the fractional bits, and fixed-point results are saturated with min and max.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForMath(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objDest, PimMathPrecision precision, unsigned numFracBits) const
+{
+  pimCmdMath::microOps ops = pimCmdMath::getMicroOps(cmdType, precision);
+  std::vector<std::pair<pimeval::perfEnergy, unsigned>> perfOps = {
+    { getPerfEnergyForFunc2(PimCmdEnum::MUL, objSrc, objSrc, objDest), ops.m_numMul },
+    { getPerfEnergyForFunc2(PimCmdEnum::ADD, objSrc, objSrc, objDest), ops.m_numAdd },
+    { getPerfEnergyForFunc2(PimCmdEnum::DIV, objSrc, objSrc, objDest), ops.m_numDiv },
+    { getPerfEnergyForFunc1(PimCmdEnum::MUL_SCALAR, objSrc, objDest), ops.m_numMulScalar },
+  };
+  if (!pimUtils::isFP(objSrc.getDataType())) {
+    if (numFracBits > 0) {
+      perfOps.emplace_back(getPerfEnergyForFunc1(PimCmdEnum::SHIFT_BITS_R, objSrc, objDest), ops.m_numMul + ops.m_numMulScalar);
+    }
+    perfOps.emplace_back(getPerfEnergyForFunc1(PimCmdEnum::MIN_SCALAR, objSrc, objDest), 1);
+    perfOps.emplace_back(getPerfEnergyForFunc1(PimCmdEnum::MAX_SCALAR, objSrc, objDest), 1);
+  }
+
+  pimeval::perfEnergy perf;
+  for (const auto& [perfOp, count] : perfOps) {
+    if (count == 0) {
+      continue;
+    }
+    perf.m_msRuntime += perfOp.m_msRuntime * count;
+    perf.m_mjEnergy += perfOp.m_mjEnergy * count;
+    perf.m_msRead += perfOp.m_msRead * count;
+    perf.m_msWrite += perfOp.m_msWrite * count;
+    perf.m_msCompute += perfOp.m_msCompute * count;
+    perf.m_mjBreakdown += perfOp.m_mjBreakdown * count;
+    perf.m_msActLimit += perfOp.m_msActLimit * count;
+  }
+  perf.m_totalOp = objSrc.getNumElements();
+  return perf;
+}
+
+//! @brief  Perf energy model of base class for GEMV/GEMM
+//! Column-broadcast dataflow: each matrix column is placed like dest, and dest accumulates one
+//! scaled add per column with the host operand element as scalar. This is also the bit-serial
+//! dataflow, which has no accumulator registers and keeps partial sums in dest rows. Devices with
+//! a native MAC dataflow override this.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const
+{
+  pimeval::perfEnergy perfCol = getPerfEnergyForFunc2(PimCmdEnum::SCALED_ADD, objDest, objDest, objDest);
+  pimeval::perfEnergy perf(perfCol.m_msRuntime * numCols, perfCol.m_mjBreakdown * numCols,
+                           perfCol.m_msRead * numCols, perfCol.m_msWrite * numCols, perfCol.m_msCompute * numCols,
+                           perfCol.m_totalOp * numCols);
+  perf.m_msActLimit = perfCol.m_msActLimit * numCols;
+  return perf;
+}
+
+//! @brief  Perf energy model of moving matrix columns next to dest for GEMV/GEMM
+//! Column-wise dataflows need each matrix element in the same core and element slot as its dest element.
+//! Pieces of matrix columns placed elsewhere are moved in DRAM before they are multiplied. This is not
+//! memoized as it depends on object placement, like device-to-device copies.
+pimeval::perfEnergy
+pimPerfEnergyBase::getPerfEnergyForGemvMoves(const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const
+{
+  const std::vector<pimRegion>& matRegions = objMat.getRegions();
+  uint64_t numRows = (numCols > 0 ? objMat.getNumElements() / numCols : 0);
+  if (numRows == 0 || matRegions.empty()) {
+    return pimeval::perfEnergy();
+  }
+  unsigned bitsPerElement = objMat.getBitsPerElement(PimBitWidth::PADDED);
+  auto isBefore = [](uint64_t idx, const pimRegion& region) { return idx < region.getElemIdxBegin(); };
+  std::vector<rowMove> moves;
+  for (const auto& destRegion : objDest.getRegions()) {
+    // A dest region may hold rows of more than one output vector
+    uint64_t destIdx = destRegion.getElemIdxBegin();
+    while (destIdx < destRegion.getElemIdxEnd()) {
+      uint64_t row = destIdx % numRows;
+      uint64_t numRowsInBlock = std::min(destRegion.getElemIdxEnd() - destIdx, numRows - row);
+      for (uint64_t col = 0; col < numCols; ++col) {
+        uint64_t matBegin = col * numRows + row;
+        uint64_t matEnd = matBegin + numRowsInBlock;
+        auto it = std::upper_bound(matRegions.begin(), matRegions.end(), matBegin, isBefore);
+        for (it = (it == matRegions.begin() ? it : it - 1); it != matRegions.end() && it->getElemIdxBegin() < matEnd; ++it) {
+          uint64_t elemBegin = std::max(matBegin, it->getElemIdxBegin());
+          uint64_t elemEnd = std::min(matEnd, it->getElemIdxEnd());
+          if (elemBegin >= elemEnd || it->getNumAllocRows() == 0) {
+            continue;
+          }
+          uint64_t destSlot = destIdx + (elemBegin - matBegin) - destRegion.getElemIdxBegin();
+          if (it->getCoreId() == destRegion.getCoreId() && it->getColIdx() == destRegion.getColIdx() &&
+              elemBegin - it->getElemIdxBegin() == destSlot) {
+            continue;
+          }
+          rowMove move;
+          move.m_srcCoreId = it->getCoreId();
+          move.m_destCoreId = destRegion.getCoreId();
+          move.m_numRows = it->getNumAllocRows();
+          move.m_numBitsPerRow = ((elemEnd - elemBegin) * bitsPerElement + move.m_numRows - 1) / move.m_numRows;
+          move.m_isWholeRow = (elemEnd - elemBegin == it->getNumElemInRegion());
+          moves.push_back(move);
+        }
+      }
+      destIdx += numRowsInBlock;
+    }
+  }
+  return getPerfEnergyForRowMoves(moves, objMat.getNumCoreAvailable());
+}
@@ -11,16 +11,62 @@
 #include "pimParamsDram.h"             // for pimParamsDram
 #include "pimCmd.h"                    // for PimCmdEnum
 #include "pimResMgr.h"                 // for pimObjInfo
+#include <array>
 #include <cstdint>
 #include <memory>                      // for std::unique_ptr
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace pimeval {
+  //! @class  energyBreakdown
+  //! @brief  Energy of a PIM command split by component, all in mJ
+  class energyBreakdown
+  {
+    public:
+      energyBreakdown() {}
+      energyBreakdown(double mjActPre, double mjGDL, double mjLogic, double mjBackground, double mjHost)
+        : m_mjActPre(mjActPre), m_mjGDL(mjGDL), m_mjLogic(mjLogic), m_mjBackground(mjBackground), m_mjHost(mjHost) {}
+
+      double getTotal() const { return m_mjActPre + m_mjGDL + m_mjLogic + m_mjBackground + m_mjHost; }
+
+      energyBreakdown& operator+=(const energyBreakdown& rhs) {
+        m_mjActPre += rhs.m_mjActPre;
+        m_mjGDL += rhs.m_mjGDL;
+        m_mjLogic += rhs.m_mjLogic;
+        m_mjBackground += rhs.m_mjBackground;
+        m_mjHost += rhs.m_mjHost;
+        return *this;
+      }
+      energyBreakdown& operator*=(double factor) {
+        m_mjActPre *= factor;
+        m_mjGDL *= factor;
+        m_mjLogic *= factor;
+        m_mjBackground *= factor;
+        m_mjHost *= factor;
+        return *this;
+      }
+      energyBreakdown operator*(double factor) const {
+        energyBreakdown result(*this);
+        result *= factor;
+        return result;
+      }
+
+      double m_mjActPre = 0.0;      // row activate and precharge
+      double m_mjGDL = 0.0;         // local row buffer <-> global row buffer / IO transfers
+      double m_mjLogic = 0.0;       // PIM logic and ALU operations
+      double m_mjBackground = 0.0;  // background power over the command runtime
+      double m_mjHost = 0.0;        // host CPU aggregation
+  };
+
   class perfEnergy
   {
     public:
       perfEnergy() : m_msRuntime(0.0), m_mjEnergy(0.0), m_msRead(0.0), m_msWrite(0.0), m_msCompute(0.0), m_totalOp(0) {}
       perfEnergy(double msRuntime, double mjEnergy, double msRead, double msWrite, double msCompute, uint64_t totalOp) : m_msRuntime(msRuntime), m_mjEnergy(mjEnergy), m_msRead(msRead), m_msWrite(msWrite), m_msCompute(msCompute), m_totalOp(totalOp)  {}
+      // Total energy is the sum of all components
+      perfEnergy(double msRuntime, const energyBreakdown& mjBreakdown, double msRead, double msWrite, double msCompute, uint64_t totalOp) : m_msRuntime(msRuntime), m_mjEnergy(mjBreakdown.getTotal()), m_msRead(msRead), m_msWrite(msWrite), m_msCompute(msCompute), m_totalOp(totalOp), m_mjBreakdown(mjBreakdown)  {}
 
       double m_msRuntime;
       double m_mjEnergy;
@@ -28,6 +74,23 @@ namespace pimeval {
       double m_msWrite;
       double m_msCompute;
       uint64_t m_totalOp;
+      energyBreakdown m_mjBreakdown;
+      double m_msActLimit = 0.0;  // slowdown due to row activation rate limits, included in m_msRuntime
+      double m_msDataAware = 0.0; // runtime with data-dependent micro-op counts, if modeled, not included in m_msRuntime
+
+      //! @brief  Accumulate another perf energy that runs after this one
+      perfEnergy& operator+=(const perfEnergy& rhs) {
+        m_msRuntime += rhs.m_msRuntime;
+        m_mjEnergy += rhs.m_mjEnergy;
+        m_msRead += rhs.m_msRead;
+        m_msWrite += rhs.m_msWrite;
+        m_msCompute += rhs.m_msCompute;
+        m_totalOp += rhs.m_totalOp;
+        m_mjBreakdown += rhs.m_mjBreakdown;
+        m_msActLimit += rhs.m_msActLimit;
+        m_msDataAware += rhs.m_msDataAware;
+        return *this;
+      }
   };
 }
 
@@ -36,14 +99,16 @@ namespace pimeval {
 class pimPerfEnergyModelParams
 {
 public:
-  pimPerfEnergyModelParams(PimDeviceEnum simTarget, unsigned numRanks, const pimParamsDram& paramsDram)
-    : m_simTarget(simTarget), m_numRanks(numRanks), m_paramsDram(paramsDram) {}
+  pimPerfEnergyModelParams(PimDeviceEnum simTarget, unsigned numRanks, unsigned numBankPerRank, const pimParamsDram& paramsDram)
+    : m_simTarget(simTarget), m_numRanks(numRanks), m_numBankPerRank(numBankPerRank), m_paramsDram(paramsDram) {}
   PimDeviceEnum getSimTarget() const { return m_simTarget; }
   unsigned getNumRanks() const { return m_numRanks; }
+  unsigned getNumBankPerRank() const { return m_numBankPerRank; }
   const pimParamsDram& getParamsDram() const { return m_paramsDram; }
 private:
   PimDeviceEnum m_simTarget;
   unsigned m_numRanks;
+  unsigned m_numBankPerRank;
   const pimParamsDram& m_paramsDram;
 };
 
@@ -73,10 +138,83 @@ public:
   virtual pimeval::perfEnergy getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const;
   virtual pimeval::perfEnergy getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const;
   virtual pimeval::perfEnergy getPerfEnergyForMac(PimCmdEnum cmdType, const pimObjInfo& obj) const;
+  virtual pimeval::perfEnergy getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const;
+  virtual pimeval::perfEnergy getPerfEnergyForGemvMoves(const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const;
+  virtual pimeval::perfEnergy getPerfEnergyForAndPopCount(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t numWords) const;
+  virtual pimeval::perfEnergy getPerfEnergyForGatherScatter(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objIndex, const pimObjInfo& objDest) const;
+  virtual pimeval::perfEnergy getPerfEnergyForCompact(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objCond, const pimObjInfo& objDest, uint64_t numSelected) const;
+  virtual pimeval::perfEnergy getPerfEnergyForTopK(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t k) const;
+  virtual pimeval::perfEnergy getPerfEnergyForMath(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objDest, PimMathPrecision precision, unsigned numFracBits) const;
+  virtual pimeval::perfEnergy getPerfEnergyForRefresh(double msRuntime, uint64_t numApiCalls) const;
+  virtual double getMsRuntimeDataAware(PimCmdEnum cmdType, const pimeval::perfEnergy& perf, double ratio) const { return perf.m_msRuntime; }
+  pimeval::perfEnergy getPerfEnergyForCopyD2D(const pimObjInfo& objSrc, const pimObjInfo& objDest, uint64_t idxBegin, uint64_t idxEnd) const;
+  pimeval::perfEnergy getPerfEnergyForRotateBoundary(PimCmdEnum cmdType, const pimObjInfo& obj) const;
+  pimeval::perfEnergy getPerfEnergyForSegmentedPartials(const pimObjInfo& obj, uint64_t numPartials) const;
+  virtual pimeval::perfEnergy getPerfEnergyForBatchedReduction(const std::vector<pimeval::perfEnergy>& perfs) const;
+  static pimeval::perfEnergy getPerfEnergyForInterDeviceCopy(const pimeval::perfEnergy& srcRead, const pimeval::perfEnergy& destWrite, uint64_t numBytes, unsigned linkMBps);
+
+  // Memoized perf energy evaluation for the PIM command hot path
+  pimeval::perfEnergy getCachedPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objDest) const;
+  pimeval::perfEnergy getCachedPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& objSrc1, const pimObjInfo& objSrc2, const pimObjInfo& objDest) const;
+  pimeval::perfEnergy getCachedPerfEnergyForReduction(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const;
+  pimeval::perfEnergy getCachedPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const;
+  pimeval::perfEnergy getCachedPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const;
+  pimeval::perfEnergy getCachedPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const;
+  pimeval::perfEnergy getCachedPerfEnergyForMac(PimCmdEnum cmdType, const pimObjInfo& obj) const;
+  pimeval::perfEnergy getCachedPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const;
+  pimeval::perfEnergy getCachedPerfEnergyForAndPopCount(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t numWords) const;
+  pimeval::perfEnergy getCachedPerfEnergyForGatherScatter(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objIndex, const pimObjInfo& objDest) const;
+  pimeval::perfEnergy getCachedPerfEnergyForTopK(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t k) const;
+  pimeval::perfEnergy getCachedPerfEnergyForMath(PimCmdEnum cmdType, const pimObjInfo& objSrc, const pimObjInfo& objDest, PimMathPrecision precision, unsigned numFracBits) const;
+  uint64_t getNumCacheHits() const { return m_numCacheHits; }
+  uint64_t getNumCacheMisses() const { return m_numCacheMisses; }
+  size_t getCacheSize() const { return m_cache.size(); }
+
+  //! @brief  DRAM refresh policies, named after refresh_policy in DRAMsim3 memory configs
+  enum class refreshPolicy {
+    RANK_LEVEL_SIMULTANEOUS = 0,
+    RANK_LEVEL_STAGGERED,
+    BANK_LEVEL_STAGGERED,
+  };
+  refreshPolicy getRefreshPolicy() const { return m_refreshPolicy; }
+  static std::string refreshPolicyToStr(refreshPolicy policy);
 
 protected:
+  //! @class  pimPerfEnergyBase::cacheKey
+  //! @brief  Everything a perf energy model reads from a PIM command: command type, an extra
+  //!         parameter such as number of reduction passes, and shapes and layouts of up to three objects
+  struct cacheKey {
+    static constexpr size_t NUM_VALS_PER_OBJ = 5;
+    std::array<uint64_t, 2 + 3 * NUM_VALS_PER_OBJ> m_vals{};
+    cacheKey(PimCmdEnum cmdType, uint64_t extra, const pimObjInfo* obj1, const pimObjInfo* obj2 = nullptr, const pimObjInfo* obj3 = nullptr);
+    bool operator==(const cacheKey& rhs) const { return m_vals == rhs.m_vals; }
+  };
+  struct cacheKeyHash {
+    size_t operator()(const cacheKey& key) const;
+  };
+  //! @class  pimPerfEnergyBase::rowMove
+  //! @brief  In-DRAM movement of a number of rows from a source core to a destination core
+  struct rowMove {
+    PimCoreId m_srcCoreId = -1;
+    PimCoreId m_destCoreId = -1;
+    uint64_t m_numRows = 0;
+    unsigned m_numBitsPerRow = 0;  // bits to move in each row
+    bool m_isWholeRow = false;     // whole rows can be moved without column accesses
+  };
+  pimeval::perfEnergy getPerfEnergyForRowMoves(const std::vector<rowMove>& moves, unsigned numCores) const;
+  uint64_t getNumPassForWords(const pimObjInfo& obj, uint64_t numWords) const;
+  pimeval::perfEnergy getPerfEnergyForTopKResults(const pimObjInfo& obj, uint64_t numCandidates) const;
+  pimeval::perfEnergy getPerfEnergyForOverlappedReductions(const std::vector<pimeval::perfEnergy>& perfs) const;
+
+  template <typename Eval> pimeval::perfEnergy lookupCache(const cacheKey& key, Eval eval) const;
+
+  double getMjBackground(double msRuntime) const { return m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime; }
+  uint64_t getNumRowActRounds(const pimeval::perfEnergy& perf) const;
+  void applyActLimits(pimeval::perfEnergy& perf, uint64_t numActRounds) const;
+
   PimDeviceEnum m_simTarget;
   unsigned m_numRanks;
+  unsigned m_numBankPerRank;
   const pimParamsDram& m_paramsDram;
 
   const double m_nano_to_milli = 1000000.0;
@@ -88,6 +226,7 @@ protected:
   double m_tL; // Logic operation for bitserial / tCCD in ms
   double m_tGDL; // Fetch data from local row buffer to global row buffer
   double m_tCAS; // CAS time in ms
+  double m_tLisaHop; // LISA row buffer movement latency across one subarray boundary in ms
   int m_GDLWidth; // Number of bits that can be fetched from local to global row buffer.
   int m_numChipsPerRank; // Number of chips per rank
   double m_typicalRankBW; // typical rank data transfer bandwidth in GB/s
@@ -106,6 +245,22 @@ protected:
   unsigned m_tRCD; // RCD in cycles
   unsigned m_tRP; // RP in cycles
   unsigned m_tRAS; // RAS in cycles
+
+  refreshPolicy m_refreshPolicy; // DRAM refresh policy
+  double m_tRFC; // All-bank refresh cycle time in ms
+  double m_tREFI; // All-bank refresh interval in ms
+  double m_tRFCb; // Per-bank refresh cycle time in ms
+  double m_tREFIb; // Per-bank refresh interval in ms
+  double m_eRefresh; // All-bank refresh energy per chip in mJ
+  double m_eRefreshBank; // Per-bank refresh energy per chip in mJ
+
+  unsigned m_numActPerChip; // Banks per chip activating together in a lockstep row operation
+  double m_tActLimit; // Extra latency of a lockstep row operation due to tRRD and tFAW in ms
+
+  // Perf energy models are deterministic given cacheKey, so results are memoized
+  mutable std::unordered_map<cacheKey, pimeval::perfEnergy, cacheKeyHash> m_cache;
+  mutable uint64_t m_numCacheHits = 0;
+  mutable uint64_t m_numCacheMisses = 0;
 };
 
 #endif
@@ -10,6 +10,7 @@
 #include "pimUtils.h"
 #include <cstdio>
 #include <cmath> // For log2()
+#include <algorithm> // For clamp()
 
 
 //! @brief  Get performance and energy for bit-serial PIM
@@ -19,7 +20,7 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
 {
   bool ok = false;
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   unsigned numCores = objSrc1.getNumCoreAvailable();
   unsigned bitsPerElement = objSrc1.getBitsPerElement(PimBitWidth::ACTUAL);
   PimDataType dataType = objSrc1.getDataType();
@@ -75,8 +76,9 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
         msLogic += m_tL * numL;
         totalOp += objSrc1.getNumElements();
         msRuntime += msRead + msWrite + msLogic;
-        mjEnergy += ((m_eL * numL * objSrc1.getMaxElementsPerRegion()) + (m_eAP * numR + m_eAP * numW)) * numCores;
-        mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+        mjEnergy.m_mjLogic += m_eL * numL * objSrc1.getMaxElementsPerRegion() * numCores;
+        mjEnergy.m_mjActPre += (m_eAP * numR + m_eAP * numW) * numCores;
+        mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       }
       // handle bit-serial operations not in the above table
       if (!ok) {
@@ -91,8 +93,9 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
             msWrite += numW * m_tW;
             msLogic += numL * m_tL;
             msRuntime += msRead + msWrite + msLogic;
-            mjEnergy += ((m_eL * numL * objSrc1.getMaxElementsPerRegion()) + (m_eAP * numR + m_eAP * numW)) * numCores;
-            mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+            mjEnergy.m_mjLogic += m_eL * numL * objSrc1.getMaxElementsPerRegion() * numCores;
+            mjEnergy.m_mjActPre += (m_eAP * numR + m_eAP * numW) * numCores;
+            mjEnergy.m_mjBackground += getMjBackground(msRuntime);
             ok = true;
             break;
           }
@@ -102,8 +105,8 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
             msRead += m_tR;
             msWrite += m_tW;
             msRuntime += msRead + msWrite;
-            mjEnergy += (m_eAP + m_eAP) * numCores;
-            mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+            mjEnergy.m_mjActPre += (m_eAP + m_eAP) * numCores;
+            mjEnergy.m_mjBackground += getMjBackground(msRuntime);
             totalOp += objSrc1.getNumElements();
             ok = true;
             break;
@@ -124,8 +127,9 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
             msLogic += numL * m_tL;
             totalOp += objSrc1.getNumElements();
             msRuntime += msRead + msWrite + msLogic;
-            mjEnergy += ((m_eL * numL * objSrc1.getMaxElementsPerRegion()) + (m_eAP * numR + m_eAP * numW)) * numCores;
-            mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+            mjEnergy.m_mjLogic += m_eL * numL * objSrc1.getMaxElementsPerRegion() * numCores;
+            mjEnergy.m_mjActPre += (m_eAP * numR + m_eAP * numW) * numCores;
+            mjEnergy.m_mjBackground += getMjBackground(msRuntime);
             ok = true;
             break;
           }
@@ -137,8 +141,9 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
             msLogic += m_tL;
             msRuntime += msRead + msWrite + msLogic;
             totalOp += objSrc1.getNumElements();
-            mjEnergy += ((m_eL * objSrc1.getMaxElementsPerRegion()) + (m_eAP * numR + m_eAP * numW)) * numCores;
-            mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+            mjEnergy.m_mjLogic += m_eL * objSrc1.getMaxElementsPerRegion() * numCores;
+            mjEnergy.m_mjActPre += (m_eAP * numR + m_eAP * numW) * numCores;
+            mjEnergy.m_mjBackground += getMjBackground(msRuntime);
             ok = true;
             break;
           default:
@@ -167,7 +172,9 @@ pimPerfEnergyBitSerial::getPerfEnergyBitSerial(PimDeviceEnum deviceType, PimCmdE
   msLogic *= numPass;
   msRuntime *= numPass;
   mjEnergy *= numPass;
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msLogic, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msLogic, totalOp);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
 }
 
 //! @brief  Perf energy model of bit-serial type conversion
@@ -176,7 +183,7 @@ pimPerfEnergyBitSerial::getPerfEnergyTypeConversion(PimDeviceEnum deviceType, Pi
 {
   assert(cmdType == PimCmdEnum::CONVERT_TYPE);
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   unsigned numCores = objSrc.getNumCoreAvailable();
   unsigned numPass = objSrc.getMaxNumRegionsPerCore();
   double msRead = 0.0;
@@ -209,8 +216,9 @@ pimPerfEnergyBitSerial::getPerfEnergyTypeConversion(PimDeviceEnum deviceType, Pi
       msWrite = numW * m_tW;
       msLogic = numL * m_tL;
       msRuntime = msRead + msWrite + msLogic;
-      mjEnergy = ((m_eL * numL * objSrc.getMaxElementsPerRegion()) + (m_eAP * numR + m_eAP * numW)) * numCores;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjLogic = m_eL * numL * objSrc.getMaxElementsPerRegion() * numCores;
+      mjEnergy.m_mjActPre = (m_eAP * numR + m_eAP * numW) * numCores;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       break;
     }
     default:
@@ -221,7 +229,9 @@ pimPerfEnergyBitSerial::getPerfEnergyTypeConversion(PimDeviceEnum deviceType, Pi
   msLogic *= numPass;
   msRuntime *= numPass;
   mjEnergy *= numPass;
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msLogic, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msLogic, totalOp);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for func1
@@ -250,6 +260,16 @@ pimPerfEnergyBitSerial::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjIn
   return perf;
 }
 
+//! @brief  Runtime of bit-serial PIM with data-dependent micro-op counts
+//! Only the given ratio of row reads, row writes and logic steps is needed by actual data,
+//! while other overheads such as activation limits stay the same
+double
+pimPerfEnergyBitSerial::getMsRuntimeDataAware(PimCmdEnum cmdType, const pimeval::perfEnergy& perf, double ratio) const
+{
+  double msMicroOps = perf.m_msRead + perf.m_msWrite + perf.m_msCompute;
+  return perf.m_msRuntime - msMicroOps * (1.0 - std::clamp(ratio, 0.0, 1.0));
+}
+
 //! @brief  Perf energy model of bit-serial PIM for func2
 pimeval::perfEnergy
 pimPerfEnergyBitSerial::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& objSrc1, const pimObjInfo& objSrc2, const pimObjInfo& objDest) const
@@ -277,7 +297,7 @@ pimeval::perfEnergy
 pimPerfEnergyBitSerial::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -309,11 +329,12 @@ pimPerfEnergyBitSerial::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimO
           msRead = m_tR * bitsPerElement * numPass;
           msWrite = 0;
           msCompute = aggregateMs + ((m_pclNsDelay * 1e-6) * numPclPerCore * bitsPerElement * numPass) ; 
-          mjEnergy = m_eAP * numCore + mjEnergyPerPcl * numPclPerCore * numCore; // energy of one row read and row-wide popcount
+          mjEnergy.m_mjActPre = m_eAP * numCore; // energy of one row read
+          mjEnergy.m_mjLogic = mjEnergyPerPcl * numPclPerCore * numCore; // energy of row-wide popcount
           mjEnergy *= bitsPerElement * numPass;
           msRuntime += msRead + msWrite + msCompute;
-          mjEnergy += aggregateMs * cpuTDP;
-          mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+          mjEnergy.m_mjHost = aggregateMs * cpuTDP;
+          mjEnergy.m_mjBackground += getMjBackground(msRuntime);
           totalOp += obj.getNumElements();
           break;
         }
@@ -327,7 +348,7 @@ pimPerfEnergyBitSerial::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimO
           unsigned levels = static_cast<unsigned>(std::ceil(std::log2(numElements))); // Tree depth
           pimeval::perfEnergy perfEnergyBS = getPerfEnergyBitSerial(m_simTarget, cmdType, (std::ceil(numPass*1.0/2)), obj, obj, obj);
           msRuntime = perfEnergyBS.m_msRuntime * levels;
-          mjEnergy = perfEnergyBS.m_mjEnergy * levels;
+          mjEnergy = perfEnergyBS.m_mjBreakdown * levels;
           msRead = perfEnergyBS.m_msRead * levels;
           msWrite = perfEnergyBS.m_msWrite * levels;
           msCompute = perfEnergyBS.m_msCompute * levels;
@@ -344,7 +365,7 @@ pimPerfEnergyBitSerial::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimO
           unsigned levels = static_cast<unsigned>(std::ceil(std::log2(numElements))); // Tree depth
           pimeval::perfEnergy perfEnergyBS = getPerfEnergyBitSerial(m_simTarget, cmdType, (std::ceil(numPass*1.0/2)), obj, obj, obj);
           msRuntime = perfEnergyBS.m_msRuntime * levels;
-          mjEnergy = perfEnergyBS.m_mjEnergy * levels;
+          mjEnergy = perfEnergyBS.m_mjBreakdown * levels;
           msRead = perfEnergyBS.m_msRead * levels;
           msWrite = perfEnergyBS.m_msWrite * levels;
           msCompute = perfEnergyBS.m_msCompute * levels;
@@ -361,7 +382,7 @@ pimPerfEnergyBitSerial::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimO
       } else if (pimUtils::isFP(dataType)) {
         printf("PIM-Warning: Perf energy model for FP reduction sum on bit-serial PIM is not available yet.\n");
         msRuntime = 999999999.9; // todo
-        mjEnergy = 999999999.9;  // todo
+        mjEnergy.m_mjLogic = 999999999.9;  // todo
       } else {
         assert(0);
       }
@@ -374,14 +395,16 @@ pimPerfEnergyBitSerial::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimO
     case PIM_DEVICE_BITSIMD_H:
       // Sequentially process all elements per CPU cycle
       msRuntime = static_cast<double>(numElements) / 3200000; // typical 3.2 GHz CPU
-      mjEnergy = 999999999.9; // todo
+      mjEnergy.m_mjLogic = 999999999.9; // todo
       // consider PCL
       break;
     default:
       assert(0);
   }
   
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for broadcast
@@ -389,7 +412,7 @@ pimeval::perfEnergy
 pimPerfEnergyBitSerial::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -408,8 +431,8 @@ pimPerfEnergyBitSerial::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimO
       msCompute = m_tL * bitsPerElement * numPass;
       totalOp = 0;
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = m_eAP * numCore * numPass ;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = m_eAP * numCore * numPass;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       break;
     }
     case PIM_DEVICE_SIMDRAM:
@@ -417,7 +440,7 @@ pimPerfEnergyBitSerial::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimO
       // todo
       msRuntime *= numPass;
       mjEnergy *= numPass;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       break;
     }
     case PIM_DEVICE_BITSIMD_H:
@@ -426,15 +449,18 @@ pimPerfEnergyBitSerial::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimO
       uint64_t maxBytesPerRegion = (uint64_t)maxElementsPerRegion * (bitsPerElement / 8);
       msRuntime = m_tW + m_tL * maxBytesPerRegion; // for one pass
       msRuntime *= numPass;
-      mjEnergy = (m_eAP + (m_tL * maxBytesPerRegion)) * numCore * numPass;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = m_eAP * numCore * numPass;
+      mjEnergy.m_mjLogic = m_tL * maxBytesPerRegion * numCore * numPass;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       break;
     }
     default:
       assert(0);
   }
   
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for rotate
@@ -442,17 +468,15 @@ pimeval::perfEnergy
 pimPerfEnergyBitSerial::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
   uint64_t totalOp = 0;
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::ACTUAL);
-  unsigned numRegions = obj.getRegions().size();
   unsigned numCore = obj.getNumCoreAvailable();
-  // boundary handling - assume two times copying between device and host for boundary elements
-  pimeval::perfEnergy perfEnergyBT = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numRegions * bitsPerElement / 8);
+  // boundary elements across regions are modeled separately by getPerfEnergyForRotateBoundary
 
   switch (m_simTarget) {
     case PIM_DEVICE_BITSIMD_V:
@@ -464,9 +488,8 @@ pimPerfEnergyBitSerial::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjI
       msCompute = 3 * m_tL * bitsPerElement * numPass;
       totalOp += 3 * bitsPerElement * numPass * numCore;
       msRuntime = msRead + msWrite + msCompute;
-      mjEnergy = (m_eAP + 3 * m_eL) * bitsPerElement * numPass; // for one pass
-      msRuntime += 2 * perfEnergyBT.m_msRuntime;
-      mjEnergy += 2 * perfEnergyBT.m_mjEnergy;
+      mjEnergy.m_mjActPre = m_eAP * bitsPerElement * numPass; // for one pass
+      mjEnergy.m_mjLogic = 3 * m_eL * bitsPerElement * numPass;
       break;
     case PIM_DEVICE_SIMDRAM:
       // todo
@@ -480,15 +503,16 @@ pimPerfEnergyBitSerial::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjI
       // TOD): total Op uinimplemented
       msRuntime = (m_tR + (bitsPerElement + 2) * m_tL + m_tW); // for one pass
       msRuntime *= numPass;
-      mjEnergy = (m_eAP + (bitsPerElement + 2) * m_eL) * numPass;
-      msRuntime += 2 * perfEnergyBT.m_msRuntime;
-      mjEnergy += 2 * perfEnergyBT.m_mjEnergy;
+      mjEnergy.m_mjActPre = m_eAP * numPass;
+      mjEnergy.m_mjLogic = (bitsPerElement + 2) * m_eL * numPass;
       break;
     default:
       assert(0);
   }
   
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
 }
 
 //! @brief  Perf energy model of bit-serial PIM for prefix sum
@@ -496,11 +520,93 @@ pimeval::perfEnergy
 pimPerfEnergyBitSerial::getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
   uint64_t totalOp = 0;
   printf("PIM-Warning: Perf energy model not available for PIM command %s\n", pimCmd::getName(cmdType, "").c_str());
-  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
-}
\ No newline at end of file
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
+}
+
+//! @brief  Perf energy model of bit-serial PIM for batched AND-popcount
+//! Reuses the row-wide 64-bit popcount logic of reduction sum. In each pass, both operand rows of every
+//! bit-slice (V-layout) or word row (H-layout) are aligned with in-DRAM row copies, ANDed in the row
+//! register, and popcounted into per-pair accumulators without writing intermediate results back.
+pimeval::perfEnergy
+pimPerfEnergyBitSerial::getPerfEnergyForAndPopCount(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t numWords) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
+  unsigned numCore = obj.getNumCoresUsed();
+  uint64_t numPass = getNumPassForWords(obj, numWords);
+  double mjEnergyPerPcl = m_pclNsDelay * m_pclUwPower * 1e-12;
+
+  // rows per operand and 64-bit popcounts per row in one pass
+  unsigned numRowsPerOperand = obj.isVLayout() ? bitsPerElement : 1;
+  uint64_t numPclPerRow = obj.isVLayout() ? (maxElementsPerRegion + 63) / 64
+                                          : (static_cast<uint64_t>(maxElementsPerRegion) * bitsPerElement + 63) / 64;
+
+  double msRead = (4 * m_tR * numRowsPerOperand) * numPass; // row copy and operand read of two operands
+  double msWrite = (2 * m_tW * numRowsPerOperand) * numPass; // row copy of two operands
+  double msCompute = (m_tL + (m_pclNsDelay * 1e-6) * numPclPerRow) * numRowsPerOperand * numPass;
+  double msRuntime = msRead + msWrite + msCompute;
+  mjEnergy.m_mjActPre = m_eAP * 6 * numRowsPerOperand * numCore;
+  mjEnergy.m_mjLogic = (m_eL + mjEnergyPerPcl * numPclPerRow) * numRowsPerOperand * numCore;
+  mjEnergy *= numPass;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, numWords * 3);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
+}
+
+//! @brief  Perf energy model of bit-serial PIM for top-k selection
+//! Radix select in V-layout, which costs one round per bit regardless of k. From the most significant bit,
+//! each round ANDs the bit-slice with the candidate mask in the row register, counts matches with the
+//! row-wide 64-bit popcount logic, aggregates counts of all cores on host, and updates the mask. FP bits
+//! are XORed with the sign bit first to make them ordered like integers. The final mask and the k winners
+//! with their indices are read back to host. Other layouts use the tournament model of the base class.
+pimeval::perfEnergy
+pimPerfEnergyBitSerial::getPerfEnergyForTopK(PimCmdEnum cmdType, const pimObjInfo& obj, uint64_t k) const
+{
+  PimDataType dataType = obj.getDataType();
+  if ((m_simTarget != PIM_DEVICE_BITSIMD_V && m_simTarget != PIM_DEVICE_BITSIMD_V_AP) || !obj.isVLayout()) {
+    return pimPerfEnergyBase::getPerfEnergyForTopK(cmdType, obj, k);
+  }
+
+  pimeval::energyBreakdown mjEnergy;
+  unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned numPass = std::max(obj.getMaxNumRegionsPerCore(), 1u);
+  unsigned maxElementsPerRegion = obj.getMaxElementsPerRegion();
+  unsigned numCore = obj.getNumCoresUsed();
+  double cpuTDP = 225; // W; AMD EPYC 9124 16 core
+  double aggregateMs = static_cast<double>(numCore) / 2300000;
+  double mjEnergyPerPcl = m_pclNsDelay * m_pclUwPower * 1e-12;
+  uint64_t numPclPerRow = (maxElementsPerRegion + 63) / 64;
+  unsigned numLogicOps = pimUtils::isFP(dataType) ? 3 : 2;
+
+  // read bit-slice and mask, AND and popcount, update and write mask
+  double msRead = 2 * m_tR * bitsPerElement * numPass;
+  double msWrite = m_tW * bitsPerElement * numPass;
+  double msCompute = ((numLogicOps * m_tL + (m_pclNsDelay * 1e-6) * numPclPerRow) * numPass + aggregateMs) * bitsPerElement;
+  mjEnergy.m_mjActPre = m_eAP * 3 * numCore;
+  mjEnergy.m_mjLogic = (numLogicOps * m_eL + mjEnergyPerPcl * numPclPerRow) * numCore;
+  mjEnergy *= bitsPerElement * numPass;
+  mjEnergy.m_mjHost = aggregateMs * bitsPerElement * cpuTDP;
+
+  // final mask and winners
+  pimeval::perfEnergy perfMask = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, (obj.getNumElements() + 7) / 8);
+  pimeval::perfEnergy perfResults = getPerfEnergyForTopKResults(obj, k);
+  msRead += perfMask.m_msRuntime + perfResults.m_msRuntime;
+  mjEnergy.m_mjGDL += perfMask.m_mjBreakdown.m_mjGDL + perfResults.m_mjBreakdown.m_mjGDL;
+
+  double msRuntime = msRead + msWrite + msCompute;
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  pimeval::perfEnergy perf(msRuntime, mjEnergy, msRead, msWrite, msCompute, obj.getNumElements() * bitsPerElement);
+  applyActLimits(perf, getNumRowActRounds(perf));
+  return perf;
+}
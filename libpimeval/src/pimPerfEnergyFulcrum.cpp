@@ -23,7 +23,7 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
   // the write operation is also pipelined. Thus, only one row write operation is needed.
 
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msALU = 0.0;
@@ -45,8 +45,8 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       msRead = m_tR * numPass;
       msWrite = m_tW * numPass;
       msRuntime = msRead + msWrite + msALU;
-      mjEnergy = numPass * numCores * m_eAP * 2;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = numPass * numCores * m_eAP * 2;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       break;
     }
     case PimCmdEnum::POPCOUNT:
@@ -58,10 +58,11 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       msRuntime = msRead + msWrite + msALU;
       double energyArithmetic = (((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy * numberOfALUOperationPerElement) + (maxElementsPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement)) * (numPass - 1);
       energyArithmetic += (((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy * numberOfALUOperationPerElement) + (minElementPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement));
-      double energyLogical = ((m_eAP * 2) + (((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * 11))) * (numPass - 1);
-      energyLogical += (m_eAP * 2) + (((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * 11));
-      mjEnergy = (energyArithmetic + energyLogical) * numCores ;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      double energyLogical = (((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * 11)) * (numPass - 1);
+      energyLogical += (((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * 11));
+      mjEnergy.m_mjActPre = m_eAP * 2 * numPass * numCores;
+      mjEnergy.m_mjLogic = (energyArithmetic + energyLogical) * numCores;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements() * 12;
       break;
     }
@@ -79,10 +80,11 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       msWrite = m_tW;
       msALU = ((maxElementsPerRegion * m_fulcrumAddLatency * numberOfALUOperationPerElement) * (numPass - 1)) + (minElementPerRegion * m_fulcrumAddLatency * numberOfALUOperationPerElement);
       msRuntime = msRead + msWrite + msALU;
-      double energyLogical = ((m_eAP * 2) + ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement)) * (numPass - 1);
-      energyLogical += ((m_eAP * 2) + (minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement);
-      mjEnergy = energyLogical * numCores;
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      double energyLogical = (((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement)) * (numPass - 1);
+      energyLogical += ((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjActPre = m_eAP * 2 * numPass * numCores;
+      mjEnergy.m_mjLogic = energyLogical * numCores;
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -93,9 +95,11 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       msWrite = m_tW;
       msALU = ((maxElementsPerRegion * m_fulcrumMulLatency * numberOfALUOperationPerElement) * (numPass - 1)) + (minElementPerRegion * m_fulcrumMulLatency * numberOfALUOperationPerElement);
       msRuntime = msRead + msWrite + msALU;
-      mjEnergy = (numPass - 1) * numCores * ((m_eAP * 2) + ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement));
-      mjEnergy += numCores * ((m_eAP * 2) + ((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = (numPass - 1) * numCores * m_eAP * 2;
+      mjEnergy.m_mjLogic = (numPass - 1) * numCores * ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy + maxElementsPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjActPre += numCores * m_eAP * 2;
+      mjEnergy.m_mjLogic += numCores * ((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy + minElementPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -120,16 +124,18 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc1(PimCmdEnum cmdType, const pimObjInfo
       msWrite = m_tW;
       msALU = ((maxElementsPerRegion * m_fulcrumAddLatency * numberOfALUOperationPerElement) * (numPass - 1)) + (minElementPerRegion * m_fulcrumAddLatency * numberOfALUOperationPerElement);
       msRuntime = msRead + msWrite + msALU;
-      mjEnergy = (numPass - 1) * numCores * ((m_eAP * 2) + ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement));
-      mjEnergy = numCores * ((m_eAP * 2) + ((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime; 
+      mjEnergy.m_mjActPre = (numPass - 1) * numCores * m_eAP * 2;
+      mjEnergy.m_mjLogic = (numPass - 1) * numCores * ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy + maxElementsPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjActPre = numCores * m_eAP * 2;
+      mjEnergy.m_mjLogic = numCores * ((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy + minElementPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime); 
       totalOp = obj.getNumElements();
       break;
     }
     case PimCmdEnum::AES_SBOX:
     case PimCmdEnum::AES_INVERSE_SBOX:
       msRuntime = 1e10;
-      mjEnergy = 999999999.9;
+      mjEnergy.m_mjLogic = 999999999.9; // todo
       printf("PIM-Warning: Perf energy model not available for PIM command %s\n", pimCmd::getName(cmdType, "").c_str());
       break;
     default:
@@ -145,7 +151,7 @@ pimeval::perfEnergy
 pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo& obj, const pimObjInfo& objSrc2, const pimObjInfo& objDest) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msALU = 0.0;
@@ -165,9 +171,11 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
       msWrite = m_tW * numPass;
       msALU = (maxElementsPerRegion * numberOfALUOperationPerElement * m_fulcrumMulLatency * (numPass - 1)) +  (minElementPerRegion * numberOfALUOperationPerElement * m_fulcrumMulLatency);
       msRuntime = msRead + msWrite + msALU;
-      mjEnergy = numCoresUsed * (numPass - 1) * ((m_eAP * 3) + ((maxElementsPerRegion - 1) * 3 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement));
-      mjEnergy += numCoresUsed * ((m_eAP * 3) + ((minElementPerRegion - 1) * 3 *  m_fulcrumShiftEnergy) + ((minElementPerRegion) * m_fulcrumMulEnergy * numberOfALUOperationPerElement));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = numCoresUsed * (numPass - 1) * m_eAP * 3;
+      mjEnergy.m_mjLogic = numCoresUsed * (numPass - 1) * ((maxElementsPerRegion - 1) * 3 *  m_fulcrumShiftEnergy + maxElementsPerRegion * m_fulcrumMulEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjActPre += numCoresUsed * m_eAP * 3;
+      mjEnergy.m_mjLogic += numCoresUsed * ((minElementPerRegion - 1) * 3 *  m_fulcrumShiftEnergy + (minElementPerRegion) * m_fulcrumMulEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -192,9 +200,11 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
       msWrite = m_tW;
       msALU = (maxElementsPerRegion * numberOfALUOperationPerElement * (m_fulcrumAddLatency + m_fulcrumMulLatency ) * (numPass - 1)) +  (minElementPerRegion * numberOfALUOperationPerElement * (m_fulcrumAddLatency + m_fulcrumMulLatency ));
       msRuntime = msRead + msWrite + msALU;
-      mjEnergy = numCoresUsed * (numPass - 1) * ((m_eAP * 2) + ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy * 2) + (maxElementsPerRegion * (m_fulcrumAddEnergy + m_fulcrumMulEnergy) * numberOfALUOperationPerElement));
-      mjEnergy += numCoresUsed * ((m_eAP * 2) + ((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy * 2) + (minElementPerRegion * (m_fulcrumAddEnergy + m_fulcrumMulEnergy) * numberOfALUOperationPerElement));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = numCoresUsed * (numPass - 1) * m_eAP * 2;
+      mjEnergy.m_mjLogic = numCoresUsed * (numPass - 1) * ((maxElementsPerRegion - 1) * 2 *  m_fulcrumShiftEnergy * 2 + maxElementsPerRegion * (m_fulcrumAddEnergy + m_fulcrumMulEnergy) * numberOfALUOperationPerElement);
+      mjEnergy.m_mjActPre += numCoresUsed * m_eAP * 2;
+      mjEnergy.m_mjLogic += numCoresUsed * ((minElementPerRegion - 1) * 2 *  m_fulcrumShiftEnergy * 2 + minElementPerRegion * (m_fulcrumAddEnergy + m_fulcrumMulEnergy) * numberOfALUOperationPerElement);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements() * 2;
       break;
     }
@@ -216,9 +226,11 @@ pimPerfEnergyFulcrum::getPerfEnergyForFunc2(PimCmdEnum cmdType, const pimObjInfo
       msWrite = m_tW * numPass;
       msALU = (maxElementsPerRegion * numberOfALUOperationPerElement * m_fulcrumAddLatency * (numPass - 1)) +  (minElementPerRegion * numberOfALUOperationPerElement * m_fulcrumAddLatency);
       msRuntime = msRead + msWrite + msALU;
-      mjEnergy = numCoresUsed * (numPass - 1) * ((m_eAP * 3) + ((maxElementsPerRegion - 1) * 3 *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement));
-      mjEnergy += numCoresUsed * ((m_eAP * 3) + ((minElementPerRegion - 1) * 3 *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement));
-      mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+      mjEnergy.m_mjActPre = numCoresUsed * (numPass - 1) * m_eAP * 3;
+      mjEnergy.m_mjLogic = numCoresUsed * (numPass - 1) * ((maxElementsPerRegion - 1) * 3 *  m_fulcrumShiftEnergy + maxElementsPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjActPre += numCoresUsed * m_eAP * 3;
+      mjEnergy.m_mjLogic += numCoresUsed * ((minElementPerRegion - 1) * 3 *  m_fulcrumShiftEnergy + minElementPerRegion * m_fulcrumAddEnergy * numberOfALUOperationPerElement);
+      mjEnergy.m_mjBackground += getMjBackground(msRuntime);
       totalOp = obj.getNumElements();
       break;
     }
@@ -234,7 +246,7 @@ pimeval::perfEnergy
 pimPerfEnergyFulcrum::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimObjInfo& obj, unsigned numPass) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -263,10 +275,12 @@ pimPerfEnergyFulcrum::getPerfEnergyForReduction(PimCmdEnum cmdType, const pimObj
     msWrite = 0;
     msCompute = aggregateMs + (maxElementsPerRegion * m_fulcrumAddLatency * numberOfOperationPerElement * (numPass  - 1)) + (minElementPerRegion * m_fulcrumAddLatency * numberOfOperationPerElement);
     msRuntime = msRead + msWrite + msCompute;
-    mjEnergy = (numPass - 1) * numCore * (m_eAP + ((maxElementsPerRegion - 1) *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement));
-    mjEnergy += numCore * (m_eAP + ((minElementPerRegion - 1) *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement));
-    mjEnergy += aggregateMs * cpuTDP;
-    mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+    mjEnergy.m_mjActPre = (numPass - 1) * numCore * m_eAP;
+    mjEnergy.m_mjLogic = (numPass - 1) * numCore * ((maxElementsPerRegion - 1) *  m_fulcrumShiftEnergy + maxElementsPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement);
+    mjEnergy.m_mjActPre += numCore * m_eAP;
+    mjEnergy.m_mjLogic += numCore * ((minElementPerRegion - 1) *  m_fulcrumShiftEnergy + minElementPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement);
+    mjEnergy.m_mjHost += aggregateMs * cpuTDP;
+    mjEnergy.m_mjBackground += getMjBackground(msRuntime);
     totalOp = obj.getNumElements();
     break;
   }
@@ -282,7 +296,7 @@ pimeval::perfEnergy
 pimPerfEnergyFulcrum::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -297,9 +311,11 @@ pimPerfEnergyFulcrum::getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObj
   msWrite = m_tW * numPass;
   msCompute = (m_fulcrumAddLatency * maxElementsPerRegion * numberOfOperationPerElement * (numPass - 1)) + (m_fulcrumAddLatency * minElementPerRegion * numberOfOperationPerElement);
   msRuntime = msRead + msWrite + msCompute;
-  mjEnergy = (numPass - 1) * numCore * (m_eAP + ((maxElementsPerRegion - 1) *  m_fulcrumShiftEnergy) + ((maxElementsPerRegion) * m_fulcrumAddEnergy * numberOfOperationPerElement));
-  mjEnergy += numCore * (m_eAP + ((minElementPerRegion - 1) *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement));
-  mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+  mjEnergy.m_mjActPre = (numPass - 1) * numCore * m_eAP;
+  mjEnergy.m_mjLogic = (numPass - 1) * numCore * ((maxElementsPerRegion - 1) *  m_fulcrumShiftEnergy + (maxElementsPerRegion) * m_fulcrumAddEnergy * numberOfOperationPerElement);
+  mjEnergy.m_mjActPre += numCore * m_eAP;
+  mjEnergy.m_mjLogic += numCore * ((minElementPerRegion - 1) *  m_fulcrumShiftEnergy + minElementPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement);
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
   totalOp = 0;
 
   return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
@@ -310,16 +326,14 @@ pimeval::perfEnergy
 pimPerfEnergyFulcrum::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
   unsigned numPass = obj.getMaxNumRegionsPerCore();
   unsigned bitsPerElement = obj.getBitsPerElement(PimBitWidth::ACTUAL);
-  unsigned numRegions = obj.getRegions().size();
   uint64_t totalOp = 0;
-  // boundary handling - assume two times copying between device and host for boundary elements
-  pimeval::perfEnergy perfEnergyBT = getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numRegions * bitsPerElement / 8);
+  // boundary elements across regions are modeled separately by getPerfEnergyForRotateBoundary
 
   // rotate within subarray:
   // For every bit: Read row to SA; move SA to R1; Shift R1 by N steps; Move R1 to SA; Write SA to row
@@ -329,9 +343,8 @@ pimPerfEnergyFulcrum::getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInf
   msCompute = (bitsPerElement + 2) * m_tL * numPass;
   msWrite = m_tW * numPass;
   msRuntime = msRead + msWrite + msCompute;
-  mjEnergy = (m_eAP + (bitsPerElement + 2) * m_eL) * numPass;
-  msRuntime += 2 * perfEnergyBT.m_msRuntime;
-  mjEnergy += 2 * perfEnergyBT.m_mjEnergy;
+  mjEnergy.m_mjActPre = m_eAP * numPass;
+  mjEnergy.m_mjLogic = (bitsPerElement + 2) * m_eL * numPass;
   printf("PIM-Warning: Perf energy model is not precise for PIM command %s\n", pimCmd::getName(cmdType, "").c_str());
 
   return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
@@ -342,7 +355,7 @@ pimeval::perfEnergy
 pimPerfEnergyFulcrum::getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const
 {
   double msRuntime = 0.0;
-  double mjEnergy = 0.0;
+  pimeval::energyBreakdown mjEnergy;
   double msRead = 0.0;
   double msWrite = 0.0;
   double msCompute = 0.0;
@@ -390,10 +403,14 @@ pimPerfEnergyFulcrum::getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObj
     msWrite = 2 * m_tW;
     msCompute = aggregateMs + hostRW + (maxElementsPerRegion * m_fulcrumAddLatency * numberOfOperationPerElement * (numPass  - 1) * 2) + (minElementPerRegion * m_fulcrumAddLatency * numberOfOperationPerElement) * 2;
     msRuntime = msRead + msWrite + msCompute;
-    mjEnergy = 2 * (numPass - 1) * numCore * (m_eAP + ((maxElementsPerRegion - 1) *  m_fulcrumShiftEnergy) + (maxElementsPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement * 2));
-    mjEnergy += 2 * numCore * (m_eAP + ((minElementPerRegion - 1) *  m_fulcrumShiftEnergy) + (minElementPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement));
-    mjEnergy += aggregateMs * cpuTDP + ((obj.getNumCoresUsed() * 1.0 / m_numChipsPerRank) * ((2 * m_eAP)  + m_eR + m_eW));
-    mjEnergy += m_pBChip * m_numChipsPerRank * m_numRanks * msRuntime;
+    mjEnergy.m_mjActPre = 2 * (numPass - 1) * numCore * m_eAP;
+    mjEnergy.m_mjLogic = 2 * (numPass - 1) * numCore * ((maxElementsPerRegion - 1) *  m_fulcrumShiftEnergy + maxElementsPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement * 2);
+    mjEnergy.m_mjActPre += 2 * numCore * m_eAP;
+    mjEnergy.m_mjLogic += 2 * numCore * ((minElementPerRegion - 1) *  m_fulcrumShiftEnergy + minElementPerRegion * m_fulcrumAddEnergy * numberOfOperationPerElement);
+    mjEnergy.m_mjHost += aggregateMs * cpuTDP;
+    mjEnergy.m_mjActPre += (obj.getNumCoresUsed() * 1.0 / m_numChipsPerRank) * 2 * m_eAP;
+    mjEnergy.m_mjGDL += (obj.getNumCoresUsed() * 1.0 / m_numChipsPerRank) * (m_eR + m_eW);
+    mjEnergy.m_mjBackground += getMjBackground(msRuntime);
     totalOp = obj.getNumElements() * 2;
     break;
   }
@@ -402,4 +419,32 @@ pimPerfEnergyFulcrum::getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObj
     break;
   }
   return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msCompute, totalOp);
-}
\ No newline at end of file
+}
+
+//! @brief  Perf energy model of Fulcrum for GEMV/GEMM
+//! Fused column MAC: in each pass, one walker keeps the partial sums of a dest region while the other
+//! walker streams the matching row of every matrix column through the ALU. Dest is written once per pass.
+pimeval::perfEnergy
+pimPerfEnergyFulcrum::getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const
+{
+  pimeval::energyBreakdown mjEnergy;
+  unsigned numPass = objDest.getMaxNumRegionsPerCore();
+  unsigned bitsPerElement = objDest.getBitsPerElement(PimBitWidth::ACTUAL);
+  unsigned numCoresUsed = objDest.isLoadBalanced() ? objDest.getNumCoreAvailable() : objDest.getNumCoresUsed();
+  unsigned maxElementsPerRegion = objDest.getMaxElementsPerRegion();
+  unsigned minElementPerRegion = objDest.isLoadBalanced() ? (std::ceil(objDest.getNumElements() * 1.0 / objDest.getNumCoreAvailable()) - (maxElementsPerRegion * (numPass - 1))) : maxElementsPerRegion;
+  double numberOfALUOperationPerElement = ((double)bitsPerElement / m_fulcrumAluBitWidth);
+  double macLatency = m_fulcrumAddLatency + m_fulcrumMulLatency;
+  double macEnergy = m_fulcrumAddEnergy + m_fulcrumMulEnergy;
+
+  double msRead = m_tR * numCols * numPass;
+  double msWrite = m_tW * numPass;
+  double msALU = numCols * ((maxElementsPerRegion * numberOfALUOperationPerElement * macLatency * (numPass - 1)) + (minElementPerRegion * numberOfALUOperationPerElement * macLatency));
+  double msRuntime = msRead + msWrite + msALU;
+  mjEnergy.m_mjActPre = numCoresUsed * numPass * (numCols + 1) * m_eAP;
+  mjEnergy.m_mjLogic = numCols * numCoresUsed * (numPass - 1) * ((maxElementsPerRegion - 1) * 2 * m_fulcrumShiftEnergy + maxElementsPerRegion * macEnergy * numberOfALUOperationPerElement);
+  mjEnergy.m_mjLogic += numCols * numCoresUsed * ((minElementPerRegion - 1) * 2 * m_fulcrumShiftEnergy + minElementPerRegion * macEnergy * numberOfALUOperationPerElement);
+  mjEnergy.m_mjBackground += getMjBackground(msRuntime);
+  uint64_t totalOp = objDest.getNumElements() * numCols * 2;
+  return pimeval::perfEnergy(msRuntime, mjEnergy, msRead, msWrite, msALU, totalOp);
+}
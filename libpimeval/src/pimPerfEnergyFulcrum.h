@@ -28,6 +28,8 @@ public:
   virtual pimeval::perfEnergy getPerfEnergyForBroadcast(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
   virtual pimeval::perfEnergy getPerfEnergyForRotate(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
   virtual pimeval::perfEnergy getPerfEnergyForPrefixSum(PimCmdEnum cmdType, const pimObjInfo& obj) const override;
+  virtual pimeval::perfEnergy getPerfEnergyForBatchedReduction(const std::vector<pimeval::perfEnergy>& perfs) const override { return getPerfEnergyForOverlappedReductions(perfs); }
+  virtual pimeval::perfEnergy getPerfEnergyForGemv(PimCmdEnum cmdType, const pimObjInfo& objMat, const pimObjInfo& objDest, uint64_t numCols) const override;
 
 protected:
   double m_fulcrumMulLatency = 0.00000609; // 6.09ns
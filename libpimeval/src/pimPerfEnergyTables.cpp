@@ -334,6 +334,158 @@ pimPerfEnergyTables::bitsimdPerfTable = {
       { PimCmdEnum::MUL,          { 1852, 1000, 3054 } },
       { PimCmdEnum::DIV,          { 2744, 1458, 4187 } },
       { PimCmdEnum::MUL_SCALAR,   { 1852, 1000, 3054 } },
+    }},
+    { PIM_INT4, {
+      { PimCmdEnum::ABS,          {    5,    4,   18 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    8,    4,   13 } },
+      { PimCmdEnum::SUB,          {    8,    4,   13 } },
+      { PimCmdEnum::MUL,          {   20,   10,   36 } },
+      { PimCmdEnum::DIV,          {   52,   43,  108 } },
+      { PimCmdEnum::NOT,          {    4,    4,    4 } },
+      { PimCmdEnum::AND,          {    8,    4,    8 } },
+      { PimCmdEnum::OR,           {    8,    4,    8 } },
+      { PimCmdEnum::XOR,          {    8,    4,    8 } },
+      { PimCmdEnum::XNOR,         {    8,    4,   12 } },
+      { PimCmdEnum::GT,           {    8,    1,   13 } },
+      { PimCmdEnum::LT,           {    8,    1,   13 } },
+      { PimCmdEnum::EQ,           {    8,    1,   14 } },
+      { PimCmdEnum::NE,           {    8,    1,   14 } },
+      { PimCmdEnum::MIN,          {   16,    4,   21 } },
+      { PimCmdEnum::MAX,          {   16,    4,   21 } },
+      { PimCmdEnum::ADD_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::SUB_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::MUL_SCALAR,   {   10,   10,   46 } },
+      { PimCmdEnum::DIV_SCALAR,   {   42,   47,  122 } },
+      { PimCmdEnum::AND_SCALAR,   {    4,    4,   12 } },
+      { PimCmdEnum::OR_SCALAR,    {    4,    4,   12 } },
+      { PimCmdEnum::XOR_SCALAR,   {    4,    4,   12 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    4,    4,   16 } },
+      { PimCmdEnum::GT_SCALAR,    {    4,    1,   17 } },
+      { PimCmdEnum::LT_SCALAR,    {    4,    1,   17 } },
+      { PimCmdEnum::EQ_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::NE_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::MIN_SCALAR,   {    8,    4,   29 } },
+      { PimCmdEnum::MAX_SCALAR,   {    8,    4,   29 } },
+      { PimCmdEnum::SCALED_ADD,   {   18,   14,   59 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {   16,    4,   21 } },
+      { PimCmdEnum::REDMIN_RANGE, {   16,    4,   21 } },
+      { PimCmdEnum::REDMAX,       {   16,    4,   21 } },
+      { PimCmdEnum::REDMAX_RANGE, {   16,    4,   21 } },
+    }},
+    { PIM_UINT4, {
+      { PimCmdEnum::ABS,          {    4,    4,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    8,    4,   13 } },
+      { PimCmdEnum::SUB,          {    8,    4,   13 } },
+      { PimCmdEnum::MUL,          {   20,   10,   36 } },
+      { PimCmdEnum::DIV,          {   60,   46,   85 } },
+      { PimCmdEnum::NOT,          {    4,    4,    4 } },
+      { PimCmdEnum::AND,          {    8,    4,    8 } },
+      { PimCmdEnum::OR,           {    8,    4,    8 } },
+      { PimCmdEnum::XOR,          {    8,    4,    8 } },
+      { PimCmdEnum::XNOR,         {    8,    4,   12 } },
+      { PimCmdEnum::GT,           {    8,    1,   14 } },
+      { PimCmdEnum::LT,           {    8,    1,   14 } },
+      { PimCmdEnum::EQ,           {    8,    1,   14 } },
+      { PimCmdEnum::NE,           {    8,    1,   14 } },
+      { PimCmdEnum::MIN,          {   16,    4,   22 } },
+      { PimCmdEnum::MAX,          {   16,    4,   22 } },
+      { PimCmdEnum::ADD_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::SUB_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::MUL_SCALAR,   {   10,   10,   46 } },
+      { PimCmdEnum::DIV_SCALAR,   {   44,   46,  101 } },
+      { PimCmdEnum::AND_SCALAR,   {    4,    4,   12 } },
+      { PimCmdEnum::OR_SCALAR,    {    4,    4,   12 } },
+      { PimCmdEnum::XOR_SCALAR,   {    4,    4,   12 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    4,    4,   16 } },
+      { PimCmdEnum::GT_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::LT_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::EQ_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::NE_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::MIN_SCALAR,   {    8,    4,   30 } },
+      { PimCmdEnum::MAX_SCALAR,   {    8,    4,   30 } },
+      { PimCmdEnum::SCALED_ADD,   {   18,   14,   59 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {   16,    4,   22 } },
+      { PimCmdEnum::REDMIN_RANGE, {   16,    4,   22 } },
+      { PimCmdEnum::REDMAX,       {   16,    4,   22 } },
+      { PimCmdEnum::REDMAX_RANGE, {   16,    4,   22 } },
+    }},
+    { PIM_INT2, {
+      { PimCmdEnum::ABS,          {    3,    2,   10 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    4,    2,    7 } },
+      { PimCmdEnum::SUB,          {    4,    2,    7 } },
+      { PimCmdEnum::MUL,          {    6,    3,   10 } },
+      { PimCmdEnum::DIV,          {   16,   14,   42 } },
+      { PimCmdEnum::NOT,          {    2,    2,    2 } },
+      { PimCmdEnum::AND,          {    4,    2,    4 } },
+      { PimCmdEnum::OR,           {    4,    2,    4 } },
+      { PimCmdEnum::XOR,          {    4,    2,    4 } },
+      { PimCmdEnum::XNOR,         {    4,    2,    6 } },
+      { PimCmdEnum::GT,           {    4,    1,    7 } },
+      { PimCmdEnum::LT,           {    4,    1,    7 } },
+      { PimCmdEnum::EQ,           {    4,    1,    8 } },
+      { PimCmdEnum::NE,           {    4,    1,    8 } },
+      { PimCmdEnum::MIN,          {    8,    2,   11 } },
+      { PimCmdEnum::MAX,          {    8,    2,   11 } },
+      { PimCmdEnum::ADD_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::SUB_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::MUL_SCALAR,   {    3,    3,   13 } },
+      { PimCmdEnum::DIV_SCALAR,   {   14,   16,   46 } },
+      { PimCmdEnum::AND_SCALAR,   {    2,    2,    6 } },
+      { PimCmdEnum::OR_SCALAR,    {    2,    2,    6 } },
+      { PimCmdEnum::XOR_SCALAR,   {    2,    2,    6 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    2,    2,    8 } },
+      { PimCmdEnum::GT_SCALAR,    {    2,    1,    9 } },
+      { PimCmdEnum::LT_SCALAR,    {    2,    1,    9 } },
+      { PimCmdEnum::EQ_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::NE_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::MIN_SCALAR,   {    4,    2,   15 } },
+      { PimCmdEnum::MAX_SCALAR,   {    4,    2,   15 } },
+      { PimCmdEnum::SCALED_ADD,   {    7,    5,   20 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {    8,    2,   11 } },
+      { PimCmdEnum::REDMIN_RANGE, {    8,    2,   11 } },
+      { PimCmdEnum::REDMAX,       {    8,    2,   11 } },
+      { PimCmdEnum::REDMAX_RANGE, {    8,    2,   11 } },
+    }},
+    { PIM_UINT2, {
+      { PimCmdEnum::ABS,          {    2,    2,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    4,    2,    7 } },
+      { PimCmdEnum::SUB,          {    4,    2,    7 } },
+      { PimCmdEnum::MUL,          {    6,    3,   10 } },
+      { PimCmdEnum::DIV,          {   18,   17,   27 } },
+      { PimCmdEnum::NOT,          {    2,    2,    2 } },
+      { PimCmdEnum::AND,          {    4,    2,    4 } },
+      { PimCmdEnum::OR,           {    4,    2,    4 } },
+      { PimCmdEnum::XOR,          {    4,    2,    4 } },
+      { PimCmdEnum::XNOR,         {    4,    2,    6 } },
+      { PimCmdEnum::GT,           {    4,    1,    8 } },
+      { PimCmdEnum::LT,           {    4,    1,    8 } },
+      { PimCmdEnum::EQ,           {    4,    1,    8 } },
+      { PimCmdEnum::NE,           {    4,    1,    8 } },
+      { PimCmdEnum::MIN,          {    8,    2,   12 } },
+      { PimCmdEnum::MAX,          {    8,    2,   12 } },
+      { PimCmdEnum::ADD_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::SUB_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::MUL_SCALAR,   {    3,    3,   13 } },
+      { PimCmdEnum::DIV_SCALAR,   {   14,   17,   31 } },
+      { PimCmdEnum::AND_SCALAR,   {    2,    2,    6 } },
+      { PimCmdEnum::OR_SCALAR,    {    2,    2,    6 } },
+      { PimCmdEnum::XOR_SCALAR,   {    2,    2,    6 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    2,    2,    8 } },
+      { PimCmdEnum::GT_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::LT_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::EQ_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::NE_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::MIN_SCALAR,   {    4,    2,   16 } },
+      { PimCmdEnum::MAX_SCALAR,   {    4,    2,   16 } },
+      { PimCmdEnum::SCALED_ADD,   {    7,    5,   20 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {    8,    2,   12 } },
+      { PimCmdEnum::REDMIN_RANGE, {    8,    2,   12 } },
+      { PimCmdEnum::REDMAX,       {    8,    2,   12 } },
+      { PimCmdEnum::REDMAX_RANGE, {    8,    2,   12 } },
     }}
   }},
   { PIM_DEVICE_BITSIMD_V_AP, {
@@ -656,6 +808,158 @@ pimPerfEnergyTables::bitsimdPerfTable = {
       { PimCmdEnum::MUL,          { 2222, 1200, 3664 } },
       { PimCmdEnum::DIV,          { 3292, 1749, 5024 } },
       { PimCmdEnum::MUL_SCALAR,   { 2222, 1200, 3664 } },
+    }},
+    { PIM_INT4, {
+      { PimCmdEnum::ABS,          {    5,    4,   27 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    8,    4,   13 } },
+      { PimCmdEnum::SUB,          {    8,    4,   13 } },
+      { PimCmdEnum::MUL,          {   20,   10,   36 } },
+      { PimCmdEnum::DIV,          {   52,   43,  157 } },
+      { PimCmdEnum::NOT,          {    4,    4,    4 } },
+      { PimCmdEnum::AND,          {    8,    4,    8 } },
+      { PimCmdEnum::OR,           {    8,    4,    9 } },
+      { PimCmdEnum::XOR,          {    8,    4,   13 } },
+      { PimCmdEnum::XNOR,         {    8,    4,    8 } },
+      { PimCmdEnum::GT,           {    8,    1,   17 } },
+      { PimCmdEnum::LT,           {    8,    1,   17 } },
+      { PimCmdEnum::EQ,           {    8,    1,   14 } },
+      { PimCmdEnum::NE,           {    8,    1,   14 } },
+      { PimCmdEnum::MIN,          {   16,    4,   25 } },
+      { PimCmdEnum::MAX,          {   16,    4,   25 } },
+      { PimCmdEnum::ADD_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::SUB_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::MUL_SCALAR,   {   10,   10,   46 } },
+      { PimCmdEnum::DIV_SCALAR,   {   42,   47,  171 } },
+      { PimCmdEnum::AND_SCALAR,   {    4,    4,   12 } },
+      { PimCmdEnum::OR_SCALAR,    {    4,    4,   13 } },
+      { PimCmdEnum::XOR_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    4,    4,   12 } },
+      { PimCmdEnum::GT_SCALAR,    {    4,    1,   21 } },
+      { PimCmdEnum::LT_SCALAR,    {    4,    1,   21 } },
+      { PimCmdEnum::EQ_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::NE_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::MIN_SCALAR,   {    8,    4,   33 } },
+      { PimCmdEnum::MAX_SCALAR,   {    8,    4,   33 } },
+      { PimCmdEnum::SCALED_ADD,   {   18,   14,   59 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {   16,    4,   25 } },
+      { PimCmdEnum::REDMIN_RANGE, {   16,    4,   25 } },
+      { PimCmdEnum::REDMAX,       {   16,    4,   25 } },
+      { PimCmdEnum::REDMAX_RANGE, {   16,    4,   25 } },
+    }},
+    { PIM_UINT4, {
+      { PimCmdEnum::ABS,          {    4,    4,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    8,    4,   13 } },
+      { PimCmdEnum::SUB,          {    8,    4,   13 } },
+      { PimCmdEnum::MUL,          {   20,   10,   36 } },
+      { PimCmdEnum::DIV,          {   60,   46,  121 } },
+      { PimCmdEnum::NOT,          {    4,    4,    4 } },
+      { PimCmdEnum::AND,          {    8,    4,    8 } },
+      { PimCmdEnum::OR,           {    8,    4,    9 } },
+      { PimCmdEnum::XOR,          {    8,    4,   13 } },
+      { PimCmdEnum::XNOR,         {    8,    4,    8 } },
+      { PimCmdEnum::GT,           {    8,    1,   19 } },
+      { PimCmdEnum::LT,           {    8,    1,   19 } },
+      { PimCmdEnum::EQ,           {    8,    1,   14 } },
+      { PimCmdEnum::NE,           {    8,    1,   14 } },
+      { PimCmdEnum::MIN,          {   16,    4,   27 } },
+      { PimCmdEnum::MAX,          {   16,    4,   27 } },
+      { PimCmdEnum::ADD_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::SUB_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::MUL_SCALAR,   {   10,   10,   46 } },
+      { PimCmdEnum::DIV_SCALAR,   {   44,   46,  137 } },
+      { PimCmdEnum::AND_SCALAR,   {    4,    4,   12 } },
+      { PimCmdEnum::OR_SCALAR,    {    4,    4,   13 } },
+      { PimCmdEnum::XOR_SCALAR,   {    4,    4,   17 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    4,    4,   12 } },
+      { PimCmdEnum::GT_SCALAR,    {    4,    1,   23 } },
+      { PimCmdEnum::LT_SCALAR,    {    4,    1,   23 } },
+      { PimCmdEnum::EQ_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::NE_SCALAR,    {    4,    1,   18 } },
+      { PimCmdEnum::MIN_SCALAR,   {    8,    4,   35 } },
+      { PimCmdEnum::MAX_SCALAR,   {    8,    4,   35 } },
+      { PimCmdEnum::SCALED_ADD,   {   18,   14,   59 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {   16,    4,   27 } },
+      { PimCmdEnum::REDMIN_RANGE, {   16,    4,   27 } },
+      { PimCmdEnum::REDMAX,       {   16,    4,   27 } },
+      { PimCmdEnum::REDMAX_RANGE, {   16,    4,   27 } },
+    }},
+    { PIM_INT2, {
+      { PimCmdEnum::ABS,          {    3,    2,   15 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    4,    2,    7 } },
+      { PimCmdEnum::SUB,          {    4,    2,    7 } },
+      { PimCmdEnum::MUL,          {    6,    3,   10 } },
+      { PimCmdEnum::DIV,          {   16,   14,   61 } },
+      { PimCmdEnum::NOT,          {    2,    2,    2 } },
+      { PimCmdEnum::AND,          {    4,    2,    4 } },
+      { PimCmdEnum::OR,           {    4,    2,    5 } },
+      { PimCmdEnum::XOR,          {    4,    2,    7 } },
+      { PimCmdEnum::XNOR,         {    4,    2,    4 } },
+      { PimCmdEnum::GT,           {    4,    1,    9 } },
+      { PimCmdEnum::LT,           {    4,    1,    9 } },
+      { PimCmdEnum::EQ,           {    4,    1,    8 } },
+      { PimCmdEnum::NE,           {    4,    1,    8 } },
+      { PimCmdEnum::MIN,          {    8,    2,   13 } },
+      { PimCmdEnum::MAX,          {    8,    2,   13 } },
+      { PimCmdEnum::ADD_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::SUB_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::MUL_SCALAR,   {    3,    3,   13 } },
+      { PimCmdEnum::DIV_SCALAR,   {   14,   16,   65 } },
+      { PimCmdEnum::AND_SCALAR,   {    2,    2,    6 } },
+      { PimCmdEnum::OR_SCALAR,    {    2,    2,    7 } },
+      { PimCmdEnum::XOR_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    2,    2,    6 } },
+      { PimCmdEnum::GT_SCALAR,    {    2,    1,   11 } },
+      { PimCmdEnum::LT_SCALAR,    {    2,    1,   11 } },
+      { PimCmdEnum::EQ_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::NE_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::MIN_SCALAR,   {    4,    2,   17 } },
+      { PimCmdEnum::MAX_SCALAR,   {    4,    2,   17 } },
+      { PimCmdEnum::SCALED_ADD,   {    7,    5,   20 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {    8,    2,   13 } },
+      { PimCmdEnum::REDMIN_RANGE, {    8,    2,   13 } },
+      { PimCmdEnum::REDMAX,       {    8,    2,   13 } },
+      { PimCmdEnum::REDMAX_RANGE, {    8,    2,   13 } },
+    }},
+    { PIM_UINT2, {
+      { PimCmdEnum::ABS,          {    2,    2,    0 } },
+      //{ PimCmdEnum::POPCOUNT,     {    0,    0,    0 } },
+      { PimCmdEnum::ADD,          {    4,    2,    7 } },
+      { PimCmdEnum::SUB,          {    4,    2,    7 } },
+      { PimCmdEnum::MUL,          {    6,    3,   10 } },
+      { PimCmdEnum::DIV,          {   18,   17,   37 } },
+      { PimCmdEnum::NOT,          {    2,    2,    2 } },
+      { PimCmdEnum::AND,          {    4,    2,    4 } },
+      { PimCmdEnum::OR,           {    4,    2,    5 } },
+      { PimCmdEnum::XOR,          {    4,    2,    7 } },
+      { PimCmdEnum::XNOR,         {    4,    2,    4 } },
+      { PimCmdEnum::GT,           {    4,    1,   11 } },
+      { PimCmdEnum::LT,           {    4,    1,   11 } },
+      { PimCmdEnum::EQ,           {    4,    1,    8 } },
+      { PimCmdEnum::NE,           {    4,    1,    8 } },
+      { PimCmdEnum::MIN,          {    8,    2,   15 } },
+      { PimCmdEnum::MAX,          {    8,    2,   15 } },
+      { PimCmdEnum::ADD_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::SUB_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::MUL_SCALAR,   {    3,    3,   13 } },
+      { PimCmdEnum::DIV_SCALAR,   {   14,   17,   41 } },
+      { PimCmdEnum::AND_SCALAR,   {    2,    2,    6 } },
+      { PimCmdEnum::OR_SCALAR,    {    2,    2,    7 } },
+      { PimCmdEnum::XOR_SCALAR,   {    2,    2,    9 } },
+      { PimCmdEnum::XNOR_SCALAR,  {    2,    2,    6 } },
+      { PimCmdEnum::GT_SCALAR,    {    2,    1,   13 } },
+      { PimCmdEnum::LT_SCALAR,    {    2,    1,   13 } },
+      { PimCmdEnum::EQ_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::NE_SCALAR,    {    2,    1,   10 } },
+      { PimCmdEnum::MIN_SCALAR,   {    4,    2,   19 } },
+      { PimCmdEnum::MAX_SCALAR,   {    4,    2,   19 } },
+      { PimCmdEnum::SCALED_ADD,   {    7,    5,   20 } }, // Derived from adding ADD + MUL_SCALAR
+      { PimCmdEnum::REDMIN,       {    8,    2,   15 } },
+      { PimCmdEnum::REDMIN_RANGE, {    8,    2,   15 } },
+      { PimCmdEnum::REDMAX,       {    8,    2,   15 } },
+      { PimCmdEnum::REDMAX_RANGE, {    8,    2,   15 } },
     }}
   }},
 };
@@ -7,7 +7,7 @@
 #include "pimResMgr.h"       // for pimResMgr
 #include "pimDevice.h"       // for pimDevice
 #include <cstdio>            // for printf
-#include <algorithm>         // for sort, prev
+#include <algorithm>         // for sort, prev, max
 #include <stdexcept>         // for throw, invalid_argument
 #include <memory>            // for make_unique
 #include <cassert>           // for assert
@@ -190,11 +190,21 @@ pimObjInfo::getElementBits(uint64_t index) const
   return bits;
 }
 
+//! @brief  Analysis mode only models cost, so PIM objects do not need data storage
+bool
+pimObjInfo::isAnalysisMode(const pimDevice* device)
+{
+  return device && device->getConfig().isAnalysisMode();
+}
+
 //! @brief  Sync PIM object data from simulated memory
 void
 pimObjInfo::syncFromSimulatedMem()
 {
   pimObjInfo &obj = (m_refObjId != -1 ? m_device->getResMgr()->getObjInfo(m_refObjId) : *this);
+  if (!obj.m_data.hasStorage()) {
+    return;
+  }
   unsigned numBits = getBitsPerElement(PimBitWidth::SIM);
   for (size_t i = 0; i < m_regions.size(); ++i) {
     pimRegion& region = m_regions[i];
@@ -216,6 +226,9 @@ void
 pimObjInfo::syncToSimulatedMem() const
 {
   const pimObjInfo &obj = (m_refObjId != -1 ? m_device->getResMgr()->getObjInfo(m_refObjId) : *this);
+  if (!obj.m_data.hasStorage()) {
+    return;
+  }
   unsigned numBits = getBitsPerElement(PimBitWidth::SIM);
   for (size_t i = 0; i < m_regions.size(); ++i) {
     const pimRegion& region = m_regions[i];
@@ -760,7 +773,7 @@ pimResMgr::getCoreIdsSortedByLeastUsage() const
 {
   std::vector<std::pair<unsigned, unsigned>> usages;
   for (unsigned coreId = 0; coreId < m_device->getNumCores(); ++coreId) {
-    unsigned usage = m_coreUsage.at(coreId)->getTotRowsInUse();
+    unsigned usage = m_coreUsage.at(coreId)->getNumRowsInUse();
     usages.emplace_back(usage, coreId);
   }
   std::sort(usages.begin(), usages.end());
@@ -809,6 +822,17 @@ pimResMgr::coreUsage::addRange(std::pair<unsigned, unsigned> range, PimObjId obj
   m_newAlloc.insert(range);
 }
 
+//! @brief  Get number of rows currently occupied by all ranges
+unsigned
+pimResMgr::coreUsage::getNumRowsInUse() const
+{
+  unsigned numRows = 0;
+  for (const auto& it : m_rangesInUse) {
+    numRows += it.first.second;
+  }
+  return numRows;
+}
+
 //! @brief  Delete an object from core usage
 void
 pimResMgr::coreUsage::deleteObj(PimObjId objId)
@@ -837,6 +861,8 @@ pimResMgr::coreUsage::newAllocEnd(bool success)
     for (const auto &range : m_newAlloc) {
       m_rangesInUse.erase(range);
     }
+  } else if (!m_newAlloc.empty()) {
+    m_peakRowsInUse = std::max(m_peakRowsInUse, getNumRowsInUse());
   }
   m_newAlloc.clear();
 }
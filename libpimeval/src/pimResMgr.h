@@ -77,31 +77,56 @@ private:
 //! @class  pimDataHolder
 //! @brief  A container holding raw data vector of a PIM object as a byte array
 //! Assumption: Caller gurantees correct range and indices
+//! A data holder without storage (analysis mode) ignores all writes and reads back zeros
 class pimDataHolder
 {
 public:
-  pimDataHolder(PimDataType dataType, uint64_t numElements)
+  pimDataHolder(PimDataType dataType, uint64_t numElements, bool hasStorage = true)
     : m_dataType(dataType),
-      m_numElements(numElements)
+      m_numElements(numElements),
+      m_hasStorage(hasStorage),
+      m_isPacked(pimUtils::isPackedFP(dataType)),
+      m_isSubByte(pimUtils::isSubByteInt(dataType))
   {
     unsigned numBitsOfDataType = pimUtils::getNumBitsOfDataType(m_dataType, PimBitWidth::HOST);
     // Note: Each data element is stored as m_bytesPerElement bytes in this data holder.
-    // This aligns with the number of bytes per element in the host void* ptr for memcpy.
-    m_bytesPerElement = (numBitsOfDataType + 7) / 8;  // round up, e.g. 1 byte per bool
-    m_data.resize(m_numElements * m_bytesPerElement);
+    // This aligns with the number of bytes per element in the host void* ptr for memcpy,
+    // except for low-precision FP types which are stored packed at actual width and converted on copy,
+    // and sub-byte integer types which are stored as m_bitsPerElement bits per element.
+    m_hostBytesPerElement = (numBitsOfDataType + 7) / 8;  // round up, e.g. 1 byte per bool
+    m_bytesPerElement = m_isPacked ? (pimUtils::getNumBitsOfDataType(m_dataType, PimBitWidth::ACTUAL) + 7) / 8 : m_hostBytesPerElement;
+    m_bitsPerElement = m_isSubByte ? pimUtils::getNumBitsOfDataType(m_dataType, PimBitWidth::ACTUAL) : m_bytesPerElement * 8;
+    if (m_hasStorage) {
+      m_data.resize((m_numElements * m_bitsPerElement + 7) / 8);
+    }
   }
   ~pimDataHolder() {}
 
-  // return the number of bytes within a given range
+  bool hasStorage() const { return m_hasStorage; }
+
+  // return the number of host bytes within a given range
   uint64_t getNumBytes(uint64_t idxBegin, uint64_t idxEnd) const {
     uint64_t numElements = (idxEnd == 0 ? m_numElements : idxEnd - idxBegin);
-    return numElements * m_bytesPerElement;
+    return numElements * m_hostBytesPerElement;
   }
 
   // copy data of range [idxBegin, idxEnd) from host ptr into holder
   // use full range if idxEnd is default 0
   bool copyFromHost(void* src, uint64_t idxBegin = 0, uint64_t idxEnd = 0) {
+    if (!m_hasStorage) { return true; }
+    uint64_t numElements = (idxEnd == 0 ? m_numElements : idxEnd - idxBegin);
+    if (m_isSubByte) {
+      const uint8_t* srcBytes = static_cast<const uint8_t*>(src);
+      for (uint64_t i = 0; i < numElements; ++i) {
+        setSubByteBits(idxBegin + i, srcBytes[i]);
+      }
+      return true;
+    }
     uint64_t byteIndex = idxBegin * m_bytesPerElement;
+    if (m_isPacked) {
+      pimUtils::packFpArray(static_cast<const float*>(src), m_data.data() + byteIndex, numElements, m_dataType);
+      return true;
+    }
     uint64_t numBytes = getNumBytes(idxBegin, idxEnd);
     std::memcpy(m_data.data() + byteIndex, src, numBytes);
     return true;
@@ -110,7 +135,20 @@ public:
   // copy data of range [idxBegin, idxEnd) from holder to host ptr
   // use full range if idxEnd is default 0
   bool copyToHost(void* dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0) const {
+    if (!m_hasStorage) { return true; }
+    uint64_t numElements = (idxEnd == 0 ? m_numElements : idxEnd - idxBegin);
+    if (m_isSubByte) {
+      uint8_t* destBytes = static_cast<uint8_t*>(dest);
+      for (uint64_t i = 0; i < numElements; ++i) {
+        destBytes[i] = static_cast<uint8_t>(pimUtils::signExt(getSubByteBits(idxBegin + i), m_dataType));
+      }
+      return true;
+    }
     uint64_t byteIndex = idxBegin * m_bytesPerElement;
+    if (m_isPacked) {
+      pimUtils::unpackFpArray(m_data.data() + byteIndex, static_cast<float*>(dest), numElements, m_dataType);
+      return true;
+    }
     uint64_t numBytes = getNumBytes(idxBegin, idxEnd);
     std::memcpy(dest, m_data.data() + byteIndex, numBytes);
     return true;
@@ -119,32 +157,59 @@ public:
   // copy data of range [idxBegin, idxEnd) from this holder to another holder
   // use full range if idxEnd is default 0
   bool copyToObj(pimDataHolder& dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0) const {
+    if (!m_hasStorage || !dest.m_hasStorage) { return true; }
+    uint64_t numElements = (idxEnd == 0 ? m_numElements : idxEnd - idxBegin);
+    if (m_isSubByte) {
+      for (uint64_t i = idxBegin; i < idxBegin + numElements; ++i) {
+        dest.setSubByteBits(i, getSubByteBits(i));
+      }
+      return true;
+    }
     uint64_t byteIndex = idxBegin * m_bytesPerElement;
-    uint64_t numBytes = getNumBytes(idxBegin, idxEnd);
+    uint64_t numBytes = numElements * m_bytesPerElement;
     std::memcpy(dest.m_data.data() + byteIndex, m_data.data() + byteIndex, numBytes);
     return true;
   }
 
   // set an element at index from bit representation
+  // low-precision FP types take FP32 bits and round them to actual width
   bool setElementBits(uint64_t index, uint64_t bits) {
+    if (!m_hasStorage) { return true; }
+    if (m_isSubByte) {
+      setSubByteBits(index, bits);
+      return true;
+    }
     uint64_t byteIndex = index * m_bytesPerElement;
+    if (m_isPacked) {
+      bits = pimUtils::packFpBits(bits, m_dataType);
+    }
     std::memcpy(m_data.data() + byteIndex, &bits, m_bytesPerElement);
     return true;
   }
 
   // get bit representation of an element at index
+  // low-precision FP types return FP32 bits
   bool getElementBits(uint64_t index, uint64_t &bits) const {
     bits = 0;
+    if (!m_hasStorage) { return true; }
+    if (m_isSubByte) {
+      bits = pimUtils::signExt(getSubByteBits(index), m_dataType);
+      return true;
+    }
     uint64_t byteIndex = index * m_bytesPerElement;
     std::memcpy(&bits, m_data.data() + byteIndex, m_bytesPerElement);
+    if (m_isPacked) {
+      bits = pimUtils::unpackFpBits(bits, m_dataType);
+      return true;
+    }
     bits = pimUtils::signExt(bits, m_dataType);
     return true;
   }
 
   // print all bytes for debugging
   void print() const {
-    printf("PIM obj data holder: data-type = %s, num-elements = %lu, bytes-per-element = %u\n",
-           pimUtils::pimDataTypeEnumToStr(m_dataType).c_str(), m_numElements, m_bytesPerElement);
+    printf("PIM obj data holder: data-type = %s, num-elements = %lu, bits-per-element = %u\n",
+           pimUtils::pimDataTypeEnumToStr(m_dataType).c_str(), m_numElements, m_bitsPerElement);
     for (size_t i = 0; i < m_data.size(); ++i) {
       std::printf(" %02x", m_data[i]);
       if ((i + 1) % 64 == 0) { std::printf("\n"); }
@@ -153,10 +218,34 @@ public:
   }
 
 private:
+  // get raw bits of a sub-byte element
+  uint64_t getSubByteBits(uint64_t index) const {
+    uint64_t bitIndex = index * m_bitsPerElement;
+    uint8_t mask = static_cast<uint8_t>((1u << m_bitsPerElement) - 1);
+    return (m_data[bitIndex / 8] >> (bitIndex % 8)) & mask;
+  }
+
+  // set raw bits of a sub-byte element
+  // Note: Multiple threads may update different elements that share a byte, so use atomic byte updates
+  void setSubByteBits(uint64_t index, uint64_t bits) {
+    uint64_t bitIndex = index * m_bitsPerElement;
+    unsigned shift = bitIndex % 8;
+    uint8_t mask = static_cast<uint8_t>(((1u << m_bitsPerElement) - 1) << shift);
+    uint8_t val = static_cast<uint8_t>(bits << shift) & mask;
+    uint8_t* ptr = m_data.data() + bitIndex / 8;
+    __atomic_fetch_and(ptr, static_cast<uint8_t>(~mask), __ATOMIC_RELAXED);
+    __atomic_fetch_or(ptr, val, __ATOMIC_RELAXED);
+  }
+
   std::vector<uint8_t> m_data;
   PimDataType m_dataType;
   uint64_t m_numElements;
   unsigned m_bytesPerElement;
+  unsigned m_hostBytesPerElement;
+  unsigned m_bitsPerElement;
+  bool m_hasStorage;
+  bool m_isPacked;
+  bool m_isSubByte;
 };
 
 //! @class  pimObjInfo
@@ -172,7 +261,7 @@ public:
       m_assocObjId(objId),
       m_dataType(dataType),
       m_allocType(allocType),
-      m_data(dataType, numElements),
+      m_data(dataType, numElements, !isAnalysisMode(device)),
       m_numElements(numElements),
       m_bitsPerElementPadded(bitsPerElementPadded),
       m_device(device)
@@ -182,7 +271,7 @@ public:
       m_assocObjId(objId),
       m_dataType(dataType),
       m_allocType(allocType),
-      m_data(dataType, numElements),
+      m_data(dataType, numElements, !isAnalysisMode(device)),
       m_numElements(numElements),
       m_bitsPerElementPadded(bitsPerElementPadded),
       m_device(device),
@@ -249,6 +338,8 @@ public:
   void syncToSimulatedMem() const;
 
 private:
+  static bool isAnalysisMode(const pimDevice* device);
+
   PimObjId m_objId = -1;
   PimObjId m_assocObjId = -1;
   PimObjId m_refObjId = -1;
@@ -293,6 +384,9 @@ public:
   bool isHLayoutObj(PimObjId objId) const;
   bool isHybridLayoutObj(PimObjId objId) const;
 
+  unsigned getNumRowsInUse(PimCoreId coreId) const { return m_coreUsage.at(coreId)->getNumRowsInUse(); }
+  unsigned getPeakNumRowsInUse(PimCoreId coreId) const { return m_coreUsage.at(coreId)->getPeakNumRowsInUse(); }
+
 private:
   pimRegion findAvailRegionOnCore(PimCoreId coreId, unsigned numAllocRows, unsigned numAllocCols) const;
   std::vector<PimCoreId> getCoreIdsSortedByLeastUsage() const;
@@ -304,7 +398,8 @@ private:
     coreUsage(unsigned numRowsPerCore) : m_numRowsPerCore(numRowsPerCore) {}
     ~coreUsage() {}
     unsigned getNumRowsPerCore() const { return m_numRowsPerCore; }
-    unsigned getTotRowsInUse() const { return m_totRowsInUse; }
+    unsigned getNumRowsInUse() const;
+    unsigned getPeakNumRowsInUse() const { return m_peakRowsInUse; }
     unsigned findAvailRange(unsigned numRowsToAlloc);
     void addRange(std::pair<unsigned, unsigned> range, PimObjId objId);
     void deleteObj(PimObjId objId);
@@ -312,7 +407,7 @@ private:
     void newAllocEnd(bool success);
   private:
     unsigned m_numRowsPerCore = 0;
-    unsigned m_totRowsInUse = 0;
+    unsigned m_peakRowsInUse = 0;
     std::map<std::pair<unsigned, unsigned>, PimObjId> m_rangesInUse;
     std::set<std::pair<unsigned, unsigned>> m_newAlloc;
   };
@@ -10,10 +10,13 @@
 #include "pimParamsDram.h"
 #include "pimStats.h"
 #include "pimUtils.h"
+#include <cinttypes>
 #include <cstdio>
 #include <memory>
 #include <algorithm>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 // The pimSim singleton
 pimSim* pimSim::s_instance = nullptr;
@@ -40,6 +43,7 @@ pimSim::destroy()
 
 //! @brief  pimSim ctor
 pimSim::pimSim()
+  : m_config(std::make_unique<pimSimConfig>())
 {
 }
 
@@ -47,6 +51,8 @@ pimSim::pimSim()
 pimSim::~pimSim()
 {
   uninit();
+  m_otherDevices.clear();
+  m_traceWriter.reset();
 }
 
 //! @brief  Uninitialize pimSim member classes
@@ -54,10 +60,11 @@ void
 pimSim::uninit()
 {
   m_device.reset();
+  m_cmdStream.reset();
   m_threadPool.reset();
   m_statsMgr.reset();
   m_paramsDram.reset();
-  m_config.uninit();
+  m_config->uninit();
 }
 
 //! @brief  Create a PIM device
@@ -66,11 +73,15 @@ pimSim::createDevice(PimDeviceEnum deviceType, unsigned numRanks, unsigned numBa
 {
   pimPerfMon perfMon("createDevice");
   uninit();
-  bool success = m_config.init(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols, bufferSize);
+  bool success = m_config->init(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols, bufferSize);
   if (!success) {
     return false;
   }
-  return createDeviceCommon();
+  success = createDeviceCommon();
+  if (success) {
+    recordTrace(pimTraceOp::CREATE_DEVICE, deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols, bufferSize);
+  }
+  return success;
 }
 
 //! @brief  Create a PIM device from a config file
@@ -79,40 +90,66 @@ pimSim::createDeviceFromConfig(PimDeviceEnum deviceType, const char* configFileP
 {
   pimPerfMon perfMon("createDeviceFromConfig");
   uninit();
-  bool success = m_config.init(deviceType, configFilePath);
+  bool success = m_config->init(deviceType, configFilePath);
   if (!success) {
     return false;
   }
-  return createDeviceCommon();
+  success = createDeviceCommon();
+  if (success) {
+    recordTrace(pimTraceOp::CREATE_DEVICE_FROM_CONFIG, deviceType, std::string(configFilePath));
+  }
+  return success;
 }
 
 //! @brief  Common code to create a PIM device
 bool
 pimSim::createDeviceCommon()
 {
+  if (m_forceAnalysisMode) {
+    m_config->setAnalysisMode(true);
+  }
+
   // Create memory params, which is needed before creating pimDevice
-  if (!m_config.getMemConfigFile().empty()) {
-    m_paramsDram = pimParamsDram::createFromConfig(m_config.getMemConfigFile());
+  if (!m_config->getMemConfigFile().empty()) {
+    m_paramsDram = pimParamsDram::createFromConfig(m_config->getMemConfigFile());
   } else {
-    m_paramsDram = pimParamsDram::create(m_config.getMemoryProtocol());
+    m_paramsDram = pimParamsDram::create(m_config->getMemoryProtocol());
   }
 
   // Create PIM device
-  m_device = std::make_unique<pimDevice>(m_config);
+  m_device = std::make_unique<pimDevice>(*m_config, *m_paramsDram);
 
   if (!m_device->isValid()) {
     uninit();
-    std::printf("PIM-Error: Failed to create PIM device of type %s\n", pimUtils::pimDeviceEnumToStr(m_config.getDeviceType()).c_str());
+    std::printf("PIM-Error: Failed to create PIM device of type %s\n", pimUtils::pimDeviceEnumToStr(m_config->getDeviceType()).c_str());
     return false;
   }
 
   // Create stats mgr
   m_statsMgr = std::make_unique<pimStatsMgr>();
+#ifdef DRAMSIM3_INTEG
+  m_statsMgr->setDramSim3(m_device->getDramSim3());
+#endif
+
+  // Record PIM commands for replaying against sweep configs
+  if (!m_config->getSweepConfigFiles().empty()) {
+    m_cmdStream = std::make_unique<pimCmdStream>();
+    m_device->setCmdStream(m_cmdStream.get());
+    std::printf("PIM-Info: Recording PIM commands for design space sweep over %lu configs\n", m_config->getSweepConfigFiles().size());
+  }
 
   // Create thread pool
   if (getNumThreads() > 1) {
     m_threadPool = std::make_unique<pimUtils::threadPool>(getNumThreads());
   }
+
+  // Record PIM API calls into a trace file, which covers all devices created afterwards
+  if (!m_traceWriter && !m_isReplayingTrace && !m_config->getTraceFile().empty()) {
+    m_traceWriter = std::make_unique<pimTraceWriter>(m_config->getTraceFile(), m_config->isTracePayload());
+    if (!m_traceWriter->isValid()) {
+      m_traceWriter.reset();
+    }
+  }
   return true;
 }
 
@@ -120,10 +157,73 @@ pimSim::createDeviceCommon()
 bool
 pimSim::deleteDevice()
 {
+  recordTrace(pimTraceOp::DELETE_DEVICE);
+  if (m_traceWriter) {
+    m_traceWriter->flush();
+  }
   uninit();
   return true;
 }
 
+//! @brief  Select the PIM device slot used by following PIM APIs
+//! Not monitored by pimPerfMon, as the stats manager changes with the device
+bool
+pimSim::setDevice(PimDeviceId deviceId)
+{
+  if (deviceId < 0) {
+    std::printf("PIM-Error: Invalid PIM device ID %d\n", deviceId);
+    return false;
+  }
+  recordTrace(pimTraceOp::SET_DEVICE, deviceId);
+  switchDevice(deviceId);
+  return true;
+}
+
+//! @brief  Swap states of the current device with another device slot
+void
+pimSim::switchDevice(PimDeviceId deviceId)
+{
+  if (deviceId == m_curDeviceId) {
+    return;
+  }
+  // Streams and async copies of the current device run against current device states
+  if (m_device) {
+    m_device->synchronize();
+    deviceSlot& slot = m_otherDevices[m_curDeviceId];
+    slot.m_config = std::move(m_config);
+    slot.m_paramsDram = std::move(m_paramsDram);
+    slot.m_device = std::move(m_device);
+    slot.m_statsMgr = std::move(m_statsMgr);
+    slot.m_threadPool = std::move(m_threadPool);
+    slot.m_cmdStream = std::move(m_cmdStream);
+  }
+  auto it = m_otherDevices.find(deviceId);
+  if (it != m_otherDevices.end()) {
+    m_config = std::move(it->second.m_config);
+    m_paramsDram = std::move(it->second.m_paramsDram);
+    m_device = std::move(it->second.m_device);
+    m_statsMgr = std::move(it->second.m_statsMgr);
+    m_threadPool = std::move(it->second.m_threadPool);
+    m_cmdStream = std::move(it->second.m_cmdStream);
+    m_otherDevices.erase(it);
+  } else {
+    m_config = std::make_unique<pimSimConfig>();
+    m_paramsDram.reset();
+    m_device.reset();
+    m_statsMgr.reset();
+    m_threadPool.reset();
+    m_cmdStream.reset();
+  }
+  m_curDeviceId = deviceId;
+}
+
+//! @brief  Get number of created PIM devices
+unsigned
+pimSim::getNumDevices() const
+{
+  return static_cast<unsigned>(m_otherDevices.size()) + (m_device ? 1 : 0);
+}
+
 //! @brief  Get device properties
 bool
 pimSim::getDeviceProperties(PimDeviceProperties* deviceProperties) {
@@ -144,6 +244,37 @@ pimSim::getDeviceProperties(PimDeviceProperties* deviceProperties) {
   return true;
 }
 
+//! @brief  Get number of bytes of host data for copying a range of a PIM object
+uint64_t
+pimSim::getHostNumBytes(PimObjId objId, uint64_t idxBegin, uint64_t idxEnd) const
+{
+  if (!m_device->getResMgr()->isValidObjId(objId)) {
+    return 0;
+  }
+  const pimObjInfo& obj = m_device->getResMgr()->getObjInfo(objId);
+  uint64_t numElements = (idxEnd == 0 ? obj.getNumElements() : idxEnd - idxBegin);
+  unsigned bytesPerElement = (pimUtils::getNumBitsOfDataType(obj.getDataType(), PimBitWidth::HOST) + 7) / 8;
+  return numElements * bytesPerElement;
+}
+
+//! @brief  Get number of bytes of the host operand of GEMV/GEMM, i.e., numVectors vectors of matrix columns
+uint64_t
+pimSim::getGemvHostNumBytes(PimObjId mat, PimObjId dest, uint64_t numVectors) const
+{
+  const pimResMgr* resMgr = m_device->getResMgr();
+  if (!resMgr->isValidObjId(mat) || !resMgr->isValidObjId(dest) || numVectors == 0) {
+    return 0;
+  }
+  const pimObjInfo& objMat = resMgr->getObjInfo(mat);
+  uint64_t numRows = resMgr->getObjInfo(dest).getNumElements() / numVectors;
+  if (numRows == 0) {
+    return 0;
+  }
+  uint64_t numCols = objMat.getNumElements() / numRows;
+  unsigned bytesPerElement = (pimUtils::getNumBitsOfDataType(objMat.getDataType(), PimBitWidth::HOST) + 7) / 8;
+  return numCols * numVectors * bytesPerElement;
+}
+
 //! @brief  Check if device is valid
 bool
 pimSim::isValidDevice(bool showMsg) const
@@ -199,6 +330,7 @@ pimSim::getPerfEnergyModel()
 void
 pimSim::startKernelTimer() const
 {
+  recordTrace(pimTraceOp::START_TIMER);
   m_statsMgr->startKernelTimer();
 }
 
@@ -206,6 +338,7 @@ pimSim::startKernelTimer() const
 void
 pimSim::endKernelTimer() const
 {
+  recordTrace(pimTraceOp::END_TIMER);
   m_statsMgr->endKernelTimer();
 }
 
@@ -213,14 +346,31 @@ pimSim::endKernelTimer() const
 void
 pimSim::showStats() const
 {
+  recordTrace(pimTraceOp::SHOW_STATS);
+  if (m_traceWriter) {
+    m_traceWriter->flush();
+  }
+  if (getNumDevices() > 1) {
+    std::printf("PIM-Info: Showing stats of PIM device %d\n", m_curDeviceId);
+  }
   m_statsMgr->showStats();
+  if (m_cmdStream) {
+    pimSweep sweep(*m_cmdStream, m_config->getSweepConfigFiles(), getNumThreads());
+    sweep.run();
+    sweep.showResults(*m_statsMgr, *m_config);
+    std::printf("----------------------------------------\n");
+  }
 }
 
 //! @brief  Reset PIM command stats
 void
 pimSim::resetStats() const
 {
+  recordTrace(pimTraceOp::RESET_STATS);
   m_statsMgr->resetStats();
+  if (m_cmdStream) {
+    m_cmdStream->clearCmds();
+  }
 }
 
 //! @brief  Allocate a PIM object
@@ -229,7 +379,9 @@ pimSim::pimAlloc(PimAllocEnum allocType, uint64_t numElements, PimDataType dataT
 {
   pimPerfMon perfMon("pimAlloc");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimAlloc(allocType, numElements, dataType);
+  PimObjId objId = m_device->pimAlloc(allocType, numElements, dataType);
+  recordTrace(pimTraceOp::ALLOC, allocType, numElements, dataType, objId);
+  return objId;
 }
 
 //! @brief  Allocate a PIM object that is associated with an existing ojbect
@@ -238,7 +390,9 @@ pimSim::pimAllocAssociated(PimObjId assocId, PimDataType dataType)
 {
   pimPerfMon perfMon("pimAllocAssociated");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimAllocAssociated(assocId, dataType);
+  PimObjId objId = m_device->pimAllocAssociated(assocId, dataType);
+  recordTrace(pimTraceOp::ALLOC_ASSOCIATED, assocId, dataType, objId);
+  return objId;
 }
 
 PimObjId
@@ -246,7 +400,9 @@ pimSim::pimAllocBuffer(uint32_t numElements, PimDataType dataType)
 {
   pimPerfMon perfMon("pimAllocBuffer");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimAllocBuffer(numElements, dataType);
+  PimObjId objId = m_device->pimAllocBuffer(numElements, dataType);
+  recordTrace(pimTraceOp::ALLOC_BUFFER, numElements, dataType, objId);
+  return objId;
 }
 
 // @brief  Free a PIM object
@@ -255,6 +411,7 @@ pimSim::pimFree(PimObjId obj)
 {
   pimPerfMon perfMon("pimFree");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::FREE, obj);
   return m_device->pimFree(obj);
 }
 
@@ -264,7 +421,9 @@ pimSim::pimCreateRangedRef(PimObjId refId, uint64_t idxBegin, uint64_t idxEnd)
 {
   pimPerfMon perfMon("pimCreateRangedRef");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimCreateRangedRef(refId, idxBegin, idxEnd);
+  PimObjId objId = m_device->pimCreateRangedRef(refId, idxBegin, idxEnd);
+  recordTrace(pimTraceOp::CREATE_RANGED_REF, refId, idxBegin, idxEnd, objId);
+  return objId;
 }
 
 //! @brief  Create an obj referencing to negation of an existing obj based on dual-contact memory cells
@@ -273,7 +432,9 @@ pimSim::pimCreateDualContactRef(PimObjId refId)
 {
   pimPerfMon perfMon("pimCreateDualContactRef");
   if (!isValidDevice()) { return -1; }
-  return m_device->pimCreateDualContactRef(refId);
+  PimObjId objId = m_device->pimCreateDualContactRef(refId);
+  recordTrace(pimTraceOp::CREATE_DUAL_CONTACT_REF, refId, objId);
+  return objId;
 }
 
 // @brief  Copy data from main memory to PIM device within a range
@@ -282,6 +443,7 @@ pimSim::pimCopyMainToDevice(void* src, PimObjId dest, uint64_t idxBegin, uint64_
 {
   pimPerfMon perfMon("pimCopyMainToDevice");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COPY_H2D, dest, idxBegin, idxEnd, pimTracePayload{src, getHostNumBytes(dest, idxBegin, idxEnd), true});
   return m_device->pimCopyMainToDevice(src, dest, idxBegin, idxEnd);
 }
 
@@ -291,7 +453,9 @@ pimSim::pimCopyDeviceToMain(PimObjId src, void* dest, uint64_t idxBegin, uint64_
 {
   pimPerfMon perfMon("pimCopyDeviceToMain");
   if (!isValidDevice()) { return false; }
-  return m_device->pimCopyDeviceToMain(src, dest, idxBegin, idxEnd);
+  bool ok = m_device->pimCopyDeviceToMain(src, dest, idxBegin, idxEnd);
+  recordTrace(pimTraceOp::COPY_D2H, src, idxBegin, idxEnd, pimTracePayload{ok ? dest : nullptr, getHostNumBytes(src, idxBegin, idxEnd), false});
+  return ok;
 }
 
 // @brief  Copy data from main memory to PIM device with type within a range
@@ -300,6 +464,7 @@ pimSim::pimCopyMainToDeviceWithType(PimCopyEnum copyType, void* src, PimObjId de
 {
   pimPerfMon perfMon("pimCopyMainToDevice");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COPY_H2D_WITH_TYPE, copyType, dest, idxBegin, idxEnd, pimTracePayload{src, getHostNumBytes(dest, idxBegin, idxEnd), true});
   return m_device->pimCopyMainToDeviceWithType(copyType, src, dest, idxBegin, idxEnd);
 }
 
@@ -309,7 +474,9 @@ pimSim::pimCopyDeviceToMainWithType(PimCopyEnum copyType, PimObjId src, void* de
 {
   pimPerfMon perfMon("pimCopyDeviceToMain");
   if (!isValidDevice()) { return false; }
-  return m_device->pimCopyDeviceToMainWithType(copyType, src, dest, idxBegin, idxEnd);
+  bool ok = m_device->pimCopyDeviceToMainWithType(copyType, src, dest, idxBegin, idxEnd);
+  recordTrace(pimTraceOp::COPY_D2H_WITH_TYPE, copyType, src, idxBegin, idxEnd, pimTracePayload{ok ? dest : nullptr, getHostNumBytes(src, idxBegin, idxEnd), false});
+  return ok;
 }
 
 // @brief  Copy data from PIM device to device within a range
@@ -318,13 +485,192 @@ pimSim::pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin, ui
 {
   pimPerfMon perfMon("pimCopyDeviceToDevice");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COPY_D2D, src, dest, idxBegin, idxEnd);
   return m_device->pimCopyDeviceToDevice(src, dest, idxBegin, idxEnd);
 }
 
+// @brief  Copy data from main memory to PIM device within a range asynchronously
+// Traces record async copies as synchronous ones, which produce the same data
+PimCopyHandle
+pimSim::pimCopyMainToDeviceAsync(void* src, PimObjId dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  pimPerfMon perfMon("pimCopyMainToDeviceAsync");
+  if (!isValidDevice()) { return -1; }
+  recordTrace(pimTraceOp::COPY_H2D, dest, idxBegin, idxEnd, pimTracePayload{src, getHostNumBytes(dest, idxBegin, idxEnd), true});
+  return m_device->pimCopyMainToDeviceAsync(src, dest, idxBegin, idxEnd);
+}
+
+// @brief  Copy data from PIM device to main memory within a range asynchronously
+// Output is not ready until pimWait, so the trace does not validate it
+PimCopyHandle
+pimSim::pimCopyDeviceToMainAsync(PimObjId src, void* dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  pimPerfMon perfMon("pimCopyDeviceToMainAsync");
+  if (!isValidDevice()) { return -1; }
+  recordTrace(pimTraceOp::COPY_D2H, src, idxBegin, idxEnd, pimTracePayload{nullptr, getHostNumBytes(src, idxBegin, idxEnd), false});
+  return m_device->pimCopyDeviceToMainAsync(src, dest, idxBegin, idxEnd);
+}
+
+// @brief  Wait for an async data copy to finish
+bool
+pimSim::pimWait(PimCopyHandle handle)
+{
+  pimPerfMon perfMon("pimWait");
+  if (!isValidDevice()) { return false; }
+  return m_device->pimWait(handle);
+}
+
+// @brief  Copy data between PIM objects of two PIM devices
+// Data moves through a host buffer functionally, and is modeled as one transfer over the inter-device link
+bool
+pimSim::pimCopyInterDevice(PimDeviceId srcDeviceId, PimObjId src, PimDeviceId destDeviceId, PimObjId dest, uint64_t idxBegin, uint64_t idxEnd)
+{
+  pimPerfMon perfMon("pimCopyInterDevice");
+  if (!isValidDevice()) { return false; }
+  auto findDevice = [this](PimDeviceId deviceId) -> pimDevice* {
+    if (deviceId == m_curDeviceId) {
+      return m_device.get();
+    }
+    auto it = m_otherDevices.find(deviceId);
+    return it == m_otherDevices.end() ? nullptr : it->second.m_device.get();
+  };
+  pimDevice* srcDevice = findDevice(srcDeviceId);
+  pimDevice* destDevice = findDevice(destDeviceId);
+  if (!srcDevice || !destDevice) {
+    std::printf("PIM-Error: Invalid PIM device ID %d or %d for inter-device copy\n", srcDeviceId, destDeviceId);
+    return false;
+  }
+  if (!srcDevice->getResMgr()->isValidObjId(src) || !destDevice->getResMgr()->isValidObjId(dest)) {
+    std::printf("PIM-Error: Invalid PIM object ID %d or %d for inter-device copy\n", src, dest);
+    return false;
+  }
+  const pimObjInfo& objSrc = srcDevice->getResMgr()->getObjInfo(src);
+  const pimObjInfo& objDest = destDevice->getResMgr()->getObjInfo(dest);
+  // A full copy needs objects of the same size, while a ranged copy only needs the range in both objects
+  bool isFullRange = (idxEnd == 0);
+  uint64_t numElements = (isFullRange ? objSrc.getNumElements() : idxEnd - idxBegin);
+  bool isValidRange = isFullRange ? objSrc.getNumElements() == objDest.getNumElements()
+                                  : idxBegin <= idxEnd && idxEnd <= objSrc.getNumElements() && idxEnd <= objDest.getNumElements();
+  if (objSrc.getDataType() != objDest.getDataType() || !isValidRange) {
+    std::printf("PIM-Error: PIM objects %d and %d of inter-device copy have mismatched data types or ranges\n", src, dest);
+    return false;
+  }
+  recordTrace(pimTraceOp::COPY_INTER_DEVICE, srcDeviceId, src, destDeviceId, dest, idxBegin, idxEnd);
+
+  // Stage data on the host. Each device runs its own copy command without recording stats.
+  PimDeviceId curDeviceId = m_curDeviceId;
+  unsigned bytesPerElement = (pimUtils::getNumBitsOfDataType(objSrc.getDataType(), PimBitWidth::HOST) + 7) / 8;
+  std::vector<uint8_t> buffer(numElements * bytesPerElement);
+  switchDevice(srcDeviceId);
+  PimCopyEnum readCopyType = objSrc.isHLayout() ? PIM_COPY_H : PIM_COPY_V;
+  std::unique_ptr<pimCmdCopy> readCmd = std::make_unique<pimCmdCopy>(PimCmdEnum::COPY_D2H, readCopyType, src, buffer.data(), idxBegin, idxEnd);
+  readCmd->setSkipStats(true);
+  bool ok = m_device->executeCmd(std::move(readCmd));
+  switchDevice(destDeviceId);
+  if (ok) {
+    PimCopyEnum writeCopyType = objDest.isHLayout() ? PIM_COPY_H : PIM_COPY_V;
+    std::unique_ptr<pimCmdCopy> writeCmd = std::make_unique<pimCmdCopy>(PimCmdEnum::COPY_H2D, writeCopyType, buffer.data(), dest, idxBegin, idxEnd);
+    writeCmd->setSkipStats(true);
+    ok = m_device->executeCmd(std::move(writeCmd));
+  }
+  switchDevice(curDeviceId);
+  if (!ok) {
+    return false;
+  }
+
+  uint64_t numBits = numElements * objSrc.getBitsPerElement(PimBitWidth::ACTUAL);
+  pimeval::perfEnergy srcRead = srcDevice->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_D2H, numBits / 8);
+  pimeval::perfEnergy destWrite = destDevice->getPerfEnergyModel()->getPerfEnergyForBytesTransfer(PimCmdEnum::COPY_H2D, numBits / 8);
+  unsigned linkMBps = std::min(srcDevice->getConfig().getLinkBandwidthMBps(), destDevice->getConfig().getLinkBandwidthMBps());
+  m_statsMgr->recordCopyInterDevice(numBits, pimPerfEnergyBase::getPerfEnergyForInterDeviceCopy(srcRead, destWrite, numBits / 8, linkMBps));
+  if (isDebug(pimSimConfig::DEBUG_CMDS)) {
+    std::printf("PIM-Cmd: Copied %" PRIu64 " elements from PIM obj %d of device %d to PIM obj %d of device %d\n",
+                numElements, src, srcDeviceId, dest, destDeviceId);
+  }
+  return true;
+}
+
+// @brief  Create a PIM stream
+PimStreamId
+pimSim::pimStreamCreate()
+{
+  pimPerfMon perfMon("pimStreamCreate");
+  if (!isValidDevice()) { return -1; }
+  return m_device->pimStreamCreate();
+}
+
+// @brief  Destroy a PIM stream
+bool
+pimSim::pimStreamDestroy(PimStreamId streamId)
+{
+  pimPerfMon perfMon("pimStreamDestroy");
+  if (!isValidDevice()) { return false; }
+  bool ok = m_device->pimStreamDestroy(streamId);
+  m_statsMgr->setCurStream(m_device->getCurStream());
+  return ok;
+}
+
+// @brief  Set the current PIM stream
+// Traces do not record streams, so a replay runs all PIM APIs on the default stream
+bool
+pimSim::pimSetStream(PimStreamId streamId)
+{
+  pimPerfMon perfMon("pimSetStream");
+  if (!isValidDevice()) { return false; }
+  bool ok = m_device->pimSetStream(streamId);
+  m_statsMgr->setCurStream(m_device->getCurStream());
+  return ok;
+}
+
+// @brief  Wait for all commands of a PIM stream to finish
+bool
+pimSim::pimStreamSynchronize(PimStreamId streamId)
+{
+  pimPerfMon perfMon("pimStreamSynchronize");
+  if (!isValidDevice()) { return false; }
+  return m_device->pimStreamSynchronize(streamId);
+}
+
+// @brief  Record an event on a PIM stream
+PimEventId
+pimSim::pimEventRecord(PimStreamId streamId)
+{
+  pimPerfMon perfMon("pimEventRecord");
+  if (!isValidDevice()) { return -1; }
+  PimEventId eventId = m_device->pimEventRecord(streamId);
+  if (eventId != -1) {
+    m_statsMgr->recordEvent(eventId, streamId);
+  }
+  return eventId;
+}
+
+// @brief  Make a PIM stream wait for an event
+bool
+pimSim::pimStreamWaitEvent(PimStreamId streamId, PimEventId eventId)
+{
+  pimPerfMon perfMon("pimStreamWaitEvent");
+  if (!isValidDevice()) { return false; }
+  bool ok = m_device->pimStreamWaitEvent(streamId, eventId);
+  if (ok) {
+    m_statsMgr->recordStreamWaitEvent(streamId, eventId);
+  }
+  return ok;
+}
+
+// @brief  Wait for an event on the host
+bool
+pimSim::pimEventSynchronize(PimEventId eventId)
+{
+  pimPerfMon perfMon("pimEventSynchronize");
+  if (!isValidDevice()) { return false; }
+  return m_device->pimEventSynchronize(eventId);
+}
+
 bool pimSim::pimCopyObjectToObject(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimCopyObjectToObject");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COPY_O2O, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::COPY_O2O, src, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -334,6 +680,7 @@ pimSim::pimConvertType(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimConvertType");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::CONVERT_TYPE, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::CONVERT_TYPE, src, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -344,6 +691,13 @@ pimSim::pimBroadcast(PimObjId dest, T value)
 {
   pimPerfMon perfMon("pimBroadcast");
   if (!isValidDevice()) { return false; }
+  if constexpr (std::is_same_v<T, float>) {
+    recordTrace(pimTraceOp::BROADCAST_FP, dest, value);
+  } else if constexpr (std::is_signed_v<T>) {
+    recordTrace(pimTraceOp::BROADCAST_INT, dest, value);
+  } else {
+    recordTrace(pimTraceOp::BROADCAST_UINT, dest, value);
+  }
   uint64_t signExtBits = pimUtils::castTypeToBits(value);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdBroadcast>(PimCmdEnum::BROADCAST, dest, signExtBits);
   return m_device->executeCmd(std::move(cmd));
@@ -355,6 +709,7 @@ pimSim::pimAdd(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimAdd");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::ADD, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::ADD, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -365,6 +720,7 @@ pimSim::pimSub(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimSub");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SUB, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::SUB, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -375,6 +731,7 @@ pimSim::pimDiv(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimDiv");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::DIV, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::DIV, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -385,6 +742,7 @@ pimSim::pimAbs(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimAbs");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::ABS, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::ABS, src, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -395,6 +753,7 @@ pimSim::pimMul(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimMul");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::MUL, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::MUL, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -405,6 +764,7 @@ pimSim::pimNot(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimNot");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::NOT, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::NOT, src, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -415,6 +775,7 @@ pimSim::pimAnd(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimAnd");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::AND, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::AND, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -425,6 +786,7 @@ pimSim::pimOr(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimOr");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OR, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::OR, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -435,6 +797,7 @@ pimSim::pimXor(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimXor");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::XOR, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::XOR, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -445,6 +808,7 @@ pimSim::pimXnor(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimXnor");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::XNOR, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::XNOR, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -455,6 +819,7 @@ pimSim::pimGT(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimGT");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::GT, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::GT, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -465,6 +830,7 @@ pimSim::pimLT(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimLT");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::LT, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::LT, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -475,6 +841,7 @@ pimSim::pimEQ(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimEQ");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::EQ, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::EQ, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -485,6 +852,7 @@ pimSim::pimNE(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimNE");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::NE, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::NE, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -495,6 +863,7 @@ pimSim::pimMin(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimMin");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::MIN, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::MIN, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -505,6 +874,7 @@ pimSim::pimMax(PimObjId src1, PimObjId src2, PimObjId dest)
 {
   pimPerfMon perfMon("pimMax");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::MAX, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::MAX, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -513,6 +883,7 @@ bool pimSim::pimAdd(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimAddScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::ADD_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::ADD_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -521,6 +892,7 @@ bool pimSim::pimSub(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimSubScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SUB_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::SUB_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -529,6 +901,7 @@ bool pimSim::pimMul(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimMulScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::MUL_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::MUL_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -537,6 +910,7 @@ bool pimSim::pimDiv(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimDivScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::DIV_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::DIV_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -545,6 +919,7 @@ bool pimSim::pimAnd(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimAndScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::AND_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::AND_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -553,6 +928,7 @@ bool pimSim::pimOr(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimOrScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OR_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::OR_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -561,6 +937,7 @@ bool pimSim::pimXor(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimXorScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::XOR_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::XOR_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -569,6 +946,7 @@ bool pimSim::pimXnor(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimXnorScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::XNOR_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::XNOR_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -577,6 +955,7 @@ bool pimSim::pimGT(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimGTScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::GT_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::GT_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -585,6 +964,7 @@ bool pimSim::pimLT(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimLTScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::LT_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::LT_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -593,6 +973,7 @@ bool pimSim::pimEQ(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimEQScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::EQ_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::EQ_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -601,6 +982,7 @@ bool pimSim::pimNE(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimNEScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::NE_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::NE_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -609,6 +991,7 @@ bool pimSim::pimMin(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimMinScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::MIN_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::MIN_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -617,6 +1000,7 @@ bool pimSim::pimMax(PimObjId src, PimObjId dest, uint64_t scalarValue)
 {
   pimPerfMon perfMon("pimMaxScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::MAX_SCALAR, src, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::MAX_SCALAR, src, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -624,26 +1008,190 @@ bool pimSim::pimMax(PimObjId src, PimObjId dest, uint64_t scalarValue)
 bool pimSim::pimScaledAdd(PimObjId src1, PimObjId src2, PimObjId dest, uint64_t scalarValue) {
   pimPerfMon perfMon("pimScaledAdd");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SCALED_ADD, src1, src2, dest, scalarValue);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc2>(PimCmdEnum::SCALED_ADD, src1, src2, dest, scalarValue);
   return m_device->executeCmd(std::move(cmd));
 }
 
+//! @brief  PIM OP: matrix-vector multiplication of a column-major PIM matrix and a host vector
+bool
+pimSim::pimGemv(PimObjId mat, const void* vec, PimObjId dest)
+{
+  pimPerfMon perfMon("pimGemv");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::GEMV, mat, dest, pimTracePayload{vec, getGemvHostNumBytes(mat, dest, 1), true});
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdGemv>(PimCmdEnum::GEMV, mat, vec, dest, 1);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: matrix-matrix multiplication of a column-major PIM matrix and a column-major host matrix
+bool
+pimSim::pimGemm(PimObjId mat, const void* matB, PimObjId dest, uint64_t numColsB)
+{
+  pimPerfMon perfMon("pimGemm");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::GEMM, mat, dest, numColsB, pimTracePayload{matB, getGemvHostNumBytes(mat, dest, numColsB), true});
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdGemv>(PimCmdEnum::GEMM, mat, matB, dest, numColsB);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: count common set bits of many pairs of bitmap rows
+bool
+pimSim::pimAndPopCountBatched(PimObjId bitmaps, uint64_t numWordsPerRow, const uint64_t* rowsA, const uint64_t* rowsB, uint64_t numPairs, uint64_t* counts)
+{
+  pimPerfMon perfMon("pimAndPopCountBatched");
+  if (!isValidDevice()) { return false; }
+  if (numPairs > 0 && (rowsA == nullptr || rowsB == nullptr)) {
+    std::printf("PIM-Error: Invalid null row pairs for pimAndPopCountBatched\n");
+    return false;
+  }
+  std::vector<uint64_t> rowsAVec(rowsA, rowsA + numPairs);
+  std::vector<uint64_t> rowsBVec(rowsB, rowsB + numPairs);
+  recordTrace(pimTraceOp::AND_POPCOUNT_BATCHED, bitmaps, numWordsPerRow, rowsAVec, rowsBVec);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdAndPopCountBatched>(PimCmdEnum::AND_POPCOUNT_BATCHED, bitmaps, numWordsPerRow,
+                                                                           std::move(rowsAVec), std::move(rowsBVec), counts);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: gather elements of src by index
+bool
+pimSim::pimGather(PimObjId src, PimObjId index, PimObjId dest)
+{
+  pimPerfMon perfMon("pimGather");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::GATHER, src, index, dest);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdGatherScatter>(PimCmdEnum::GATHER, src, index, dest);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: scatter elements of src to dest by index
+bool
+pimSim::pimScatter(PimObjId src, PimObjId index, PimObjId dest)
+{
+  pimPerfMon perfMon("pimScatter");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SCATTER, src, index, dest);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdGatherScatter>(PimCmdEnum::SCATTER, src, index, dest);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: scatter-add elements of src to dest by index
+bool
+pimSim::pimScatterAdd(PimObjId src, PimObjId index, PimObjId dest)
+{
+  pimPerfMon perfMon("pimScatterAdd");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SCATTER_ADD, src, index, dest);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdGatherScatter>(PimCmdEnum::SCATTER_ADD, src, index, dest);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: stream compaction of elements selected by a bool condition
+bool
+pimSim::pimCompact(PimObjId src, PimObjId cond, PimObjId dest, uint64_t* count)
+{
+  pimPerfMon perfMon("pimCompact");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COMPACT, src, cond, dest);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdCompact>(PimCmdEnum::COMPACT, src, cond, dest, count);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: top-k selection of largest or smallest elements
+bool
+pimSim::pimTopK(PimObjId src, uint64_t k, void* outValues, uint64_t* outIndices, bool isSmallest)
+{
+  pimPerfMon perfMon("pimTopK");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::TOPK, src, k, isSmallest);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdTopK>(PimCmdEnum::TOPK, src, k, outValues, outIndices, isSmallest);
+  return m_device->executeCmd(std::move(cmd));
+}
+
 // @brief  PIM OP: popcount
 bool
 pimSim::pimPopCount(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimPopCount");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::POPCOUNT, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::POPCOUNT, src, dest);
   return m_device->executeCmd(std::move(cmd));
 }
 
+//! @brief  PIM OP: elementwise exponential approximation
+bool
+pimSim::pimExp(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  pimPerfMon perfMon("pimExp");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::EXP, src, dest, precision, numFracBits);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdMath>(PimCmdEnum::EXP, src, dest, precision, numFracBits);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: elementwise natural logarithm approximation
+bool
+pimSim::pimLog(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  pimPerfMon perfMon("pimLog");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::LOG, src, dest, precision, numFracBits);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdMath>(PimCmdEnum::LOG, src, dest, precision, numFracBits);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: elementwise square root approximation
+bool
+pimSim::pimSqrt(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  pimPerfMon perfMon("pimSqrt");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SQRT, src, dest, precision, numFracBits);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdMath>(PimCmdEnum::SQRT, src, dest, precision, numFracBits);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: elementwise reciprocal approximation
+bool
+pimSim::pimRecip(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  pimPerfMon perfMon("pimRecip");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::RECIP, src, dest, precision, numFracBits);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdMath>(PimCmdEnum::RECIP, src, dest, precision, numFracBits);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: elementwise sigmoid approximation
+bool
+pimSim::pimSigmoid(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  pimPerfMon perfMon("pimSigmoid");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SIGMOID, src, dest, precision, numFracBits);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdMath>(PimCmdEnum::SIGMOID, src, dest, precision, numFracBits);
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  PIM OP: elementwise hyperbolic tangent approximation
+bool
+pimSim::pimTanh(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits)
+{
+  pimPerfMon perfMon("pimTanh");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::TANH, src, dest, precision, numFracBits);
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdMath>(PimCmdEnum::TANH, src, dest, precision, numFracBits);
+  return m_device->executeCmd(std::move(cmd));
+}
+
 // @brief  PIM OP: prefixsum
 bool
 pimSim::pimPrefixSum(PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimPrefixSum");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::PREFIX_SUM, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdPrefixSum>(PimCmdEnum::PREFIX_SUM, src, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -653,12 +1201,15 @@ bool pimSim::pimMAC(PimObjId src1, PimObjId src2, void* dest)
 {
   pimPerfMon perfMon("pimMAC");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::MAC, src1, src2);
   const PimDataType dataType = m_device->getResMgr()->getObjInfo(src1).getDataType();
   std::unique_ptr<pimCmd> cmd;
   PimCmdEnum cmdType = PimCmdEnum::MAC;
   
   switch (dataType) {
     case PimDataType::PIM_INT8:
+    case PimDataType::PIM_INT4:
+    case PimDataType::PIM_INT2:
       cmd = std::make_unique<pimCmdMAC<int8_t>>(cmdType, src1, src2, dest);
       break;
     case PimDataType::PIM_INT16:
@@ -671,6 +1222,8 @@ bool pimSim::pimMAC(PimObjId src1, PimObjId src2, void* dest)
       cmd = std::make_unique<pimCmdMAC<int64_t>>(cmdType, src1, src2, dest);
       break;
     case PimDataType::PIM_UINT8:
+    case PimDataType::PIM_UINT4:
+    case PimDataType::PIM_UINT2:
       cmd = std::make_unique<pimCmdMAC<uint8_t>>(cmdType, src1, src2, dest);
       break;
     case PimDataType::PIM_UINT16:
@@ -695,52 +1248,68 @@ bool pimSim::pimMAC(PimObjId src1, PimObjId src2, void* dest)
   return m_device->executeCmd(std::move(cmd));
 }
 
-//! @brief  Min reduction operation
-bool pimSim::pimRedMin(PimObjId src, void* min, uint64_t idxBegin, uint64_t idxEnd) {
-  std::string tag = (idxBegin != idxEnd && idxBegin < idxEnd) ? "pimRedMinRanged" : "pimRedMin";
-  pimPerfMon perfMon(tag);
-  if (!isValidDevice()) { return false; }
-  if (!min) { return false; }
-
-  // Create the reduction command for Min operation
+//! @brief  Create a reduction command based on object data type
+//! Sum results are widened to int64_t, uint64_t or float, while min and max keep the object data type
+std::unique_ptr<pimCmdReductionBase>
+pimSim::createReductionCmd(PimCmdEnum cmdType, PimObjId src, void* result, uint64_t idxBegin, uint64_t idxEnd) const
+{
+  bool isSum = (cmdType == PimCmdEnum::REDSUM || cmdType == PimCmdEnum::REDSUM_RANGE);
   const PimDataType dataType = m_device->getResMgr()->getObjInfo(src).getDataType();
-  std::unique_ptr<pimCmd> cmd;
-  PimCmdEnum cmdType = (idxBegin < idxEnd && idxEnd > 0) ? PimCmdEnum::REDMIN_RANGE : PimCmdEnum::REDMIN;
   switch (dataType) {
     case PimDataType::PIM_INT8:
-      cmd = std::make_unique<pimCmdReduction<int8_t>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+    case PimDataType::PIM_INT4:
+    case PimDataType::PIM_INT2:
+      if (isSum) return std::make_unique<pimCmdReduction<int64_t>>(cmdType, src, result, idxBegin, idxEnd);
+      return std::make_unique<pimCmdReduction<int8_t>>(cmdType, src, result, idxBegin, idxEnd);
     case PimDataType::PIM_INT16:
-      cmd = std::make_unique<pimCmdReduction<int16_t>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+      if (isSum) return std::make_unique<pimCmdReduction<int64_t>>(cmdType, src, result, idxBegin, idxEnd);
+      return std::make_unique<pimCmdReduction<int16_t>>(cmdType, src, result, idxBegin, idxEnd);
     case PimDataType::PIM_INT32:
-      cmd = std::make_unique<pimCmdReduction<int32_t>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+      if (isSum) return std::make_unique<pimCmdReduction<int64_t>>(cmdType, src, result, idxBegin, idxEnd);
+      return std::make_unique<pimCmdReduction<int32_t>>(cmdType, src, result, idxBegin, idxEnd);
     case PimDataType::PIM_INT64:
-      cmd = std::make_unique<pimCmdReduction<int64_t>>(cmdType, src, min, idxBegin, idxEnd);
+      return std::make_unique<pimCmdReduction<int64_t>>(cmdType, src, result, idxBegin, idxEnd);
+    case PimDataType::PIM_BOOL:
+      if (isSum) return std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, result, idxBegin, idxEnd);
       break;
     case PimDataType::PIM_UINT8:
-      cmd = std::make_unique<pimCmdReduction<uint8_t>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+    case PimDataType::PIM_UINT4:
+    case PimDataType::PIM_UINT2:
+      if (isSum) return std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, result, idxBegin, idxEnd);
+      return std::make_unique<pimCmdReduction<uint8_t>>(cmdType, src, result, idxBegin, idxEnd);
     case PimDataType::PIM_UINT16:
-      cmd = std::make_unique<pimCmdReduction<uint16_t>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+      if (isSum) return std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, result, idxBegin, idxEnd);
+      return std::make_unique<pimCmdReduction<uint16_t>>(cmdType, src, result, idxBegin, idxEnd);
     case PimDataType::PIM_UINT32:
-      cmd = std::make_unique<pimCmdReduction<uint32_t>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+      if (isSum) return std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, result, idxBegin, idxEnd);
+      return std::make_unique<pimCmdReduction<uint32_t>>(cmdType, src, result, idxBegin, idxEnd);
     case PimDataType::PIM_UINT64:
-      cmd = std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+      return std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, result, idxBegin, idxEnd);
     case PimDataType::PIM_FP8:
     case PimDataType::PIM_FP16:
     case PimDataType::PIM_BF16:
     case PimDataType::PIM_FP32:
-      cmd = std::make_unique<pimCmdReduction<float>>(cmdType, src, min, idxBegin, idxEnd);
-      break;
+      return std::make_unique<pimCmdReduction<float>>(cmdType, src, result, idxBegin, idxEnd);
     default:
-      std::printf("PIM-Error: pimRedMin does not support data type %s\n", pimUtils::pimDataTypeEnumToStr(dataType).c_str());
-      return false;
+      break;
   }
+  std::printf("PIM-Error: %s does not support data type %s\n", pimCmd::getName(cmdType, "").c_str(),
+              pimUtils::pimDataTypeEnumToStr(dataType).c_str());
+  return nullptr;
+}
+
+//! @brief  Min reduction operation
+bool pimSim::pimRedMin(PimObjId src, void* min, uint64_t idxBegin, uint64_t idxEnd) {
+  std::string tag = (idxBegin != idxEnd && idxBegin < idxEnd) ? "pimRedMinRanged" : "pimRedMin";
+  pimPerfMon perfMon(tag);
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::REDMIN, src, idxBegin, idxEnd);
+  if (!min) { return false; }
+
+  // Create the reduction command for Min operation
+  PimCmdEnum cmdType = (idxBegin < idxEnd && idxEnd > 0) ? PimCmdEnum::REDMIN_RANGE : PimCmdEnum::REDMIN;
+  std::unique_ptr<pimCmd> cmd = createReductionCmd(cmdType, src, min, idxBegin, idxEnd);
+  if (!cmd) { return false; }
   return m_device->executeCmd(std::move(cmd));
 }
 
@@ -749,47 +1318,13 @@ bool pimSim::pimRedMax(PimObjId src, void* max, uint64_t idxBegin, uint64_t idxE
   std::string tag = (idxBegin != idxEnd && idxBegin < idxEnd) ? "pimRedMaxRanged" : "pimRedMax";
   pimPerfMon perfMon(tag);
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::REDMAX, src, idxBegin, idxEnd);
   if (!max) { return false; }
 
   // Create the reduction command for Max operation
-  const PimDataType dataType = m_device->getResMgr()->getObjInfo(src).getDataType();
-  std::unique_ptr<pimCmd> cmd;
   PimCmdEnum cmdType = (idxBegin < idxEnd && idxEnd > 0) ? PimCmdEnum::REDMAX_RANGE : PimCmdEnum::REDMAX;
-  switch (dataType) {
-    case PimDataType::PIM_INT8:
-      cmd = std::make_unique<pimCmdReduction<int8_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_INT16:
-      cmd = std::make_unique<pimCmdReduction<int16_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_INT32:
-      cmd = std::make_unique<pimCmdReduction<int32_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_INT64:
-      cmd = std::make_unique<pimCmdReduction<int64_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_UINT8:
-      cmd = std::make_unique<pimCmdReduction<uint8_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_UINT16:
-      cmd = std::make_unique<pimCmdReduction<uint16_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_UINT32:
-      cmd = std::make_unique<pimCmdReduction<uint32_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_UINT64:
-      cmd = std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    case PimDataType::PIM_FP8:
-    case PimDataType::PIM_FP16:
-    case PimDataType::PIM_BF16:
-    case PimDataType::PIM_FP32:
-      cmd = std::make_unique<pimCmdReduction<float>>(cmdType, src, max, idxBegin, idxEnd);
-      break;
-    default:
-      std::printf("PIM-Error: pimRedMax does not support data type %s\n", pimUtils::pimDataTypeEnumToStr(dataType).c_str());
-      return false;
-  }
+  std::unique_ptr<pimCmd> cmd = createReductionCmd(cmdType, src, max, idxBegin, idxEnd);
+  if (!cmd) { return false; }
   return m_device->executeCmd(std::move(cmd));
 }
 
@@ -799,44 +1334,197 @@ pimSim::pimRedSum(PimObjId src, void* sum, uint64_t idxBegin, uint64_t idxEnd)
   std::string tag = (idxBegin != idxEnd && idxBegin < idxEnd) ? "pimRedSumRanged" : "pimRedSum";
   pimPerfMon perfMon(tag);
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::REDSUM, src, idxBegin, idxEnd);
   if (!sum) { return false; }
 
+  PimCmdEnum cmdType = (idxBegin < idxEnd && idxEnd > 0) ? PimCmdEnum::REDSUM_RANGE : PimCmdEnum::REDSUM;
+  std::unique_ptr<pimCmd> cmd = createReductionCmd(cmdType, src, sum, idxBegin, idxEnd);
+  if (!cmd) { return false; }
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  Batched reductions of associated objects in one walk over their shared regions
+bool
+pimSim::pimRedBatched(const PimObjId* srcs, const PimReductionEnum* ops, void** results, unsigned numObjs, uint64_t idxBegin, uint64_t idxEnd)
+{
+  pimPerfMon perfMon("pimRedBatched");
+  if (!isValidDevice()) { return false; }
+  if (!srcs || !ops || !results) { return false; }
+  std::vector<PimObjId> srcVec(srcs, srcs + numObjs);
+  std::vector<PimReductionEnum> opVec(ops, ops + numObjs);
+  recordTrace(pimTraceOp::RED_BATCHED, srcVec, opVec, idxBegin, idxEnd);
+
+  bool isRanged = (idxBegin < idxEnd && idxEnd > 0);
+  std::vector<std::unique_ptr<pimCmdReductionBase>> reductions;
+  for (unsigned i = 0; i < numObjs; ++i) {
+    if (!results[i] || !m_device->getResMgr()->isValidObjId(srcs[i])) { return false; }
+    PimCmdEnum cmdType;
+    switch (ops[i]) {
+      case PIM_RED_SUM: cmdType = isRanged ? PimCmdEnum::REDSUM_RANGE : PimCmdEnum::REDSUM; break;
+      case PIM_RED_MIN: cmdType = isRanged ? PimCmdEnum::REDMIN_RANGE : PimCmdEnum::REDMIN; break;
+      case PIM_RED_MAX: cmdType = isRanged ? PimCmdEnum::REDMAX_RANGE : PimCmdEnum::REDMAX; break;
+      default:
+        std::printf("PIM-Error: Unknown reduction type %d for batched reduction\n", static_cast<int>(ops[i]));
+        return false;
+    }
+    std::unique_ptr<pimCmdReductionBase> reduction = createReductionCmd(cmdType, srcs[i], results[i], idxBegin, idxEnd);
+    if (!reduction) { return false; }
+    reductions.push_back(std::move(reduction));
+  }
+  std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdReductionBatched>(std::move(reductions));
+  return m_device->executeCmd(std::move(cmd));
+}
+
+//! @brief  Segmented reduction with an offsets array: segment i covers [offsets[i], offsets[i + 1])
+bool
+pimSim::pimRedSegmented(PimCmdEnum cmdType, PimObjId src, void* results, std::vector<uint64_t> offsets)
+{
+  if (!results || !m_device->getResMgr()->isValidObjId(src)) { return false; }
+
+  // Sum results are widened the same way as pimRedSum, while min and max keep the object data type
+  bool isSum = (cmdType == PimCmdEnum::REDSUM_SEGMENTED);
   const PimDataType dataType = m_device->getResMgr()->getObjInfo(src).getDataType();
   std::unique_ptr<pimCmd> cmd;
-  PimCmdEnum cmdType = (idxBegin < idxEnd && idxEnd > 0) ? PimCmdEnum::REDSUM_RANGE : PimCmdEnum::REDSUM;
   switch (dataType) {
     case PimDataType::PIM_INT8:
+    case PimDataType::PIM_INT4:
+    case PimDataType::PIM_INT2:
+      cmd = isSum ? std::unique_ptr<pimCmd>(std::make_unique<pimCmdReductionSegmented<int64_t>>(cmdType, src, results, std::move(offsets)))
+                  : std::make_unique<pimCmdReductionSegmented<int8_t>>(cmdType, src, results, std::move(offsets));
+      break;
     case PimDataType::PIM_INT16:
+      cmd = isSum ? std::unique_ptr<pimCmd>(std::make_unique<pimCmdReductionSegmented<int64_t>>(cmdType, src, results, std::move(offsets)))
+                  : std::make_unique<pimCmdReductionSegmented<int16_t>>(cmdType, src, results, std::move(offsets));
+      break;
     case PimDataType::PIM_INT32:
+      cmd = isSum ? std::unique_ptr<pimCmd>(std::make_unique<pimCmdReductionSegmented<int64_t>>(cmdType, src, results, std::move(offsets)))
+                  : std::make_unique<pimCmdReductionSegmented<int32_t>>(cmdType, src, results, std::move(offsets));
+      break;
     case PimDataType::PIM_INT64:
-      cmd = std::make_unique<pimCmdReduction<int64_t>>(cmdType, src, sum, idxBegin, idxEnd);
+      cmd = std::make_unique<pimCmdReductionSegmented<int64_t>>(cmdType, src, results, std::move(offsets));
       break;
     case PimDataType::PIM_BOOL:
     case PimDataType::PIM_UINT8:
+    case PimDataType::PIM_UINT4:
+    case PimDataType::PIM_UINT2:
+      cmd = isSum ? std::unique_ptr<pimCmd>(std::make_unique<pimCmdReductionSegmented<uint64_t>>(cmdType, src, results, std::move(offsets)))
+                  : std::make_unique<pimCmdReductionSegmented<uint8_t>>(cmdType, src, results, std::move(offsets));
+      break;
     case PimDataType::PIM_UINT16:
+      cmd = isSum ? std::unique_ptr<pimCmd>(std::make_unique<pimCmdReductionSegmented<uint64_t>>(cmdType, src, results, std::move(offsets)))
+                  : std::make_unique<pimCmdReductionSegmented<uint16_t>>(cmdType, src, results, std::move(offsets));
+      break;
     case PimDataType::PIM_UINT32:
+      cmd = isSum ? std::unique_ptr<pimCmd>(std::make_unique<pimCmdReductionSegmented<uint64_t>>(cmdType, src, results, std::move(offsets)))
+                  : std::make_unique<pimCmdReductionSegmented<uint32_t>>(cmdType, src, results, std::move(offsets));
+      break;
     case PimDataType::PIM_UINT64:
-      cmd = std::make_unique<pimCmdReduction<uint64_t>>(cmdType, src, sum, idxBegin, idxEnd);
+      cmd = std::make_unique<pimCmdReductionSegmented<uint64_t>>(cmdType, src, results, std::move(offsets));
       break;
     case PimDataType::PIM_FP8:
     case PimDataType::PIM_FP16:
     case PimDataType::PIM_BF16:
     case PimDataType::PIM_FP32:
-      cmd = std::make_unique<pimCmdReduction<float>>(cmdType, src, sum, idxBegin, idxEnd);
+      cmd = std::make_unique<pimCmdReductionSegmented<float>>(cmdType, src, results, std::move(offsets));
       break;
     default:
-      std::printf("PIM-Error: pimRedSum does not support data type %s\n", pimUtils::pimDataTypeEnumToStr(dataType).c_str());
+      std::printf("PIM-Error: %s does not support data type %s\n", pimCmd::getName(cmdType, "").c_str(),
+                  pimUtils::pimDataTypeEnumToStr(dataType).c_str());
       return false;
   }
   return m_device->executeCmd(std::move(cmd));
 }
 
+//! @brief  Segmented reduction with a segment length: segment i covers [i * segmentLen, (i + 1) * segmentLen)
+//! The last segment ends at the last element of the object
+bool
+pimSim::pimRedSegmented(PimCmdEnum cmdType, PimObjId src, void* results, uint64_t segmentLen)
+{
+  if (!m_device->getResMgr()->isValidObjId(src)) { return false; }
+  if (segmentLen == 0) {
+    std::printf("PIM-Error: Segment length of segmented reduction must be greater than zero\n");
+    return false;
+  }
+  uint64_t numElements = m_device->getResMgr()->getObjInfo(src).getNumElements();
+  std::vector<uint64_t> offsets;
+  offsets.reserve((numElements + segmentLen - 1) / segmentLen + 1);
+  for (uint64_t idx = 0; idx < numElements; idx += segmentLen) {
+    offsets.push_back(idx);
+  }
+  offsets.push_back(numElements);
+  return pimRedSegmented(cmdType, src, results, std::move(offsets));
+}
+
+//! @brief  Segmented reduction sum with a segment length
+bool
+pimSim::pimRedSumSegmented(PimObjId src, void* results, uint64_t segmentLen)
+{
+  pimPerfMon perfMon("pimRedSumSegmented");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::REDSUM_SEGMENTED, src, segmentLen);
+  return pimRedSegmented(PimCmdEnum::REDSUM_SEGMENTED, src, results, segmentLen);
+}
+
+//! @brief  Segmented min reduction with a segment length
+bool
+pimSim::pimRedMinSegmented(PimObjId src, void* results, uint64_t segmentLen)
+{
+  pimPerfMon perfMon("pimRedMinSegmented");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::REDMIN_SEGMENTED, src, segmentLen);
+  return pimRedSegmented(PimCmdEnum::REDMIN_SEGMENTED, src, results, segmentLen);
+}
+
+//! @brief  Segmented max reduction with a segment length
+bool
+pimSim::pimRedMaxSegmented(PimObjId src, void* results, uint64_t segmentLen)
+{
+  pimPerfMon perfMon("pimRedMaxSegmented");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::REDMAX_SEGMENTED, src, segmentLen);
+  return pimRedSegmented(PimCmdEnum::REDMAX_SEGMENTED, src, results, segmentLen);
+}
+
+//! @brief  Segmented reduction sum with an offsets array of numSegments + 1 entries
+bool
+pimSim::pimRedSumSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments)
+{
+  pimPerfMon perfMon("pimRedSumSegmentedByOffsets");
+  if (!isValidDevice() || !offsets) { return false; }
+  std::vector<uint64_t> offsetVec(offsets, offsets + numSegments + 1);
+  recordTrace(pimTraceOp::REDSUM_SEGMENTED_BY_OFFSETS, src, offsetVec);
+  return pimRedSegmented(PimCmdEnum::REDSUM_SEGMENTED, src, results, std::move(offsetVec));
+}
+
+//! @brief  Segmented min reduction with an offsets array of numSegments + 1 entries
+bool
+pimSim::pimRedMinSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments)
+{
+  pimPerfMon perfMon("pimRedMinSegmentedByOffsets");
+  if (!isValidDevice() || !offsets) { return false; }
+  std::vector<uint64_t> offsetVec(offsets, offsets + numSegments + 1);
+  recordTrace(pimTraceOp::REDMIN_SEGMENTED_BY_OFFSETS, src, offsetVec);
+  return pimRedSegmented(PimCmdEnum::REDMIN_SEGMENTED, src, results, std::move(offsetVec));
+}
+
+//! @brief  Segmented max reduction with an offsets array of numSegments + 1 entries
+bool
+pimSim::pimRedMaxSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments)
+{
+  pimPerfMon perfMon("pimRedMaxSegmentedByOffsets");
+  if (!isValidDevice() || !offsets) { return false; }
+  std::vector<uint64_t> offsetVec(offsets, offsets + numSegments + 1);
+  recordTrace(pimTraceOp::REDMAX_SEGMENTED_BY_OFFSETS, src, offsetVec);
+  return pimRedSegmented(PimCmdEnum::REDMAX_SEGMENTED, src, results, std::move(offsetVec));
+}
+
 //! @brief  Extract a bit slice from a data vector. Dest must be BOOL type
 bool
 pimSim::pimBitSliceExtract(PimObjId src, PimObjId destBool, unsigned bitIdx)
 {
   pimPerfMon perfMon("pimBitSliceExtract");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::BIT_SLICE_EXTRACT, src, destBool, bitIdx);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::BIT_SLICE_EXTRACT, src, destBool, bitIdx);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -847,6 +1535,7 @@ pimSim::pimBitSliceInsert(PimObjId srcBool, PimObjId dest, unsigned bitIdx)
 {
   pimPerfMon perfMon("pimBitSliceInsert");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::BIT_SLICE_INSERT, srcBool, dest, bitIdx);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::BIT_SLICE_INSERT, srcBool, dest, bitIdx);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -856,6 +1545,7 @@ pimSim::pimCondCopy(PimObjId condBool, PimObjId src, PimObjId dest)
 {
   pimPerfMon perfMon("pimCondCopy");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COND_COPY, condBool, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdCond>(PimCmdEnum::COND_COPY, condBool, src, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -865,6 +1555,7 @@ pimSim::pimCondBroadcast(PimObjId condBool, uint64_t scalarBits, PimObjId dest)
 {
   pimPerfMon perfMon("pimCondBroadcast");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COND_BROADCAST, condBool, scalarBits, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdCond>(PimCmdEnum::COND_BROADCAST, condBool, scalarBits, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -874,6 +1565,7 @@ pimSim::pimCondSelect(PimObjId condBool, PimObjId src1, PimObjId src2, PimObjId
 {
   pimPerfMon perfMon("pimCondSelect");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COND_SELECT, condBool, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdCond>(PimCmdEnum::COND_SELECT, condBool, src1, src2, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -883,6 +1575,7 @@ pimSim::pimCondSelectScalar(PimObjId condBool, PimObjId src1, uint64_t scalarBit
 {
   pimPerfMon perfMon("pimCondSelectScalar");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::COND_SELECT_SCALAR, condBool, src1, scalarBits, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdCond>(PimCmdEnum::COND_SELECT_SCALAR, condBool, src1, scalarBits, dest);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -892,6 +1585,7 @@ pimSim::pimRotateElementsRight(PimObjId src)
 {
   pimPerfMon perfMon("pimRotateElementsRight");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::ROTATE_ELEM_R, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::ROTATE_ELEM_R, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -901,6 +1595,7 @@ pimSim::pimRotateElementsLeft(PimObjId src)
 {
   pimPerfMon perfMon("pimRotateElementsLeft");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::ROTATE_ELEM_L, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::ROTATE_ELEM_L, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -910,6 +1605,7 @@ pimSim::pimShiftElementsRight(PimObjId src)
 {
   pimPerfMon perfMon("pimShiftElementsRight");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SHIFT_ELEM_R, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::SHIFT_ELEM_R, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -919,6 +1615,7 @@ pimSim::pimShiftElementsLeft(PimObjId src)
 {
   pimPerfMon perfMon("pimShiftElementsLeft");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SHIFT_ELEM_L, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRotate>(PimCmdEnum::SHIFT_ELEM_L, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -928,6 +1625,7 @@ pimSim::pimShiftBitsRight(PimObjId src, PimObjId dest, unsigned shiftAmount)
 {
   pimPerfMon perfMon("pimShiftBitsRight");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SHIFT_BITS_R, src, dest, shiftAmount);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::SHIFT_BITS_R, src, dest, shiftAmount);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -937,6 +1635,7 @@ pimSim::pimShiftBitsLeft(PimObjId src, PimObjId dest, unsigned shiftAmount)
 {
   pimPerfMon perfMon("pimShiftBitsLeft");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::SHIFT_BITS_L, src, dest, shiftAmount);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::SHIFT_BITS_L, src, dest, shiftAmount);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -946,6 +1645,7 @@ pimSim::pimAesSbox(PimObjId src, PimObjId dest, const std::vector<uint8_t>& lut)
 {
   pimPerfMon perfMon("pimAesSbox");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::AES_SBOX, src, dest, lut);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::AES_SBOX, src, dest, lut);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -955,6 +1655,7 @@ pimSim::pimAesInverseSbox(PimObjId src, PimObjId dest, const std::vector<uint8_t
 {
   pimPerfMon perfMon("pimAesInverseSbox");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::AES_INVERSE_SBOX, src, dest, lut);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFunc1>(PimCmdEnum::AES_INVERSE_SBOX, src, dest, lut);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -964,8 +1665,12 @@ pimSim::pimFuse(PimProg prog)
 {
   pimPerfMon perfMon("pimFuse");
   if (!isValidDevice()) { return false; }
+  // APIs within the fused program record themselves
+  recordTrace(pimTraceOp::FUSE_BEGIN);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdFuse>(prog);
-  return m_device->executeCmd(std::move(cmd));
+  bool ok = m_device->executeCmd(std::move(cmd));
+  recordTrace(pimTraceOp::FUSE_END);
+  return ok;
 }
 
 bool
@@ -973,6 +1678,7 @@ pimSim::pimOpReadRowToSa(PimObjId objId, unsigned ofst)
 {
   pimPerfMon perfMon("pimOpReadRowToSa");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_READ_ROW_TO_SA, objId, ofst);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdReadRowToSa>(PimCmdEnum::ROW_R, objId, ofst);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -982,6 +1688,7 @@ pimSim::pimOpWriteSaToRow(PimObjId objId, unsigned ofst)
 {
   pimPerfMon perfMon("pimOpWriteSaToRow");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_WRITE_SA_TO_ROW, objId, ofst);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdWriteSaToRow>(PimCmdEnum::ROW_W, objId, ofst);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -990,6 +1697,7 @@ bool
 pimSim::pimOpTRA(PimObjId src1, unsigned ofst1, PimObjId src2, unsigned ofst2, PimObjId src3, unsigned ofst3)
 {
   pimPerfMon perfMon("pimOpTRA");
+  recordTrace(pimTraceOp::OP_TRA, src1, ofst1, src2, ofst2, src3, ofst3);
   return false;
 }
 
@@ -998,6 +1706,7 @@ pimSim::pimOpMove(PimObjId objId, PimRowReg src, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpMove");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_MOVE, objId, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_MOV, objId, dest, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1007,6 +1716,7 @@ pimSim::pimOpSet(PimObjId objId, PimRowReg dest, bool val)
 {
   pimPerfMon perfMon("pimOpSet");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_SET, objId, dest, val);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_SET, objId, dest, val);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1016,6 +1726,7 @@ pimSim::pimOpNot(PimObjId objId, PimRowReg src, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpNot");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_NOT, objId, src, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_NOT, objId, dest, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1025,6 +1736,7 @@ pimSim::pimOpAnd(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpAnd");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_AND, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_AND, objId, dest, src1, src2);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1034,6 +1746,7 @@ pimSim::pimOpOr(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpOr");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_OR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_OR, objId, dest, src1, src2);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1043,6 +1756,7 @@ pimSim::pimOpNand(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest
 {
   pimPerfMon perfMon("pimOpNand");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_NAND, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_NAND, objId, dest, src1, src2);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1052,6 +1766,7 @@ pimSim::pimOpNor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpNor");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_NOR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_NOR, objId, dest, src1, src2);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1061,6 +1776,7 @@ pimSim::pimOpXor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest)
 {
   pimPerfMon perfMon("pimOpXor");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_XOR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_XOR, objId, dest, src1, src2);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1070,6 +1786,7 @@ pimSim::pimOpXnor(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg dest
 {
   pimPerfMon perfMon("pimOpXnor");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_XNOR, objId, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_XNOR, objId, dest, src1, src2);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1079,6 +1796,7 @@ pimSim::pimOpMaj(PimObjId objId, PimRowReg src1, PimRowReg src2, PimRowReg src3,
 {
   pimPerfMon perfMon("pimOpMaj");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_MAJ, objId, src1, src2, src3, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_MAJ, objId, dest, src1, src2, src3);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1088,6 +1806,7 @@ pimSim::pimOpSel(PimObjId objId, PimRowReg cond, PimRowReg src1, PimRowReg src2,
 {
   pimPerfMon perfMon("pimOpSel");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_SEL, objId, cond, src1, src2, dest);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegOp>(PimCmdEnum::RREG_SEL, objId, dest, cond, src1, src2);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1097,6 +1816,7 @@ pimSim::pimOpRotateRH(PimObjId objId, PimRowReg src)
 {
   pimPerfMon perfMon("pimOpRotateRH");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_ROTATE_RH, objId, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegRotate>(PimCmdEnum::RREG_ROTATE_R, objId, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1106,6 +1826,7 @@ pimSim::pimOpRotateLH(PimObjId objId, PimRowReg src)
 {
   pimPerfMon perfMon("pimOpRotateLH");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_ROTATE_LH, objId, src);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdRRegRotate>(PimCmdEnum::RREG_ROTATE_L, objId, src);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1113,16 +1834,21 @@ pimSim::pimOpRotateLH(PimObjId objId, PimRowReg src)
 bool
 pimSim::pimOpAP(int numSrc, va_list args)
 {
-  pimPerfMon perfMon("pimOpAP");
-  if (!isValidDevice()) { return false; }
-
   std::vector<std::pair<PimObjId, unsigned>> srcRows;
   for (int i = 0; i < numSrc; ++i) {
     PimObjId objId = va_arg(args, PimObjId);
     unsigned ofst = va_arg(args, unsigned);
     srcRows.emplace_back(objId, ofst);
   }
+  return pimOpAP(srcRows);
+}
 
+bool
+pimSim::pimOpAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows)
+{
+  pimPerfMon perfMon("pimOpAP");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_AP, srcRows);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdAnalogAAP>(PimCmdEnum::ROW_AP, srcRows);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1130,9 +1856,6 @@ pimSim::pimOpAP(int numSrc, va_list args)
 bool
 pimSim::pimOpAAP(int numSrc, int numDest, va_list args)
 {
-  pimPerfMon perfMon("pimOpAAP");
-  if (!isValidDevice()) { return false; }
-
   std::vector<std::pair<PimObjId, unsigned>> srcRows;
   for (int i = 0; i < numSrc; ++i) {
     PimObjId objId = va_arg(args, PimObjId);
@@ -1145,7 +1868,15 @@ pimSim::pimOpAAP(int numSrc, int numDest, va_list args)
     int ofst = va_arg(args, unsigned);
     destRows.emplace_back(objId, ofst);
   }
+  return pimOpAAP(srcRows, destRows);
+}
 
+bool
+pimSim::pimOpAAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows, const std::vector<std::pair<PimObjId, unsigned>>& destRows)
+{
+  pimPerfMon perfMon("pimOpAAP");
+  if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_AAP, srcRows, destRows);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdAnalogAAP>(PimCmdEnum::ROW_AAP, srcRows, destRows);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1155,6 +1886,7 @@ pimSim::pimOPAPP_GND(PimObjId objId, unsigned index)
 {
   pimPerfMon perfMon("pimOpAAP");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_APP_GND, objId, index);
 
   std::pair<PimObjId, unsigned> rowIdx;
   rowIdx.first = objId;
@@ -1169,6 +1901,7 @@ pimSim::pimOPAPP_VDD(PimObjId objId, unsigned index)
 {
   pimPerfMon perfMon("pimOpAAP");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_APP_VDD, objId, index);
 
   std::pair<PimObjId, unsigned> rowIdx;
   rowIdx.first = objId;
@@ -1183,6 +1916,7 @@ pimSim::pimOPAPP_AP(PimObjId objId, unsigned index)
 {
   pimPerfMon perfMon("pimOpAAP_AP");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_APP_AP, objId, index);
 
   std::pair<PimObjId, unsigned> rowIdx;
   rowIdx.first = objId;
@@ -1197,6 +1931,7 @@ pimSim::pimOpColGrpShiftR(PimObjId objId, unsigned shift_num)
 {
   pimPerfMon perfMon("pimOpColumnShiftR");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_COL_GRP_SHIFT_R, objId, shift_num);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdColGrpOP>(PimCmdEnum::COL_SHIFT_R, objId, shift_num);
   return m_device->executeCmd(std::move(cmd));
 }
@@ -1206,6 +1941,7 @@ pimSim::pimOpColGrpShiftL(PimObjId objId, unsigned shift_num)
 {
   pimPerfMon perfMon("pimOpColumnShiftL");
   if (!isValidDevice()) { return false; }
+  recordTrace(pimTraceOp::OP_COL_GRP_SHIFT_L, objId, shift_num);
   std::unique_ptr<pimCmd> cmd = std::make_unique<pimCmdColGrpOP>(PimCmdEnum::COL_SHIFT_L, objId, shift_num);
   return m_device->executeCmd(std::move(cmd));
 }
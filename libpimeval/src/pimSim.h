@@ -13,7 +13,10 @@
 #include "pimParamsDram.h"
 #include "pimPerfEnergyBase.h"
 #include "pimStats.h"
+#include "pimSweep.h"
+#include "pimTrace.h"
 #include <cstdarg>
+#include <map>
 #include <memory>
 
 
@@ -32,18 +35,24 @@ public:
   bool deleteDevice();
   bool isValidDevice(bool showMsg = true) const;
 
+  // Multiple devices
+  bool setDevice(PimDeviceId deviceId);
+  PimDeviceId getCurDeviceId() const { return m_curDeviceId; }
+  unsigned getNumDevices() const;
+
   // From pimSimConfig
-  const pimSimConfig& getConfig() const { return m_config; }
-  PimDeviceEnum getDeviceType() const { return m_config.getDeviceType(); }
-  PimDeviceEnum getSimTarget() const { return m_config.getSimTarget(); }
-  unsigned getNumRanks() const { return m_config.getNumRanks(); }
-  unsigned getNumBankPerRank() const { return m_config.getNumBankPerRank(); }
-  unsigned getNumSubarrayPerBank() const { return m_config.getNumSubarrayPerBank(); }
-  unsigned getNumRowPerSubarray() const { return m_config.getNumRowPerSubarray(); }
-  unsigned getNumColPerSubarray() const { return m_config.getNumColPerSubarray(); }
-  bool isAnalysisMode() const { return m_config.isAnalysisMode(); }
-  unsigned getNumThreads() const { return m_config.getNumThreads(); }
-  bool isDebug(pimSimConfig::pimDebugFlags flag) const { return m_config.getDebug() & flag; }
+  const pimSimConfig& getConfig() const { return *m_config; }
+  PimDeviceEnum getDeviceType() const { return m_config->getDeviceType(); }
+  PimDeviceEnum getSimTarget() const { return m_config->getSimTarget(); }
+  unsigned getNumRanks() const { return m_config->getNumRanks(); }
+  unsigned getNumBankPerRank() const { return m_config->getNumBankPerRank(); }
+  unsigned getNumSubarrayPerBank() const { return m_config->getNumSubarrayPerBank(); }
+  unsigned getNumRowPerSubarray() const { return m_config->getNumRowPerSubarray(); }
+  unsigned getNumColPerSubarray() const { return m_config->getNumColPerSubarray(); }
+  bool isAnalysisMode() const { return m_config->isAnalysisMode(); }
+  bool isDataAwarePerf() const { return m_config->isDataAwarePerf(); }
+  unsigned getNumThreads() const { return m_config->getNumThreads(); }
+  bool isDebug(pimSimConfig::pimDebugFlags flag) const { return m_config->getDebug() & flag; }
 
   unsigned getNumCores() const;
   unsigned getNumRows() const;
@@ -56,6 +65,7 @@ public:
   pimStatsMgr* getStatsMgr() { return m_statsMgr.get(); }
   const pimParamsDram& getParamsDram() const { assert(m_paramsDram); return *m_paramsDram; }
   pimPerfEnergyBase* getPerfEnergyModel();
+  pimDevice* getDevice() { return m_device.get(); }
 
   pimUtils::threadPool* getThreadPool() { return m_threadPool.get(); }
 
@@ -73,6 +83,19 @@ public:
   bool pimCopyMainToDeviceWithType(PimCopyEnum copyType, void* src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimCopyDeviceToMainWithType(PimCopyEnum copyType, PimObjId src, void* dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimCopyDeviceToDevice(PimObjId src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+  PimCopyHandle pimCopyMainToDeviceAsync(void* src, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+  PimCopyHandle pimCopyDeviceToMainAsync(PimObjId src, void* dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+  bool pimWait(PimCopyHandle handle);
+  bool pimCopyInterDevice(PimDeviceId srcDeviceId, PimObjId src, PimDeviceId destDeviceId, PimObjId dest, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+
+  // Streams and events
+  PimStreamId pimStreamCreate();
+  bool pimStreamDestroy(PimStreamId streamId);
+  bool pimSetStream(PimStreamId streamId);
+  bool pimStreamSynchronize(PimStreamId streamId);
+  PimEventId pimEventRecord(PimStreamId streamId);
+  bool pimStreamWaitEvent(PimStreamId streamId, PimEventId eventId);
+  bool pimEventSynchronize(PimEventId eventId);
   bool pimCopyObjectToObject(PimObjId src, PimObjId dest);
   bool pimConvertType(PimObjId src, PimObjId dest);
 
@@ -109,9 +132,22 @@ public:
   bool pimMax(PimObjId src, PimObjId dest, uint64_t scalarValue);
   bool pimScaledAdd(PimObjId src1, PimObjId src2, PimObjId dest, uint64_t scalarValue);
   bool pimPopCount(PimObjId src, PimObjId dest);
+  bool pimExp(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits);
+  bool pimLog(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits);
+  bool pimSqrt(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits);
+  bool pimRecip(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits);
+  bool pimSigmoid(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits);
+  bool pimTanh(PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits);
   bool pimRedSum(PimObjId src, void* sum, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimRedMin(PimObjId src, void* min, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimRedMax(PimObjId src, void* max, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
+  bool pimRedSumSegmented(PimObjId src, void* results, uint64_t segmentLen);
+  bool pimRedMinSegmented(PimObjId src, void* results, uint64_t segmentLen);
+  bool pimRedMaxSegmented(PimObjId src, void* results, uint64_t segmentLen);
+  bool pimRedSumSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments);
+  bool pimRedMinSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments);
+  bool pimRedMaxSegmentedByOffsets(PimObjId src, void* results, const uint64_t* offsets, uint64_t numSegments);
+  bool pimRedBatched(const PimObjId* srcs, const PimReductionEnum* ops, void** results, unsigned numObjs, uint64_t idxBegin = 0, uint64_t idxEnd = 0);
   bool pimBitSliceExtract(PimObjId src, PimObjId destBool, unsigned bitIdx);
   bool pimBitSliceInsert(PimObjId srcBool, PimObjId dest, unsigned bitIdx);
   bool pimCondCopy(PimObjId condBool, PimObjId src, PimObjId dest);
@@ -129,6 +165,14 @@ public:
   bool pimAesInverseSbox(PimObjId src, PimObjId dest, const std::vector<uint8_t>& lut); 
   bool pimPrefixSum(PimObjId src, PimObjId dest);
   bool pimMAC(PimObjId src1, PimObjId src2, void* dest);
+  bool pimGemv(PimObjId mat, const void* vec, PimObjId dest);
+  bool pimGemm(PimObjId mat, const void* matB, PimObjId dest, uint64_t numColsB);
+  bool pimAndPopCountBatched(PimObjId bitmaps, uint64_t numWordsPerRow, const uint64_t* rowsA, const uint64_t* rowsB, uint64_t numPairs, uint64_t* counts);
+  bool pimGather(PimObjId src, PimObjId index, PimObjId dest);
+  bool pimScatter(PimObjId src, PimObjId index, PimObjId dest);
+  bool pimScatterAdd(PimObjId src, PimObjId index, PimObjId dest);
+  bool pimCompact(PimObjId src, PimObjId cond, PimObjId dest, uint64_t* count);
+  bool pimTopK(PimObjId src, uint64_t k, void* outValues, uint64_t* outIndices, bool isSmallest);
 
   // PIM API Fusion
   bool pimFuse(PimProg prog);
@@ -154,6 +198,8 @@ public:
   // SIMDRAM micro ops
   bool pimOpAP(int numSrc, va_list args);
   bool pimOpAAP(int numSrc, int numDest, va_list args);
+  bool pimOpAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows);
+  bool pimOpAAP(const std::vector<std::pair<PimObjId, unsigned>>& srcRows, const std::vector<std::pair<PimObjId, unsigned>>& destRows);
   bool pimOPAPP_GND(PimObjId objId, unsigned index);
   bool pimOPAPP_VDD(PimObjId objId, unsigned index);
   bool pimOPAPP_AP(PimObjId objId, unsigned index);
@@ -162,6 +208,9 @@ public:
   bool pimOpColGrpShiftR(PimObjId objId,  unsigned shift_num);
   bool pimOpColGrpShiftL(PimObjId objId,  unsigned shift_num);
 
+  // PIM API trace replay: Do not record a new trace, and optionally force analysis mode
+  void setTraceReplayMode(bool isReplaying, bool forceAnalysisMode) { m_isReplayingTrace = isReplaying; m_forceAnalysisMode = forceAnalysisMode; }
+
   //added for memory access pattern
   pimCore& getCore(PimCoreId coreId) {
     return m_device->getCore(coreId);
@@ -174,15 +223,49 @@ private:
   pimSim operator=(const pimSim&) = delete;
   bool createDeviceCommon();
   void uninit();
+  void switchDevice(PimDeviceId deviceId);
+  uint64_t getHostNumBytes(PimObjId objId, uint64_t idxBegin, uint64_t idxEnd) const;
+  uint64_t getGemvHostNumBytes(PimObjId mat, PimObjId dest, uint64_t numVectors) const;
+  std::unique_ptr<pimCmdReductionBase> createReductionCmd(PimCmdEnum cmdType, PimObjId src, void* result, uint64_t idxBegin, uint64_t idxEnd) const;
+  bool pimRedSegmented(PimCmdEnum cmdType, PimObjId src, void* results, std::vector<uint64_t> offsets);
+  bool pimRedSegmented(PimCmdEnum cmdType, PimObjId src, void* results, uint64_t segmentLen);
+
+  //! @brief  Record a PIM API call into the trace file if tracing is enabled
+  template <typename... Args> void recordTrace(pimTraceOp op, const Args&... args) const {
+    if (m_traceWriter) {
+      m_traceWriter->record(op, args...);
+    }
+  }
+
+  //! @class  pimSim::deviceSlot
+  //! @brief  States of a PIM device that is not the current device
+  struct deviceSlot {
+    std::unique_ptr<pimSimConfig> m_config;
+    std::unique_ptr<pimParamsDram> m_paramsDram;
+    std::unique_ptr<pimDevice> m_device;
+    std::unique_ptr<pimStatsMgr> m_statsMgr;
+    std::unique_ptr<pimUtils::threadPool> m_threadPool;
+    std::unique_ptr<pimCmdStream> m_cmdStream;
+  };
 
   static pimSim* s_instance;
-  pimSimConfig m_config;
 
-  // support one device for now
-  std::unique_ptr<pimDevice> m_device;
+  // Current device. The device keeps a reference to its config, so the config moves with it between slots.
+  PimDeviceId m_curDeviceId = 0;
+  std::unique_ptr<pimSimConfig> m_config;
   std::unique_ptr<pimParamsDram> m_paramsDram;
+  std::unique_ptr<pimDevice> m_device;
   std::unique_ptr<pimStatsMgr> m_statsMgr;
   std::unique_ptr<pimUtils::threadPool> m_threadPool;
+  std::unique_ptr<pimCmdStream> m_cmdStream;
+
+  // Other created devices
+  std::map<PimDeviceId, deviceSlot> m_otherDevices;
+
+  // PIM API trace lives across devices until the simulator is destroyed
+  std::unique_ptr<pimTraceWriter> m_traceWriter;
+  bool m_isReplayingTrace = false;
+  bool m_forceAnalysisMode = false;
 
 };
 
@@ -12,6 +12,7 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <sstream>
 #include <filesystem>
 
 
@@ -58,6 +59,18 @@ pimSimConfig::show() const
 
   std::printf("PIM-Config: Number of Threads = %u\n", m_numThreads);
   std::printf("PIM-Config: Load Balanced = %s\n", m_loadBalanced ? "1" : "0");
+  for (const auto& sweepConfigFile : m_sweepConfigFiles) {
+    std::printf("PIM-Config: Sweep Config File: %s\n", sweepConfigFile.c_str());
+  }
+  if (!m_traceFile.empty()) {
+    std::printf("PIM-Config: Trace File: %s, Trace Payload = %s\n", m_traceFile.c_str(), m_tracePayload ? "1" : "0");
+  }
+  if (m_linkBandwidthMBps != DEFAULT_LINK_BANDWIDTH_MBPS) {
+    std::printf("PIM-Config: Inter-Device Link Bandwidth = %u MB/s\n", m_linkBandwidthMBps);
+  }
+  if (m_dataAwarePerf) {
+    std::printf("PIM-Config: Data-Aware Perf Model = 1\n");
+  }
   std::printf("----------------------------------------\n");
 }
 
@@ -91,6 +104,10 @@ pimSimConfig::deriveConfig(PimDeviceEnum deviceType,
   ok = ok & deriveNumThreads();
   ok = ok & deriveMiscEnvVars();
   ok = ok & deriveLoadBalance();
+  ok = ok & deriveSweepConfigFiles();
+  ok = ok & deriveTraceFile();
+  ok = ok & deriveLinkBandwidth();
+  ok = ok & deriveDataAwarePerf();
 
   // Show summary
   show();
@@ -452,3 +469,134 @@ pimSimConfig::deriveLoadBalance()
   return true;
 }
 
+//! @brief  Derive Params: Sweep config files - Replay recorded commands against other simulator configs
+bool
+pimSimConfig::deriveSweepConfigFiles()
+{
+  m_sweepConfigFiles.clear();
+
+  // Check config file then env variable
+  bool hasVal = false;
+  std::string valStr = pimUtils::getOptionalParam(m_cfgParams, m_cfgVarSweepConfigs, hasVal);
+  if (!hasVal) {
+    valStr = pimUtils::getOptionalParam(m_envParams, m_envVarSweepConfigs, hasVal);
+  }
+  if (!hasVal) {
+    return true;
+  }
+
+  std::stringstream ss(valStr);
+  std::string configFile;
+  while (std::getline(ss, configFile, ',')) {
+    pimUtils::trim(configFile);
+    if (configFile.empty()) {
+      continue;
+    }
+    if (!std::filesystem::exists(configFile)) {
+      // Try to find it in the same directory of sim config file
+      std::string configFilePath = pimUtils::getDirectoryPath(m_simConfigFile);
+      if (!m_simConfigFile.empty() && std::filesystem::exists(configFilePath + "/" + configFile)) {
+        configFile = configFilePath + "/" + configFile;
+      } else {
+        std::printf("PIM-Error: Cannot find sweep config file: %s\n", configFile.c_str());
+        return false;
+      }
+    }
+    m_sweepConfigFiles.push_back(configFile);
+  }
+  return true;
+}
+
+//! @brief  Derive Params: Trace file - Record PIM API calls for replaying without the application
+bool
+pimSimConfig::deriveTraceFile()
+{
+  m_traceFile.clear();
+  m_tracePayload = false;  // off by default
+
+  // Check config file then env variable
+  bool hasVal = false;
+  m_traceFile = pimUtils::getOptionalParam(m_cfgParams, m_cfgVarTraceFile, hasVal);
+  if (!hasVal) {
+    m_traceFile = pimUtils::getOptionalParam(m_envParams, m_envVarTraceFile, hasVal);
+  }
+
+  std::string valStr = pimUtils::getOptionalParam(m_cfgParams, m_cfgVarTracePayload, hasVal);
+  if (hasVal) {
+    if (valStr != "0" && valStr != "1") {
+      std::printf("PIM-Error: Incorrect config file parameter: %s=%s\n", m_cfgVarTracePayload.c_str(), valStr.c_str());
+      return false;
+    }
+    m_tracePayload = (valStr == "1");
+  } else {
+    valStr = pimUtils::getOptionalParam(m_envParams, m_envVarTracePayload, hasVal);
+    if (hasVal) {
+      if (valStr != "0" && valStr != "1") {
+        std::printf("PIM-Error: Incorrect environment variable: %s=%s\n", m_envVarTracePayload.c_str(), valStr.c_str());
+        return false;
+      }
+      m_tracePayload = (valStr == "1");
+    }
+  }
+  return true;
+}
+
+//! @brief  Derive Params: Inter-device link bandwidth - Model data copy between PIM devices
+bool
+pimSimConfig::deriveLinkBandwidth()
+{
+  m_linkBandwidthMBps = DEFAULT_LINK_BANDWIDTH_MBPS;
+
+  // Check config file then env variable
+  bool hasVal = false;
+  std::string valStr = pimUtils::getOptionalParam(m_cfgParams, m_cfgVarLinkBandwidth, hasVal);
+  if (hasVal) {
+    unsigned val = 0;
+    bool ok = pimUtils::convertStringToUnsigned(valStr, val);
+    if (!ok || val == 0) {
+      std::printf("PIM-Error: Incorrect config file parameter: %s=%s\n", m_cfgVarLinkBandwidth.c_str(), valStr.c_str());
+      return false;
+    }
+    m_linkBandwidthMBps = val;
+  } else {
+    valStr = pimUtils::getOptionalParam(m_envParams, m_envVarLinkBandwidth, hasVal);
+    if (hasVal) {
+      unsigned val = 0;
+      bool ok = pimUtils::convertStringToUnsigned(valStr, val);
+      if (!ok || val == 0) {
+        std::printf("PIM-Error: Incorrect environment variable: %s=%s\n", m_envVarLinkBandwidth.c_str(), valStr.c_str());
+        return false;
+      }
+      m_linkBandwidthMBps = val;
+    }
+  }
+  return true;
+}
+
+//! @brief  Derive Params: Data-aware perf - Model bit-serial commands based on actual data values
+bool
+pimSimConfig::deriveDataAwarePerf()
+{
+  m_dataAwarePerf = false;  // off by default
+
+  // Check config file then env variable
+  bool hasVal = false;
+  std::string valStr = pimUtils::getOptionalParam(m_cfgParams, m_cfgVarDataAwarePerf, hasVal);
+  if (hasVal) {
+    if (valStr != "0" && valStr != "1") {
+      std::printf("PIM-Error: Incorrect config file parameter: %s=%s\n", m_cfgVarDataAwarePerf.c_str(), valStr.c_str());
+      return false;
+    }
+    m_dataAwarePerf = (valStr == "1");
+  } else {
+    valStr = pimUtils::getOptionalParam(m_envParams, m_envVarDataAwarePerf, hasVal);
+    if (hasVal) {
+      if (valStr != "0" && valStr != "1") {
+        std::printf("PIM-Error: Incorrect environment variable: %s=%s\n", m_envVarDataAwarePerf.c_str(), valStr.c_str());
+        return false;
+      }
+      m_dataAwarePerf = (valStr == "1");
+    }
+  }
+  return true;
+}
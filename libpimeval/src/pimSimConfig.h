@@ -28,6 +28,11 @@
 //!   num_col_per_subarray = <int>               // number of columns per subarray
 //!   max_num_threads = <int>                    // maximum number of threads used by simulation
 //!   should_load_balance = <0|1>                // distribute data evenly among all cores
+//!   sweep_config_files = <cfg-file>,...        // replay perf-energy models against these sim config files
+//!   trace_file = <file>                        // record PIM API calls into a binary trace file
+//!   trace_payload = <0|1>                      // store host-to-device copy data in the trace
+//!   link_bandwidth_mbps = <int>                // bandwidth of inter-device links in MB/s
+//!   data_aware_perf = <0|1>                    // also model bit-serial commands based on actual data values
 //!
 //! Supported environment variables:
 //!   PIMEVAL_SIM_CONFIG <abs-path/cfg-file>     // PIMeval config file, e.g., abs-path/PIMeval_BitSimdV.cfg
@@ -42,6 +47,11 @@
 //!   PIMEVAL_ANALYSIS_MODE <0|1>                // PIMeval analysis mode
 //!   PIMEVAL_DEBUG <int>                        // PIMeval debug flags (see enum pimDebugFlags)
 //!   PIMEVAL_LOAD_BALANCE <0|1>                 // distribute data evenly among all cores
+//!   PIMEVAL_SWEEP_CONFIGS <cfg-file>,...       // replay perf-energy models against these sim config files
+//!   PIMEVAL_TRACE_FILE <file>                  // record PIM API calls into a binary trace file
+//!   PIMEVAL_TRACE_PAYLOAD <0|1>                // store host-to-device copy data in the trace
+//!   PIMEVAL_LINK_BANDWIDTH_MBPS <int>          // bandwidth of inter-device links in MB/s
+//!   PIMEVAL_DATA_AWARE_PERF <0|1>              // also model bit-serial commands based on actual data values
 //!
 //! Precedence rules (highest to lowest priority):
 //! * Config file: Either from -c command-line argument or from PIMEVAL_SIM_CONFIG
@@ -93,6 +103,14 @@ public:
   bool isAnalysisMode() const { return m_analysisMode; }
   unsigned getDebug() const { return m_debug; }
   bool isLoadBalanced() const { return m_loadBalanced; }
+  const std::vector<std::string>& getSweepConfigFiles() const { return m_sweepConfigFiles; }
+  const std::string& getTraceFile() const { return m_traceFile; }
+  bool isTracePayload() const { return m_tracePayload; }
+  unsigned getLinkBandwidthMBps() const { return m_linkBandwidthMBps; }
+  bool isDataAwarePerf() const { return m_dataAwarePerf; }
+
+  // Force analysis mode, e.g., for replaying recorded commands against a different config
+  void setAnalysisMode(bool val) { m_analysisMode = val; }
 
   enum pimDebugFlags
   {
@@ -101,6 +119,7 @@ public:
     DEBUG_CMDS        = 0x0004,
     DEBUG_ALLOC       = 0x0008,
     DEBUG_PERF        = 0x0010,
+    DEBUG_CORE_UTIL   = 0x0020,
   };
 
 private:
@@ -125,6 +144,10 @@ private:
   bool deriveNumThreads();
   bool deriveMiscEnvVars();
   bool deriveLoadBalance();
+  bool deriveSweepConfigFiles();
+  bool deriveTraceFile();
+  bool deriveLinkBandwidth();
+  bool deriveDataAwarePerf();
 
   bool parseConfigFromFile(const std::string& config, unsigned& numRanks, unsigned& numBankPerRank, unsigned& numSubarrayPerBank, unsigned& numRows, unsigned& numCols);
 
@@ -139,6 +162,11 @@ private:
   inline static const std::string m_cfgVarMaxNumThreads = "max_num_threads";
   inline static const std::string m_cfgVarLoadBalance = "should_load_balance";
   inline static const std::string m_cfgVarBufferSize = "buffer_size";
+  inline static const std::string m_cfgVarSweepConfigs = "sweep_config_files";
+  inline static const std::string m_cfgVarTraceFile = "trace_file";
+  inline static const std::string m_cfgVarTracePayload = "trace_payload";
+  inline static const std::string m_cfgVarLinkBandwidth = "link_bandwidth_mbps";
+  inline static const std::string m_cfgVarDataAwarePerf = "data_aware_perf";
 
   // Environment variables
   inline static const std::string m_envVarSimConfig = "PIMEVAL_SIM_CONFIG";
@@ -154,6 +182,11 @@ private:
   inline static const std::string m_envVarAnalysisMode = "PIMEVAL_ANALYSIS_MODE";
   inline static const std::string m_envVarDebug = "PIMEVAL_DEBUG";
   inline static const std::string m_envVarLoadBalance = "PIMEVAL_LOAD_BALANCE";
+  inline static const std::string m_envVarSweepConfigs = "PIMEVAL_SWEEP_CONFIGS";
+  inline static const std::string m_envVarTraceFile = "PIMEVAL_TRACE_FILE";
+  inline static const std::string m_envVarTracePayload = "PIMEVAL_TRACE_PAYLOAD";
+  inline static const std::string m_envVarLinkBandwidth = "PIMEVAL_LINK_BANDWIDTH_MBPS";
+  inline static const std::string m_envVarDataAwarePerf = "PIMEVAL_DATA_AWARE_PERF";
 
   // Add env vars to this list for readEnvVars
   inline static const std::vector<std::string> m_envVarList = {
@@ -170,6 +203,11 @@ private:
     m_envVarDebug,
     m_envVarLoadBalance,
     m_envVarBufferSize,
+    m_envVarSweepConfigs,
+    m_envVarTraceFile,
+    m_envVarTracePayload,
+    m_envVarLinkBandwidth,
+    m_envVarDataAwarePerf,
   };
 
   // Default values if not specified during init
@@ -180,6 +218,7 @@ private:
   static constexpr int DEFAULT_NUM_COL_PER_SUBARRAY = 8192;
   static constexpr int DEFAULT_BUFFER_SIZE = 0;
   static constexpr PimDeviceEnum DEFAULT_SIM_TARGET = PIM_DEVICE_BANK_LEVEL;
+  static constexpr unsigned DEFAULT_LINK_BANDWIDTH_MBPS = 25600;  // one DDR4-3200 channel through the host
 
   //! @brief  Reset all member variables to default status
   inline void reset() {
@@ -198,6 +237,11 @@ private:
     m_analysisMode = false;
     m_debug = 0;
     m_loadBalanced = false;
+    m_sweepConfigFiles.clear();
+    m_traceFile.clear();
+    m_tracePayload = false;
+    m_linkBandwidthMBps = 0;
+    m_dataAwarePerf = false;
     m_envParams.clear();
     m_cfgParams.clear();
     m_isInit = false;
@@ -219,6 +263,11 @@ private:
   bool m_analysisMode;
   unsigned m_debug;
   bool m_loadBalanced;
+  std::vector<std::string> m_sweepConfigFiles;
+  std::string m_traceFile;
+  bool m_tracePayload;
+  unsigned m_linkBandwidthMBps;
+  bool m_dataAwarePerf;
 
   // Store original parameters for extension purpose
   std::unordered_map<std::string, std::string> m_envParams;
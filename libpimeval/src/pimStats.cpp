@@ -7,10 +7,16 @@
 #include "pimStats.h"
 #include "pimSim.h"
 #include "pimUtils.h"
+#include "pimResMgr.h"
+#ifdef DRAMSIM3_INTEG
+#include "pimDramSim3.h"
+#endif
 #include <chrono>            // for chrono
 #include <cstdint>           // for uint64_t
 #include <cstdio>            // for printf
 #include <iomanip>           // for setw, fixed, setprecision
+#include <set>               // for set
+#include <algorithm>         // for min, max
 
 
 //! @brief  Show PIM stats
@@ -23,11 +29,107 @@ pimStatsMgr::showStats() const
   }
   showDeviceParams();
   showCopyStats();
+  showAsyncCopyStats();
   showCmdStats();
+  if (pimSim::get()->isDebug(pimSimConfig::DEBUG_CORE_UTIL)) {
+    showCoreUtilStats();
+  }
+  showActLimitStats();
+  showDataAwareStats();
+  showStreamStats();
+  showRefreshStats();
+  showDramSim3Stats();
   // showMemoryAccessStats();
   std::printf("----------------------------------------\n");
 }
 
+//! @brief  Show slowdown of PIM commands due to tRRD and tFAW row activation limits
+void
+pimStatsMgr::showActLimitStats() const
+{
+  double msTotalActLimit = 0.0;
+  for (const auto& it : m_cmdPerf) {
+    msTotalActLimit += it.second.second.m_msActLimit;
+  }
+  if (msTotalActLimit <= 0.0) {
+    return;
+  }
+  std::printf("Activation Limit Stats (tRRD/tFAW):\n");
+  std::printf(" %44s : %10s %14s %14s %10s\n", "PIM-CMD", "CNT", "Runtime(ms)", "Slowdown(ms)", "Slowdown");
+  for (const auto& it : m_cmdPerf) {
+    const pimeval::perfEnergy& perf = it.second.second;
+    if (perf.m_msActLimit <= 0.0) {
+      continue;
+    }
+    double msUnlimited = perf.m_msRuntime - perf.m_msActLimit;
+    std::printf(" %44s : %10d %14f %14f %9.2f%%\n", it.first.c_str(), it.second.first, perf.m_msRuntime, perf.m_msActLimit,
+                msUnlimited > 0.0 ? perf.m_msActLimit / msUnlimited * 100.0 : 0.0);
+  }
+  std::printf(" %44s : %10s %14s %14f\n", "TOTAL", "", "", msTotalActLimit);
+}
+
+//! @brief  Show worst-case and data-aware runtime of PIM commands with data-dependent bit-serial steps
+void
+pimStatsMgr::showDataAwareStats() const
+{
+  // Speedup only compares calls with a data-aware runtime, while a command may also have calls without one
+  double msTotalWorstCase = 0.0;
+  double msTotalDataAware = 0.0;
+  for (const auto& it : m_cmdPerf) {
+    if (it.second.second.m_msDataAware > 0.0) {
+      msTotalWorstCase += m_cmdMsWorstCaseDataAware.at(it.first);
+      msTotalDataAware += it.second.second.m_msDataAware;
+    }
+  }
+  if (msTotalDataAware <= 0.0) {
+    return;
+  }
+  std::printf("Data-Aware Perf Stats:\n");
+  std::printf(" %44s : %10s %14s %14s %10s\n", "PIM-CMD", "CNT", "WorstCase(ms)", "DataAware(ms)", "Speedup");
+  for (const auto& it : m_cmdPerf) {
+    const pimeval::perfEnergy& perf = it.second.second;
+    if (perf.m_msDataAware <= 0.0) {
+      continue;
+    }
+    double msWorstCase = m_cmdMsWorstCaseDataAware.at(it.first);
+    std::printf(" %44s : %10d %14f %14f %10.4f\n", it.first.c_str(), it.second.first, msWorstCase, perf.m_msDataAware,
+                msWorstCase / perf.m_msDataAware);
+  }
+  std::printf(" %44s : %10s %14f %14f %10.4f\n", "TOTAL", "", msTotalWorstCase, msTotalDataAware,
+              msTotalWorstCase / msTotalDataAware);
+}
+
+//! @brief  Show DRAM refresh stats accumulated over kernel timers
+void
+pimStatsMgr::showRefreshStats() const
+{
+  if (m_msRefreshStall <= 0.0) {
+    return;
+  }
+  std::printf("DRAM Refresh Stats:\n");
+  std::printf(" %30s : %14f ms Estimated Stall %14f mj Estimated Energy\n", "Refresh over kernels", m_msRefreshStall, m_mjRefresh);
+}
+
+//! @brief  Show analytical vs cycle-level runtime of PIM commands and data copy
+void
+pimStatsMgr::showDramSim3Stats() const
+{
+#ifdef DRAMSIM3_INTEG
+  if (m_cycleLevelMs.empty()) {
+    return;
+  }
+  std::printf("DRAMsim3 Cross-Validation:\n");
+  std::printf(" PIM commands compare row reads and writes only. Commands without them are not validated.\n");
+  std::printf(" %44s : %14s %14s %10s\n", "PIM-CMD", "Analytical(ms)", "DRAMsim3(ms)", "Ratio");
+  for (const auto& it : m_cycleLevelMs) {
+    double msAnalytical = it.second.first;
+    double msCycleLevel = it.second.second;
+    std::printf(" %44s : %14f %14f %10.4f\n", it.first.c_str(), msAnalytical, msCycleLevel,
+                msAnalytical > 0.0 ? msCycleLevel / msAnalytical : 0.0);
+  }
+#endif
+}
+
 //! @brief  Show API stats
 void
 pimStatsMgr::showMemoryAccessStats() const
@@ -72,7 +174,7 @@ pimStatsMgr::showApiStats() const
     } else if (it.first.find("pimAlloc") == 0 || it.first.find("pimFree") == 0) {
       totCallsAlloc += it.second.first;
       msTotalElapsedAlloc += it.second.second;
-    } else if (it.first.find("pimCopy") == 0) {
+    } else if (it.first.find("pimCopy") == 0 || it.first.find("pimWait") == 0) {
       totCallsCopy += it.second.first;
       msTotalElapsedCopy += it.second.second;
     } else {
@@ -123,21 +225,68 @@ pimStatsMgr::showCopyStats() const
   uint64_t bytesCopiedMainToDevice = m_bitsCopiedMainToDevice / 8;
   uint64_t bytesCopiedDeviceToMain = m_bitsCopiedDeviceToMain / 8;
   uint64_t bytesCopiedDeviceToDevice = m_bitsCopiedDeviceToDevice / 8;
-  uint64_t totalBytes = bytesCopiedMainToDevice + bytesCopiedDeviceToMain;
-  double totalMsRuntime = m_elapsedTimeCopiedMainToDevice + m_elapsedTimeCopiedDeviceToMain + m_elapsedTimeCopiedDeviceToDevice;
-  double totalMjEnergy = m_mJCopiedMainToDevice + m_mJCopiedDeviceToMain + m_mJCopiedDeviceToDevice;
+  uint64_t bytesCopiedInterDevice = m_bitsCopiedInterDevice / 8;
+  uint64_t totalBytes = bytesCopiedMainToDevice + bytesCopiedDeviceToMain + bytesCopiedInterDevice;
+  double totalMsRuntime = getCopyMsRuntime();
+  double totalMjEnergy = getCopyMjEnergy();
   std::printf(" %45s : %llu bytes\n", "Host to Device", (unsigned long long)bytesCopiedMainToDevice);
   std::printf(" %45s : %llu bytes\n", "Device to Host", (unsigned long long)bytesCopiedDeviceToMain);
   std::printf(" %45s : %llu bytes\n", "Device to Device", (unsigned long long)bytesCopiedDeviceToDevice);
+  if (bytesCopiedInterDevice > 0) {
+    std::printf(" %45s : %llu bytes %14.6f ms Estimated Runtime %14.6f mj Estimated Energy\n", "Inter-Device (Link)",
+                (unsigned long long)bytesCopiedInterDevice, m_elapsedTimeCopiedInterDevice, m_mJCopiedInterDevice);
+  }
   std::printf(" %45s : %llu bytes %14.6f ms Estimated Runtime %14.6f mj Estimated Energy\n", "TOTAL ---------", (unsigned long long)totalBytes, totalMsRuntime, totalMjEnergy);
 }
 
+//! @brief  Show overlap of async data copy with PIM commands
+void
+pimStatsMgr::showAsyncCopyStats() const
+{
+  if (m_numAsyncCopies == 0) {
+    return;
+  }
+  double msOverlapped = std::max(m_msAsyncCopyWaited - m_msAsyncCopyStall - m_msAsyncCopyHazardStall, 0.0);
+  std::printf("Async Copy Stats:\n");
+  std::printf(" %45s : %llu\n", "Number of Async Copies", (unsigned long long)m_numAsyncCopies);
+  std::printf(" %45s : %14.6f ms\n", "Transfer Runtime", m_msAsyncCopy);
+  std::printf(" %45s : %14.6f ms\n", "Stall at pimWait", m_msAsyncCopyStall);
+  std::printf(" %45s : %14.6f ms\n", "Stall at PIM APIs Using Copied Objects", m_msAsyncCopyHazardStall);
+  std::printf(" %45s : %14.6f ms\n", "Overlapped with PIM Commands", msOverlapped);
+}
+
+//! @brief  Show overlap of PIM APIs among streams
+void
+pimStatsMgr::showStreamStats() const
+{
+  if (m_streamMsBusy.empty() || (m_streamMsBusy.size() == 1 && m_streamMsBusy.count(0))) {
+    return;
+  }
+  std::printf("PIM Stream Stats:\n");
+  for (const auto& it : m_streamMsBusy) {
+    std::string name = "Stream " + std::to_string(it.first) + (it.first == 0 ? " (default)" : "");
+    std::printf(" %45s : %14.6f ms\n", name.c_str(), it.second);
+  }
+  std::printf(" %45s : %14.6f ms\n", "Serialized Runtime", m_msTimeline);
+  std::printf(" %45s : %14.6f ms\n", "Runtime with Stream Overlap", m_msMakespan);
+  std::printf(" %45s : %14.4f\n", "Speedup", m_msMakespan == 0.0 ? 0.0 : m_msTimeline / m_msMakespan);
+}
+
+//! @brief  Get percentage of a value over a total, or 0 if the total is 0
+static double
+getPercent(double value, double total)
+{
+  return total == 0.0 ? 0.0 : (value * 100 / total);
+}
+
 //! @brief  Show PIM cmd and perf stats
 void
 pimStatsMgr::showCmdStats() const
 {
   std::printf("PIM Command Stats:\n");
-  std::printf(" %44s : %10s %14s %14s %14s %7s %7s %7s\n", "PIM-CMD", "CNT", "Runtime(ms)", "Energy(mJ)", "GOPS/W", "%R", "%W", "%L");
+  // %R/%W/%L are runtime percentages; %E-* are energy percentages of activate/precharge, GDL transfers, PIM logic, background and host
+  std::printf(" %44s : %10s %14s %14s %14s %7s %7s %7s %7s %7s %7s %7s %7s\n", "PIM-CMD", "CNT", "Runtime(ms)", "Energy(mJ)", "GOPS/W", "%R", "%W", "%L",
+              "%E-ACT", "%E-GDL", "%E-LOG", "%E-BG", "%E-HOST");
   int totalCmd = 0;
   double totalMsRuntime = 0.0;
   double totalMjEnergy = 0.0;
@@ -145,6 +294,7 @@ pimStatsMgr::showCmdStats() const
   double totalMsWrite = 0.0;
   double totalMsCompute = 0.0;
   uint64_t totalOp = 0;
+  pimeval::energyBreakdown totalMjBreakdown;
   for (const auto& it : m_cmdPerf) {
     double cmdRuntime = it.second.second.m_msRuntime;
     double percentRead = cmdRuntime == 0.0 ? 0.0 : (it.second.second.m_msRead * 100 / cmdRuntime);
@@ -152,7 +302,10 @@ pimStatsMgr::showCmdStats() const
     double percentCompute = cmdRuntime == 0.0 ? 0.0 : (it.second.second.m_msCompute * 100 / cmdRuntime);
     double cmdEnergy = it.second.second.m_mjEnergy;
     double perfWatt = cmdEnergy == 0.0 ? 0.0 : (it.second.second.m_totalOp * 1.0 / cmdEnergy * 1e-6);
-    std::printf(" %44s : %10d %14f %14f %14f %7.2f %7.2f %7.2f\n", it.first.c_str(), it.second.first, it.second.second.m_msRuntime, it.second.second.m_mjEnergy, perfWatt, percentRead, percentWrite, percentCompute);
+    const pimeval::energyBreakdown& cmdBreakdown = it.second.second.m_mjBreakdown;
+    std::printf(" %44s : %10d %14f %14f %14f %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f\n", it.first.c_str(), it.second.first, it.second.second.m_msRuntime, it.second.second.m_mjEnergy, perfWatt, percentRead, percentWrite, percentCompute,
+                getPercent(cmdBreakdown.m_mjActPre, cmdEnergy), getPercent(cmdBreakdown.m_mjGDL, cmdEnergy), getPercent(cmdBreakdown.m_mjLogic, cmdEnergy),
+                getPercent(cmdBreakdown.m_mjBackground, cmdEnergy), getPercent(cmdBreakdown.m_mjHost, cmdEnergy));
     totalCmd += it.second.first;
     totalMsRuntime += it.second.second.m_msRuntime;
     totalMjEnergy += it.second.second.m_mjEnergy;
@@ -160,8 +313,11 @@ pimStatsMgr::showCmdStats() const
     totalMsWrite += it.second.first * percentWrite;
     totalMsCompute += it.second.first * percentCompute;
     totalOp += it.second.second.m_totalOp;
+    totalMjBreakdown += cmdBreakdown;
   }
-  std::printf(" %44s : %10d %14f %14f %14f %7.2f %7.2f %7.2f\n", "TOTAL ---------", totalCmd, totalMsRuntime, totalMjEnergy, (totalOp * 1.0 / totalMjEnergy * 1e-6), (totalMsRead / totalCmd), (totalMsWrite / totalCmd), (totalMsCompute / totalCmd) );
+  std::printf(" %44s : %10d %14f %14f %14f %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f %7.2f\n", "TOTAL ---------", totalCmd, totalMsRuntime, totalMjEnergy, (totalOp * 1.0 / totalMjEnergy * 1e-6), (totalMsRead / totalCmd), (totalMsWrite / totalCmd), (totalMsCompute / totalCmd),
+              getPercent(totalMjBreakdown.m_mjActPre, totalMjEnergy), getPercent(totalMjBreakdown.m_mjGDL, totalMjEnergy), getPercent(totalMjBreakdown.m_mjLogic, totalMjEnergy),
+              getPercent(totalMjBreakdown.m_mjBackground, totalMjEnergy), getPercent(totalMjBreakdown.m_mjHost, totalMjEnergy));
   // analyze micro-ops
   int numR = 0;
   int numW = 0;
@@ -185,6 +341,78 @@ pimStatsMgr::showCmdStats() const
     std::printf(" %30s : %d, %d, %d\n", "Num Read, Write, Logic", numR, numW, numL);
     std::printf(" %30s : %d, %d\n", "Num Activate, Precharge", numActivate, numPrecharge);
   }
+  if (pimSim::get()->isDebug(pimSimConfig::DEBUG_PERF)) {
+    const pimPerfEnergyBase* perfEnergyModel = pimSim::get()->getPerfEnergyModel();
+    if (perfEnergyModel) {
+      uint64_t numHits = perfEnergyModel->getNumCacheHits();
+      uint64_t numLookups = numHits + perfEnergyModel->getNumCacheMisses();
+      std::printf(" %30s : %llu lookups, %llu entries, %.2f%% hit rate\n", "Perf-Energy Cache",
+                  (unsigned long long)numLookups, (unsigned long long)perfEnergyModel->getCacheSize(),
+                  getPercent(numHits, numLookups));
+    }
+  }
+}
+
+//! @brief  Show per-core busy time and row occupancy as rank x bank x subarray grids
+void
+pimStatsMgr::showCoreUtilStats() const
+{
+  pimDevice* device = pimSim::get()->getDevice();
+  if (!device || !device->isValid()) {
+    return;
+  }
+  unsigned numCores = device->getNumCores();
+  unsigned numRanks = device->getNumCoreRanks();
+  unsigned numBanks = device->getNumCoreBankPerRank();
+  unsigned numSubarrays = device->getNumCoreSubarrayPerBank();
+  unsigned numRowsPerCore = device->getNumRows();
+  const pimResMgr* resMgr = device->getResMgr();
+
+  // Busy time is relative to the total runtime of all PIM commands, as each command occupies its cores for its full duration
+  double totalMsRuntime = getCmdMsRuntime();
+  std::vector<double> percentBusy(numCores, 0.0);
+  std::vector<double> percentRows(numCores, 0.0);
+  unsigned numCoresBusy = 0;
+  double sumPercentBusy = 0.0;
+  double maxPercentBusy = 0.0;
+  double minPercentBusy = 100.0;
+  for (unsigned coreId = 0; coreId < numCores; ++coreId) {
+    double msBusy = coreId < m_coreMsBusy.size() ? m_coreMsBusy[coreId] : 0.0;
+    percentBusy[coreId] = totalMsRuntime == 0.0 ? 0.0 : (msBusy * 100 / totalMsRuntime);
+    percentRows[coreId] = resMgr->getPeakNumRowsInUse(coreId) * 100.0 / numRowsPerCore;
+    if (msBusy > 0.0) {
+      numCoresBusy++;
+    }
+    sumPercentBusy += percentBusy[coreId];
+    maxPercentBusy = std::max(maxPercentBusy, percentBusy[coreId]);
+    minPercentBusy = std::min(minPercentBusy, percentBusy[coreId]);
+  }
+
+  std::printf("PIM Core Utilization Stats:\n");
+  std::printf(" %30s : %u of %u\n", "Cores Busy", numCoresBusy, numCores);
+  std::printf(" %30s : %.2f, %.2f, %.2f\n", "Busy % Min, Avg, Max", minPercentBusy, sumPercentBusy / numCores, maxPercentBusy);
+
+  // Print grids only if the cores can be mapped to rank x bank x subarray
+  if (numRanks * numBanks * numSubarrays != numCores) {
+    return;
+  }
+  const std::vector<std::pair<std::string, const std::vector<double>*>> grids = {
+    { "Busy time (% of PIM command runtime)", &percentBusy },
+    { "Peak row occupancy (% of rows per core)", &percentRows },
+  };
+  for (const auto& [title, values] : grids) {
+    std::printf(" %s, bank x subarray:\n", title.c_str());
+    for (unsigned rank = 0; rank < numRanks; ++rank) {
+      for (unsigned bank = 0; bank < numBanks; ++bank) {
+        std::printf("  R%u B%-3u :", rank, bank);
+        for (unsigned subarray = 0; subarray < numSubarrays; ++subarray) {
+          PimCoreId coreId = (rank * numBanks + bank) * numSubarrays + subarray;
+          std::printf(" %6.2f", (*values)[coreId]);
+        }
+        std::printf("\n");
+      }
+    }
+  }
 }
 
 //! @brief  Reset PIM stats
@@ -192,55 +420,263 @@ void
 pimStatsMgr::resetStats()
 {
   m_cmdPerf.clear();
+  m_cmdMsWorstCaseDataAware.clear();
   m_msElapsed.clear();
+  m_coreMsBusy.clear();
   m_bitsCopiedMainToDevice = 0;
   m_bitsCopiedDeviceToMain = 0;
   m_bitsCopiedDeviceToDevice = 0;
+  m_bitsCopiedInterDevice = 0;
+  m_elapsedTimeCopiedInterDevice = 0.0;
+  m_mJCopiedInterDevice = 0.0;
+  m_msRefreshStall = 0.0;
+  m_mjRefresh = 0.0;
+  m_asyncCopyMs.clear();
+  m_msTimeline = 0.0;
+  m_msCopyChannelFree = 0.0;
+  m_numAsyncCopies = 0;
+  m_msAsyncCopy = 0.0;
+  m_msAsyncCopyWaited = 0.0;
+  m_msAsyncCopyStall = 0.0;
+  m_msAsyncCopyHazardStall = 0.0;
+  m_streamMsClock.clear();
+  m_streamMsBusy.clear();
+  m_eventMs.clear();
+  m_coreMsFree.clear();
+  m_msBarrier = 0.0;
+  m_msMakespan = 0.0;
+#ifdef DRAMSIM3_INTEG
+  m_cycleLevelMs.clear();
+#endif
 }
 
-//! @brief  Record estimated runtime and energy of a PIM command
+//! @brief  Record estimated runtime and energy of a PIM command, with its object for cycle-level simulation if any
 void
-pimStatsMgr::recordCmd(const std::string& cmdName, pimeval::perfEnergy mPerfEnergy)
+pimStatsMgr::recordCmd(const std::string& cmdName, pimeval::perfEnergy mPerfEnergy, const pimObjInfo* obj)
 {
   auto& item = m_cmdPerf[cmdName];
   item.first++;
   item.second.m_msRuntime += mPerfEnergy.m_msRuntime;
   m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+  m_curApiNumCmds++;
   item.second.m_mjEnergy += mPerfEnergy.m_mjEnergy;
   item.second.m_msRead += mPerfEnergy.m_msRead;
   item.second.m_msWrite += mPerfEnergy.m_msWrite;
   item.second.m_msCompute += mPerfEnergy.m_msCompute;
   item.second.m_totalOp += mPerfEnergy.m_totalOp;
+  item.second.m_mjBreakdown += mPerfEnergy.m_mjBreakdown;
+  item.second.m_msActLimit += mPerfEnergy.m_msActLimit;
+  item.second.m_msDataAware += mPerfEnergy.m_msDataAware;
+  if (mPerfEnergy.m_msDataAware > 0.0) {
+    m_cmdMsWorstCaseDataAware[cmdName] += mPerfEnergy.m_msRuntime;
+  }
+
+#ifdef DRAMSIM3_INTEG
+  // Only row reads and writes are lowered to DRAM commands, including their activation rate limits.
+  // Commands without them have nothing to cross-validate.
+  double msRowOps = mPerfEnergy.m_msRead + mPerfEnergy.m_msWrite + mPerfEnergy.m_msActLimit;
+  if (m_dramSim3 && msRowOps > 0.0) {
+    auto& cycleLevel = m_cycleLevelMs[cmdName];
+    cycleLevel.first += msRowOps;
+    cycleLevel.second += m_dramSim3->simulateCmd(mPerfEnergy, obj);
+  }
+#endif
+}
+
+//! @brief  Get total estimated runtime of all PIM commands
+double
+pimStatsMgr::getCmdMsRuntime() const
+{
+  double totalMsRuntime = 0.0;
+  for (const auto& it : m_cmdPerf) {
+    totalMsRuntime += it.second.second.m_msRuntime;
+  }
+  return totalMsRuntime;
+}
+
+//! @brief  Get total estimated energy of all PIM commands
+double
+pimStatsMgr::getCmdMjEnergy() const
+{
+  double totalMjEnergy = 0.0;
+  for (const auto& it : m_cmdPerf) {
+    totalMjEnergy += it.second.second.m_mjEnergy;
+  }
+  return totalMjEnergy;
+}
+
+//! @brief  Record estimated busy time of all PIM cores occupied by a PIM object
+void
+pimStatsMgr::recordCoreBusyTime(const pimObjInfo& obj, double msRuntime)
+{
+  std::set<PimCoreId> coreIds;
+  for (const auto& region : obj.getRegions()) {
+    coreIds.insert(region.getCoreId());
+  }
+  for (PimCoreId coreId : coreIds) {
+    if (static_cast<size_t>(coreId) >= m_coreMsBusy.size()) {
+      m_coreMsBusy.resize(coreId + 1, 0.0);
+    }
+    m_coreMsBusy[coreId] += msRuntime;
+  }
+  m_curApiCores.insert(coreIds.begin(), coreIds.end());
+  m_curApiNumCmdsWithCores++;
+}
+
+//! @brief  Record modeled time of an event, which is after all APIs submitted to a stream so far
+void
+pimStatsMgr::recordEvent(PimEventId eventId, PimStreamId streamId)
+{
+  m_eventMs[eventId] = streamId == 0 ? m_msMakespan : std::max(m_streamMsClock[streamId], m_msBarrier);
+}
+
+//! @brief  Delay subsequent APIs of a stream until an event
+void
+pimStatsMgr::recordStreamWaitEvent(PimStreamId streamId, PimEventId eventId)
+{
+  auto it = m_eventMs.find(eventId);
+  if (streamId != 0 && it != m_eventMs.end()) {
+    m_streamMsClock[streamId] = std::max(m_streamMsClock[streamId], it->second);
+  }
 }
 
 //! @brief  Record estimated runtime and energy of data copy
 void
-pimStatsMgr::recordCopyMainToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy)
+pimStatsMgr::recordCopyMainToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy, PimCopyHandle asyncHandle,
+                                    const pimObjInfo* objDest)
 {
   m_bitsCopiedMainToDevice += numBits;
   m_elapsedTimeCopiedMainToDevice += mPerfEnergy.m_msRuntime;
-  m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+  if (asyncHandle == -1) {
+    m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+    m_curApiDeviceWide = true;
+  } else {
+    recordAsyncCopy(asyncHandle, mPerfEnergy.m_msRuntime, objDest);
+  }
   m_mJCopiedMainToDevice += mPerfEnergy.m_mjEnergy;
+
+#ifdef DRAMSIM3_INTEG
+  if (m_dramSim3) {
+    auto& cycleLevel = m_cycleLevelMs["copy_h2d"];
+    cycleLevel.first += mPerfEnergy.m_msRuntime;
+    cycleLevel.second += m_dramSim3->simulateCopy(numBits, nullptr, objDest);
+  }
+#endif
 }
 
 //! @brief  Record estimated runtime and energy of data copy
 void
-pimStatsMgr::recordCopyDeviceToMain(uint64_t numBits, pimeval::perfEnergy mPerfEnergy)
+pimStatsMgr::recordCopyDeviceToMain(uint64_t numBits, pimeval::perfEnergy mPerfEnergy, PimCopyHandle asyncHandle,
+                                    const pimObjInfo* objSrc)
 {
   m_bitsCopiedDeviceToMain += numBits;
   m_elapsedTimeCopiedDeviceToMain += mPerfEnergy.m_msRuntime;
-  m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+  if (asyncHandle == -1) {
+    m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+    m_curApiDeviceWide = true;
+  } else {
+    recordAsyncCopy(asyncHandle, mPerfEnergy.m_msRuntime, objSrc);
+  }
   m_mJCopiedDeviceToMain += mPerfEnergy.m_mjEnergy;
+
+#ifdef DRAMSIM3_INTEG
+  if (m_dramSim3) {
+    auto& cycleLevel = m_cycleLevelMs["copy_d2h"];
+    cycleLevel.first += mPerfEnergy.m_msRuntime;
+    cycleLevel.second += m_dramSim3->simulateCopy(numBits, objSrc, nullptr);
+  }
+#endif
 }
 
 //! @brief  Record estimated runtime and energy of data copy
 void
-pimStatsMgr::recordCopyDeviceToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy)
+pimStatsMgr::recordCopyDeviceToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy, PimCopyHandle asyncHandle,
+                                      const pimObjInfo* objSrc, const pimObjInfo* objDest)
 {
   m_bitsCopiedDeviceToDevice += numBits;
   m_elapsedTimeCopiedDeviceToDevice += mPerfEnergy.m_msRuntime;
-  m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+  if (asyncHandle == -1) {
+    m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+    m_curApiDeviceWide = true;
+  } else {
+    recordAsyncCopy(asyncHandle, mPerfEnergy.m_msRuntime, objSrc, objDest);
+  }
   m_mJCopiedDeviceToDevice += mPerfEnergy.m_mjEnergy;
+
+#ifdef DRAMSIM3_INTEG
+  if (m_dramSim3) {
+    auto& cycleLevel = m_cycleLevelMs["copy_d2d"];
+    cycleLevel.first += mPerfEnergy.m_msRuntime;
+    cycleLevel.second += m_dramSim3->simulateCopy(numBits, objSrc, objDest);
+  }
+#endif
+}
+
+//! @brief  Record estimated runtime and energy of data copy from another PIM device
+void
+pimStatsMgr::recordCopyInterDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy)
+{
+  m_bitsCopiedInterDevice += numBits;
+  m_elapsedTimeCopiedInterDevice += mPerfEnergy.m_msRuntime;
+  m_mJCopiedInterDevice += mPerfEnergy.m_mjEnergy;
+  m_curApiMsEstRuntime += mPerfEnergy.m_msRuntime;
+  m_curApiDeviceWide = true;
+}
+
+//! @brief  Schedule an async copy on the host-device transfer channel
+//! It starts when both the issuing API and the previous async copy are done, and only blocks PIM APIs using its objects
+void
+pimStatsMgr::recordAsyncCopy(PimCopyHandle asyncHandle, double msRuntime, const pimObjInfo* obj1, const pimObjInfo* obj2)
+{
+  double msStart = std::max(m_msTimeline + m_curApiMsEstRuntime, m_msCopyChannelFree);
+  m_msCopyChannelFree = msStart + msRuntime;
+  asyncCopyInfo& info = m_asyncCopyMs[asyncHandle];
+  info.m_msRuntime = msRuntime;
+  info.m_msEnd = m_msCopyChannelFree;
+  for (const pimObjInfo* obj : { obj1, obj2 }) {
+    if (obj) {
+      // ranged refs share data with the referenced object
+      info.m_objIds.push_back(obj->getRefObjId() != -1 ? obj->getRefObjId() : obj->getObjId());
+    }
+  }
+  m_numAsyncCopies++;
+  m_msAsyncCopy += msRuntime;
+}
+
+//! @brief  Stall current PIM API until an async copy is done
+void
+pimStatsMgr::recordAsyncCopyWait(PimCopyHandle asyncHandle)
+{
+  auto it = m_asyncCopyMs.find(asyncHandle);
+  if (it == m_asyncCopyMs.end()) {
+    return; // stats have been reset after issuing the copy
+  }
+  double msNow = m_msTimeline + m_curApiMsEstRuntime;
+  double msStall = std::max(it->second.m_msEnd - msNow, 0.0);
+  m_curApiMsEstRuntime += msStall;
+  m_curApiDeviceWide = true;
+  m_msAsyncCopyWaited += it->second.m_msRuntime;
+  m_msAsyncCopyStall += msStall;
+  m_asyncCopyMs.erase(it);
+}
+
+//! @brief  Stall current PIM API until pending async copies of any of its objects are done
+//! Object IDs of ranged refs are expected to be resolved to the referenced objects by the caller
+void
+pimStatsMgr::recordAsyncCopyHazard(const std::vector<PimObjId>& objIds)
+{
+  double msNow = m_msTimeline + m_curApiMsEstRuntime;
+  double msReady = msNow;
+  for (const auto& [handle, info] : m_asyncCopyMs) {
+    for (PimObjId objId : info.m_objIds) {
+      if (std::find(objIds.begin(), objIds.end(), objId) != objIds.end()) {
+        msReady = std::max(msReady, info.m_msEnd);
+        break;
+      }
+    }
+  }
+  m_curApiMsEstRuntime += msReady - msNow;
+  m_msAsyncCopyHazardStall += msReady - msNow;
 }
 
 //! @brief  Preprocessing at the beginning of a PIM API scope
@@ -249,6 +685,10 @@ pimStatsMgr::pimApiScopeStart()
 {
   // Restart for current PIM API call
   m_curApiMsEstRuntime = 0.0;
+  m_curApiCores.clear();
+  m_curApiDeviceWide = false;
+  m_curApiNumCmds = 0;
+  m_curApiNumCmdsWithCores = 0;
 }
 
 //! @brief  Postprocessing at the end of a PIM API scope
@@ -259,12 +699,53 @@ pimStatsMgr::pimApiScopeEnd(const std::string& tag, double elapsed)
   auto& item = m_msElapsed[tag];
   item.first++;
   item.second += elapsed;
+  m_msTimeline += m_curApiMsEstRuntime;
+  scheduleStreamApi();
 
   // Update kernel stats
   if (m_isKernelTimerOn) {
     m_kernelMsElapsedSim += elapsed;
     m_kernelMsEstRuntime += m_curApiMsEstRuntime;
+    if (m_curApiMsEstRuntime > 0.0) {
+      m_kernelNumApiCalls++;
+    }
+  }
+}
+
+//! @brief  Schedule current PIM API on the modeled timeline of its stream
+void
+pimStatsMgr::scheduleStreamApi()
+{
+  double msRuntime = m_curApiMsEstRuntime;
+  if (msRuntime > 0.0) {
+    bool isDeviceWide = m_curStream == 0 || m_curApiDeviceWide || m_curApiNumCmds != m_curApiNumCmdsWithCores;
+    double msEnd = 0.0;
+    if (isDeviceWide) {
+      msEnd = m_msMakespan + msRuntime;
+      m_msBarrier = msEnd;
+    } else {
+      double msStart = std::max(m_streamMsClock[m_curStream], m_msBarrier);
+      for (PimCoreId coreId : m_curApiCores) {
+        if (static_cast<size_t>(coreId) < m_coreMsFree.size()) {
+          msStart = std::max(msStart, m_coreMsFree[coreId]);
+        }
+      }
+      msEnd = msStart + msRuntime;
+      for (PimCoreId coreId : m_curApiCores) {
+        if (static_cast<size_t>(coreId) >= m_coreMsFree.size()) {
+          m_coreMsFree.resize(coreId + 1, 0.0);
+        }
+        m_coreMsFree[coreId] = msEnd;
+      }
+    }
+    m_streamMsClock[m_curStream] = msEnd;
+    m_streamMsBusy[m_curStream] += msRuntime;
+    m_msMakespan = std::max(m_msMakespan, msEnd);
   }
+  m_curApiCores.clear();
+  m_curApiDeviceWide = false;
+  m_curApiNumCmds = 0;
+  m_curApiNumCmdsWithCores = 0;
 }
 
 //! @brief  Start timer for a PIM kernel to measure CPU runtime and DRAM refresh
@@ -277,6 +758,9 @@ pimStatsMgr::startKernelTimer()
   }
   std::printf("PIM-Info: Start kernel timer.\n");
   m_isKernelTimerOn = true;
+  m_kernelMsElapsedSim = 0.0;
+  m_kernelMsEstRuntime = 0.0;
+  m_kernelNumApiCalls = 0;
   m_kernelStart = std::chrono::high_resolution_clock::now();
 }
 
@@ -291,8 +775,23 @@ pimStatsMgr::endKernelTimer()
   auto now = std::chrono::high_resolution_clock::now();
   double kernelMsElapsedTotal = std::chrono::duration<double, std::milli>(now - m_kernelStart).count();
   double kernelMsElapsedCpu = kernelMsElapsedTotal - m_kernelMsElapsedSim;
+
+  // DRAM refresh stalls PIM commands over the modeled kernel time
+  double kernelMsPim = m_kernelMsEstRuntime;
+  const pimPerfEnergyBase* perfEnergyModel = pimSim::get()->getPerfEnergyModel();
+  if (perfEnergyModel) {
+    pimeval::perfEnergy refresh = perfEnergyModel->getPerfEnergyForRefresh(m_kernelMsEstRuntime, m_kernelNumApiCalls);
+    kernelMsPim += refresh.m_msRuntime;
+    m_msRefreshStall += refresh.m_msRuntime;
+    m_mjRefresh += refresh.m_mjEnergy;
+    if (refresh.m_msRuntime > 0.0) {
+      std::printf("PIM-Info: DRAM refresh (%s): stall = %14f ms (%.2f%%), energy = %14f mJ\n",
+          pimPerfEnergyBase::refreshPolicyToStr(perfEnergyModel->getRefreshPolicy()).c_str(),
+          refresh.m_msRuntime, refresh.m_msRuntime / kernelMsPim * 100.0, refresh.m_mjEnergy);
+    }
+  }
   std::printf("PIM-Info: End kernel timer. Runtime = %14f ms, CPU = %14f ms, PIM = %14f ms\n",
-      kernelMsElapsedCpu + m_kernelMsEstRuntime, kernelMsElapsedCpu, m_kernelMsEstRuntime);
+      kernelMsElapsedCpu + kernelMsPim, kernelMsElapsedCpu, kernelMsPim);
   m_kernelStart = std::chrono::high_resolution_clock::time_point(); // reset
   m_isKernelTimerOn = false;
 }
@@ -13,8 +13,14 @@
 #include <cstdint>
 #include <string>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
 #include <chrono>
 
+class pimObjInfo;
+class pimDramSim3;
+
 //! @class  pimPerfMon
 //! @brief  PIM performance monitor
 class pimPerfMon
@@ -43,24 +49,54 @@ public:
   void showStats() const;
   void resetStats();
 
-  void recordCmd(const std::string& cmdName, pimeval::perfEnergy mPerfEnergy);
-  void recordCopyMainToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy);
-  void recordCopyDeviceToMain(uint64_t numBits, pimeval::perfEnergy mPerfEnergy);
-  void recordCopyDeviceToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy);
+  void recordCmd(const std::string& cmdName, pimeval::perfEnergy mPerfEnergy, const pimObjInfo* obj = nullptr);
+  void recordCopyMainToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy, PimCopyHandle asyncHandle = -1,
+                              const pimObjInfo* objDest = nullptr);
+  void recordCopyDeviceToMain(uint64_t numBits, pimeval::perfEnergy mPerfEnergy, PimCopyHandle asyncHandle = -1,
+                              const pimObjInfo* objSrc = nullptr);
+  void recordCopyDeviceToDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy, PimCopyHandle asyncHandle = -1,
+                                const pimObjInfo* objSrc = nullptr, const pimObjInfo* objDest = nullptr);
+  void recordCopyInterDevice(uint64_t numBits, pimeval::perfEnergy mPerfEnergy);
+  void recordAsyncCopyWait(PimCopyHandle asyncHandle);
+  void recordAsyncCopyHazard(const std::vector<PimObjId>& objIds);
+  void recordCoreBusyTime(const pimObjInfo& obj, double msRuntime);
+  void setCurStream(PimStreamId streamId) { m_curStream = streamId; }
+  void recordEvent(PimEventId eventId, PimStreamId streamId);
+  void recordStreamWaitEvent(PimStreamId streamId, PimEventId eventId);
+
+  double getCmdMsRuntime() const;
+  double getCmdMjEnergy() const;
+  double getCopyMsRuntime() const { return m_elapsedTimeCopiedMainToDevice + m_elapsedTimeCopiedDeviceToMain + m_elapsedTimeCopiedDeviceToDevice + m_elapsedTimeCopiedInterDevice; }
+#ifdef DRAMSIM3_INTEG
+  void setDramSim3(pimDramSim3* dramSim3) { m_dramSim3 = dramSim3; }
+#endif
+
+  double getCopyMjEnergy() const { return m_mJCopiedMainToDevice + m_mJCopiedDeviceToMain + m_mJCopiedDeviceToDevice + m_mJCopiedInterDevice; }
 
 private:
   friend class pimPerfMon;
   void pimApiScopeStart();
   void pimApiScopeEnd(const std::string& tag, double elapsed);
+  void recordAsyncCopy(PimCopyHandle asyncHandle, double msRuntime, const pimObjInfo* obj1, const pimObjInfo* obj2 = nullptr);
+  void scheduleStreamApi();
 
   void showMemoryAccessStats() const; //added for memory access
   void showApiStats() const;
   void showDeviceParams() const;
   void showCopyStats() const;
+  void showAsyncCopyStats() const;
   void showCmdStats() const;
+  void showCoreUtilStats() const;
+  void showActLimitStats() const;
+  void showDataAwareStats() const;
+  void showStreamStats() const;
+  void showRefreshStats() const;
+  void showDramSim3Stats() const;
 
   std::map<std::string, std::pair<int, pimeval::perfEnergy>> m_cmdPerf;
+  std::map<std::string, double> m_cmdMsWorstCaseDataAware;  // worst-case runtime of calls with data-aware runtime
   std::map<std::string, std::pair<int, double>> m_msElapsed;
+  std::vector<double> m_coreMsBusy;  // estimated busy time of each PIM core
 
   uint64_t m_bitsCopiedMainToDevice = 0;
   uint64_t m_bitsCopiedDeviceToMain = 0;
@@ -71,11 +107,52 @@ private:
   double m_mJCopiedMainToDevice = 0.0;
   double m_mJCopiedDeviceToMain = 0.0;
   double m_mJCopiedDeviceToDevice = 0.0;
+  uint64_t m_bitsCopiedInterDevice = 0;      // copied from another PIM device to this device
+  double m_elapsedTimeCopiedInterDevice = 0.0;
+  double m_mJCopiedInterDevice = 0.0;
 
   bool m_isKernelTimerOn = false;
   double m_curApiMsEstRuntime = 0.0;
   double m_kernelMsElapsedSim = 0.0;
   double m_kernelMsEstRuntime = 0.0;
+  uint64_t m_kernelNumApiCalls = 0;
+  double m_msRefreshStall = 0.0;  // DRAM refresh stall time over all kernels
+  double m_mjRefresh = 0.0;       // DRAM refresh energy over all kernels
+
+  // Async copies occupy a serial host-device transfer channel, while PIM APIs advance the modeled timeline
+  //! @brief  Modeled runtime and end time of a pending async copy, and PIM objects it touches
+  struct asyncCopyInfo {
+    double m_msRuntime = 0.0;
+    double m_msEnd = 0.0;
+    std::vector<PimObjId> m_objIds;
+  };
+  std::unordered_map<PimCopyHandle, asyncCopyInfo> m_asyncCopyMs;
+  double m_msTimeline = 0.0;           // modeled end time of all finished PIM APIs
+  double m_msCopyChannelFree = 0.0;    // modeled end time of the last async copy
+  uint64_t m_numAsyncCopies = 0;
+  double m_msAsyncCopy = 0.0;          // runtime of all async copies
+  double m_msAsyncCopyWaited = 0.0;    // runtime of async copies that have been waited
+  double m_msAsyncCopyStall = 0.0;     // exposed runtime of async copies at pimWait
+  double m_msAsyncCopyHazardStall = 0.0; // stall of PIM APIs using objects of pending async copies
+
+  // PIM APIs of non-default streams overlap with each other on disjoint PIM cores.
+  // Default stream APIs and APIs without known cores are device-wide, which wait for and block all streams.
+  PimStreamId m_curStream = 0;
+  std::map<PimStreamId, double> m_streamMsClock;  // modeled end time of the last API of each stream
+  std::map<PimStreamId, double> m_streamMsBusy;   // modeled runtime of all APIs of each stream
+  std::unordered_map<PimEventId, double> m_eventMs; // modeled time of each recorded event
+  std::vector<double> m_coreMsFree;    // modeled time when each PIM core becomes free
+  double m_msBarrier = 0.0;            // modeled end time of the last device-wide API
+  double m_msMakespan = 0.0;           // modeled end time of all PIM APIs with stream overlap
+  std::set<PimCoreId> m_curApiCores;   // PIM cores occupied by current PIM API
+  bool m_curApiDeviceWide = false;
+  uint64_t m_curApiNumCmds = 0;
+  uint64_t m_curApiNumCmdsWithCores = 0;
+
+#ifdef DRAMSIM3_INTEG
+  pimDramSim3* m_dramSim3 = nullptr;
+  std::map<std::string, std::pair<double, double>> m_cycleLevelMs; // analytical vs cycle-level runtime
+#endif
   std::chrono::time_point<std::chrono::high_resolution_clock> m_kernelStart{};
 };
 
@@ -0,0 +1,84 @@
+// File: pimStream.cpp
+// PIMeval Simulator - PIM Streams
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimStream.h"
+#include <memory>
+
+
+//! @brief  pimStream ctor
+pimStream::pimStream(PimStreamId streamId)
+  : m_streamId(streamId)
+{
+  m_thread = std::thread([this] { workerThread(); });
+}
+
+//! @brief  pimStream dtor, which finishes all submitted commands
+pimStream::~pimStream()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_terminate = true;
+  }
+  m_cond.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+//! @brief  Submit a task to the end of the stream
+void
+pimStream::submit(std::function<void()> task)
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_tasks.push(std::move(task));
+    m_numPending++;
+  }
+  m_cond.notify_all();
+}
+
+//! @brief  Record an event, which is signaled once all previously submitted tasks are done
+std::shared_future<void>
+pimStream::recordEvent()
+{
+  auto promise = std::make_shared<std::promise<void>>();
+  std::shared_future<void> event = promise->get_future().share();
+  submit([promise]() { promise->set_value(); });
+  return event;
+}
+
+//! @brief  Wait for all submitted tasks to be done
+void
+pimStream::synchronize()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this] { return m_numPending == 0; });
+}
+
+//! @brief  Worker thread that runs tasks in submission order
+void
+pimStream::workerThread()
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cond.wait(lock, [this] { return m_terminate || !m_tasks.empty(); });
+      if (m_terminate && m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop();
+    }
+    task();
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_numPending--;
+    }
+    m_cond.notify_all();
+  }
+}
+
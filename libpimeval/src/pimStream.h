@@ -0,0 +1,49 @@
+// File: pimStream.h
+// PIMeval Simulator - PIM Streams
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_STREAM_H
+#define LAVA_PIM_STREAM_H
+
+#include "libpimeval.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+
+//! @class  pimStream
+//! @brief  An in-order queue of PIM commands executed on its own host thread
+//! Commands are modeled when submitted and only run functionally here, so commands of different
+//! streams can run in parallel on the host without touching the stats manager. Commands whose models
+//! depend on execution results are not submitted, and run on the calling thread after the stream drains.
+class pimStream
+{
+public:
+  pimStream(PimStreamId streamId);
+  ~pimStream();
+
+  PimStreamId getStreamId() const { return m_streamId; }
+  void submit(std::function<void()> task);
+  std::shared_future<void> recordEvent();
+  void synchronize();
+
+private:
+  void workerThread();
+
+  PimStreamId m_streamId;
+  std::thread m_thread;
+  std::queue<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  uint64_t m_numPending = 0;
+  bool m_terminate = false;
+};
+
+#endif
+
@@ -0,0 +1,257 @@
+// File: pimSweep.cpp
+// PIMeval Simulator - Design Space Sweep
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimSweep.h"
+#include "pimSim.h"
+#include <cstdio>            // for printf
+#include <algorithm>         // for min, remove_if
+#include <filesystem>        // for path
+
+
+//! @brief  Record allocation of a PIM object
+void
+pimCmdStream::recordAlloc(PimObjId objId, PimAllocEnum allocType, uint64_t numElements, PimDataType dataType)
+{
+  entry item;
+  item.m_op = pimStreamOp::ALLOC;
+  item.m_objId = objId;
+  item.m_allocType = allocType;
+  item.m_numElements = numElements;
+  item.m_dataType = dataType;
+  m_entries.push_back(std::move(item));
+}
+
+//! @brief  Record allocation of a PIM object associated with another PIM object
+void
+pimCmdStream::recordAllocAssociated(PimObjId objId, PimObjId assocId, PimDataType dataType)
+{
+  entry item;
+  item.m_op = pimStreamOp::ALLOC_ASSOCIATED;
+  item.m_objId = objId;
+  item.m_refId = assocId;
+  item.m_dataType = dataType;
+  m_entries.push_back(std::move(item));
+}
+
+//! @brief  Record allocation of a PIM buffer
+void
+pimCmdStream::recordAllocBuffer(PimObjId objId, uint32_t numElements, PimDataType dataType)
+{
+  entry item;
+  item.m_op = pimStreamOp::ALLOC_BUFFER;
+  item.m_objId = objId;
+  item.m_numElements = numElements;
+  item.m_dataType = dataType;
+  m_entries.push_back(std::move(item));
+}
+
+//! @brief  Record deletion of a PIM object
+void
+pimCmdStream::recordFree(PimObjId objId)
+{
+  entry item;
+  item.m_op = pimStreamOp::FREE;
+  item.m_objId = objId;
+  m_entries.push_back(std::move(item));
+}
+
+//! @brief  Record creation of a ranged reference
+void
+pimCmdStream::recordCreateRangedRef(PimObjId objId, PimObjId refId, uint64_t idxBegin, uint64_t idxEnd)
+{
+  entry item;
+  item.m_op = pimStreamOp::CREATE_RANGED_REF;
+  item.m_objId = objId;
+  item.m_refId = refId;
+  item.m_idxBegin = idxBegin;
+  item.m_idxEnd = idxEnd;
+  m_entries.push_back(std::move(item));
+}
+
+//! @brief  Record creation of a dual-contact reference
+void
+pimCmdStream::recordCreateDualContactRef(PimObjId objId, PimObjId refId)
+{
+  entry item;
+  item.m_op = pimStreamOp::CREATE_DUAL_CONTACT_REF;
+  item.m_objId = objId;
+  item.m_refId = refId;
+  m_entries.push_back(std::move(item));
+}
+
+//! @brief  Record an executed PIM command
+void
+pimCmdStream::recordCmd(std::unique_ptr<pimCmd> cmd)
+{
+  entry item;
+  item.m_op = pimStreamOp::CMD;
+  item.m_cmd = std::move(cmd);
+  m_entries.push_back(std::move(item));
+  m_numCmds++;
+}
+
+//! @brief  Drop all recorded commands while keeping resource operations, e.g., when stats are reset
+void
+pimCmdStream::clearCmds()
+{
+  m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                 [](const entry& item) { return item.m_op == pimStreamOp::CMD; }),
+                  m_entries.end());
+  m_numCmds = 0;
+}
+
+//! @brief  Replay the stream on a device and record perf-energy stats into a stats manager
+bool
+pimCmdStream::replay(pimDevice* device, pimStatsMgr* statsMgr) const
+{
+  for (const auto& item : m_entries) {
+    PimObjId objId = -1;
+    switch (item.m_op) {
+    case pimStreamOp::ALLOC:
+      objId = device->pimAlloc(item.m_allocType, item.m_numElements, item.m_dataType);
+      break;
+    case pimStreamOp::ALLOC_ASSOCIATED:
+      objId = device->pimAllocAssociated(item.m_refId, item.m_dataType);
+      break;
+    case pimStreamOp::ALLOC_BUFFER:
+      objId = device->pimAllocBuffer(item.m_numElements, item.m_dataType);
+      break;
+    case pimStreamOp::FREE:
+      objId = device->pimFree(item.m_objId) ? item.m_objId : -1;
+      break;
+    case pimStreamOp::CREATE_RANGED_REF:
+      objId = device->pimCreateRangedRef(item.m_refId, item.m_idxBegin, item.m_idxEnd);
+      break;
+    case pimStreamOp::CREATE_DUAL_CONTACT_REF:
+      objId = device->pimCreateDualContactRef(item.m_refId);
+      break;
+    case pimStreamOp::CMD:
+      item.m_cmd->updateStats(device, statsMgr);
+      continue;
+    default:
+      assert(0);
+    }
+    if (objId != item.m_objId) {
+      std::printf("PIM-Error: Failed to replay resource operation of PIM object ID %d\n", item.m_objId);
+      return false;
+    }
+  }
+  return true;
+}
+
+
+//! @brief  pimSweep ctor
+pimSweep::pimSweep(const pimCmdStream& cmdStream, const std::vector<std::string>& configFiles, unsigned numThreads)
+  : m_cmdStream(cmdStream),
+    m_results(configFiles.size()),
+    m_numThreads(numThreads)
+{
+  for (size_t i = 0; i < configFiles.size(); ++i) {
+    m_results[i].m_configFile = configFiles[i];
+  }
+}
+
+//! @brief  pimSweep dtor
+pimSweep::~pimSweep()
+{
+}
+
+//! @brief  Create a replaying device with its own config, DRAM params, perf-energy model and stats
+bool
+pimSweep::createDevice(sweepResult& result) const
+{
+  result.m_config = std::make_unique<pimSimConfig>();
+  if (!result.m_config->init(PIM_FUNCTIONAL, result.m_configFile)) {
+    return false;
+  }
+  result.m_config->setAnalysisMode(true);
+
+  if (!result.m_config->getMemConfigFile().empty()) {
+    result.m_paramsDram = pimParamsDram::createFromConfig(result.m_config->getMemConfigFile());
+  } else {
+    result.m_paramsDram = pimParamsDram::create(result.m_config->getMemoryProtocol());
+  }
+
+  result.m_device = std::make_unique<pimDevice>(*result.m_config, *result.m_paramsDram);
+  if (!result.m_device->isValid()) {
+    return false;
+  }
+  result.m_statsMgr = std::make_unique<pimStatsMgr>();
+  return true;
+}
+
+//! @brief  Replay the command stream for one sweep config
+void
+pimSweep::sweepWorker::execute()
+{
+  m_result.m_isValid = m_cmdStream.replay(m_result.m_device.get(), m_result.m_statsMgr.get());
+}
+
+//! @brief  Replay the command stream against all sweep configs
+bool
+pimSweep::run()
+{
+  std::printf("PIM-Info: Replaying %llu PIM commands against %lu sweep configs\n",
+              (unsigned long long)m_cmdStream.getNumCmds(), m_results.size());
+
+  // Device creation shows config summaries, so keep it in the main thread for readable logs
+  std::vector<pimUtils::threadWorker*> workers;
+  for (auto& result : m_results) {
+    result.m_isValid = createDevice(result);
+    if (result.m_isValid) {
+      workers.push_back(new sweepWorker(m_cmdStream, result));
+    } else {
+      std::printf("PIM-Error: Failed to create PIM device for sweep config %s\n", result.m_configFile.c_str());
+    }
+  }
+
+  if (m_numThreads > 1 && workers.size() > 1) { // MT
+    // thread pool reserves one thread for main program
+    pimUtils::threadPool pool(std::min<size_t>(m_numThreads, workers.size() + 1));
+    pool.doWork(workers);
+  } else { // single thread
+    for (auto worker : workers) {
+      worker->execute();
+    }
+  }
+  for (auto worker : workers) {
+    delete worker;
+  }
+
+  bool success = true;
+  for (const auto& result : m_results) {
+    success = success && result.m_isValid;
+  }
+  return success;
+}
+
+//! @brief  Show a comparison table of the current device and all sweep configs
+void
+pimSweep::showResults(const pimStatsMgr& curStatsMgr, const pimSimConfig& curConfig) const
+{
+  double curMsRuntime = curStatsMgr.getCmdMsRuntime();
+  std::printf("PIM Design Space Sweep:\n");
+  std::printf(" %30s : %26s %10s %14s %14s %14s %14s %10s\n", "Config", "Simulation Target", "Cores",
+              "Runtime(ms)", "Energy(mJ)", "Copy(ms)", "Copy(mJ)", "Speedup");
+  std::string curConfigName = curConfig.getSimConfigFile().empty() ? "<current>" : std::filesystem::path(curConfig.getSimConfigFile()).filename().string();
+  std::printf(" %30s : %26s %10u %14f %14f %14f %14f %10.4f\n", curConfigName.c_str(),
+              pimUtils::pimDeviceEnumToStr(curConfig.getSimTarget()).c_str(), pimSim::get()->getNumCores(),
+              curMsRuntime, curStatsMgr.getCmdMjEnergy(), curStatsMgr.getCopyMsRuntime(), curStatsMgr.getCopyMjEnergy(), 1.0);
+  for (const auto& result : m_results) {
+    std::string configName = std::filesystem::path(result.m_configFile).filename().string();
+    if (!result.m_isValid) {
+      std::printf(" %30s : %26s\n", configName.c_str(), "<FAILED>");
+      continue;
+    }
+    double msRuntime = result.m_statsMgr->getCmdMsRuntime();
+    std::printf(" %30s : %26s %10u %14f %14f %14f %14f %10.4f\n", configName.c_str(),
+                pimUtils::pimDeviceEnumToStr(result.m_config->getSimTarget()).c_str(), result.m_device->getNumCores(),
+                msRuntime, result.m_statsMgr->getCmdMjEnergy(),
+                result.m_statsMgr->getCopyMsRuntime(), result.m_statsMgr->getCopyMjEnergy(),
+                msRuntime == 0.0 ? 0.0 : curMsRuntime / msRuntime);
+  }
+}
+
@@ -0,0 +1,122 @@
+// File: pimSweep.h
+// PIMeval Simulator - Design Space Sweep
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_SWEEP_H
+#define LAVA_PIM_SWEEP_H
+
+#include "libpimeval.h"
+#include "pimCmd.h"
+#include "pimDevice.h"
+#include "pimSimConfig.h"
+#include "pimParamsDram.h"
+#include "pimStats.h"
+#include "pimUtils.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+//! @class  pimCmdStream
+//! @brief  A recorded stream of PIM resource operations and executed PIM commands
+//! Perf-energy evaluation is deterministic given the command stream and object shapes,
+//! so a stream recorded once can be replayed against any device configuration.
+//! Object IDs are deterministic as well, so replaying the resource operations in order
+//! reproduces the same object IDs referenced by the recorded commands.
+class pimCmdStream
+{
+public:
+  pimCmdStream() {}
+  ~pimCmdStream() {}
+
+  void recordAlloc(PimObjId objId, PimAllocEnum allocType, uint64_t numElements, PimDataType dataType);
+  void recordAllocAssociated(PimObjId objId, PimObjId assocId, PimDataType dataType);
+  void recordAllocBuffer(PimObjId objId, uint32_t numElements, PimDataType dataType);
+  void recordFree(PimObjId objId);
+  void recordCreateRangedRef(PimObjId objId, PimObjId refId, uint64_t idxBegin, uint64_t idxEnd);
+  void recordCreateDualContactRef(PimObjId objId, PimObjId refId);
+  void recordCmd(std::unique_ptr<pimCmd> cmd);
+
+  void clearCmds();
+  uint64_t getNumCmds() const { return m_numCmds; }
+  bool replay(pimDevice* device, pimStatsMgr* statsMgr) const;
+
+private:
+  enum class pimStreamOp {
+    ALLOC,
+    ALLOC_ASSOCIATED,
+    ALLOC_BUFFER,
+    FREE,
+    CREATE_RANGED_REF,
+    CREATE_DUAL_CONTACT_REF,
+    CMD,
+  };
+
+  //! @class  pimCmdStream::entry
+  //! @brief  One resource operation or one executed PIM command
+  struct entry {
+    pimStreamOp m_op;
+    PimObjId m_objId = -1;
+    PimObjId m_refId = -1;  // associated or referenced object
+    PimAllocEnum m_allocType = PIM_ALLOC_AUTO;
+    PimDataType m_dataType = PIM_INT32;
+    uint64_t m_numElements = 0;
+    uint64_t m_idxBegin = 0;
+    uint64_t m_idxEnd = 0;
+    std::unique_ptr<pimCmd> m_cmd;
+  };
+
+  std::vector<entry> m_entries;
+  uint64_t m_numCmds = 0;
+};
+
+
+//! @class  pimSweep
+//! @brief  Replay a recorded command stream against multiple simulator configs in parallel
+//! Each config gets its own pimSimConfig, pimParamsDram, pimDevice with perf-energy model,
+//! and pimStatsMgr. Replaying devices run in analysis mode and never hold any element data.
+class pimSweep
+{
+public:
+  pimSweep(const pimCmdStream& cmdStream, const std::vector<std::string>& configFiles, unsigned numThreads);
+  ~pimSweep();
+
+  bool run();
+  void showResults(const pimStatsMgr& curStatsMgr, const pimSimConfig& curConfig) const;
+
+private:
+  //! @class  pimSweep::sweepResult
+  //! @brief  Replay states and results of one sweep config
+  struct sweepResult {
+    std::string m_configFile;
+    std::unique_ptr<pimSimConfig> m_config;
+    std::unique_ptr<pimParamsDram> m_paramsDram;
+    std::unique_ptr<pimDevice> m_device;
+    std::unique_ptr<pimStatsMgr> m_statsMgr;
+    bool m_isValid = false;
+  };
+
+  //! @class  pimSweep::sweepWorker
+  //! @brief  Thread worker to replay the command stream for one sweep config
+  class sweepWorker : public pimUtils::threadWorker {
+  public:
+    sweepWorker(const pimCmdStream& cmdStream, sweepResult& result) : m_cmdStream(cmdStream), m_result(result) {}
+    virtual ~sweepWorker() {}
+    virtual void execute();
+  private:
+    const pimCmdStream& m_cmdStream;
+    sweepResult& m_result;
+  };
+
+  bool createDevice(sweepResult& result) const;
+
+  const pimCmdStream& m_cmdStream;
+  std::vector<sweepResult> m_results;
+  unsigned m_numThreads = 1;
+};
+
+#endif
+
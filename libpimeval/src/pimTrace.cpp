@@ -0,0 +1,758 @@
+// File: pimTrace.cpp
+// PIMeval Simulator - PIM API Trace Capture and Replay
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "pimTrace.h"
+#include "pimSim.h"
+#include "pimDevice.h"
+#include "pimResMgr.h"
+#include <cstdio>            // for printf
+#include <cstring>           // for memcmp
+
+
+//! @brief  pimTraceWriter ctor - Create the trace file and write its header
+pimTraceWriter::pimTraceWriter(const std::string& filePath, bool withPayload)
+  : m_filePath(filePath),
+    m_file(filePath, std::ios::binary | std::ios::trunc),
+    m_withPayload(withPayload)
+{
+  if (!m_file.is_open()) {
+    std::printf("PIM-Error: Cannot open PIM trace file %s for writing\n", filePath.c_str());
+    return;
+  }
+  m_file.write(MAGIC, sizeof(MAGIC));
+  write(VERSION);
+  write(m_withPayload ? FLAG_PAYLOAD : 0u);
+  std::printf("PIM-Info: Recording PIM API trace to %s%s\n", filePath.c_str(), m_withPayload ? " with input payloads" : "");
+}
+
+//! @brief  pimTraceWriter dtor
+pimTraceWriter::~pimTraceWriter()
+{
+  if (m_file.is_open()) {
+    m_file.close();
+    std::printf("PIM-Info: Recorded %llu PIM API calls to %s\n", (unsigned long long)m_numRecords, m_filePath.c_str());
+  }
+}
+
+//! @brief  Write a string as length and characters
+void
+pimTraceWriter::write(const std::string& str)
+{
+  write(static_cast<uint64_t>(str.size()));
+  m_file.write(str.data(), str.size());
+}
+
+//! @brief  Write a host memory buffer as raw bytes or hash
+void
+pimTraceWriter::write(const pimTracePayload& payload)
+{
+  pimTracePayload::kind kind = pimTracePayload::kind::HASH;
+  if (!payload.m_ptr || payload.m_numBytes == 0) {
+    kind = pimTracePayload::kind::NONE;
+  } else if (payload.m_isInput && m_withPayload) {
+    kind = pimTracePayload::kind::DATA;
+  }
+  write(kind);
+  write(payload.m_numBytes);
+  if (kind == pimTracePayload::kind::HASH) {
+    write(hash(payload.m_ptr, payload.m_numBytes));
+  } else if (kind == pimTracePayload::kind::DATA) {
+    m_file.write(static_cast<const char*>(payload.m_ptr), payload.m_numBytes);
+  }
+}
+
+//! @brief  FNV-1a hash of a host memory buffer
+uint64_t
+pimTraceWriter::hash(const void* ptr, uint64_t numBytes)
+{
+  const uint8_t* bytes = static_cast<const uint8_t*>(ptr);
+  uint64_t val = 0xcbf29ce484222325ULL;
+  for (uint64_t i = 0; i < numBytes; ++i) {
+    val ^= bytes[i];
+    val *= 0x100000001b3ULL;
+  }
+  return val;
+}
+
+
+//! @brief  pimTraceReader ctor
+pimTraceReader::pimTraceReader(const std::string& filePath, PimDeviceEnum deviceType, const std::string& configFilePath)
+  : m_filePath(filePath),
+    m_file(filePath, std::ios::binary),
+    m_deviceType(deviceType),
+    m_configFilePath(configFilePath)
+{
+}
+
+//! @brief  Read and check trace file header
+bool
+pimTraceReader::readHeader()
+{
+  char magic[sizeof(pimTraceWriter::MAGIC)] = {};
+  m_file.read(magic, sizeof(magic));
+  uint32_t version = read<uint32_t>();
+  uint32_t flags = read<uint32_t>();
+  if (!m_file || std::memcmp(magic, pimTraceWriter::MAGIC, sizeof(magic)) != 0) {
+    std::printf("PIM-Error: %s is not a PIM trace file\n", m_filePath.c_str());
+    return false;
+  }
+  if (version != pimTraceWriter::VERSION) {
+    std::printf("PIM-Error: Unsupported PIM trace version %u in %s, expecting %u\n", version, m_filePath.c_str(), pimTraceWriter::VERSION);
+    return false;
+  }
+  m_hasPayload = (flags & pimTraceWriter::FLAG_PAYLOAD);
+  return true;
+}
+
+//! @brief  Read a string as length and characters
+std::string
+pimTraceReader::readString()
+{
+  uint64_t size = read<uint64_t>();
+  std::string str(size, '\0');
+  m_file.read(str.data(), size);
+  return str;
+}
+
+//! @brief  Read a byte vector as length and bytes
+std::vector<uint8_t>
+pimTraceReader::readBytes()
+{
+  uint64_t size = read<uint64_t>();
+  std::vector<uint8_t> bytes(size);
+  m_file.read(reinterpret_cast<char*>(bytes.data()), size);
+  return bytes;
+}
+
+//! @brief  Read a vector of (obj id, row offset) pairs used by analog micro-ops
+std::vector<std::pair<PimObjId, unsigned>>
+pimTraceReader::readRows()
+{
+  uint64_t size = read<uint64_t>();
+  std::vector<std::pair<PimObjId, unsigned>> rows;
+  for (uint64_t i = 0; i < size && m_file; ++i) {
+    PimObjId objId = readObjId();
+    unsigned ofst = read<unsigned>();
+    rows.emplace_back(objId, ofst);
+  }
+  return rows;
+}
+
+//! @brief  Read a traced object ID and map it to the object ID of the replay
+PimObjId
+pimTraceReader::readObjId()
+{
+  PimObjId tracedId = read<PimObjId>();
+  auto it = m_objIdMap.find(tracedId);
+  return it == m_objIdMap.end() ? tracedId : it->second;
+}
+
+//! @brief  Map a traced object ID to the object ID of the replay
+void
+pimTraceReader::mapObjId(PimObjId tracedId, PimObjId objId)
+{
+  if (tracedId != -1) {
+    m_objIdMap[tracedId] = objId;
+  }
+}
+
+//! @brief  Read a host memory buffer stored as raw bytes or hash
+pimTracePayload::kind
+pimTraceReader::readPayload(uint64_t& numBytes, uint64_t& hash, std::vector<uint8_t>& data)
+{
+  pimTracePayload::kind kind = read<pimTracePayload::kind>();
+  numBytes = read<uint64_t>();
+  hash = 0;
+  if (kind == pimTracePayload::kind::HASH) {
+    hash = read<uint64_t>();
+  } else if (kind == pimTracePayload::kind::DATA) {
+    data.resize(numBytes);
+    m_file.read(reinterpret_cast<char*>(data.data()), numBytes);
+  }
+  return kind;
+}
+
+//! @brief  Decode records between FUSE_BEGIN and FUSE_END into a fused PIM program
+std::function<bool()>
+pimTraceReader::decodeFuse()
+{
+  PimProg prog;
+  while (m_file) {
+    pimTraceOp op = read<pimTraceOp>();
+    if (!m_file || op == pimTraceOp::FUSE_END) {
+      break;
+    }
+    std::function<bool()> api = decode(op);
+    if (!api) {
+      return nullptr;
+    }
+    prog.m_apis.push_back([api]() { return api() ? PIM_OK : PIM_ERROR; });
+  }
+  return [prog]() { return pimSim::get()->pimFuse(prog); };
+}
+
+//! @brief  Decode one trace record into a callable PIM API invocation
+std::function<bool()>
+pimTraceReader::decode(pimTraceOp op)
+{
+  pimSim* sim = pimSim::get();
+
+  // Decoders for common API signatures
+  auto decodeObj = [&](bool (pimSim::*api)(PimObjId)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    return [=]() { return (sim->*api)(src); };
+  };
+  auto decodeFunc1 = [&](bool (pimSim::*api)(PimObjId, PimObjId)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    PimObjId dest = readObjId();
+    return [=]() { return (sim->*api)(src, dest); };
+  };
+  auto decodeFunc2 = [&](bool (pimSim::*api)(PimObjId, PimObjId, PimObjId)) -> std::function<bool()> {
+    PimObjId src1 = readObjId();
+    PimObjId src2 = readObjId();
+    PimObjId dest = readObjId();
+    return [=]() { return (sim->*api)(src1, src2, dest); };
+  };
+  auto decodeScalar = [&](bool (pimSim::*api)(PimObjId, PimObjId, uint64_t)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    PimObjId dest = readObjId();
+    uint64_t scalarValue = read<uint64_t>();
+    return [=]() { return (sim->*api)(src, dest, scalarValue); };
+  };
+  auto decodeObjIdx = [&](bool (pimSim::*api)(PimObjId, unsigned)) -> std::function<bool()> {
+    PimObjId objId = readObjId();
+    unsigned idx = read<unsigned>();
+    return [=]() { return (sim->*api)(objId, idx); };
+  };
+  auto decodeFuncIdx = [&](bool (pimSim::*api)(PimObjId, PimObjId, unsigned)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    PimObjId dest = readObjId();
+    unsigned idx = read<unsigned>();
+    return [=]() { return (sim->*api)(src, dest, idx); };
+  };
+  auto decodeMath = [&](bool (pimSim::*api)(PimObjId, PimObjId, PimMathPrecision, unsigned)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    PimObjId dest = readObjId();
+    PimMathPrecision precision = read<PimMathPrecision>();
+    unsigned numFracBits = read<unsigned>();
+    return [=]() { return (sim->*api)(src, dest, precision, numFracBits); };
+  };
+  auto decodeReduction = [&](bool (pimSim::*api)(PimObjId, void*, uint64_t, uint64_t)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    uint64_t idxBegin = read<uint64_t>();
+    uint64_t idxEnd = read<uint64_t>();
+    return [=]() {
+      uint64_t result = 0;
+      return (sim->*api)(src, &result, idxBegin, idxEnd);
+    };
+  };
+  auto decodeSegmented = [&](bool (pimSim::*api)(PimObjId, void*, uint64_t)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    uint64_t segmentLen = read<uint64_t>();
+    return [=]() {
+      // One result per segment of the object on the replaying device
+      pimResMgr* resMgr = sim->isValidDevice(false) ? sim->getDevice()->getResMgr() : nullptr;
+      uint64_t numElements = (resMgr && resMgr->isValidObjId(src)) ? resMgr->getObjInfo(src).getNumElements() : 0;
+      std::vector<uint64_t> results(segmentLen ? numElements / segmentLen + 1 : 1);
+      return (sim->*api)(src, results.data(), segmentLen);
+    };
+  };
+  auto decodeSegmentedByOffsets = [&](bool (pimSim::*api)(PimObjId, void*, const uint64_t*, uint64_t)) -> std::function<bool()> {
+    PimObjId src = readObjId();
+    std::vector<uint64_t> offsets = readVector<uint64_t>();
+    return [=]() {
+      uint64_t numSegments = offsets.empty() ? 0 : offsets.size() - 1;
+      std::vector<uint64_t> results(numSegments);
+      return (sim->*api)(src, results.data(), offsets.data(), numSegments);
+    };
+  };
+  auto decodeRReg1 = [&](bool (pimSim::*api)(PimObjId, PimRowReg, PimRowReg)) -> std::function<bool()> {
+    PimObjId objId = readObjId();
+    PimRowReg src = read<PimRowReg>();
+    PimRowReg dest = read<PimRowReg>();
+    return [=]() { return (sim->*api)(objId, src, dest); };
+  };
+  auto decodeRReg2 = [&](bool (pimSim::*api)(PimObjId, PimRowReg, PimRowReg, PimRowReg)) -> std::function<bool()> {
+    PimObjId objId = readObjId();
+    PimRowReg src1 = read<PimRowReg>();
+    PimRowReg src2 = read<PimRowReg>();
+    PimRowReg dest = read<PimRowReg>();
+    return [=]() { return (sim->*api)(objId, src1, src2, dest); };
+  };
+  auto decodeRReg3 = [&](bool (pimSim::*api)(PimObjId, PimRowReg, PimRowReg, PimRowReg, PimRowReg)) -> std::function<bool()> {
+    PimObjId objId = readObjId();
+    PimRowReg src1 = read<PimRowReg>();
+    PimRowReg src2 = read<PimRowReg>();
+    PimRowReg src3 = read<PimRowReg>();
+    PimRowReg dest = read<PimRowReg>();
+    return [=]() { return (sim->*api)(objId, src1, src2, src3, dest); };
+  };
+  auto decodeCopyH2D = [&](bool withType) -> std::function<bool()> {
+    PimCopyEnum copyType = withType ? read<PimCopyEnum>() : PIM_COPY_V;
+    PimObjId dest = readObjId();
+    uint64_t idxBegin = read<uint64_t>();
+    uint64_t idxEnd = read<uint64_t>();
+    uint64_t numBytes = 0;
+    uint64_t hash = 0;
+    std::vector<uint8_t> data;
+    if (readPayload(numBytes, hash, data) != pimTracePayload::kind::DATA) {
+      data.resize(numBytes);
+    }
+    return [=]() mutable {
+      if (withType) {
+        return sim->pimCopyMainToDeviceWithType(copyType, data.data(), dest, idxBegin, idxEnd);
+      }
+      return sim->pimCopyMainToDevice(data.data(), dest, idxBegin, idxEnd);
+    };
+  };
+  auto decodeCopyD2H = [&](bool withType) -> std::function<bool()> {
+    PimCopyEnum copyType = withType ? read<PimCopyEnum>() : PIM_COPY_V;
+    PimObjId src = readObjId();
+    uint64_t idxBegin = read<uint64_t>();
+    uint64_t idxEnd = read<uint64_t>();
+    uint64_t numBytes = 0;
+    uint64_t hash = 0;
+    std::vector<uint8_t> data;
+    pimTracePayload::kind kind = readPayload(numBytes, hash, data);
+    return [=]() {
+      std::vector<uint8_t> buffer(numBytes);
+      bool ok = withType ? sim->pimCopyDeviceToMainWithType(copyType, src, buffer.data(), idxBegin, idxEnd)
+                         : sim->pimCopyDeviceToMain(src, buffer.data(), idxBegin, idxEnd);
+      // Outputs are only reproducible when the trace carries all input data
+      if (ok && m_hasPayload && kind == pimTracePayload::kind::HASH && !sim->isAnalysisMode()
+          && pimTraceWriter::hash(buffer.data(), numBytes) != hash) {
+        std::printf("PIM-Warning: Replayed data copied from PIM object %d does not match the trace\n", src);
+        m_numMismatches++;
+      }
+      return ok;
+    };
+  };
+
+  switch (op) {
+  case pimTraceOp::CREATE_DEVICE:
+  {
+    PimDeviceEnum deviceType = read<PimDeviceEnum>();
+    unsigned numRanks = read<unsigned>();
+    unsigned numBankPerRank = read<unsigned>();
+    unsigned numSubarrayPerBank = read<unsigned>();
+    unsigned numRows = read<unsigned>();
+    unsigned numCols = read<unsigned>();
+    unsigned bufferSize = read<unsigned>();
+    if (m_deviceType != PIM_DEVICE_NONE) {
+      deviceType = m_deviceType;
+    }
+    if (!m_configFilePath.empty()) {
+      return [=]() { return sim->createDeviceFromConfig(deviceType, m_configFilePath.c_str()); };
+    }
+    return [=]() { return sim->createDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols, bufferSize); };
+  }
+  case pimTraceOp::CREATE_DEVICE_FROM_CONFIG:
+  {
+    PimDeviceEnum deviceType = read<PimDeviceEnum>();
+    std::string configFilePath = readString();
+    if (m_deviceType != PIM_DEVICE_NONE) {
+      deviceType = m_deviceType;
+    }
+    if (!m_configFilePath.empty()) {
+      configFilePath = m_configFilePath;
+    }
+    return [=]() { return sim->createDeviceFromConfig(deviceType, configFilePath.c_str()); };
+  }
+  case pimTraceOp::DELETE_DEVICE: return [=]() { m_objIdMap.clear(); return sim->deleteDevice(); };
+  case pimTraceOp::SET_DEVICE:
+  {
+    PimDeviceId deviceId = read<PimDeviceId>();
+    return [=]() { return sim->setDevice(deviceId); };
+  }
+  case pimTraceOp::START_TIMER: return [=]() { sim->startKernelTimer(); return true; };
+  case pimTraceOp::END_TIMER: return [=]() { sim->endKernelTimer(); return true; };
+  case pimTraceOp::SHOW_STATS: return [=]() { sim->showStats(); return true; };
+  case pimTraceOp::RESET_STATS: return [=]() { sim->resetStats(); return true; };
+  case pimTraceOp::ALLOC:
+  {
+    PimAllocEnum allocType = read<PimAllocEnum>();
+    uint64_t numElements = read<uint64_t>();
+    PimDataType dataType = read<PimDataType>();
+    PimObjId tracedId = read<PimObjId>();
+    return [=]() {
+      PimObjId objId = sim->pimAlloc(allocType, numElements, dataType);
+      mapObjId(tracedId, objId);
+      return objId != -1;
+    };
+  }
+  case pimTraceOp::ALLOC_ASSOCIATED:
+  {
+    PimObjId assocId = readObjId();
+    PimDataType dataType = read<PimDataType>();
+    PimObjId tracedId = read<PimObjId>();
+    return [=]() {
+      PimObjId objId = sim->pimAllocAssociated(assocId, dataType);
+      mapObjId(tracedId, objId);
+      return objId != -1;
+    };
+  }
+  case pimTraceOp::ALLOC_BUFFER:
+  {
+    uint32_t numElements = read<uint32_t>();
+    PimDataType dataType = read<PimDataType>();
+    PimObjId tracedId = read<PimObjId>();
+    return [=]() {
+      PimObjId objId = sim->pimAllocBuffer(numElements, dataType);
+      mapObjId(tracedId, objId);
+      return objId != -1;
+    };
+  }
+  case pimTraceOp::FREE: return decodeObj(&pimSim::pimFree);
+  case pimTraceOp::CREATE_RANGED_REF:
+  {
+    PimObjId refId = readObjId();
+    uint64_t idxBegin = read<uint64_t>();
+    uint64_t idxEnd = read<uint64_t>();
+    PimObjId tracedId = read<PimObjId>();
+    return [=]() {
+      PimObjId objId = sim->pimCreateRangedRef(refId, idxBegin, idxEnd);
+      mapObjId(tracedId, objId);
+      return objId != -1;
+    };
+  }
+  case pimTraceOp::CREATE_DUAL_CONTACT_REF:
+  {
+    PimObjId refId = readObjId();
+    PimObjId tracedId = read<PimObjId>();
+    return [=]() {
+      PimObjId objId = sim->pimCreateDualContactRef(refId);
+      mapObjId(tracedId, objId);
+      return objId != -1;
+    };
+  }
+  case pimTraceOp::COPY_H2D: return decodeCopyH2D(false);
+  case pimTraceOp::COPY_D2H: return decodeCopyD2H(false);
+  case pimTraceOp::COPY_H2D_WITH_TYPE: return decodeCopyH2D(true);
+  case pimTraceOp::COPY_D2H_WITH_TYPE: return decodeCopyD2H(true);
+  case pimTraceOp::COPY_D2D:
+  {
+    PimObjId src = readObjId();
+    PimObjId dest = readObjId();
+    uint64_t idxBegin = read<uint64_t>();
+    uint64_t idxEnd = read<uint64_t>();
+    return [=]() { return sim->pimCopyDeviceToDevice(src, dest, idxBegin, idxEnd); };
+  }
+  case pimTraceOp::COPY_INTER_DEVICE:
+  {
+    PimDeviceId srcDeviceId = read<PimDeviceId>();
+    PimObjId src = readObjId();
+    PimDeviceId destDeviceId = read<PimDeviceId>();
+    PimObjId dest = readObjId();
+    uint64_t idxBegin = read<uint64_t>();
+    uint64_t idxEnd = read<uint64_t>();
+    return [=]() { return sim->pimCopyInterDevice(srcDeviceId, src, destDeviceId, dest, idxBegin, idxEnd); };
+  }
+  case pimTraceOp::COPY_O2O: return decodeFunc1(&pimSim::pimCopyObjectToObject);
+  case pimTraceOp::CONVERT_TYPE: return decodeFunc1(&pimSim::pimConvertType);
+  case pimTraceOp::BROADCAST_INT:
+  {
+    PimObjId dest = readObjId();
+    int64_t value = read<int64_t>();
+    return [=]() { return sim->pimBroadcast(dest, value); };
+  }
+  case pimTraceOp::BROADCAST_UINT:
+  {
+    PimObjId dest = readObjId();
+    uint64_t value = read<uint64_t>();
+    return [=]() { return sim->pimBroadcast(dest, value); };
+  }
+  case pimTraceOp::BROADCAST_FP:
+  {
+    PimObjId dest = readObjId();
+    float value = read<float>();
+    return [=]() { return sim->pimBroadcast(dest, value); };
+  }
+  case pimTraceOp::ADD: return decodeFunc2(&pimSim::pimAdd);
+  case pimTraceOp::SUB: return decodeFunc2(&pimSim::pimSub);
+  case pimTraceOp::MUL: return decodeFunc2(&pimSim::pimMul);
+  case pimTraceOp::DIV: return decodeFunc2(&pimSim::pimDiv);
+  case pimTraceOp::ABS: return decodeFunc1(&pimSim::pimAbs);
+  case pimTraceOp::NOT: return decodeFunc1(&pimSim::pimNot);
+  case pimTraceOp::AND: return decodeFunc2(&pimSim::pimAnd);
+  case pimTraceOp::OR: return decodeFunc2(&pimSim::pimOr);
+  case pimTraceOp::XOR: return decodeFunc2(&pimSim::pimXor);
+  case pimTraceOp::XNOR: return decodeFunc2(&pimSim::pimXnor);
+  case pimTraceOp::GT: return decodeFunc2(&pimSim::pimGT);
+  case pimTraceOp::LT: return decodeFunc2(&pimSim::pimLT);
+  case pimTraceOp::EQ: return decodeFunc2(&pimSim::pimEQ);
+  case pimTraceOp::NE: return decodeFunc2(&pimSim::pimNE);
+  case pimTraceOp::MIN: return decodeFunc2(&pimSim::pimMin);
+  case pimTraceOp::MAX: return decodeFunc2(&pimSim::pimMax);
+  case pimTraceOp::ADD_SCALAR: return decodeScalar(&pimSim::pimAdd);
+  case pimTraceOp::SUB_SCALAR: return decodeScalar(&pimSim::pimSub);
+  case pimTraceOp::MUL_SCALAR: return decodeScalar(&pimSim::pimMul);
+  case pimTraceOp::DIV_SCALAR: return decodeScalar(&pimSim::pimDiv);
+  case pimTraceOp::AND_SCALAR: return decodeScalar(&pimSim::pimAnd);
+  case pimTraceOp::OR_SCALAR: return decodeScalar(&pimSim::pimOr);
+  case pimTraceOp::XOR_SCALAR: return decodeScalar(&pimSim::pimXor);
+  case pimTraceOp::XNOR_SCALAR: return decodeScalar(&pimSim::pimXnor);
+  case pimTraceOp::GT_SCALAR: return decodeScalar(&pimSim::pimGT);
+  case pimTraceOp::LT_SCALAR: return decodeScalar(&pimSim::pimLT);
+  case pimTraceOp::EQ_SCALAR: return decodeScalar(&pimSim::pimEQ);
+  case pimTraceOp::NE_SCALAR: return decodeScalar(&pimSim::pimNE);
+  case pimTraceOp::MIN_SCALAR: return decodeScalar(&pimSim::pimMin);
+  case pimTraceOp::MAX_SCALAR: return decodeScalar(&pimSim::pimMax);
+  case pimTraceOp::SCALED_ADD:
+  {
+    PimObjId src1 = readObjId();
+    PimObjId src2 = readObjId();
+    PimObjId dest = readObjId();
+    uint64_t scalarValue = read<uint64_t>();
+    return [=]() { return sim->pimScaledAdd(src1, src2, dest, scalarValue); };
+  }
+  case pimTraceOp::POPCOUNT: return decodeFunc1(&pimSim::pimPopCount);
+  case pimTraceOp::EXP: return decodeMath(&pimSim::pimExp);
+  case pimTraceOp::LOG: return decodeMath(&pimSim::pimLog);
+  case pimTraceOp::SQRT: return decodeMath(&pimSim::pimSqrt);
+  case pimTraceOp::RECIP: return decodeMath(&pimSim::pimRecip);
+  case pimTraceOp::SIGMOID: return decodeMath(&pimSim::pimSigmoid);
+  case pimTraceOp::TANH: return decodeMath(&pimSim::pimTanh);
+  case pimTraceOp::PREFIX_SUM: return decodeFunc1(&pimSim::pimPrefixSum);
+  case pimTraceOp::MAC:
+  {
+    PimObjId src1 = readObjId();
+    PimObjId src2 = readObjId();
+    return [=]() {
+      // One accumulator per PIM core of the replaying device
+      std::vector<uint64_t> result(sim->getNumCores());
+      return sim->pimMAC(src1, src2, result.data());
+    };
+  }
+  case pimTraceOp::REDSUM: return decodeReduction(&pimSim::pimRedSum);
+  case pimTraceOp::REDMIN: return decodeReduction(&pimSim::pimRedMin);
+  case pimTraceOp::REDMAX: return decodeReduction(&pimSim::pimRedMax);
+  case pimTraceOp::REDSUM_SEGMENTED: return decodeSegmented(&pimSim::pimRedSumSegmented);
+  case pimTraceOp::REDMIN_SEGMENTED: return decodeSegmented(&pimSim::pimRedMinSegmented);
+  case pimTraceOp::REDMAX_SEGMENTED: return decodeSegmented(&pimSim::pimRedMaxSegmented);
+  case pimTraceOp::REDSUM_SEGMENTED_BY_OFFSETS: return decodeSegmentedByOffsets(&pimSim::pimRedSumSegmentedByOffsets);
+  case pimTraceOp::REDMIN_SEGMENTED_BY_OFFSETS: return decodeSegmentedByOffsets(&pimSim::pimRedMinSegmentedByOffsets);
+  case pimTraceOp::REDMAX_SEGMENTED_BY_OFFSETS: return decodeSegmentedByOffsets(&pimSim::pimRedMaxSegmentedByOffsets);
+  case pimTraceOp::RED_BATCHED:
+  {
+    uint64_t numObjs = read<uint64_t>();
+    std::vector<PimObjId> srcs;
+    for (uint64_t i = 0; i < numObjs && m_file; ++i) {
+      srcs.push_back(readObjId());
+    }
+    std::vector<PimReductionEnum> ops = readVector<PimReductionEnum>();
+    uint64_t idxBegin = read<uint64_t>();
+    uint64_t idxEnd = read<uint64_t>();
+    return [=]() {
+      std::vector<uint64_t> results(srcs.size());
+      std::vector<void*> resultPtrs;
+      for (auto& result : results) {
+        resultPtrs.push_back(&result);
+      }
+      return sim->pimRedBatched(srcs.data(), ops.data(), resultPtrs.data(), srcs.size(), idxBegin, idxEnd);
+    };
+  }
+  case pimTraceOp::GEMV:
+  case pimTraceOp::GEMM:
+  {
+    PimObjId mat = readObjId();
+    PimObjId dest = readObjId();
+    uint64_t numColsB = (op == pimTraceOp::GEMM ? read<uint64_t>() : 1);
+    uint64_t numBytes = 0;
+    uint64_t hash = 0;
+    std::vector<uint8_t> data;
+    if (readPayload(numBytes, hash, data) != pimTracePayload::kind::DATA) {
+      data.resize(numBytes);
+    }
+    return [=]() {
+      if (op == pimTraceOp::GEMM) {
+        return sim->pimGemm(mat, data.data(), dest, numColsB);
+      }
+      return sim->pimGemv(mat, data.data(), dest);
+    };
+  }
+  case pimTraceOp::AND_POPCOUNT_BATCHED:
+  {
+    PimObjId bitmaps = readObjId();
+    uint64_t numWordsPerRow = read<uint64_t>();
+    std::vector<uint64_t> rowsA = readVector<uint64_t>();
+    std::vector<uint64_t> rowsB = readVector<uint64_t>();
+    return [=]() {
+      std::vector<uint64_t> counts(rowsA.size());
+      return sim->pimAndPopCountBatched(bitmaps, numWordsPerRow, rowsA.data(), rowsB.data(), rowsA.size(), counts.data());
+    };
+  }
+  case pimTraceOp::GATHER: return decodeFunc2(&pimSim::pimGather);
+  case pimTraceOp::SCATTER: return decodeFunc2(&pimSim::pimScatter);
+  case pimTraceOp::SCATTER_ADD: return decodeFunc2(&pimSim::pimScatterAdd);
+  case pimTraceOp::COMPACT:
+  {
+    PimObjId src = readObjId();
+    PimObjId cond = readObjId();
+    PimObjId dest = readObjId();
+    return [=]() {
+      uint64_t count = 0;
+      return sim->pimCompact(src, cond, dest, &count);
+    };
+  }
+  case pimTraceOp::TOPK:
+  {
+    PimObjId src = readObjId();
+    uint64_t k = read<uint64_t>();
+    bool isSmallest = read<bool>();
+    return [=]() {
+      std::vector<uint64_t> indices(k);
+      return sim->pimTopK(src, k, nullptr, indices.data(), isSmallest);
+    };
+  }
+  case pimTraceOp::BIT_SLICE_EXTRACT: return decodeFuncIdx(&pimSim::pimBitSliceExtract);
+  case pimTraceOp::BIT_SLICE_INSERT: return decodeFuncIdx(&pimSim::pimBitSliceInsert);
+  case pimTraceOp::COND_COPY: return decodeFunc2(&pimSim::pimCondCopy);
+  case pimTraceOp::COND_BROADCAST:
+  {
+    PimObjId condBool = readObjId();
+    uint64_t scalarBits = read<uint64_t>();
+    PimObjId dest = readObjId();
+    return [=]() { return sim->pimCondBroadcast(condBool, scalarBits, dest); };
+  }
+  case pimTraceOp::COND_SELECT:
+  {
+    PimObjId condBool = readObjId();
+    PimObjId src1 = readObjId();
+    PimObjId src2 = readObjId();
+    PimObjId dest = readObjId();
+    return [=]() { return sim->pimCondSelect(condBool, src1, src2, dest); };
+  }
+  case pimTraceOp::COND_SELECT_SCALAR:
+  {
+    PimObjId condBool = readObjId();
+    PimObjId src1 = readObjId();
+    uint64_t scalarBits = read<uint64_t>();
+    PimObjId dest = readObjId();
+    return [=]() { return sim->pimCondSelectScalar(condBool, src1, scalarBits, dest); };
+  }
+  case pimTraceOp::ROTATE_ELEM_R: return decodeObj(&pimSim::pimRotateElementsRight);
+  case pimTraceOp::ROTATE_ELEM_L: return decodeObj(&pimSim::pimRotateElementsLeft);
+  case pimTraceOp::SHIFT_ELEM_R: return decodeObj(&pimSim::pimShiftElementsRight);
+  case pimTraceOp::SHIFT_ELEM_L: return decodeObj(&pimSim::pimShiftElementsLeft);
+  case pimTraceOp::SHIFT_BITS_R: return decodeFuncIdx(&pimSim::pimShiftBitsRight);
+  case pimTraceOp::SHIFT_BITS_L: return decodeFuncIdx(&pimSim::pimShiftBitsLeft);
+  case pimTraceOp::AES_SBOX:
+  case pimTraceOp::AES_INVERSE_SBOX:
+  {
+    PimObjId src = readObjId();
+    PimObjId dest = readObjId();
+    std::vector<uint8_t> lut = readBytes();
+    if (op == pimTraceOp::AES_SBOX) {
+      return [=]() { return sim->pimAesSbox(src, dest, lut); };
+    }
+    return [=]() { return sim->pimAesInverseSbox(src, dest, lut); };
+  }
+  case pimTraceOp::FUSE_BEGIN: return decodeFuse();
+  case pimTraceOp::OP_READ_ROW_TO_SA: return decodeObjIdx(&pimSim::pimOpReadRowToSa);
+  case pimTraceOp::OP_WRITE_SA_TO_ROW: return decodeObjIdx(&pimSim::pimOpWriteSaToRow);
+  case pimTraceOp::OP_TRA:
+  {
+    PimObjId src1 = readObjId();
+    unsigned ofst1 = read<unsigned>();
+    PimObjId src2 = readObjId();
+    unsigned ofst2 = read<unsigned>();
+    PimObjId src3 = readObjId();
+    unsigned ofst3 = read<unsigned>();
+    return [=]() { return sim->pimOpTRA(src1, ofst1, src2, ofst2, src3, ofst3); };
+  }
+  case pimTraceOp::OP_MOVE: return decodeRReg1(&pimSim::pimOpMove);
+  case pimTraceOp::OP_SET:
+  {
+    PimObjId objId = readObjId();
+    PimRowReg dest = read<PimRowReg>();
+    bool val = read<bool>();
+    return [=]() { return sim->pimOpSet(objId, dest, val); };
+  }
+  case pimTraceOp::OP_NOT: return decodeRReg1(&pimSim::pimOpNot);
+  case pimTraceOp::OP_AND: return decodeRReg2(&pimSim::pimOpAnd);
+  case pimTraceOp::OP_OR: return decodeRReg2(&pimSim::pimOpOr);
+  case pimTraceOp::OP_NAND: return decodeRReg2(&pimSim::pimOpNand);
+  case pimTraceOp::OP_NOR: return decodeRReg2(&pimSim::pimOpNor);
+  case pimTraceOp::OP_XOR: return decodeRReg2(&pimSim::pimOpXor);
+  case pimTraceOp::OP_XNOR: return decodeRReg2(&pimSim::pimOpXnor);
+  case pimTraceOp::OP_MAJ: return decodeRReg3(&pimSim::pimOpMaj);
+  case pimTraceOp::OP_SEL: return decodeRReg3(&pimSim::pimOpSel);
+  case pimTraceOp::OP_ROTATE_RH:
+  {
+    PimObjId objId = readObjId();
+    PimRowReg src = read<PimRowReg>();
+    return [=]() { return sim->pimOpRotateRH(objId, src); };
+  }
+  case pimTraceOp::OP_ROTATE_LH:
+  {
+    PimObjId objId = readObjId();
+    PimRowReg src = read<PimRowReg>();
+    return [=]() { return sim->pimOpRotateLH(objId, src); };
+  }
+  case pimTraceOp::OP_AP:
+  {
+    std::vector<std::pair<PimObjId, unsigned>> srcRows = readRows();
+    return [=]() { return sim->pimOpAP(srcRows); };
+  }
+  case pimTraceOp::OP_AAP:
+  {
+    std::vector<std::pair<PimObjId, unsigned>> srcRows = readRows();
+    std::vector<std::pair<PimObjId, unsigned>> destRows = readRows();
+    return [=]() { return sim->pimOpAAP(srcRows, destRows); };
+  }
+  case pimTraceOp::OP_APP_GND: return decodeObjIdx(&pimSim::pimOPAPP_GND);
+  case pimTraceOp::OP_APP_VDD: return decodeObjIdx(&pimSim::pimOPAPP_VDD);
+  case pimTraceOp::OP_APP_AP: return decodeObjIdx(&pimSim::pimOPAPP_AP);
+  case pimTraceOp::OP_COL_GRP_SHIFT_R: return decodeObjIdx(&pimSim::pimOpColGrpShiftR);
+  case pimTraceOp::OP_COL_GRP_SHIFT_L: return decodeObjIdx(&pimSim::pimOpColGrpShiftL);
+  default:
+    std::printf("PIM-Error: Unknown PIM trace record type %u\n", static_cast<unsigned>(op));
+  }
+  return nullptr;
+}
+
+//! @brief  Replay all records of a trace file
+bool
+pimTraceReader::replay()
+{
+  if (!m_file.is_open()) {
+    std::printf("PIM-Error: Cannot open PIM trace file %s\n", m_filePath.c_str());
+    return false;
+  }
+  if (!readHeader()) {
+    return false;
+  }
+  std::printf("PIM-Info: Replaying PIM API trace %s\n", m_filePath.c_str());
+  if (!m_hasPayload) {
+    std::printf("PIM-Info: PIM trace has no input payloads. Replaying in analysis mode.\n");
+  }
+
+  pimSim* sim = pimSim::get();
+  sim->setTraceReplayMode(true, !m_hasPayload);
+  bool success = true;
+  while (true) {
+    pimTraceOp op = read<pimTraceOp>();
+    if (!m_file) {
+      break;
+    }
+    std::function<bool()> api = decode(op);
+    if (!api || !m_file) {
+      std::printf("PIM-Error: Corrupted PIM trace record %llu in %s\n", (unsigned long long)m_numRecords, m_filePath.c_str());
+      success = false;
+      break;
+    }
+    if (!api()) {
+      m_numFailedCalls++;
+    }
+    m_numRecords++;
+  }
+  sim->setTraceReplayMode(false, false);
+
+  std::printf("PIM-Info: Replayed %llu PIM API calls: %llu failed, %llu output mismatches\n",
+              (unsigned long long)m_numRecords, (unsigned long long)m_numFailedCalls, (unsigned long long)m_numMismatches);
+  return success && m_numMismatches == 0;
+}
+
@@ -0,0 +1,284 @@
+// File: pimTrace.h
+// PIMeval Simulator - PIM API Trace Capture and Replay
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#ifndef LAVA_PIM_TRACE_H
+#define LAVA_PIM_TRACE_H
+
+#include "libpimeval.h"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+//! @brief  PIM API trace record types
+//! Note: Append new values at the end and bump pimTraceWriter::VERSION when changing record layouts
+enum class pimTraceOp : uint16_t {
+  // device and stats
+  CREATE_DEVICE = 1,
+  CREATE_DEVICE_FROM_CONFIG,
+  DELETE_DEVICE,
+  START_TIMER,
+  END_TIMER,
+  SHOW_STATS,
+  RESET_STATS,
+  // resource
+  ALLOC,
+  ALLOC_ASSOCIATED,
+  ALLOC_BUFFER,
+  FREE,
+  CREATE_RANGED_REF,
+  CREATE_DUAL_CONTACT_REF,
+  // data copy
+  COPY_H2D,
+  COPY_D2H,
+  COPY_H2D_WITH_TYPE,
+  COPY_D2H_WITH_TYPE,
+  COPY_D2D,
+  COPY_O2O,
+  CONVERT_TYPE,
+  // compute
+  BROADCAST_INT,
+  BROADCAST_UINT,
+  BROADCAST_FP,
+  ADD,
+  SUB,
+  MUL,
+  DIV,
+  ABS,
+  NOT,
+  AND,
+  OR,
+  XOR,
+  XNOR,
+  GT,
+  LT,
+  EQ,
+  NE,
+  MIN,
+  MAX,
+  ADD_SCALAR,
+  SUB_SCALAR,
+  MUL_SCALAR,
+  DIV_SCALAR,
+  AND_SCALAR,
+  OR_SCALAR,
+  XOR_SCALAR,
+  XNOR_SCALAR,
+  GT_SCALAR,
+  LT_SCALAR,
+  EQ_SCALAR,
+  NE_SCALAR,
+  MIN_SCALAR,
+  MAX_SCALAR,
+  SCALED_ADD,
+  POPCOUNT,
+  PREFIX_SUM,
+  MAC,
+  REDSUM,
+  REDMIN,
+  REDMAX,
+  BIT_SLICE_EXTRACT,
+  BIT_SLICE_INSERT,
+  COND_COPY,
+  COND_BROADCAST,
+  COND_SELECT,
+  COND_SELECT_SCALAR,
+  ROTATE_ELEM_R,
+  ROTATE_ELEM_L,
+  SHIFT_ELEM_R,
+  SHIFT_ELEM_L,
+  SHIFT_BITS_R,
+  SHIFT_BITS_L,
+  AES_SBOX,
+  AES_INVERSE_SBOX,
+  FUSE_BEGIN,
+  FUSE_END,
+  // micro-ops
+  OP_READ_ROW_TO_SA,
+  OP_WRITE_SA_TO_ROW,
+  OP_TRA,
+  OP_MOVE,
+  OP_SET,
+  OP_NOT,
+  OP_AND,
+  OP_OR,
+  OP_NAND,
+  OP_NOR,
+  OP_XOR,
+  OP_XNOR,
+  OP_MAJ,
+  OP_SEL,
+  OP_ROTATE_RH,
+  OP_ROTATE_LH,
+  OP_AP,
+  OP_AAP,
+  OP_APP_GND,
+  OP_APP_VDD,
+  OP_APP_AP,
+  OP_COL_GRP_SHIFT_R,
+  OP_COL_GRP_SHIFT_L,
+  // multiple devices
+  SET_DEVICE,
+  COPY_INTER_DEVICE,
+  // segmented reductions
+  REDSUM_SEGMENTED,
+  REDMIN_SEGMENTED,
+  REDMAX_SEGMENTED,
+  REDSUM_SEGMENTED_BY_OFFSETS,
+  REDMIN_SEGMENTED_BY_OFFSETS,
+  REDMAX_SEGMENTED_BY_OFFSETS,
+  RED_BATCHED,
+  // matrix multiplication
+  GEMV,
+  GEMM,
+  // graph
+  AND_POPCOUNT_BATCHED,
+  // indexed access
+  GATHER,
+  SCATTER,
+  SCATTER_ADD,
+  COMPACT,
+  TOPK,
+  // math
+  EXP,
+  LOG,
+  SQRT,
+  RECIP,
+  SIGMOID,
+  TANH,
+};
+
+//! @class  pimTracePayload
+//! @brief  Host memory buffer attached to a data copy record
+//! Input buffers are stored as raw bytes if payload capture is enabled, otherwise only their hash is stored.
+//! Output buffers are always stored as hash, which is used for validating replay results.
+struct pimTracePayload
+{
+  enum class kind : uint8_t {
+    NONE = 0,
+    HASH,
+    DATA,
+  };
+  const void* m_ptr = nullptr;
+  uint64_t m_numBytes = 0;
+  bool m_isInput = true;
+};
+
+
+//! @class  pimTraceWriter
+//! @brief  Serialize PIM API calls into a compact binary trace file
+//!
+//! Trace file layout (host byte order):
+//!   header : "PIMTRACE" magic, uint32 version, uint32 flags
+//!   records: uint16 pimTraceOp, followed by API parameters in calling order
+//!            - integers, enums and floats are stored as raw values
+//!            - strings and vectors are stored as uint64 length followed by elements
+//!            - payloads are stored as uint8 kind, uint64 number of bytes, then uint64 hash or raw bytes
+//! Object IDs returned by allocation APIs are recorded as the last parameter, so that a replay can map
+//! recorded object IDs to new ones.
+class pimTraceWriter
+{
+public:
+  pimTraceWriter(const std::string& filePath, bool withPayload);
+  ~pimTraceWriter();
+
+  bool isValid() const { return m_file.good(); }
+  const std::string& getFilePath() const { return m_filePath; }
+  uint64_t getNumRecords() const { return m_numRecords; }
+
+  template <typename... Args> void record(pimTraceOp op, const Args&... args) {
+    write(op);
+    (write(args), ...);
+    m_numRecords++;
+  }
+  void flush() { m_file.flush(); }
+
+  static uint64_t hash(const void* ptr, uint64_t numBytes);
+
+  inline static const char MAGIC[8] = {'P', 'I', 'M', 'T', 'R', 'A', 'C', 'E'};
+  static constexpr uint32_t VERSION = 1;
+  static constexpr uint32_t FLAG_PAYLOAD = 0x1;
+
+private:
+  template <typename T> void write(const T& val) {
+    static_assert(std::is_trivially_copyable_v<T>, "PIM trace parameters must be trivially copyable");
+    m_file.write(reinterpret_cast<const char*>(&val), sizeof(T));
+  }
+  template <typename T1, typename T2> void write(const std::pair<T1, T2>& val) {
+    write(val.first);
+    write(val.second);
+  }
+  template <typename T> void write(const std::vector<T>& vec) {
+    write(static_cast<uint64_t>(vec.size()));
+    for (const auto& val : vec) {
+      write(val);
+    }
+  }
+  void write(const std::string& str);
+  void write(const pimTracePayload& payload);
+
+  std::string m_filePath;
+  std::ofstream m_file;
+  bool m_withPayload = false;
+  uint64_t m_numRecords = 0;
+};
+
+
+//! @class  pimTraceReader
+//! @brief  Replay a binary PIM API trace against the current PIMeval library
+//! Device creation can be redirected to a different device type or simulator config file.
+//! Traces without input payloads are replayed in analysis mode, as there is no data to compute on.
+class pimTraceReader
+{
+public:
+  pimTraceReader(const std::string& filePath, PimDeviceEnum deviceType, const std::string& configFilePath);
+  ~pimTraceReader() {}
+
+  bool replay();
+
+private:
+  bool readHeader();
+  std::function<bool()> decode(pimTraceOp op);
+  std::function<bool()> decodeFuse();
+
+  template <typename T> T read() {
+    T val{};
+    m_file.read(reinterpret_cast<char*>(&val), sizeof(T));
+    return val;
+  }
+  template <typename T> std::vector<T> readVector() {
+    uint64_t size = read<uint64_t>();
+    std::vector<T> vec;
+    for (uint64_t i = 0; i < size && m_file; ++i) {
+      vec.push_back(read<T>());
+    }
+    return vec;
+  }
+  std::string readString();
+  std::vector<uint8_t> readBytes();
+  std::vector<std::pair<PimObjId, unsigned>> readRows();
+  PimObjId readObjId();
+  void mapObjId(PimObjId tracedId, PimObjId objId);
+  pimTracePayload::kind readPayload(uint64_t& numBytes, uint64_t& hash, std::vector<uint8_t>& data);
+
+  std::string m_filePath;
+  std::ifstream m_file;
+  PimDeviceEnum m_deviceType = PIM_DEVICE_NONE;
+  std::string m_configFilePath;
+  bool m_hasPayload = false;
+  std::unordered_map<PimObjId, PimObjId> m_objIdMap;
+  uint64_t m_numRecords = 0;
+  uint64_t m_numFailedCalls = 0;
+  uint64_t m_numMismatches = 0;
+};
+
+#endif
+
@@ -15,6 +15,12 @@
 #include <cstdlib>
 #include <cassert>
 #include <stdexcept>
+#include <cmath>
+#include <limits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PIM_FP16_F16C_DISPATCH
+#endif
 
 
 //! @brief  Convert PimStatus enum to string
@@ -91,6 +97,10 @@ pimUtils::pimDataTypeEnumToStr(PimDataType dataType)
   case PIM_FP16: return "fp16";
   case PIM_BF16: return "bf16";
   case PIM_FP8: return "fp8";
+  case PIM_INT4: return "int4";
+  case PIM_UINT4: return "uint4";
+  case PIM_INT2: return "int2";
+  case PIM_UINT2: return "uint2";
   }
   return "Unknown";
 }
@@ -99,7 +109,8 @@ namespace pimUtils {
   //! @brief  Static definitions of bits of data types (see PimBitWidth)
   //! Notes:
   //! - BOOL: PIMeval requires host data to store one bool value per byte
-  //! - FP16/BF16/FP8: PIMeval uses FP32 for functional simulation
+  //! - FP16/BF16/FP8: PIMeval stores data packed at actual width, and uses FP32 for functional simulation
+  //! - INT4/UINT4/INT2/UINT2: PIMeval requires host data to store one value per byte, and stores data packed at actual width
   static const std::unordered_map<PimDataType, std::unordered_map<PimBitWidth, unsigned>> s_bitsOfDataType = {
     { PIM_BOOL, {{PimBitWidth::ACTUAL, 1}, {PimBitWidth::SIM, 1}, {PimBitWidth::HOST, 8}} },
     { PIM_INT8, {{PimBitWidth::ACTUAL, 8}, {PimBitWidth::SIM, 8}, {PimBitWidth::HOST, 8}} },
@@ -114,6 +125,10 @@ namespace pimUtils {
     { PIM_FP16, {{PimBitWidth::ACTUAL, 16}, {PimBitWidth::SIM, 32}, {PimBitWidth::HOST, 32}} },
     { PIM_BF16, {{PimBitWidth::ACTUAL, 16}, {PimBitWidth::SIM, 32}, {PimBitWidth::HOST, 32}} },
     { PIM_FP8, {{PimBitWidth::ACTUAL, 8}, {PimBitWidth::SIM, 32}, {PimBitWidth::HOST, 32}} },
+    { PIM_INT4, {{PimBitWidth::ACTUAL, 4}, {PimBitWidth::SIM, 4}, {PimBitWidth::HOST, 8}} },
+    { PIM_UINT4, {{PimBitWidth::ACTUAL, 4}, {PimBitWidth::SIM, 4}, {PimBitWidth::HOST, 8}} },
+    { PIM_INT2, {{PimBitWidth::ACTUAL, 2}, {PimBitWidth::SIM, 2}, {PimBitWidth::HOST, 8}} },
+    { PIM_UINT2, {{PimBitWidth::ACTUAL, 2}, {PimBitWidth::SIM, 2}, {PimBitWidth::HOST, 8}} },
   };
 }
 
@@ -132,14 +147,23 @@ pimUtils::getNumBitsOfDataType(PimDataType dataType, PimBitWidth bitWidthType)
 bool
 pimUtils::isSigned(PimDataType dataType)
 {
-  return dataType == PIM_INT8 || dataType == PIM_INT16 || dataType == PIM_INT32 || dataType == PIM_INT64;
+  return dataType == PIM_INT8 || dataType == PIM_INT16 || dataType == PIM_INT32 || dataType == PIM_INT64 ||
+         dataType == PIM_INT4 || dataType == PIM_INT2;
 }
 
 //! @brief  Check if a PIM data type is unsigned integer
 bool
 pimUtils::isUnsigned(PimDataType dataType)
 {
-  return dataType == PIM_BOOL || dataType == PIM_UINT8 || dataType == PIM_UINT16 || dataType == PIM_UINT32 || dataType == PIM_UINT64;
+  return dataType == PIM_BOOL || dataType == PIM_UINT8 || dataType == PIM_UINT16 || dataType == PIM_UINT32 || dataType == PIM_UINT64 ||
+         dataType == PIM_UINT4 || dataType == PIM_UINT2;
+}
+
+//! @brief  Check if a PIM data type is a sub-byte integer type stored packed at actual width
+bool
+pimUtils::isSubByteInt(PimDataType dataType)
+{
+  return dataType == PIM_INT4 || dataType == PIM_UINT4 || dataType == PIM_INT2 || dataType == PIM_UINT2;
 }
 
 //! @brief  Check if a PIM data type is floating point
@@ -149,6 +173,228 @@ pimUtils::isFP(PimDataType dataType)
   return dataType == PIM_FP32 || dataType == PIM_FP16 || dataType == PIM_BF16 || dataType == PIM_FP8;
 }
 
+//! @brief  Convert FP32 to IEEE FP16 bits with round-to-nearest-even
+uint16_t
+pimUtils::fp32ToFp16(float val)
+{
+  uint32_t bits = castBitsToType<uint32_t>(castTypeToBits(val));
+  uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  bits &= 0x7fffffff;
+  if (bits >= 0x7f800000) { // inf or nan
+    return sign | (bits > 0x7f800000 ? 0x7e00 : 0x7c00);
+  }
+  if (bits >= 0x477ff000) { // round to inf
+    return sign | 0x7c00;
+  }
+  if (bits < 0x38800000) { // subnormal or zero: let FP32 addition round at 2^-24 granularity
+    float res = castBitsToType<float>(bits) + 0.5f;
+    return sign | static_cast<uint16_t>(castBitsToType<uint32_t>(castTypeToBits(res)) - 0x3f000000);
+  }
+  uint32_t mantOdd = (bits >> 13) & 1;
+  bits += 0xc8000fff + mantOdd; // rebias exponent and round
+  return sign | static_cast<uint16_t>(bits >> 13);
+}
+
+//! @brief  Convert IEEE FP16 bits to FP32
+float
+pimUtils::fp16ToFp32(uint16_t bits)
+{
+  uint32_t exp = (bits >> 10) & 0x1f;
+  uint32_t mant = bits & 0x3ff;
+  float res = 0.0f;
+  if (exp == 0x1f) {
+    res = mant ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+  } else if (exp == 0) {
+    res = std::ldexp(static_cast<float>(mant), -24);
+  } else {
+    res = castBitsToType<float>(((exp + 112) << 23) | (mant << 13));
+  }
+  return (bits & 0x8000) ? -res : res;
+}
+
+//! @brief  Convert FP32 to BF16 bits with round-to-nearest-even
+uint16_t
+pimUtils::fp32ToBf16(float val)
+{
+  uint32_t bits = castBitsToType<uint32_t>(castTypeToBits(val));
+  if ((bits & 0x7fffffff) > 0x7f800000) { // keep nan quiet
+    return static_cast<uint16_t>((bits >> 16) | 0x40);
+  }
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+//! @brief  Convert BF16 bits to FP32
+float
+pimUtils::bf16ToFp32(uint16_t bits)
+{
+  return castBitsToType<float>(static_cast<uint32_t>(bits) << 16);
+}
+
+//! @brief  Convert FP32 to FP8 E4M3 bits with round-to-nearest-even, saturating to +-448
+uint8_t
+pimUtils::fp32ToFp8(float val)
+{
+  uint32_t bits = castBitsToType<uint32_t>(castTypeToBits(val));
+  uint8_t sign = static_cast<uint8_t>((bits >> 24) & 0x80);
+  float absVal = std::fabs(val);
+  if (std::isnan(val)) {
+    return sign | 0x7f;
+  }
+  if (absVal >= 448.0f) {
+    return sign | 0x7e;
+  }
+  if (absVal < 0.015625f) { // subnormal or zero, in units of 2^-9
+    return sign | static_cast<uint8_t>(std::nearbyint(absVal * 512.0f));
+  }
+  bits &= 0x7fffffff;
+  bits += 0x7ffff + ((bits >> 20) & 1);
+  uint32_t exp = (bits >> 23) - 120;
+  uint32_t mant = (bits >> 20) & 0x7;
+  return sign | static_cast<uint8_t>((exp << 3) | mant);
+}
+
+//! @brief  Convert FP8 E4M3 bits to FP32
+float
+pimUtils::fp8ToFp32(uint8_t bits)
+{
+  int exp = (bits >> 3) & 0xf;
+  int mant = bits & 0x7;
+  float res = 0.0f;
+  if (exp == 0xf && mant == 0x7) {
+    res = std::numeric_limits<float>::quiet_NaN();
+  } else if (exp == 0) {
+    res = std::ldexp(static_cast<float>(mant), -9);
+  } else {
+    res = std::ldexp(static_cast<float>(8 + mant), exp - 10);
+  }
+  return (bits & 0x80) ? -res : res;
+}
+
+//! @brief  Check if a PIM data type is a low-precision FP type stored packed at actual width
+bool
+pimUtils::isPackedFP(PimDataType dataType)
+{
+  return dataType == PIM_FP16 || dataType == PIM_BF16 || dataType == PIM_FP8;
+}
+
+//! @brief  Round FP32 bits to the packed bits of a low-precision FP data type
+uint64_t
+pimUtils::packFpBits(uint64_t fp32Bits, PimDataType dataType)
+{
+  float val = castBitsToType<float>(fp32Bits);
+  switch (dataType) {
+    case PIM_FP16: return fp32ToFp16(val);
+    case PIM_BF16: return fp32ToBf16(val);
+    case PIM_FP8: return fp32ToFp8(val);
+    default: break;
+  }
+  return fp32Bits;
+}
+
+//! @brief  Expand packed bits of a low-precision FP data type to FP32 bits
+uint64_t
+pimUtils::unpackFpBits(uint64_t packedBits, PimDataType dataType)
+{
+  switch (dataType) {
+    case PIM_FP16: return castTypeToBits(fp16ToFp32(static_cast<uint16_t>(packedBits)));
+    case PIM_BF16: return castTypeToBits(bf16ToFp32(static_cast<uint16_t>(packedBits)));
+    case PIM_FP8: return castTypeToBits(fp8ToFp32(static_cast<uint8_t>(packedBits)));
+    default: break;
+  }
+  return packedBits;
+}
+
+#if defined(PIM_FP16_F16C_DISPATCH)
+//! @brief  Whether the host CPU supports F16C conversions, checked once at runtime
+static bool
+hasF16c()
+{
+  static const bool s_hasF16c = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx");
+  return s_hasF16c;
+}
+
+//! @brief  Round FP32 to FP16 with F16C in blocks of 8 elements, and return the number of converted elements
+__attribute__((target("f16c,avx"))) static uint64_t
+packFp16F16c(const float* src, uint16_t* dest, uint64_t numElements)
+{
+  uint64_t i = 0;
+  for (; i + 8 <= numElements; i += 8) {
+    __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), packed);
+  }
+  return i;
+}
+
+//! @brief  Expand FP16 to FP32 with F16C in blocks of 8 elements, and return the number of converted elements
+__attribute__((target("f16c,avx"))) static uint64_t
+unpackFp16F16c(const uint16_t* src, float* dest, uint64_t numElements)
+{
+  uint64_t i = 0;
+  for (; i + 8 <= numElements; i += 8) {
+    __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dest + i, _mm256_cvtph_ps(packed));
+  }
+  return i;
+}
+#endif
+
+//! @brief  Round an array of host FP32 values into packed low-precision FP storage
+void
+pimUtils::packFpArray(const float* src, void* dest, uint64_t numElements, PimDataType dataType)
+{
+  uint64_t i = 0;
+  if (dataType == PIM_FP16) {
+    uint16_t* dest16 = static_cast<uint16_t*>(dest);
+#if defined(PIM_FP16_F16C_DISPATCH)
+    if (hasF16c()) {
+      i = packFp16F16c(src, dest16, numElements);
+    }
+#endif
+    for (; i < numElements; ++i) {
+      dest16[i] = fp32ToFp16(src[i]);
+    }
+  } else if (dataType == PIM_BF16) {
+    uint16_t* dest16 = static_cast<uint16_t*>(dest);
+    for (; i < numElements; ++i) {
+      dest16[i] = fp32ToBf16(src[i]);
+    }
+  } else if (dataType == PIM_FP8) {
+    uint8_t* dest8 = static_cast<uint8_t*>(dest);
+    for (; i < numElements; ++i) {
+      dest8[i] = fp32ToFp8(src[i]);
+    }
+  }
+}
+
+//! @brief  Expand an array of packed low-precision FP storage into host FP32 values
+void
+pimUtils::unpackFpArray(const void* src, float* dest, uint64_t numElements, PimDataType dataType)
+{
+  uint64_t i = 0;
+  if (dataType == PIM_FP16) {
+    const uint16_t* src16 = static_cast<const uint16_t*>(src);
+#if defined(PIM_FP16_F16C_DISPATCH)
+    if (hasF16c()) {
+      i = unpackFp16F16c(src16, dest, numElements);
+    }
+#endif
+    for (; i < numElements; ++i) {
+      dest[i] = fp16ToFp32(src16[i]);
+    }
+  } else if (dataType == PIM_BF16) {
+    const uint16_t* src16 = static_cast<const uint16_t*>(src);
+    for (; i < numElements; ++i) {
+      dest[i] = bf16ToFp32(src16[i]);
+    }
+  } else if (dataType == PIM_FP8) {
+    const uint8_t* src8 = static_cast<const uint8_t*>(src);
+    for (; i < numElements; ++i) {
+      dest[i] = fp8ToFp32(src8[i]);
+    }
+  }
+}
+
 //! @brief  Convert PimDeviceProtocolEnum to string
 std::string
 pimUtils::pimProtocolEnumToStr(PimDeviceProtocolEnum protocol)
@@ -187,8 +433,7 @@ pimUtils::getDeviceDataLayout(PimDeviceEnum deviceType)
 
 //! @brief  Thread pool ctor
 pimUtils::threadPool::threadPool(size_t numThreads)
-  : m_terminate(false),
-    m_workersRemaining(0)
+  : m_terminate(false)
 {
   // reserve one thread for main program
   for (size_t i = 1; i < numThreads; ++i) {
@@ -216,18 +461,18 @@ pimUtils::threadPool::~threadPool()
 void
 pimUtils::threadPool::doWork(const std::vector<pimUtils::threadWorker*>& workers)
 {
+  size_t workersRemaining = workers.size();
   {
     std::unique_lock<std::mutex> lock(m_mutex);
     for (auto& worker : workers) {
-      m_workers.push(worker);
+      m_workers.emplace(worker, &workersRemaining);
     }
-    m_workersRemaining = workers.size();
   }
   m_cond.notify_all();
 
-  // Wait for all workers to be done
+  // Wait for all workers of this call to be done
   std::unique_lock<std::mutex> lock(m_mutex);
-  m_cond.wait(lock, [this] { return m_workersRemaining == 0; });
+  m_cond.wait(lock, [&workersRemaining] { return workersRemaining == 0; });
 }
 
 //! @brief  Worker thread that process workers
@@ -235,7 +480,7 @@ void
 pimUtils::threadPool::workerThread()
 {
   while (true) {
-    threadWorker* worker;
+    std::pair<threadWorker*, size_t*> worker;
     {
       std::unique_lock<std::mutex> lock(m_mutex);
       m_cond.wait(lock, [this] { return m_terminate || !m_workers.empty(); });
@@ -245,10 +490,10 @@ pimUtils::threadPool::workerThread()
       worker = m_workers.front();
       m_workers.pop();
     }
-    worker->execute();
+    worker.first->execute();
     {
       std::unique_lock<std::mutex> lock(m_mutex);
-      --m_workersRemaining;
+      --(*worker.second);
     }
     m_cond.notify_all();
   }
@@ -56,6 +56,7 @@ namespace pimUtils
   bool isSigned(PimDataType dataType);
   bool isUnsigned(PimDataType dataType);
   bool isFP(PimDataType dataType);
+  bool isSubByteInt(PimDataType dataType);
   std::string pimProtocolEnumToStr(PimDeviceProtocolEnum protocol);
   PimDataLayout getDeviceDataLayout(PimDeviceEnum deviceType);
 
@@ -68,6 +69,8 @@ namespace pimUtils
       case PIM_INT16: return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int16_t>(bits)));
       case PIM_INT32: return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(bits)));
       case PIM_INT64: return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int64_t>(bits)));
+      case PIM_INT4: return static_cast<uint64_t>(static_cast<int64_t>(bits << 60) >> 60);
+      case PIM_INT2: return static_cast<uint64_t>(static_cast<int64_t>(bits << 62) >> 62);
       default: break; // no-op
     }
     return bits;
@@ -95,6 +98,23 @@ namespace pimUtils
     return signExtBits;
   }
 
+  // Conversion between FP32 and low-precision FP formats with round-to-nearest-even
+  // FP16: IEEE binary16; BF16: upper half of FP32; FP8: OCP E4M3 (bias 7, max 448, saturating, no inf)
+  uint16_t fp32ToFp16(float val);
+  float fp16ToFp32(uint16_t bits);
+  uint16_t fp32ToBf16(float val);
+  float bf16ToFp32(uint16_t bits);
+  uint8_t fp32ToFp8(float val);
+  float fp8ToFp32(uint8_t bits);
+
+  // Low-precision FP data types are stored packed at their actual width, and computed as FP32.
+  // Packed bits are converted from/to FP32 bits, i.e., the bit representation used for functional simulation.
+  bool isPackedFP(PimDataType dataType);
+  uint64_t packFpBits(uint64_t fp32Bits, PimDataType dataType);
+  uint64_t unpackFpBits(uint64_t packedBits, PimDataType dataType);
+  void packFpArray(const float* src, void* dest, uint64_t numElements, PimDataType dataType);
+  void unpackFpArray(const void* src, float* dest, uint64_t numElements, PimDataType dataType);
+
   // Service APIs for file system, config files, env vars
   std::string& ltrim(std::string& s);
   std::string& rtrim(std::string& s);
@@ -164,11 +184,12 @@ namespace pimUtils
     void workerThread();
 
     std::vector<std::thread> m_threads;
-    std::queue<threadWorker*> m_workers;
+    // Each worker is queued with the remaining count of its doWork call, so that multiple callers,
+    // e.g., PIM streams, can share the pool concurrently
+    std::queue<std::pair<threadWorker*, size_t*>> m_workers;
     std::mutex m_mutex;
     std::condition_variable m_cond;
     bool m_terminate;
-    std::atomic<size_t> m_workersRemaining;
   };
 
 }
@@ -76,7 +76,6 @@ int main()
 
   int min_diff = INT_MAX;
   int min_idx = -1;
-  int64_t sum_abs_diff = 0;
 
   for (int idx = 0; idx < subvectorLength; idx++) {
     status = pimSub(obj1, obj2, obj3);
@@ -91,17 +90,26 @@ int main()
       return 1;
     }
 
+    // Reduce all subvectors starting at idx in one segmented reduction. Each subvector gets its own sum of
+    // absolute differences, instead of a running sum across subvectors
+    std::vector<uint64_t> offsets;
     for (int i = idx; i + subvectorLength - 1 < vectorLength; i += subvectorLength) {
-      status = pimRedSum(obj3, static_cast<void*>(&sum_abs_diff), i, i + subvectorLength);
-      if (status != PIM_OK) {
-        std::cout << "Abort" << std::endl;
-        return 1;
-      }
+      offsets.push_back(i);
+    }
+    offsets.push_back(offsets.back() + subvectorLength);
+    std::vector<int64_t> sum_abs_diff(offsets.size() - 1);
+    status = pimRedSumSegmentedByOffsets(obj3, static_cast<void*>(sum_abs_diff.data()), offsets.data(), sum_abs_diff.size());
+    if (status != PIM_OK) {
+      std::cout << "Abort" << std::endl;
+      return 1;
+    }
+
+    for (size_t seg = 0; seg < sum_abs_diff.size(); ++seg) {
       // Update minimum
-      // TODO: put the reduction sum ranged value in a vector object and calculate the minimum in PIM. Currently it executes the comparison on CPU
-      if (sum_abs_diff < min_diff) {
-        min_idx = i;
-        min_diff = sum_abs_diff;
+      // TODO: calculate the minimum in PIM. Currently it executes the comparison on CPU
+      if (sum_abs_diff[seg] < min_diff) {
+        min_idx = offsets[seg];
+        min_diff = sum_abs_diff[seg];
       }
     }
 
@@ -14,8 +14,8 @@ int main(int argc, char *argv[])
 #ifdef DRAMSIM3_INTEG
   if (argc != 2)
   {
-        std::cout << "Config file is required.\n";
-        std::cout << "Syntax: " << argv[0] << " <path_to_DRAMSIM3_config_file>.\n";
+        std::cout << "PIMeval config file with memory_config_file is required.\n";
+        std::cout << "Syntax: " << argv[0] << " <path_to_PIMeval_config_file>.\n";
         exit(1);
   }
 
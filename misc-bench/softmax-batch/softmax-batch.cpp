@@ -118,30 +118,13 @@ void softMaxPIM(const std::vector<int> src, std::vector<int> &dst)
     return;
   }
   
-  dst.resize(vectorLength);
-  status = pimCopyDeviceToHost(srcObj, (void *) dst.data());
+  status = pimExp(srcObj, srcObj);
   if (status != PIM_OK)
   {
-    std::cout << "Function: " << __func__ << "Abort: pimCopyHostToDevice failed for dst vector" << std::endl;
+    std::cout << "Function: " << __func__ << "Abort: pimExp failed" << std::endl;
     return;
   }
 
-  auto start = std::chrono::high_resolution_clock::now();
-  #pragma omp parallel for
-  for (size_t i = 0; i < vectorLength; ++i)
-  {
-    dst[i] = std::exp(static_cast<double>(dst[i]));
-  }
-  auto end = std::chrono::high_resolution_clock::now();
-  hostElapsedTime += (end - start);
-
-  status = pimCopyHostToDevice((void *) dst.data(), srcObj);
-  if (status != PIM_OK)
-  {
-    std::cout << "Function: " << __func__ << "Abort: pimCopyHostToDevice failed for dst vector" << std::endl;
-    return;
-  }
-  
   int32_t redsum = 0;
   status = pimRedSum(srcObj, &redsum);
   if (status != PIM_OK)
@@ -157,6 +140,7 @@ void softMaxPIM(const std::vector<int> src, std::vector<int> &dst)
     return;
   }
 
+  dst.resize(vectorLength);
   status = pimCopyDeviceToHost(srcObj, (void *) dst.data());
   if (status != PIM_OK)
   {
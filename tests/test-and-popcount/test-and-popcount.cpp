@@ -0,0 +1,88 @@
+// Test: Test batched AND-popcount
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <bitset>
+
+
+// Compare batched intersection counts of bitmap rows against host results
+bool testAndPopCount(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numBitmapRows = 500;
+  uint64_t numWordsPerRow = 16;
+  uint64_t numPairs = 3000;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  std::vector<uint32_t> bitmaps(numBitmapRows * numWordsPerRow);
+  for (uint64_t i = 0; i < bitmaps.size(); ++i) {
+    bitmaps[i] = static_cast<uint32_t>(i * 2654435761ULL) & static_cast<uint32_t>(i * 40503ULL + 12345);
+  }
+  std::vector<uint64_t> rowsA(numPairs);
+  std::vector<uint64_t> rowsB(numPairs);
+  std::vector<uint64_t> expected(numPairs, 0);
+  for (uint64_t i = 0; i < numPairs; ++i) {
+    rowsA[i] = (i * 7919) % numBitmapRows;
+    rowsB[i] = (i * 104729 + 17) % numBitmapRows;
+    for (uint64_t j = 0; j < numWordsPerRow; ++j) {
+      uint32_t bits = bitmaps[rowsA[i] * numWordsPerRow + j] & bitmaps[rowsB[i] * numWordsPerRow + j];
+      expected[i] += std::bitset<32>(bits).count();
+    }
+  }
+
+  PimObjId objBitmaps = pimAlloc(PIM_ALLOC_AUTO, bitmaps.size(), PIM_UINT32);
+  assert(objBitmaps != -1);
+  status = pimCopyHostToDevice((void*)bitmaps.data(), objBitmaps);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  std::vector<uint64_t> counts(numPairs, 12345);
+  status = pimAndPopCountBatched(objBitmaps, numWordsPerRow, rowsA.data(), rowsB.data(), numPairs, counts.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numPairs; ++i) {
+    if (counts[i] != expected[i]) {
+      std::printf("Error: Count mismatch of pair %llu: %llu vs %llu\n", (unsigned long long)i,
+                  (unsigned long long)counts[i], (unsigned long long)expected[i]);
+      ok = false;
+      break;
+    }
+  }
+
+  // Row indices must be in range
+  uint64_t badRow = numBitmapRows;
+  status = pimAndPopCountBatched(objBitmaps, numWordsPerRow, rowsA.data(), &badRow, 1, counts.data());
+  ok = ok && status == PIM_ERROR;
+
+  std::printf("Result: %s batched AND-popcount of %llu pairs\n", ok ? "Passed" : "Failed", (unsigned long long)numPairs);
+  pimShowStats();
+
+  pimFree(objBitmaps);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Batched AND-popcount" << std::endl;
+
+  bool ok = true;
+  ok = testAndPopCount(PIM_DEVICE_BITSIMD_V) && ok;
+  ok = testAndPopCount(PIM_DEVICE_FULCRUM) && ok;
+  ok = testAndPopCount(PIM_DEVICE_BANK_LEVEL) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// Test: Test asynchronous data copy
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+
+// Double-buffered vector add: copy the next chunk while adding the current one
+bool testAsyncCopy(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 4;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+
+  uint64_t numElements = 64 * 1024;
+  unsigned numChunks = 4;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  std::vector<std::vector<int>> srcA(numChunks, std::vector<int>(numElements));
+  std::vector<int> srcB(numElements);
+  std::vector<std::vector<int>> dest(numChunks, std::vector<int>(numElements));
+  for (unsigned c = 0; c < numChunks; ++c) {
+    for (uint64_t i = 0; i < numElements; ++i) {
+      srcA[c][i] = static_cast<int>(c * 1000 + i % 777);
+    }
+  }
+  for (uint64_t i = 0; i < numElements; ++i) {
+    srcB[i] = static_cast<int>(i % 123);
+  }
+
+  PimObjId objA[2];
+  PimObjId objDest[2];
+  objA[0] = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(objA[0] != -1);
+  objA[1] = pimAllocAssociated(objA[0], PIM_INT32);
+  PimObjId objB = pimAllocAssociated(objA[0], PIM_INT32);
+  objDest[0] = pimAllocAssociated(objA[0], PIM_INT32);
+  objDest[1] = pimAllocAssociated(objA[0], PIM_INT32);
+  assert(objA[1] != -1 && objB != -1 && objDest[0] != -1 && objDest[1] != -1);
+
+  status = pimCopyHostToDevice((void*)srcB.data(), objB);
+  assert(status == PIM_OK);
+
+  std::vector<PimCopyHandle> copyIn(numChunks, -1);
+  std::vector<PimCopyHandle> copyOut(numChunks, -1);
+  copyIn[0] = pimCopyHostToDeviceAsync((void*)srcA[0].data(), objA[0]);
+  assert(copyIn[0] != -1);
+  for (unsigned c = 0; c < numChunks; ++c) {
+    unsigned cur = c % 2;
+    status = pimWait(copyIn[c]);
+    assert(status == PIM_OK);
+    if (c + 1 < numChunks) {
+      copyIn[c + 1] = pimCopyHostToDeviceAsync((void*)srcA[c + 1].data(), objA[1 - cur]);
+      assert(copyIn[c + 1] != -1);
+    }
+    if (c >= 2) {
+      // objDest[cur] is being reused
+      status = pimWait(copyOut[c - 2]);
+      assert(status == PIM_OK);
+    }
+    status = pimAdd(objA[cur], objB, objDest[cur]);
+    assert(status == PIM_OK);
+    copyOut[c] = pimCopyDeviceToHostAsync(objDest[cur], (void*)dest[c].data());
+    assert(copyOut[c] != -1);
+  }
+  for (unsigned c = (numChunks >= 2 ? numChunks - 2 : 0); c < numChunks; ++c) {
+    status = pimWait(copyOut[c]);
+    assert(status == PIM_OK);
+  }
+
+  // Waiting on a finished copy is an error
+  status = pimWait(copyOut[0]);
+  assert(status == PIM_ERROR);
+
+  bool ok = true;
+  if (!pimIsAnalysisMode()) {
+    for (unsigned c = 0; c < numChunks && ok; ++c) {
+      for (uint64_t i = 0; i < numElements; ++i) {
+        if (dest[c][i] != srcA[c][i] + srcB[i]) {
+          std::printf("ERROR: mismatch at chunk %u idx %llu: %d + %d != %d\n", c, (unsigned long long)i,
+                      srcA[c][i], srcB[i], dest[c][i]);
+          ok = false;
+          break;
+        }
+      }
+    }
+  }
+
+  // A command using an object of a pending async copy waits for it, and the copy can still be waited
+  PimCopyHandle copyHazard = pimCopyHostToDeviceAsync((void*)srcA[0].data(), objA[0]);
+  assert(copyHazard != -1);
+  status = pimAdd(objA[0], objB, objDest[0]);
+  assert(status == PIM_OK);
+  status = pimWait(copyHazard);
+  assert(status == PIM_OK);
+  std::vector<int> destHazard(numElements);
+  status = pimCopyDeviceToHost(objDest[0], (void*)destHazard.data());
+  assert(status == PIM_OK);
+  if (!pimIsAnalysisMode() && destHazard != dest[0]) {
+    std::printf("ERROR: mismatch of add after a pending async copy\n");
+    ok = false;
+  }
+
+  pimShowStats();
+  pimFree(objA[0]);
+  pimFree(objA[1]);
+  pimFree(objB);
+  pimFree(objDest[0]);
+  pimFree(objDest[1]);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Asynchronous data copy" << std::endl;
+
+  bool ok = true;
+
+  ok &= testAsyncCopy(PIM_DEVICE_BITSIMD_V);
+  ok &= testAsyncCopy(PIM_DEVICE_FULCRUM);
+  ok &= testAsyncCopy(PIM_DEVICE_BANK_LEVEL);
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+// Test: Test batched reductions
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+
+// Compare a batched reduction of associated objects against host results
+bool testBatchedRed(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numElements = 65536;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  std::vector<int> srcA(numElements);
+  std::vector<int> srcB(numElements);
+  std::vector<uint8_t> srcC(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    srcA[i] = static_cast<int>((i * 7919) % 2001) - 1000;
+    srcB[i] = static_cast<int>((i * 104729) % 100003);
+    srcC[i] = static_cast<uint8_t>(i * 31);
+  }
+  PimObjId objA = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  PimObjId objB = pimAllocAssociated(objA, PIM_INT32);
+  PimObjId objC = pimAllocAssociated(objA, PIM_UINT8);
+  assert(objA != -1 && objB != -1 && objC != -1);
+  status = pimCopyHostToDevice((void*)srcA.data(), objA);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)srcB.data(), objB);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)srcC.data(), objC);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  for (int ranged = 0; ranged < 2; ++ranged) {
+    uint64_t idxBegin = ranged ? 12345 : 0;
+    uint64_t idxEnd = ranged ? 54321 : numElements;
+
+    int64_t expectedSumA = 0;
+    int expectedMaxB = std::numeric_limits<int>::lowest();
+    uint8_t expectedMinC = std::numeric_limits<uint8_t>::max();
+    uint64_t expectedSumC = 0;
+    for (uint64_t i = idxBegin; i < idxEnd; ++i) {
+      expectedSumA += srcA[i];
+      expectedMaxB = std::max(expectedMaxB, srcB[i]);
+      expectedMinC = std::min(expectedMinC, srcC[i]);
+      expectedSumC += srcC[i];
+    }
+
+    // Results follow pimRedSum/pimRedMin/pimRedMax semantics, so initialize them first
+    int64_t sumA = 0;
+    int maxB = std::numeric_limits<int>::lowest();
+    uint8_t minC = std::numeric_limits<uint8_t>::max();
+    uint64_t sumC = 0;
+    PimObjId srcs[] = { objA, objB, objC, objC };
+    PimReductionEnum ops[] = { PIM_RED_SUM, PIM_RED_MAX, PIM_RED_MIN, PIM_RED_SUM };
+    void* results[] = { &sumA, &maxB, &minC, &sumC };
+    status = ranged ? pimRedBatched(srcs, ops, results, 4, idxBegin, idxEnd) : pimRedBatched(srcs, ops, results, 4);
+    assert(status == PIM_OK);
+
+    std::printf("Result: Batched%s: sumA %lld vs %lld, maxB %d vs %d, minC %u vs %u, sumC %llu vs %llu\n", ranged ? "Ranged" : "",
+                (long long)sumA, (long long)expectedSumA, maxB, expectedMaxB, minC, expectedMinC,
+                (unsigned long long)sumC, (unsigned long long)expectedSumC);
+    if (sumA != expectedSumA || maxB != expectedMaxB || minC != expectedMinC || sumC != expectedSumC) {
+      ok = false;
+    }
+  }
+
+  // Objects must be associated
+  PimObjId objD = pimAlloc(PIM_ALLOC_AUTO, numElements / 2, PIM_INT32);
+  assert(objD != -1);
+  int64_t sumA = 0;
+  int64_t sumD = 0;
+  PimObjId badSrcs[] = { objA, objD };
+  PimReductionEnum badOps[] = { PIM_RED_SUM, PIM_RED_SUM };
+  void* badResults[] = { &sumA, &sumD };
+  status = pimRedBatched(badSrcs, badOps, badResults, 2);
+  ok = ok && status == PIM_ERROR;
+
+  // One batched reduction versus separate reductions
+  int64_t sumB = 0;
+  status = pimRedSum(objA, &sumA);
+  assert(status == PIM_OK);
+  status = pimRedSum(objB, &sumB);
+  assert(status == PIM_OK);
+  PimObjId pairSrcs[] = { objA, objB };
+  PimReductionEnum pairOps[] = { PIM_RED_SUM, PIM_RED_SUM };
+  void* pairResults[] = { &sumA, &sumB };
+  status = pimRedBatched(pairSrcs, pairOps, pairResults, 2);
+  assert(status == PIM_OK);
+  pimShowStats();
+
+  pimFree(objA);
+  pimFree(objB);
+  pimFree(objC);
+  pimFree(objD);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Batched reductions" << std::endl;
+
+  bool ok = true;
+  ok = testBatchedRed(PIM_DEVICE_BITSIMD_V) && ok;
+  ok = testBatchedRed(PIM_DEVICE_FULCRUM) && ok;
+  ok = testBatchedRed(PIM_DEVICE_BANK_LEVEL) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// Test: Test stream compaction
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+
+// Compare compaction of elements less than a key against host results
+bool testCompact(PimDeviceEnum deviceType, int32_t key)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numElements = 300001;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  std::vector<int32_t> src(numElements);
+  std::vector<int32_t> expected;
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src[i] = static_cast<int32_t>((i * 2654435761ULL) % 1000);
+    if (src[i] < key) {
+      expected.push_back(src[i]);
+    }
+  }
+
+  PimObjId objSrc = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(objSrc != -1);
+  PimObjId objCond = pimAllocAssociated(objSrc, PIM_BOOL);
+  assert(objCond != -1);
+  PimObjId objDest = pimAllocAssociated(objSrc, PIM_INT32);
+  assert(objDest != -1);
+
+  status = pimCopyHostToDevice((void*)src.data(), objSrc);
+  assert(status == PIM_OK);
+  status = pimBroadcastInt(objDest, -1);
+  assert(status == PIM_OK);
+  status = pimLTScalar(objSrc, objCond, static_cast<uint64_t>(key));
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  uint64_t count = 12345;
+  status = pimCompact(objSrc, objCond, objDest, &count);
+  assert(status == PIM_OK);
+  ok = ok && count == expected.size();
+
+  // Selected elements are densely packed, and the rest of dest is unchanged
+  std::vector<int32_t> result(numElements);
+  status = pimCopyDeviceToHost(objDest, (void*)result.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements && ok; ++i) {
+    int32_t val = (i < expected.size() ? expected[i] : -1);
+    if (result[i] != val) {
+      std::printf("Error: Compaction mismatch at index %llu: %d vs %d\n", (unsigned long long)i, result[i], val);
+      ok = false;
+    }
+  }
+
+  // Source and condition objects must be associated, and dest must be a different object
+  PimObjId objOther = pimAlloc(PIM_ALLOC_AUTO, numElements / 2, PIM_BOOL);
+  assert(objOther != -1);
+  ok = ok && pimCompact(objSrc, objOther, objDest, &count) == PIM_ERROR;
+  ok = ok && pimCompact(objSrc, objCond, objSrc, &count) == PIM_ERROR;
+
+  std::printf("Result: %s compaction of %llu out of %llu elements\n", ok ? "Passed" : "Failed",
+              (unsigned long long)expected.size(), (unsigned long long)numElements);
+  pimShowStats();
+
+  pimFree(objSrc);
+  pimFree(objCond);
+  pimFree(objDest);
+  pimFree(objOther);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Stream compaction" << std::endl;
+
+  bool ok = true;
+  for (PimDeviceEnum deviceType : { PIM_DEVICE_BITSIMD_V, PIM_DEVICE_FULCRUM, PIM_DEVICE_BANK_LEVEL }) {
+    ok = testCompact(deviceType, 10) && ok;
+    ok = testCompact(deviceType, 0) && ok;
+    ok = testCompact(deviceType, 1000) && ok;
+  }
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
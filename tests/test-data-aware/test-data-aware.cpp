@@ -0,0 +1,141 @@
+// Test: Test data-aware bit-serial perf model
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+
+// Run data-dependent commands on sparse data, so that data-aware runtime is lower than worst-case.
+// Functional results must not be affected by the data-aware perf model.
+bool testDataAware(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 4;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numElements = 4096;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  // Small values only use low bits, and all element pairs differ at bit 8
+  std::vector<int> srcA(numElements);
+  std::vector<int> srcB(numElements);
+  std::vector<int> srcC(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    srcA[i] = static_cast<int>(i % 16);
+    srcB[i] = static_cast<int>(i % 4);
+    srcC[i] = srcA[i] | 0x100;
+  }
+
+  PimObjId objA = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  PimObjId objB = pimAllocAssociated(objA, PIM_INT32);
+  PimObjId objDest = pimAllocAssociated(objA, PIM_INT32);
+  PimObjId objC = pimAllocAssociated(objA, PIM_INT32);
+  PimObjId objBool = pimAllocAssociated(objA, PIM_BOOL);
+  assert(objA != -1 && objB != -1 && objC != -1 && objDest != -1 && objBool != -1);
+  status = pimCopyHostToDevice((void*)srcA.data(), objA);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)srcB.data(), objB);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)srcC.data(), objC);
+  assert(status == PIM_OK);
+
+  pimResetStats();
+
+  bool ok = true;
+  std::vector<int> dest(numElements);
+  std::vector<uint8_t> destBool(numElements);
+
+  // Scalar with two set bits
+  status = pimMulScalar(objA, objDest, 5);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objDest, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements && ok; ++i) {
+    if (dest[i] != srcA[i] * 5) {
+      std::printf("Error: pimMulScalar mismatch at index %llu: %d vs %d\n", (unsigned long long)i, dest[i], srcA[i] * 5);
+      ok = false;
+    }
+  }
+
+  // Multiplier with two bits in use
+  status = pimMul(objA, objB, objDest);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objDest, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements && ok; ++i) {
+    if (dest[i] != srcA[i] * srcB[i]) {
+      std::printf("Error: pimMul mismatch at index %llu: %d vs %d\n", (unsigned long long)i, dest[i], srcA[i] * srcB[i]);
+      ok = false;
+    }
+  }
+
+  // Four bits in use
+  status = pimPopCount(objA, objDest);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objDest, (void*)dest.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements && ok; ++i) {
+    int expected = __builtin_popcount(static_cast<unsigned>(srcA[i]));
+    if (dest[i] != expected) {
+      std::printf("Error: pimPopCount mismatch at index %llu: %d vs %d\n", (unsigned long long)i, dest[i], expected);
+      ok = false;
+    }
+  }
+
+  // Comparisons exit early at the highest differing bit
+  status = pimGT(objA, objC, objBool);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objBool, (void*)destBool.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements && ok; ++i) {
+    if (destBool[i] != (srcA[i] > srcC[i] ? 1 : 0)) {
+      std::printf("Error: pimGT mismatch at index %llu\n", (unsigned long long)i);
+      ok = false;
+    }
+  }
+  status = pimEQScalar(objA, objBool, 1000);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objBool, (void*)destBool.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements && ok; ++i) {
+    if (destBool[i] != (srcA[i] == 1000 ? 1 : 0)) {
+      std::printf("Error: pimEQScalar mismatch at index %llu\n", (unsigned long long)i);
+      ok = false;
+    }
+  }
+
+  // Shows both worst-case and data-aware runtime
+  pimShowStats();
+
+  pimFree(objA);
+  pimFree(objB);
+  pimFree(objC);
+  pimFree(objDest);
+  pimFree(objBool);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Data-aware bit-serial perf model" << std::endl;
+
+  setenv("PIMEVAL_DATA_AWARE_PERF", "1", 1);
+
+  bool ok = true;
+  ok = testDataAware(PIM_DEVICE_BITSIMD_V) && ok;
+  ok = testDataAware(PIM_DEVICE_BITSIMD_V_AP) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
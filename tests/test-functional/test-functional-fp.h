@@ -55,6 +55,16 @@ testFunctional::testFp(const std::string& category, PimDataType dataType)
   vecSrc1[500] = static_cast<T>(scalarVal); // cover scalar EQ
   vecSrc1[501] = static_cast<T>(scalarVal - 1); // cover scalar LT
 
+  // Low-precision FP data are stored at actual width, so expected results are computed from rounded inputs
+  for (unsigned i = 0; i < numElements; ++i) {
+    vecSrc1[i] = roundFp(vecSrc1[i], dataType);
+    vecSrc2[i] = roundFp(vecSrc2[i], dataType);
+    vecSrc2nz[i] = roundFp(vecSrc2nz[i], dataType);
+    if (vecSrc2nz[i] == 0.0) {
+      vecSrc2nz[i] = 1.0;
+    }
+  }
+
   // Pick a range for testing ranged operations
   const uint64_t idxBegin = 777;
   const uint64_t idxEnd = 3456;
@@ -262,6 +272,7 @@ testFunctional::testFp(const std::string& category, PimDataType dataType)
         uint8_t expected = 0;
         T val;
         std::memcpy(&val, &scalarVal, sizeof(val));
+        val = roundFp(val, dataType);
         switch (testId) {
           case  9: expected = (vecSrc1[i] > vecSrc2[i] ? 1 : 0);    break; // pimGT
           case 10: expected = (vecSrc1[i] < vecSrc2[i] ? 1 : 0);    break; // pimLT
@@ -290,6 +301,7 @@ testFunctional::testFp(const std::string& category, PimDataType dataType)
         T expected = 0.0;
         T val;
         std::memcpy(&val, &scalarVal, sizeof(val));
+        val = roundFp(val, dataType);
         T valInt = static_cast<T>(scalarValInt);
         switch (testId) {
           case  0: expected = vecSrc1[i] + vecSrc2[i];              break; // pimAdd
@@ -328,6 +340,7 @@ testFunctional::testFp(const std::string& category, PimDataType dataType)
           case 41: expected = vecSrc1[i];                break; // pimCopyObjectToObject 
           default: assert(0);
         }
+        expected = roundFp(expected, dataType);
         if (!fuzzyEqualPercent(vecDest[i], expected)) {
           if (numError < maxErrorToShow) {
           std::cout << "Error: Index = " << i << " Result = " << std::fixed << std::setprecision(12) << vecDest[i] << " Expected = " << std::fixed << std::setprecision(12) << expected << std::endl;
@@ -11,6 +11,7 @@
 #include <cassert>
 #include <limits>
 #include <type_traits>
+#include <cmath>
 
 
 //! @class  testFunctional
@@ -30,6 +31,7 @@ private:
   template <typename T> std::vector<T> getRandInt(uint64_t numElements, bool allowZero = true);
   template <typename T> std::vector<T> getRandFp(uint64_t numElements, bool allowZero = true);
   template <typename T> T safeAbs(T value);
+  template <typename T> T roundFp(T value, PimDataType dataType);
 
   template <typename T> bool testInt(const std::string& category, PimDataType dataType);
   template <typename T> bool testFp(const std::string& category, PimDataType dataType);
@@ -89,9 +91,41 @@ testFunctional::safeAbs(T value)
   return val;
 }
 
+//! @brief  Round a FP value to the precision of a low-precision PIM FP data type with round-to-nearest-even
+//! FP16 and BF16 overflow to inf, while FP8 (E4M3) saturates to +-448
+template <typename T> T
+testFunctional::roundFp(T value, PimDataType dataType)
+{
+  int numMantBits = 0;
+  int minExp = 0;
+  switch (dataType) {
+    case PIM_FP16: numMantBits = 10; minExp = -14; break;
+    case PIM_BF16: numMantBits = 7; minExp = -126; break;
+    case PIM_FP8: numMantBits = 3; minExp = -6; break;
+    default: return value;
+  }
+  if (value == 0 || !std::isfinite(value)) {
+    return (dataType == PIM_FP8 && std::isinf(value)) ? std::copysign(T(448), value) : value;
+  }
+  int exp = 0;
+  std::frexp(value, &exp);
+  int quantum = std::max(exp - 1, minExp) - numMantBits;
+  T rounded = std::ldexp(std::nearbyint(std::ldexp(value, -quantum)), quantum);
+  if (dataType == PIM_FP16 && std::abs(rounded) > T(65504)) {
+    return std::copysign(std::numeric_limits<T>::infinity(), value);
+  }
+  if (dataType == PIM_FP8 && std::abs(rounded) > T(448)) {
+    return std::copysign(T(448), value);
+  }
+  return rounded;
+}
+
 //! @brief  Check if two FP values are fuzzy equal within a percentage tolerance
 template <typename T>
 bool fuzzyEqualPercent(T a, T b, T tolerancePercent = 1e-3) {
+  if (a == b) { // also covers inf
+    return true;
+  }
   if (a == 0 || b == 0) {
     return std::abs(a - b) <= tolerancePercent / 100.0;
   }
@@ -0,0 +1,146 @@
+// Test: Test gather and scatter
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+
+// Compare gather, scatter and scatter-add against host results
+bool testGatherScatter(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numTable = 5000;
+  uint64_t numIndices = 65536;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  // table of numTable elements, and numIndices indices with repeats
+  std::vector<int32_t> table(numTable);
+  for (uint64_t i = 0; i < numTable; ++i) {
+    table[i] = static_cast<int32_t>(i * 2654435761ULL) - 1000000;
+  }
+  std::vector<int32_t> values(numIndices);
+  std::vector<uint32_t> indices(numIndices);
+  std::vector<float> fpValues(numIndices);
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    values[i] = static_cast<int32_t>(i * 40503ULL) - 7;
+    indices[i] = static_cast<uint32_t>((i * 7919 + 13) % numTable);
+    fpValues[i] = static_cast<float>(i % 17) * 0.25f;
+  }
+
+  PimObjId objTable = pimAlloc(PIM_ALLOC_AUTO, numTable, PIM_INT32);
+  assert(objTable != -1);
+  PimObjId objFpTable = pimAllocAssociated(objTable, PIM_FP32);
+  assert(objFpTable != -1);
+  PimObjId objIndex = pimAlloc(PIM_ALLOC_AUTO, numIndices, PIM_UINT32);
+  assert(objIndex != -1);
+  PimObjId objValues = pimAllocAssociated(objIndex, PIM_INT32);
+  assert(objValues != -1);
+  PimObjId objFpValues = pimAllocAssociated(objIndex, PIM_FP32);
+  assert(objFpValues != -1);
+
+  status = pimCopyHostToDevice((void*)indices.data(), objIndex);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)values.data(), objValues);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)fpValues.data(), objFpValues);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+
+  // Gather: values[i] = table[index[i]]
+  status = pimCopyHostToDevice((void*)table.data(), objTable);
+  assert(status == PIM_OK);
+  status = pimGather(objTable, objIndex, objValues);
+  assert(status == PIM_OK);
+  std::vector<int32_t> gathered(numIndices);
+  status = pimCopyDeviceToHost(objValues, (void*)gathered.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    if (gathered[i] != table[indices[i]]) {
+      std::printf("Error: Gather mismatch at index %llu: %d vs %d\n", (unsigned long long)i, gathered[i], table[indices[i]]);
+      ok = false;
+      break;
+    }
+  }
+
+  // Scatter: table[index[i]] = values[i], where the largest i wins
+  status = pimCopyHostToDevice((void*)values.data(), objValues);
+  assert(status == PIM_OK);
+  std::vector<int32_t> expected = table;
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    expected[indices[i]] = values[i];
+  }
+  status = pimScatter(objValues, objIndex, objTable);
+  assert(status == PIM_OK);
+  std::vector<int32_t> result(numTable);
+  status = pimCopyDeviceToHost(objTable, (void*)result.data());
+  assert(status == PIM_OK);
+  ok = ok && result == expected;
+
+  // Scatter-add: table[index[i]] += values[i]
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    expected[indices[i]] = static_cast<int32_t>(static_cast<uint32_t>(expected[indices[i]]) + static_cast<uint32_t>(values[i]));
+  }
+  status = pimScatterAdd(objValues, objIndex, objTable);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objTable, (void*)result.data());
+  assert(status == PIM_OK);
+  ok = ok && result == expected;
+
+  // FP scatter-add accumulates in index order
+  std::vector<float> fpExpected(numTable, 1.0f);
+  for (uint64_t i = 0; i < numIndices; ++i) {
+    fpExpected[indices[i]] += fpValues[i];
+  }
+  status = pimBroadcastFP(objFpTable, 1.0f);
+  assert(status == PIM_OK);
+  status = pimScatterAdd(objFpValues, objIndex, objFpTable);
+  assert(status == PIM_OK);
+  std::vector<float> fpResult(numTable);
+  status = pimCopyDeviceToHost(objFpTable, (void*)fpResult.data());
+  assert(status == PIM_OK);
+  ok = ok && fpResult == fpExpected;
+
+  // Indices must be in range, and types must match
+  std::vector<uint32_t> badIndices = { static_cast<uint32_t>(numTable) };
+  status = pimCopyHostToDevice((void*)badIndices.data(), objIndex, 0, 1);
+  assert(status == PIM_OK);
+  ok = ok && pimGather(objTable, objIndex, objValues) == PIM_ERROR;
+  ok = ok && pimScatter(objFpValues, objIndex, objTable) == PIM_ERROR;
+
+  std::printf("Result: %s gather and scatter of %llu indices\n", ok ? "Passed" : "Failed", (unsigned long long)numIndices);
+  pimShowStats();
+
+  pimFree(objTable);
+  pimFree(objFpTable);
+  pimFree(objIndex);
+  pimFree(objValues);
+  pimFree(objFpValues);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Gather and scatter" << std::endl;
+
+  bool ok = true;
+  ok = testGatherScatter(PIM_DEVICE_BITSIMD_V) && ok;
+  ok = testGatherScatter(PIM_DEVICE_FULCRUM) && ok;
+  ok = testGatherScatter(PIM_DEVICE_BANK_LEVEL) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// Test: Test native GEMV and GEMM
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+
+
+// Compare pimGemv and pimGemm of a column-major PIM matrix against host results
+template <typename T>
+bool testGemv(PimDeviceEnum deviceType, PimDataType dataType)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t M = 3000;
+  uint64_t K = 37;
+  uint64_t P = 5;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  std::vector<T> matA(M * K);
+  std::vector<T> matB(K * P);
+  for (uint64_t i = 0; i < matA.size(); ++i) {
+    matA[i] = static_cast<T>(static_cast<int>((i * 7919) % 201) - 100);
+  }
+  for (uint64_t i = 0; i < matB.size(); ++i) {
+    matB[i] = static_cast<T>(static_cast<int>((i * 104729) % 21) - 10);
+  }
+  // column-major: C(i, p) = sum_j A(i, j) * B(j, p)
+  std::vector<T> expected(M * P, 0);
+  for (uint64_t p = 0; p < P; ++p) {
+    for (uint64_t j = 0; j < K; ++j) {
+      for (uint64_t i = 0; i < M; ++i) {
+        expected[p * M + i] += matA[j * M + i] * matB[p * K + j];
+      }
+    }
+  }
+
+  PimObjId objA = pimAlloc(PIM_ALLOC_AUTO, M * K, dataType);
+  PimObjId objY = pimAlloc(PIM_ALLOC_AUTO, M, dataType);
+  PimObjId objC = pimAlloc(PIM_ALLOC_AUTO, M * P, dataType);
+  assert(objA != -1 && objY != -1 && objC != -1);
+  status = pimCopyHostToDevice((void*)matA.data(), objA);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  std::vector<T> resultY(M);
+  status = pimGemv(objA, matB.data(), objY);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objY, resultY.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < M; ++i) {
+    if (resultY[i] != expected[i]) {
+      std::printf("Error: GEMV mismatch at row %llu\n", (unsigned long long)i);
+      ok = false;
+      break;
+    }
+  }
+
+  std::vector<T> resultC(M * P);
+  status = pimGemm(objA, matB.data(), objC, P);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objC, resultC.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < M * P; ++i) {
+    if (resultC[i] != expected[i]) {
+      std::printf("Error: GEMM mismatch at index %llu\n", (unsigned long long)i);
+      ok = false;
+      break;
+    }
+  }
+
+  // dest must divide the matrix into whole columns
+  PimObjId objBad = pimAlloc(PIM_ALLOC_AUTO, 7, dataType);
+  assert(objBad != -1);
+  status = pimGemv(objA, matB.data(), objBad);
+  ok = ok && status == PIM_ERROR;
+
+  std::printf("Result: %s GEMV/GEMM (%llu x %llu x %llu): %s\n", ok ? "Passed" : "Failed",
+              (unsigned long long)M, (unsigned long long)K, (unsigned long long)P, ok ? "match" : "mismatch");
+  pimShowStats();
+
+  pimFree(objA);
+  pimFree(objY);
+  pimFree(objC);
+  pimFree(objBad);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Native GEMV and GEMM" << std::endl;
+
+  bool ok = true;
+  ok = testGemv<int>(PIM_DEVICE_BITSIMD_V, PIM_INT32) && ok;
+  ok = testGemv<int>(PIM_DEVICE_FULCRUM, PIM_INT32) && ok;
+  ok = testGemv<int>(PIM_DEVICE_BANK_LEVEL, PIM_INT32) && ok;
+  ok = testGemv<int>(PIM_DEVICE_AIM, PIM_INT32) && ok;
+  ok = testGemv<float>(PIM_DEVICE_FULCRUM, PIM_FP32) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
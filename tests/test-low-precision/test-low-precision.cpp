@@ -0,0 +1,130 @@
+// Test: Test low-precision FP storage
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+
+
+// Host to PIM copies round FP32 to the actual width with round-to-nearest-even,
+// and PIM results are rounded again when stored
+bool testLowPrecision(PimDeviceEnum deviceType, PimDataType dataType,
+                      const std::vector<float>& inputs, const std::vector<float>& expected,
+                      float addend, const std::vector<float>& expectedSums)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  uint64_t numElements = inputs.size();
+  PimObjId objSrc = pimAlloc(PIM_ALLOC_AUTO, numElements, dataType);
+  assert(objSrc != -1);
+  PimObjId objAddend = pimAllocAssociated(objSrc, dataType);
+  assert(objAddend != -1);
+  PimObjId objDest = pimAllocAssociated(objSrc, dataType);
+  assert(objDest != -1);
+
+  bool ok = true;
+  std::vector<float> result(numElements);
+  status = pimCopyHostToDevice((void*)inputs.data(), objSrc);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objSrc, (void*)result.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    if (result[i] != expected[i] && !(std::isnan(result[i]) && std::isnan(expected[i]))) {
+      std::printf("Error: Rounding mismatch of %g: %g vs %g\n", inputs[i], result[i], expected[i]);
+      ok = false;
+    }
+  }
+
+  // Element-wise add of a broadcast value
+  status = pimBroadcastFP(objAddend, addend);
+  assert(status == PIM_OK);
+  status = pimAdd(objSrc, objAddend, objDest);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objDest, (void*)result.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    if (result[i] != expectedSums[i] && !(std::isnan(result[i]) && std::isnan(expectedSums[i]))) {
+      std::printf("Error: Add mismatch of %g + %g: %g vs %g\n", expected[i], addend, result[i], expectedSums[i]);
+      ok = false;
+    }
+  }
+
+  // Ranged copies convert only the given range
+  std::vector<float> ranged = { 1.0f, 2.0f };
+  status = pimCopyHostToDevice((void*)ranged.data(), objDest, 1, 3);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(objDest, (void*)result.data());
+  assert(status == PIM_OK);
+  ok = ok && result[0] == expectedSums[0] && result[1] == 1.0f && result[2] == 2.0f && result[3] == expectedSums[3];
+
+  std::printf("Result: %s %s rounding of %llu elements\n", ok ? "Passed" : "Failed",
+              dataType == PIM_FP16 ? "FP16" : (dataType == PIM_BF16 ? "BF16" : "FP8"), (unsigned long long)numElements);
+
+  pimFree(objSrc);
+  pimFree(objAddend);
+  pimFree(objDest);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Low-precision FP storage" << std::endl;
+
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+
+  // FP16: ties to even, overflow to inf, subnormals
+  std::vector<float> fp16Inputs = { 1.0f + std::ldexp(1.0f, -11), 1.0f + 3 * std::ldexp(1.0f, -11), 65519.0f, 65520.0f,
+                                    std::ldexp(1.0f, -25), 3 * std::ldexp(1.0f, -26), -0.1f, nan };
+  std::vector<float> fp16Expected = { 1.0f, 1.0f + std::ldexp(1.0f, -9), 65504.0f, inf,
+                                      0.0f, std::ldexp(1.0f, -24), -0.0999755859375f, nan };
+  std::vector<float> fp16Sums = { 1.0f, 1.0f + std::ldexp(1.0f, -9), 65504.0f, inf,
+                                  std::ldexp(1.0f, -11), std::ldexp(1.0f, -11), -0.0994873046875f, nan };
+  // Host FP16 conversion runs in blocks of 8 elements with F16C if available, and the rest element by element.
+  // Repeat the cases so that they go through both paths
+  auto repeat = [](const std::vector<float>& vals, size_t numElements) {
+    std::vector<float> result(numElements);
+    for (size_t i = 0; i < numElements; ++i) {
+      result[i] = vals[i % vals.size()];
+    }
+    return result;
+  };
+  size_t numFp16Elements = fp16Inputs.size() * 2 + 5;
+  fp16Inputs = repeat(fp16Inputs, numFp16Elements);
+  fp16Expected = repeat(fp16Expected, numFp16Elements);
+  fp16Sums = repeat(fp16Sums, numFp16Elements);
+
+  // BF16: ties to even, 8-bit mantissa precision
+  std::vector<float> bf16Inputs = { 1.0f + std::ldexp(1.0f, -8), 1.0f + 3 * std::ldexp(1.0f, -8), 3.14159265f, -1e-3f };
+  std::vector<float> bf16Expected = { 1.0f, 1.0f + std::ldexp(1.0f, -6), 3.140625f, -0.00099945068359375f };
+  std::vector<float> bf16Sums = { 1.0f, 1.0f + std::ldexp(1.0f, -6), 3.140625f, 0.00095367431640625f };
+
+  // FP8 E4M3: ties to even, saturation to 448, subnormals
+  std::vector<float> fp8Inputs = { 1.0625f, 1.1875f, 448.0f, 1000.0f, std::ldexp(1.0f, -10), 3 * std::ldexp(1.0f, -10), 0.3f, -inf };
+  std::vector<float> fp8Expected = { 1.0f, 1.25f, 448.0f, 448.0f, 0.0f, std::ldexp(1.0f, -8), 0.3125f, -448.0f };
+  std::vector<float> fp8Sums = { 1.125f, 1.375f, 448.0f, 448.0f, 0.125f, 0.125f, 0.4375f, -448.0f };
+
+  bool ok = true;
+  for (PimDeviceEnum deviceType : { PIM_DEVICE_BITSIMD_V, PIM_DEVICE_FULCRUM }) {
+    ok = testLowPrecision(deviceType, PIM_FP16, fp16Inputs, fp16Expected, std::ldexp(1.0f, -11), fp16Sums) && ok;
+    ok = testLowPrecision(deviceType, PIM_BF16, bf16Inputs, bf16Expected, std::ldexp(1.0f, -9), bf16Sums) && ok;
+    ok = testLowPrecision(deviceType, PIM_FP8, fp8Inputs, fp8Expected, 0.125f, fp8Sums) && ok;
+  }
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
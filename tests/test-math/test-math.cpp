@@ -0,0 +1,217 @@
+// Test: Test elementwise math approximations
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <string>
+
+
+enum MathFunc { EXP = 0, LOG, SQRT, RECIP, SIGMOID, TANH };
+static const char* funcNames[] = { "exp", "log", "sqrt", "recip", "sigmoid", "tanh" };
+
+PimStatus runPim(MathFunc func, PimObjId src, PimObjId dest, PimMathPrecision precision, unsigned numFracBits = 0)
+{
+  switch (func) {
+    case EXP: return pimExp(src, dest, precision, numFracBits);
+    case LOG: return pimLog(src, dest, precision, numFracBits);
+    case SQRT: return pimSqrt(src, dest, precision, numFracBits);
+    case RECIP: return pimRecip(src, dest, precision, numFracBits);
+    case SIGMOID: return pimSigmoid(src, dest, precision, numFracBits);
+    case TANH: return pimTanh(src, dest, precision, numFracBits);
+  }
+  return PIM_ERROR;
+}
+
+double runHost(MathFunc func, double val)
+{
+  switch (func) {
+    case EXP: return std::exp(val);
+    case LOG: return std::log(val);
+    case SQRT: return std::sqrt(val);
+    case RECIP: return 1.0 / val;
+    case SIGMOID: return 1.0 / (1.0 + std::exp(-val));
+    case TANH: return std::tanh(val);
+  }
+  return 0.0;
+}
+
+// FP32 inputs covering the domain of each function, plus special values
+std::vector<float> getInputs(MathFunc func, uint64_t numElements)
+{
+  std::vector<float> src(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    float frac = static_cast<float>((i * 2654435761ULL) % 1000003) / 1000003.0f;
+    switch (func) {
+      case EXP: src[i] = frac * 160.0f - 80.0f; break;
+      case LOG: case SQRT: src[i] = std::exp(frac * 160.0f - 80.0f); break;
+      case RECIP: src[i] = std::exp(frac * 160.0f - 80.0f) * (i % 2 ? -1.0f : 1.0f); break;
+      case SIGMOID: case TANH: src[i] = frac * 40.0f - 20.0f; break;
+    }
+  }
+  float inf = std::numeric_limits<float>::infinity();
+  std::vector<float> specials = { 0.0f, 1.0f, -1.0f, inf, -inf, std::nanf(""), 1e-40f, 1e-3f, -1e-3f };
+  for (size_t i = 0; i < specials.size(); ++i) {
+    src[i] = specials[i];
+  }
+  return src;
+}
+
+// Compare FP32 results against host math with relative error tolerance
+bool testFP(MathFunc func, PimMathPrecision precision, uint64_t numElements)
+{
+  std::vector<float> src = getInputs(func, numElements);
+  PimObjId objSrc = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_FP32);
+  assert(objSrc != -1);
+  PimObjId objDest = pimAllocAssociated(objSrc, PIM_FP32);
+  assert(objDest != -1);
+  PimStatus status = pimCopyHostToDevice((void*)src.data(), objSrc);
+  assert(status == PIM_OK);
+  status = runPim(func, objSrc, objDest, precision);
+  assert(status == PIM_OK);
+  std::vector<float> dest(numElements);
+  status = pimCopyDeviceToHost(objDest, (void*)dest.data());
+  assert(status == PIM_OK);
+
+  double tolerance = (precision == PIM_MATH_PRECISE ? 2e-6 : 3e-3);
+  double maxErr = 0.0;
+  bool ok = true;
+  for (uint64_t i = 0; i < numElements; ++i) {
+    double expected = static_cast<float>(runHost(func, src[i]));  // FP32 overflows and underflows
+    double result = dest[i];
+    bool match = false;
+    if (std::isnan(expected) || std::isinf(expected) || expected == 0.0) {
+      match = (std::isnan(expected) && std::isnan(result)) || expected == result ||
+              std::fabs(expected - result) <= std::numeric_limits<float>::denorm_min();
+    } else if (std::fabs(expected) < std::numeric_limits<float>::min()) {
+      match = std::fabs(expected - result) <= tolerance * std::numeric_limits<float>::min();
+    } else {
+      double err = std::fabs(expected - result) / std::fabs(expected);
+      maxErr = std::max(maxErr, err);
+      match = (err <= tolerance);
+    }
+    if (!match) {
+      std::printf("Error: %s mismatch at index %llu: %s(%g) = %g vs %g\n", funcNames[func], (unsigned long long)i,
+                  funcNames[func], src[i], result, expected);
+      ok = false;
+      break;
+    }
+  }
+  std::printf("  %s %s: max relative error %g\n", funcNames[func], precision == PIM_MATH_PRECISE ? "precise" : "fast", maxErr);
+
+  pimFree(objSrc);
+  pimFree(objDest);
+  return ok;
+}
+
+// Compare Q16.16 fixed-point results against rounded and saturated host results
+bool testFixedPoint(MathFunc func, uint64_t numElements)
+{
+  unsigned numFracBits = 16;
+  double scale = 65536.0;
+  std::vector<int32_t> src(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src[i] = static_cast<int32_t>((i * 2654435761ULL) % (24 << numFracBits)) - (12 << numFracBits);
+  }
+  PimObjId objSrc = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(objSrc != -1);
+  PimObjId objDest = pimAllocAssociated(objSrc, PIM_INT32);
+  assert(objDest != -1);
+  PimStatus status = pimCopyHostToDevice((void*)src.data(), objSrc);
+  assert(status == PIM_OK);
+  status = runPim(func, objSrc, objDest, PIM_MATH_PRECISE, numFracBits);
+  assert(status == PIM_OK);
+  std::vector<int32_t> dest(numElements);
+  status = pimCopyDeviceToHost(objDest, (void*)dest.data());
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  for (uint64_t i = 0; i < numElements; ++i) {
+    double expected = runHost(func, src[i] / scale) * scale;
+    if (std::isnan(expected)) {
+      expected = 0.0;
+    }
+    expected = std::max<double>(std::min<double>(expected, INT32_MAX), INT32_MIN);
+    if (std::fabs(expected - dest[i]) > 1.0 + 2e-6 * std::fabs(expected)) {
+      std::printf("Error: Fixed-point %s mismatch at index %llu: %d vs %g\n", funcNames[func], (unsigned long long)i,
+                  dest[i], expected);
+      ok = false;
+      break;
+    }
+  }
+
+  pimFree(objSrc);
+  pimFree(objDest);
+  return ok;
+}
+
+bool testMath(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numElements = 100001;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  for (MathFunc func : { EXP, LOG, SQRT, RECIP, SIGMOID, TANH }) {
+    ok = testFP(func, PIM_MATH_PRECISE, numElements) && ok;
+    ok = testFP(func, PIM_MATH_FAST, numElements) && ok;
+    ok = testFixedPoint(func, numElements) && ok;
+  }
+
+  // Integers without fractional bits, e.g., exp of non-positive integers in softmax
+  std::vector<int32_t> src = { 0, -1, 2, 25, -100 };
+  PimObjId objSrc = pimAlloc(PIM_ALLOC_AUTO, src.size(), PIM_INT32);
+  assert(objSrc != -1);
+  PimObjId objDest = pimAllocAssociated(objSrc, PIM_INT32);
+  assert(objDest != -1);
+  PimObjId objFp = pimAllocAssociated(objSrc, PIM_FP32);
+  assert(objFp != -1);
+  status = pimCopyHostToDevice((void*)src.data(), objSrc);
+  assert(status == PIM_OK);
+  status = pimExp(objSrc, objDest);
+  assert(status == PIM_OK);
+  std::vector<int32_t> dest(src.size());
+  status = pimCopyDeviceToHost(objDest, (void*)dest.data());
+  assert(status == PIM_OK);
+  ok = ok && dest == std::vector<int32_t>({ 1, 0, 7, INT32_MAX, 0 });
+
+  // Fractional bits must fit the data type, FP types have no fractional bits, and types must match
+  ok = ok && pimExp(objSrc, objDest, PIM_MATH_PRECISE, 32) == PIM_ERROR;
+  ok = ok && pimExp(objFp, objFp, PIM_MATH_PRECISE, 8) == PIM_ERROR;
+  ok = ok && pimExp(objSrc, objFp) == PIM_ERROR;
+
+  std::printf("Result: %s math approximations\n", ok ? "Passed" : "Failed");
+  pimShowStats();
+
+  pimFree(objSrc);
+  pimFree(objDest);
+  pimFree(objFp);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Elementwise math approximations" << std::endl;
+
+  bool ok = true;
+  ok = testMath(PIM_DEVICE_BITSIMD_V) && ok;
+  ok = testMath(PIM_DEVICE_FULCRUM) && ok;
+  ok = testMath(PIM_DEVICE_BANK_LEVEL) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// Test: Test multiple PIM devices
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+
+// Shard a vector add across devices, then gather partial results into device 0 with inter-device copies
+bool testMultiDevice(PimDeviceEnum deviceType, unsigned numDevices)
+{
+  unsigned numRanks = 1;
+  unsigned numBankPerRank = 4;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+
+  uint64_t numElementsPerDevice = 16 * 1024;
+  uint64_t numElements = numElementsPerDevice * numDevices;
+
+  std::vector<int> srcA(numElements);
+  std::vector<int> srcB(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    srcA[i] = static_cast<int>(i % 1000);
+    srcB[i] = static_cast<int>(i % 37) - 18;
+  }
+
+  PimStatus status = PIM_OK;
+  std::vector<PimObjId> objDest(numDevices, -1);
+  for (unsigned d = 0; d < numDevices; ++d) {
+    status = pimSetDevice(d);
+    assert(status == PIM_OK);
+    status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+    assert(status == PIM_OK);
+    assert(pimGetDevice() == static_cast<PimDeviceId>(d));
+
+    PimObjId objA = pimAlloc(PIM_ALLOC_AUTO, numElementsPerDevice, PIM_INT32);
+    PimObjId objB = pimAllocAssociated(objA, PIM_INT32);
+    objDest[d] = pimAllocAssociated(objA, PIM_INT32);
+    assert(objA != -1 && objB != -1 && objDest[d] != -1);
+    status = pimCopyHostToDevice((void*)(srcA.data() + d * numElementsPerDevice), objA);
+    assert(status == PIM_OK);
+    status = pimCopyHostToDevice((void*)(srcB.data() + d * numElementsPerDevice), objB);
+    assert(status == PIM_OK);
+    status = pimAdd(objA, objB, objDest[d]);
+    assert(status == PIM_OK);
+  }
+  assert(pimGetNumDevices() == numDevices);
+
+  // Gather into device 0, which keeps one slot per device
+  status = pimSetDevice(0);
+  assert(status == PIM_OK);
+  PimObjId objGather = pimAlloc(PIM_ALLOC_AUTO, numElementsPerDevice, PIM_INT32);
+  assert(objGather != -1);
+  bool ok = true;
+  for (unsigned d = 0; d < numDevices; ++d) {
+    status = pimCopyInterDevice(d, objDest[d], 0, objGather);
+    assert(status == PIM_OK);
+    std::vector<int> dest(numElementsPerDevice);
+    status = pimCopyDeviceToHost(objGather, (void*)dest.data());
+    assert(status == PIM_OK);
+    for (uint64_t i = 0; i < numElementsPerDevice; ++i) {
+      uint64_t idx = d * numElementsPerDevice + i;
+      if (dest[i] != srcA[idx] + srcB[idx]) {
+        std::printf("Error: Mismatch in device %u at index %llu: %d vs %d\n", d, (unsigned long long)i, dest[i], srcA[idx] + srcB[idx]);
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  // A ranged copy only needs the range in both objects
+  PimObjId objLarge = pimAlloc(PIM_ALLOC_AUTO, numElementsPerDevice * 2, PIM_INT32);
+  assert(objLarge != -1);
+  uint64_t idxEnd = numElementsPerDevice / 2;
+  status = pimCopyInterDevice(numDevices - 1, objDest[numDevices - 1], 0, objLarge, 0, idxEnd);
+  assert(status == PIM_OK);
+  std::vector<int> destLarge(numElementsPerDevice * 2);
+  status = pimCopyDeviceToHost(objLarge, (void*)destLarge.data());
+  assert(status == PIM_OK);
+  for (uint64_t i = 0; i < idxEnd; ++i) {
+    uint64_t idx = (numDevices - 1) * numElementsPerDevice + i;
+    if (destLarge[i] != srcA[idx] + srcB[idx]) {
+      std::printf("Error: Mismatch of ranged copy at index %llu: %d vs %d\n", (unsigned long long)i, destLarge[i], srcA[idx] + srcB[idx]);
+      ok = false;
+      break;
+    }
+  }
+  status = pimCopyInterDevice(numDevices - 1, objDest[numDevices - 1], 0, objLarge, 0, numElementsPerDevice + 1);
+  assert(status == PIM_ERROR);
+
+  // Mismatched data types are rejected
+  PimObjId objChar = pimAlloc(PIM_ALLOC_AUTO, numElementsPerDevice, PIM_INT8);
+  assert(objChar != -1);
+  status = pimCopyInterDevice(numDevices - 1, objDest[numDevices - 1], 0, objChar);
+  assert(status == PIM_ERROR || numDevices == 1);
+
+  pimShowStats();
+
+  for (unsigned d = numDevices; d-- > 0;) {
+    status = pimSetDevice(d);
+    assert(status == PIM_OK);
+    pimDeleteDevice();
+  }
+  assert(pimGetNumDevices() == 0);
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Multiple PIM devices" << std::endl;
+
+  bool ok = true;
+  ok = testMultiDevice(PIM_DEVICE_BITSIMD_V, 2) && ok;
+  ok = testMultiDevice(PIM_DEVICE_FULCRUM, 3) && ok;
+  ok = testMultiDevice(PIM_DEVICE_BANK_LEVEL, 2) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
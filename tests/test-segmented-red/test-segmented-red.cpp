@@ -0,0 +1,121 @@
+// Test: Test segmented reductions
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+
+// Compare segmented reductions against per-segment ranged reductions and host results
+bool testSegmentedRed(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numElements = 65536;
+  uint64_t segmentLen = 1000; // segments span region boundaries, and the last one is partial
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  std::vector<int> src(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src[i] = static_cast<int>((i * 7919) % 2001) - 1000;
+  }
+  PimObjId obj = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj != -1);
+  status = pimCopyHostToDevice((void*)src.data(), obj);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+
+  // Fixed segment length
+  uint64_t numSegments = (numElements + segmentLen - 1) / segmentLen;
+  std::vector<int64_t> sums(numSegments);
+  std::vector<int> mins(numSegments);
+  std::vector<int> maxs(numSegments);
+  status = pimRedSumSegmented(obj, (void*)sums.data(), segmentLen);
+  assert(status == PIM_OK);
+  status = pimRedMinSegmented(obj, (void*)mins.data(), segmentLen);
+  assert(status == PIM_OK);
+  status = pimRedMaxSegmented(obj, (void*)maxs.data(), segmentLen);
+  assert(status == PIM_OK);
+  for (uint64_t seg = 0; seg < numSegments && ok; ++seg) {
+    uint64_t idxBegin = seg * segmentLen;
+    uint64_t idxEnd = std::min(idxBegin + segmentLen, numElements);
+    int64_t expectedSum = 0;
+    int expectedMin = std::numeric_limits<int>::max();
+    int expectedMax = std::numeric_limits<int>::lowest();
+    for (uint64_t i = idxBegin; i < idxEnd; ++i) {
+      expectedSum += src[i];
+      expectedMin = std::min(expectedMin, src[i]);
+      expectedMax = std::max(expectedMax, src[i]);
+    }
+    int64_t rangedSum = 0;
+    status = pimRedSum(obj, (void*)&rangedSum, idxBegin, idxEnd);
+    assert(status == PIM_OK);
+    if (sums[seg] != expectedSum || rangedSum != expectedSum || mins[seg] != expectedMin || maxs[seg] != expectedMax) {
+      std::printf("Error: Segment %llu mismatch: sum %lld vs %lld, min %d vs %d, max %d vs %d\n", (unsigned long long)seg,
+                  (long long)sums[seg], (long long)expectedSum, mins[seg], expectedMin, maxs[seg], expectedMax);
+      ok = false;
+    }
+  }
+
+  // Variable-length segments, including an empty one, not covering the whole object
+  std::vector<uint64_t> offsets = { 10, 17, 5000, 5000, 20000, 20001, 65000 };
+  uint64_t numOffsetSegments = offsets.size() - 1;
+  std::vector<int64_t> offsetSums(numOffsetSegments);
+  std::vector<int> offsetMaxs(numOffsetSegments);
+  status = pimRedSumSegmentedByOffsets(obj, (void*)offsetSums.data(), offsets.data(), numOffsetSegments);
+  assert(status == PIM_OK);
+  status = pimRedMaxSegmentedByOffsets(obj, (void*)offsetMaxs.data(), offsets.data(), numOffsetSegments);
+  assert(status == PIM_OK);
+  for (uint64_t seg = 0; seg < numOffsetSegments && ok; ++seg) {
+    int64_t expectedSum = 0;
+    int expectedMax = std::numeric_limits<int>::lowest();
+    for (uint64_t i = offsets[seg]; i < offsets[seg + 1]; ++i) {
+      expectedSum += src[i];
+      expectedMax = std::max(expectedMax, src[i]);
+    }
+    if (offsetSums[seg] != expectedSum || offsetMaxs[seg] != expectedMax) {
+      std::printf("Error: Offset segment %llu mismatch: sum %lld vs %lld, max %d vs %d\n", (unsigned long long)seg,
+                  (long long)offsetSums[seg], (long long)expectedSum, offsetMaxs[seg], expectedMax);
+      ok = false;
+    }
+  }
+
+  // Invalid segments
+  std::vector<uint64_t> badOffsets = { 0, 100, 50 };
+  status = pimRedSumSegmentedByOffsets(obj, (void*)offsetSums.data(), badOffsets.data(), badOffsets.size() - 1);
+  ok = ok && status == PIM_ERROR;
+  status = pimRedSumSegmented(obj, (void*)sums.data(), 0);
+  ok = ok && status == PIM_ERROR;
+
+  // One segmented reduction versus one ranged reduction per segment
+  pimShowStats();
+
+  pimFree(obj);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Segmented reductions" << std::endl;
+
+  bool ok = true;
+  ok = testSegmentedRed(PIM_DEVICE_BITSIMD_V) && ok;
+  ok = testSegmentedRed(PIM_DEVICE_FULCRUM) && ok;
+  ok = testSegmentedRed(PIM_DEVICE_BANK_LEVEL) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// Test: Test sub-byte integer types
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <bitset>
+#include <algorithm>
+#include <type_traits>
+
+
+// Wrap a value into the range of a numBits-bit integer, as stored by PIM
+template <typename T> T wrap(int64_t val, unsigned numBits)
+{
+  int64_t mask = (1LL << numBits) - 1;
+  val &= mask;
+  if (std::is_signed<T>::value) {
+    int64_t signBit = 1LL << (numBits - 1);
+    val = (val ^ signBit) - signBit;
+  }
+  return static_cast<T>(val);
+}
+
+// Sub-byte integers use one host byte per element, while PIM wraps results to numBits bits
+template <typename T> bool testSubByte(PimDeviceEnum deviceType, PimDataType dataType, unsigned numBits)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numElements = 100001; // odd number of elements to cover partial bytes
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  int64_t minVal = std::is_signed<T>::value ? -(1LL << (numBits - 1)) : 0;
+  int64_t maxVal = std::is_signed<T>::value ? (1LL << (numBits - 1)) - 1 : (1LL << numBits) - 1;
+  std::vector<T> src1(numElements);
+  std::vector<T> src2(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src1[i] = static_cast<T>(minVal + std::rand() % (maxVal - minVal + 1));
+    src2[i] = static_cast<T>(minVal + std::rand() % (maxVal - minVal + 1));
+  }
+
+  PimObjId obj1 = pimAlloc(PIM_ALLOC_AUTO, numElements, dataType);
+  assert(obj1 != -1);
+  PimObjId obj2 = pimAllocAssociated(obj1, dataType);
+  assert(obj2 != -1);
+  PimObjId objDest = pimAllocAssociated(obj1, dataType);
+  assert(objDest != -1);
+
+  bool ok = true;
+  std::vector<T> dest(numElements);
+  status = pimCopyHostToDevice((void*)src1.data(), obj1);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)src2.data(), obj2);
+  assert(status == PIM_OK);
+  status = pimCopyDeviceToHost(obj1, (void*)dest.data());
+  assert(status == PIM_OK);
+  ok = ok && dest == src1;
+
+  // Element-wise results wrap around at numBits bits
+  for (int testId = 0; testId < 4; ++testId) {
+    switch (testId) {
+      case 0: status = pimAdd(obj1, obj2, objDest); break;
+      case 1: status = pimMul(obj1, obj2, objDest); break;
+      case 2: status = pimAbs(obj1, objDest); break;
+      case 3: status = pimPopCount(obj1, objDest); break;
+    }
+    assert(status == PIM_OK);
+    status = pimCopyDeviceToHost(objDest, (void*)dest.data());
+    assert(status == PIM_OK);
+    for (uint64_t i = 0; i < numElements; ++i) {
+      int64_t expected = 0;
+      switch (testId) {
+        case 0: expected = static_cast<int64_t>(src1[i]) + src2[i]; break;
+        case 1: expected = static_cast<int64_t>(src1[i]) * src2[i]; break;
+        case 2: expected = std::abs(static_cast<int64_t>(src1[i])); break;
+        case 3: expected = std::bitset<8>(src1[i] & ((1 << numBits) - 1)).count(); break;
+      }
+      if (dest[i] != wrap<T>(expected, numBits)) {
+        std::printf("Error: Test %d mismatch at index %llu: %d vs %d\n", testId, (unsigned long long)i,
+                    static_cast<int>(dest[i]), static_cast<int>(wrap<T>(expected, numBits)));
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  // Reductions
+  using SumType = typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type;
+  SumType sum = 0;
+  SumType sumExpected = 0;
+  for (uint64_t i = 0; i < numElements; ++i) {
+    sumExpected += src1[i];
+  }
+  T minResult = 0;
+  T maxResult = 0;
+  status = pimRedSum(obj1, &sum);
+  assert(status == PIM_OK);
+  status = pimRedMin(obj1, &minResult);
+  assert(status == PIM_OK);
+  status = pimRedMax(obj1, &maxResult);
+  assert(status == PIM_OK);
+  ok = ok && sum == sumExpected;
+  ok = ok && minResult == *std::min_element(src1.begin(), src1.end());
+  ok = ok && maxResult == *std::max_element(src1.begin(), src1.end());
+
+  // Ranged copies and object copies may start or end in the middle of a byte
+  std::vector<T> ranged = { static_cast<T>(maxVal), static_cast<T>(minVal), static_cast<T>(maxVal) };
+  status = pimCopyHostToDevice((void*)ranged.data(), obj2, 3, 6);
+  assert(status == PIM_OK);
+  status = pimCopyObjectToObject(obj2, objDest);
+  assert(status == PIM_OK);
+  std::vector<T> rangedResult(5);
+  status = pimCopyDeviceToHost(objDest, (void*)rangedResult.data(), 2, 7);
+  assert(status == PIM_OK);
+  ok = ok && rangedResult[0] == src2[2] && rangedResult[1] == ranged[0] && rangedResult[2] == ranged[1] &&
+       rangedResult[3] == ranged[2] && rangedResult[4] == src2[6];
+
+  std::printf("Result: %s %u-bit %s integers\n", ok ? "Passed" : "Failed", numBits,
+              std::is_signed<T>::value ? "signed" : "unsigned");
+  pimShowStats();
+
+  pimFree(obj1);
+  pimFree(obj2);
+  pimFree(objDest);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Sub-byte integer types" << std::endl;
+
+  bool ok = true;
+  for (PimDeviceEnum deviceType : { PIM_DEVICE_BITSIMD_V, PIM_DEVICE_FULCRUM, PIM_DEVICE_BANK_LEVEL }) {
+    ok = testSubByte<int8_t>(deviceType, PIM_INT4, 4) && ok;
+    ok = testSubByte<uint8_t>(deviceType, PIM_UINT4, 4) && ok;
+    ok = testSubByte<int8_t>(deviceType, PIM_INT2, 2) && ok;
+    ok = testSubByte<uint8_t>(deviceType, PIM_UINT2, 2) && ok;
+  }
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Test: Test top-k selection
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <numeric>
+
+
+// Host reference: indices of the k best elements ordered from the best, with ties broken by lower index
+template <typename T> std::vector<uint64_t> hostTopK(const std::vector<T>& src, uint64_t k, bool isSmallest)
+{
+  std::vector<uint64_t> indices(src.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::stable_sort(indices.begin(), indices.end(), [&](uint64_t a, uint64_t b) {
+    return isSmallest ? src[a] < src[b] : src[a] > src[b];
+  });
+  indices.resize(k);
+  return indices;
+}
+
+// Compare top-k values and indices against host results
+template <typename T> bool checkTopK(PimObjId obj, const std::vector<T>& src, uint64_t k, bool isSmallest)
+{
+  std::vector<T> values(k);
+  std::vector<uint64_t> indices(k);
+  PimStatus status = pimTopK(obj, k, (void*)values.data(), indices.data(), isSmallest);
+  assert(status == PIM_OK);
+  std::vector<uint64_t> expected = hostTopK(src, k, isSmallest);
+  for (uint64_t i = 0; i < k; ++i) {
+    if (indices[i] != expected[i] || values[i] != src[expected[i]]) {
+      std::printf("Error: Top-%llu %s mismatch at rank %llu: index %llu vs %llu\n", (unsigned long long)k,
+                  isSmallest ? "smallest" : "largest", (unsigned long long)i, (unsigned long long)indices[i],
+                  (unsigned long long)expected[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testTopK(PimDeviceEnum deviceType)
+{
+  unsigned numRanks = 2;
+  unsigned numBankPerRank = 2;
+  unsigned numSubarrayPerBank = 8;
+  unsigned numRows = 1024;
+  unsigned numCols = 8192;
+  uint64_t numElements = 300001;
+
+  PimStatus status = pimCreateDevice(deviceType, numRanks, numBankPerRank, numSubarrayPerBank, numRows, numCols);
+  assert(status == PIM_OK);
+
+  // Values with many duplicates to cover tie breaking across regions
+  std::vector<int32_t> src(numElements);
+  std::vector<float> fpSrc(numElements);
+  for (uint64_t i = 0; i < numElements; ++i) {
+    src[i] = static_cast<int32_t>((i * 2654435761ULL) % 5000) - 2500;
+    fpSrc[i] = static_cast<float>((i * 40503ULL) % 7919) * 0.5f - 1000.0f;
+  }
+
+  PimObjId obj = pimAlloc(PIM_ALLOC_AUTO, numElements, PIM_INT32);
+  assert(obj != -1);
+  PimObjId objFp = pimAllocAssociated(obj, PIM_FP32);
+  assert(objFp != -1);
+  status = pimCopyHostToDevice((void*)src.data(), obj);
+  assert(status == PIM_OK);
+  status = pimCopyHostToDevice((void*)fpSrc.data(), objFp);
+  assert(status == PIM_OK);
+
+  bool ok = true;
+  for (uint64_t k : { 1ULL, 10ULL, 1000ULL }) {
+    ok = checkTopK(obj, src, k, false) && ok;
+    ok = checkTopK(obj, src, k, true) && ok;
+    ok = checkTopK(objFp, fpSrc, k, false) && ok;
+    ok = checkTopK(objFp, fpSrc, k, true) && ok;
+  }
+
+  // Selecting all elements is a full sort
+  std::vector<uint64_t> indices(numElements);
+  status = pimTopK(obj, numElements, nullptr, indices.data(), true);
+  assert(status == PIM_OK);
+  ok = ok && indices == hostTopK(src, numElements, true);
+
+  // k must be in range, and at least one output is needed
+  int32_t val = 0;
+  uint64_t idx = 0;
+  ok = ok && pimTopK(obj, 0, &val, &idx) == PIM_ERROR;
+  ok = ok && pimTopK(obj, numElements + 1, nullptr, indices.data()) == PIM_ERROR;
+  ok = ok && pimTopK(obj, 1, nullptr, nullptr) == PIM_ERROR;
+
+  std::printf("Result: %s top-k selection of %llu elements\n", ok ? "Passed" : "Failed", (unsigned long long)numElements);
+  pimShowStats();
+
+  pimFree(obj);
+  pimFree(objFp);
+  pimDeleteDevice();
+  return ok;
+}
+
+int main()
+{
+  std::cout << "PIM Regression Test: Top-k selection" << std::endl;
+
+  bool ok = true;
+  ok = testTopK(PIM_DEVICE_BITSIMD_V) && ok;
+  ok = testTopK(PIM_DEVICE_FULCRUM) && ok;
+  ok = testTopK(PIM_DEVICE_BANK_LEVEL) && ok;
+
+  std::cout << (ok ? "ALL PASSED!" : "FAILED!") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+// File: pim-replay.cpp
+// PIMeval Simulator - Replay a binary PIM API trace
+// Copyright (c) 2024 University of Virginia
+// This file is licensed under the MIT License.
+// See the LICENSE file in the root of this repository for more details.
+
+// Record a trace by running any PIM application with PIMEVAL_TRACE_FILE=<trace-file>,
+// and optionally PIMEVAL_TRACE_PAYLOAD=1 to capture input data for functional replay.
+
+#include "libpimeval.h"
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <getopt.h>
+
+struct Params
+{
+  std::string traceFile;
+  PimDeviceEnum deviceType = PIM_DEVICE_NONE;
+  std::string configFile;
+};
+
+void usage()
+{
+  std::cerr << "Usage: pim-replay.out <trace-file> [-d <device-type>] [-c <config-file>]\n"
+            << "  -d  override device type, e.g., PIM_DEVICE_BITSIMD_V, PIM_DEVICE_FULCRUM\n"
+            << "  -c  override simulator config file\n";
+}
+
+bool parseDeviceType(const std::string& str, PimDeviceEnum& deviceType)
+{
+  static const std::unordered_map<std::string, PimDeviceEnum> strToDevice = {
+    {"PIM_FUNCTIONAL", PIM_FUNCTIONAL},
+    {"PIM_DEVICE_BITSIMD_V", PIM_DEVICE_BITSIMD_V},
+    {"PIM_DEVICE_BITSIMD_V_NAND", PIM_DEVICE_BITSIMD_V_NAND},
+    {"PIM_DEVICE_BITSIMD_V_MAJ", PIM_DEVICE_BITSIMD_V_MAJ},
+    {"PIM_DEVICE_BITSIMD_V_AP", PIM_DEVICE_BITSIMD_V_AP},
+    {"PIM_DEVICE_DRISA_NOR", PIM_DEVICE_DRISA_NOR},
+    {"PIM_DEVICE_DRISA_MIXED", PIM_DEVICE_DRISA_MIXED},
+    {"PIM_DEVICE_SIMDRAM", PIM_DEVICE_SIMDRAM},
+    {"PIM_DEVICE_BITSIMD_H", PIM_DEVICE_BITSIMD_H},
+    {"PIM_DEVICE_FULCRUM", PIM_DEVICE_FULCRUM},
+    {"PIM_DEVICE_BANK_LEVEL", PIM_DEVICE_BANK_LEVEL},
+    {"PIM_DEVICE_AQUABOLT", PIM_DEVICE_AQUABOLT},
+    {"PIM_DEVICE_AIM", PIM_DEVICE_AIM},
+  };
+  auto it = strToDevice.find(str);
+  if (it == strToDevice.end()) {
+    return false;
+  }
+  deviceType = it->second;
+  return true;
+}
+
+bool parseParams(int argc, char* argv[], Params& params)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "hd:c:")) >= 0) {
+    switch (opt) {
+    case 'd':
+      if (!parseDeviceType(optarg, params.deviceType)) {
+        std::cerr << "Error: Unknown device type " << optarg << std::endl;
+        return false;
+      }
+      break;
+    case 'c':
+      params.configFile = optarg;
+      break;
+    default:
+      return false;
+    }
+  }
+  if (optind != argc - 1) {
+    return false;
+  }
+  params.traceFile = argv[optind];
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  Params params;
+  if (!parseParams(argc, argv, params)) {
+    usage();
+    return 1;
+  }
+
+  PimStatus status = pimReplayTrace(params.traceFile.c_str(), params.deviceType,
+                                    params.configFile.empty() ? nullptr : params.configFile.c_str());
+  return status == PIM_OK ? 0 : 1;
+}
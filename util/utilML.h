@@ -88,30 +88,13 @@ void softMaxPIM(const std::vector<int> src, std::vector<int> &dst)
     return;
   }
   
-  dst.resize(vectorLength);
-  status = pimCopyDeviceToHost(srcObj, (void *) dst.data());
+  status = pimExp(srcObj, srcObj);
   if (status != PIM_OK)
   {
-    std::cout << "Function: " << __func__ << "Abort: pimCopyHostToDevice failed for dst vector" << std::endl;
+    std::cout << "Function: " << __func__ << "Abort: pimExp failed" << std::endl;
     return;
   }
 
-  auto start = std::chrono::high_resolution_clock::now();
-  #pragma omp parallel for
-  for (size_t i = 0; i < vectorLength; ++i)
-  {
-    dst[i] = std::exp(static_cast<double>(dst[i]));
-  }
-  auto end = std::chrono::high_resolution_clock::now();
-  hostElapsedTime += (end - start);
-
-  status = pimCopyHostToDevice((void *) dst.data(), srcObj);
-  if (status != PIM_OK)
-  {
-    std::cout << "Function: " << __func__ << "Abort: pimCopyHostToDevice failed for dst vector" << std::endl;
-    return;
-  }
-  
   int32_t redsum = 0;
   status = pimRedSum(srcObj, &redsum);
   if (status != PIM_OK)
@@ -127,6 +110,7 @@ void softMaxPIM(const std::vector<int> src, std::vector<int> &dst)
     return;
   }
 
+  dst.resize(vectorLength);
   status = pimCopyDeviceToHost(srcObj, (void *) dst.data());
   if (status != PIM_OK)
   {
@@ -498,46 +482,79 @@ void pool(std::vector<std::vector<std::vector<int>>> &inputMatrix, int kernelHei
 
 // Performs General Matrix-Vector Multiplication (GEMV) in PIM
 // The function computes the matrix-vector product of the source matrix and the source vector, and stores the result in the destination vector.
-// The function allocates PIM objects, performs element-wise multiplication, and accumulates the results.
-// The accumulated results are then copied from the PIM (device) to the host. 
+// The source matrix is given column by column. Columns are copied to PIM in tiles that fit in half of the device capacity,
+// each tile is multiplied with pimGemv, and the partial results of the tiles are accumulated in the destination object.
+// The accumulated results are then copied from the PIM (device) to the host.
 void gemv(uint64_t row, uint64_t col, std::vector<int> &srcVector, std::vector<std::vector<int>> &srcMatrix, std::vector<int> &dst)
 {
-  PimObjId srcObj = pimAlloc(PIM_ALLOC_AUTO, row, PIM_INT32);
-  if (srcObj == -1)
+  PimDeviceProperties deviceProp;
+  PimStatus status = pimGetDeviceProperties(&deviceProp);
+  if (status != PIM_OK)
   {
-    std::cout << "Function: " << __func__ << ", Abort: pimAlloc failed for srcObj" << std::endl;
+    std::cout << "Function: " << __func__ << ", Abort: pimGetDeviceProperties failed" << std::endl;
     return;
   }
+  uint64_t numOfBits = uint64_t(deviceProp.numRanks) * uint64_t(deviceProp.numBankPerRank) *
+                       uint64_t(deviceProp.numSubarrayPerBank) * deviceProp.numRowPerSubarray * deviceProp.numColPerSubarray;
+  uint64_t colsPerTile = std::min<uint64_t>(col, std::max<uint64_t>(1, numOfBits / 2 / 32 / row));
 
-  PimObjId dstObj = pimAllocAssociated(srcObj, PIM_INT32);
+  PimObjId matObj = pimAlloc(PIM_ALLOC_AUTO, row * colsPerTile, PIM_INT32);
+  if (matObj == -1)
+  {
+    std::cout << "Function: " << __func__ << ", Abort: pimAlloc failed for matObj" << std::endl;
+    return;
+  }
+
+  PimObjId dstObj = pimAlloc(PIM_ALLOC_AUTO, row, PIM_INT32);
   if (dstObj == -1)
   {
-    std::cout << "Function: " << __func__ << ", Abort: pimAllocAssociated failed for dstObj" << std::endl;
+    std::cout << "Function: " << __func__ << ", Abort: pimAlloc failed for dstObj" << std::endl;
     return;
   }
 
-  PimStatus status = pimBroadcastInt(dstObj, 0);
-  if (status != PIM_OK)
+  PimObjId partialObj = pimAllocAssociated(dstObj, PIM_INT32);
+  if (partialObj == -1)
   {
-    std::cout << "Function: " << __func__ << ", Abort: pimBroadcastInt failed for dstObj" << std::endl;
+    std::cout << "Function: " << __func__ << ", Abort: pimAllocAssociated failed for partialObj" << std::endl;
     return;
   }
 
-  for (uint64_t i = 0; i < col; ++i)
+  std::vector<int> tile(row * colsPerTile, 0);
+  for (uint64_t colBegin = 0; colBegin < col; colBegin += colsPerTile)
   {
-    status = pimCopyHostToDevice((void *)srcMatrix[i].data(), srcObj);
+    uint64_t numColsInTile = std::min(colsPerTile, col - colBegin);
+    for (uint64_t i = 0; i < numColsInTile; ++i)
+    {
+      std::copy(srcMatrix[colBegin + i].begin(), srcMatrix[colBegin + i].begin() + row, tile.begin() + i * row);
+    }
+    // Columns past the end of the last tile are left as zero
+    std::fill(tile.begin() + numColsInTile * row, tile.end(), 0);
+    std::vector<int> vecTile(colsPerTile, 0);
+    std::copy(srcVector.begin() + colBegin, srcVector.begin() + colBegin + numColsInTile, vecTile.begin());
+
+    status = pimCopyHostToDevice((void *)tile.data(), matObj);
     if (status != PIM_OK)
     {
-      std::cout << "Function: " << __func__ << ", Abort: pimCopyHostToDevice failed between srcMatrix and srcObj at i=" << i << std::endl;
+      std::cout << "Function: " << __func__ << ", Abort: pimCopyHostToDevice failed between srcMatrix and matObj at column " << colBegin << std::endl;
       return;
     }
 
-    status = pimScaledAdd(srcObj, dstObj, dstObj, srcVector[i]);
+    status = pimGemv(matObj, (void *)vecTile.data(), colBegin == 0 ? dstObj : partialObj);
     if (status != PIM_OK)
     {
-      std::cout << "Function: " << __func__ << ", Abort: pimScaledAdd failed between srcObj1 and srcObj2 at i=" << i << std::endl;
+      std::cout << "Function: " << __func__ << ", Abort: pimGemv failed at column " << colBegin << std::endl;
       return;
     }
+
+    if (colBegin != 0)
+    {
+      status = pimAdd(partialObj, dstObj, dstObj);
+      if (status != PIM_OK)
+      {
+        std::cout << "Function: " << __func__ << ", Abort: pimAdd failed between partialObj and dstObj at column " << colBegin << std::endl;
+        return;
+      }
+    }
   }
 
   dst.resize(row);
@@ -546,8 +563,9 @@ void gemv(uint64_t row, uint64_t col, std::vector<int> &srcVector, std::vector<s
   {
     std::cout << "Function: " << __func__ << ", Abort: pimCopyDeviceToHost failed between dstObj and dst" << std::endl;
   }
-  pimFree(srcObj);
+  pimFree(matObj);
   pimFree(dstObj);
+  pimFree(partialObj);
 }
 
 // Perform the RELU (REctified Linear Unit) operation, max(0, x), a non-linear activation function in PIM for the given 1D input vector; called after GEMV operation.